@@ -431,7 +431,7 @@ void Application::loadModel(std::string filename)
 		std::cout << ext << " extension not supported!" << std::endl;
 	}
 
-	scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+	renderer->initDescriptors(scenes[sceneIndex]);
 	renderer->buildCmdBuffer(scenes[sceneIndex]);
 	renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
 }
@@ -517,7 +517,7 @@ void Application::setupInput()
 		//	}
 
 		//	//renderer->prepare(userCamera, scenes[sceneIndex]);
-		//	scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+		//	renderer->initDescriptors(scenes[sceneIndex]);
 		//	renderer->buildCmdBuffer(scenes[sceneIndex]);
 		//	renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
 		//}
@@ -646,7 +646,7 @@ void Application::updateGUI()
 				{
 					std::cout << "selected file " << filename << std::endl;
 					scenes[sceneIndex] = IO::SceneLoader::loadScene(assetManager, filename);
-					scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+					renderer->initDescriptors(scenes[sceneIndex]);
 					scenes[sceneIndex]->update(0.0f);
 
 					renderer->updateLights(userCamera, scenes[sceneIndex]);
@@ -769,7 +769,7 @@ void Application::updateGUI()
 					box->addComponent(pr::Renderable::create(mesh));
 
 					scenes[sceneIndex]->addRoot(box);
-					scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+					renderer->initDescriptors(scenes[sceneIndex]);
 					renderer->buildCmdBuffer(scenes[sceneIndex]);
 					renderer->buildShadowCmdBuffer(scenes[sceneIndex]);
 					renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
@@ -787,7 +787,7 @@ void Application::updateGUI()
 					sphere->addComponent(pr::Renderable::create(mesh));
 
 					scenes[sceneIndex]->addRoot(sphere);
-					scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+					renderer->initDescriptors(scenes[sceneIndex]);
 					renderer->buildCmdBuffer(scenes[sceneIndex]);
 					renderer->buildShadowCmdBuffer(scenes[sceneIndex]);
 					renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
@@ -805,7 +805,7 @@ void Application::updateGUI()
 					quad->addComponent(pr::Renderable::create(mesh));
 
 					scenes[sceneIndex]->addRoot(quad);
-					scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+					renderer->initDescriptors(scenes[sceneIndex]);
 					renderer->buildCmdBuffer(scenes[sceneIndex]);
 					renderer->buildShadowCmdBuffer(scenes[sceneIndex]);
 					renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
@@ -865,7 +865,7 @@ void Application::updateGUI()
 				auto root = assetManager.getEntity(entityID);
 				scenes[sceneIndex]->addRoot(root);
 
-				scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+				renderer->initDescriptors(scenes[sceneIndex]);
 				renderer->buildCmdBuffer(scenes[sceneIndex]);
 				renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
 			}
@@ -1037,7 +1037,7 @@ void Application::updateGUI()
 							subMesh.material = nullptr;
 							mesh->addSubMesh(subMesh);
 
-							scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+							renderer->initDescriptors(scenes[sceneIndex]);
 							renderer->buildCmdBuffer(scenes[sceneIndex]);
 							renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
 						}
@@ -1050,8 +1050,10 @@ void Application::updateGUI()
 						auto triangleCount = subMeshes[primitiveSelected].primitive->getIndexCount() / 3;
 						std::string verticesTxt = "Vertices: " + std::to_string(vertexCount);
 						std::string trianglesTxt = "Triangles: " + std::to_string(triangleCount);
+						std::string lodsTxt = "LODs: " + std::to_string(subMeshes[primitiveSelected].primitive->getNumLods());
 						ImGui::Text(verticesTxt.c_str());
 						ImGui::Text(trianglesTxt.c_str());
+						ImGui::Text(lodsTxt.c_str());
 						
 						if (subMeshes[primitiveSelected].material)
 						{
@@ -1137,7 +1139,7 @@ void Application::updateGUI()
 									int matID = *(int*)(payload->Data);
 									subMeshes[primitiveSelected].material = assetManager.getMaterial(matID);
 
-									scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+									renderer->initDescriptors(scenes[sceneIndex]);
 									renderer->buildCmdBuffer(scenes[sceneIndex]);
 									renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
 								}
@@ -1243,7 +1245,7 @@ void Application::updateGUI()
 							auto mesh = pr::Mesh::create("Mesh");
 							auto r = pr::Renderable::create(mesh);
 							selectedModel->addComponent(r);
-							scenes[sceneIndex]->initDescriptors(renderer->getDescriptorPool());
+							renderer->initDescriptors(scenes[sceneIndex]);
 							renderer->buildCmdBuffer(scenes[sceneIndex]);
 							renderer->buildScatterCmdBuffer(scenes[sceneIndex]);
 							break;
@@ -1294,6 +1296,7 @@ void Application::loop()
 		int currentBuffer = swapchain->acquireNextFrame();
 
 		renderer->renderToTexture(scenes[sceneIndex]);
+		renderer->updateCmdBuffer(scenes[sceneIndex]); // records the culled draws again if they changed
 		auto mainCmdBuf = renderer->getCommandBuffer(currentBuffer);
 		context.submitCommandBuffer(swapchain, mainCmdBuf);
 		context.waitDeviceIdle(); 
@@ -766,6 +766,7 @@ void Application::loop()
 		int currentBuffer = swapchain->acquireNextFrame();
 
 		renderer->renderToTexture(scenes[sceneIndex]);
+		renderer->updateCmdBuffer(scenes[sceneIndex]); // records the culled draws again if they changed
 		auto mainCmdBuf = renderer->getCommandBuffer(currentBuffer);
 		context.submitCommandBuffer(swapchain, mainCmdBuf);
 		context.waitDeviceIdle(); // TODO: check if this is still needed
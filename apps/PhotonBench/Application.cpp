@@ -0,0 +1,268 @@
+#include "Application.h"
+
+#include <IO/GLTFImporter.h>
+#include <IO/ImageLoader.h>
+#include <Utils/IBL.h>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/prettywriter.h>
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <fstream>
+
+using namespace std::chrono;
+namespace json = rapidjson;
+
+Application::Application(const BenchSettings& settings) :
+	settings(settings),
+	context(pr::GraphicsContext::getInstance())
+{
+#ifdef GPU_BACKEND_OPENGL
+	if (settings.api == pr::GraphicsAPI::OpenGL)
+		window = Win32Window::create("PhotonBench", settings.width, settings.height);
+	else
+#endif
+		window = HeadlessWindow::create("PhotonBench", settings.width, settings.height);
+	camera.setAspect((float)settings.width / (float)settings.height);
+}
+
+Application::~Application()
+{
+
+}
+
+bool Application::init()
+{
+	context.init(settings.api, window);
+	swapchain = context.createSwapchain(window);
+
+	std::ifstream file(settings.sceneList);
+	if (!file.is_open())
+	{
+		std::cout << "error: could not open scene list " << settings.sceneList << std::endl;
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty() || line[0] == '#')
+			continue;
+		sceneFiles.push_back(line);
+	}
+
+	if (sceneFiles.empty())
+	{
+		std::cout << "error: scene list " << settings.sceneList << " is empty" << std::endl;
+		return false;
+	}
+
+	auto panoImg = IO::ImageLoader::loadHDRFromFile(settings.environment);
+	uint32 width = panoImg->getWidth();
+	uint32 height = panoImg->getHeight();
+	uint8* data = panoImg->getData();
+	uint32 dataSize = width * height * sizeof(float) * 4;
+	auto panoTex = pr::Texture2D::create(width, height, GPU::Format::RGBA32F);
+	panoTex->upload(data, dataSize);
+	skybox = IBL::convertEqui2CM(panoTex, 1024, 0.0f);
+
+	results.SetObject();
+	auto& allocator = results.GetAllocator();
+	std::string apiName = (settings.api == pr::GraphicsAPI::Null) ? "Null" : "OpenGL";
+	results.AddMember("api", json::Value(apiName.c_str(), allocator), allocator);
+	results.AddMember("width", settings.width, allocator);
+	results.AddMember("height", settings.height, allocator);
+	results.AddMember("frames", settings.numFrames, allocator);
+	results.AddMember("scenes", json::Value(json::kArrayType), allocator);
+
+	return true;
+}
+
+bool Application::loadScene(const std::string& filename)
+{
+	IO::glTF::Importer importer;
+	std::vector<pr::Scene::Ptr> importedScenes;
+	int defaultScene = importer.importModel(filename, importedScenes);
+	if (defaultScene < 0)
+	{
+		std::cout << "error: could not load " << filename << std::endl;
+		return false;
+	}
+
+	scene = importedScenes[defaultScene];
+	scene->setSkybox(skybox);
+	return true;
+}
+
+void Application::initCamera()
+{
+	auto bbox = scene->getBoundingBox();
+	glm::vec3 center = bbox.getCenter();
+	glm::vec3 minPoint = bbox.getMinPoint();
+	glm::vec3 maxPoint = bbox.getMaxPoint();
+	glm::vec3 diag = maxPoint - minPoint;
+
+	float aspect = (float)settings.width / (float)settings.height;
+	camera.init(center, 45.0f, aspect);
+
+	float fovy = camera.getFov();
+	float fovx = fovy * aspect;
+	float xZoom = diag.x * 0.5f / glm::tan(fovx / 2.0f);
+	float yZoom = diag.y * 0.5f / glm::tan(fovy / 2.0f);
+	float dist = glm::max(xZoom, yZoom);
+	camera.setDistance(dist * 2.0f);
+
+	float longestDistance = 10.0f * glm::distance(minPoint, maxPoint);
+	float zNear = dist - (longestDistance * 0.6f);
+	float zFar = dist + (longestDistance * 0.6f);
+	zNear = glm::max(zNear, zFar / 10000.0f);
+	camera.setPlanes(zNear, zFar);
+	camera.rotate(0.0f);
+}
+
+void Application::runScene(const std::string& filename)
+{
+	std::cout << "benchmarking " << filename << std::endl;
+
+	auto startTime = high_resolution_clock::now();
+	if (!loadScene(filename))
+		return;
+	auto endTime = high_resolution_clock::now();
+	double loadTime = duration<double, std::milli>(endTime - startTime).count();
+
+	renderer = pr::Renderer::create();
+	renderer->init(window, swapchain);
+
+	initCamera();
+	renderer->prepare(camera, scene);
+	renderer->buildCmdBuffer(scene, swapchain);
+	renderer->buildShadowCmdBuffer(scene);
+	renderer->buildScatterCmdBuffer(scene);
+
+	// the camera orbits the scene once, all animations advance with a fixed time step
+	const float dt = 1.0f / 60.0f;
+	const float yawPerFrame = 3600.0f / settings.numFrames; // OrbitCamera rotates 0.1 degrees per unit
+	float totalTime = 0.0f;
+
+#ifdef GPU_BACKEND_OPENGL
+	Win32EventHandler& eventHandler = Win32EventHandler::instance();
+#endif
+	profiler.clear();
+	for (uint32 frame = 0; frame < settings.numFrames; frame++)
+	{
+		pr::ScopedTimer frameTimer(profiler, "Frame");
+
+		{
+			pr::ScopedTimer timer(profiler, "Scene::update");
+			scene->update(dt);
+		}
+
+		camera.updateRotation(yawPerFrame, 0.0f);
+		camera.rotate(dt);
+
+		{
+			pr::ScopedTimer timer(profiler, "Renderer::updateCamera");
+			renderer->updateCamera(scene, camera, totalTime);
+		}
+		{
+			pr::ScopedTimer timer(profiler, "Renderer::updateLights");
+			renderer->updateLights(camera, scene);
+		}
+
+		int currentBuffer = swapchain->acquireNextFrame();
+		{
+			pr::ScopedTimer timer(profiler, "Renderer::renderToTexture");
+			renderer->renderToTexture(scene);
+		}
+		{
+			pr::ScopedTimer timer(profiler, "Renderer::buildCmdBuffer");
+			renderer->updateCmdBuffer(scene, swapchain);
+		}
+		{
+			pr::ScopedTimer timer(profiler, "Submit");
+			auto mainCmdBuf = renderer->getCommandBuffer(currentBuffer);
+			context.submitCommandBuffer(swapchain, mainCmdBuf);
+			swapchain->present(mainCmdBuf);
+		}
+
+#ifdef GPU_BACKEND_OPENGL
+		if (settings.api == pr::GraphicsAPI::OpenGL)
+			eventHandler.handleEvents();
+#endif
+
+		totalTime += dt;
+	}
+	context.waitDeviceIdle();
+
+	addResults(filename, loadTime);
+
+	scene.reset();
+	renderer.reset();
+}
+
+void Application::addResults(const std::string& filename, double loadTime)
+{
+	auto& allocator = results.GetAllocator();
+
+	json::Value phases(json::kObjectType);
+	for (auto& phase : profiler.getPhases())
+	{
+		auto stats = profiler.getStats(phase);
+		json::Value phaseNode(json::kObjectType);
+		phaseNode.AddMember("count", stats.count, allocator);
+		phaseNode.AddMember("avg", stats.avg, allocator);
+		phaseNode.AddMember("min", stats.min, allocator);
+		phaseNode.AddMember("max", stats.max, allocator);
+		phaseNode.AddMember("p50", stats.p50, allocator);
+		phaseNode.AddMember("p95", stats.p95, allocator);
+		phaseNode.AddMember("p99", stats.p99, allocator);
+		phases.AddMember(json::Value(phase.c_str(), allocator), phaseNode, allocator);
+	}
+
+	json::Value sceneNode(json::kObjectType);
+	sceneNode.AddMember("file", json::Value(filename.c_str(), allocator), allocator);
+	sceneNode.AddMember("loadTime", loadTime, allocator);
+	sceneNode.AddMember("phases", phases, allocator);
+	results["scenes"].PushBack(sceneNode, allocator);
+
+	auto frameStats = profiler.getStats("Frame");
+	std::cout << "avg. frame time: " << frameStats.avg << " ms, p95: " << frameStats.p95 << " ms" << std::endl;
+}
+
+void Application::writeResults()
+{
+	json::StringBuffer buffer;
+	json::PrettyWriter<json::StringBuffer> writer(buffer);
+	results.Accept(writer);
+
+	std::ofstream file(settings.outputFile);
+	if (!file.is_open())
+	{
+		std::cout << "error: could not write results to " << settings.outputFile << std::endl;
+		return;
+	}
+	file << buffer.GetString();
+	std::cout << "wrote results to " << settings.outputFile << std::endl;
+}
+
+void Application::loop()
+{
+	for (auto& filename : sceneFiles)
+		runScene(filename);
+
+	writeResults();
+}
+
+void Application::shutdown()
+{
+	context.waitDeviceIdle();
+
+	scene.reset();
+	renderer.reset();
+	skybox.reset();
+	swapchain.reset();
+	context.destroy();
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef INCLUDED_APPLICATION
+#define INCLUDED_APPLICATION
+
+#pragma once
+
+#ifdef GPU_BACKEND_OPENGL
+#include <Platform/Win32/Win32Window.h>
+#include <Platform/Win32/Win32EventHandler.h>
+#endif
+
+#include <Graphics/GraphicsContext.h>
+#include <Graphics/OrbitCamera.h>
+#include <Graphics/Renderer.h>
+
+#include <Utils/Profiler.h>
+
+#include <rapidjson/document.h>
+
+struct BenchSettings
+{
+	std::string sceneList;
+	std::string outputFile = "bench_results.json";
+	std::string environment = "../../../../assets/glTF-Sample-Environments/doge2.hdr";
+	uint32 numFrames = 600;
+	uint32 width = 1600;
+	uint32 height = 900;
+#ifdef GPU_BACKEND_OPENGL
+	pr::GraphicsAPI api = pr::GraphicsAPI::OpenGL;
+#else
+	pr::GraphicsAPI api = pr::GraphicsAPI::Null;
+#endif
+};
+
+// window without a native surface, used with the Null backend
+class HeadlessWindow : public Window
+{
+public:
+	HeadlessWindow(const std::string& title, uint32 width, uint32 height) :
+		Window(title, width, height)
+	{
+
+	}
+	void setTitle(std::string title) {}
+	void setCursorPos(int posX, int posY) {}
+	void getCursorPos(int& posX, int& posY) { posX = 0; posY = 0; }
+
+	typedef std::shared_ptr<HeadlessWindow> Ptr;
+	static Ptr create(const std::string& title, uint32 width, uint32 height)
+	{
+		return std::make_shared<HeadlessWindow>(title, width, height);
+	}
+};
+
+class Application
+{
+	BenchSettings settings;
+	Window::Ptr window;
+	GPU::Swapchain::Ptr swapchain;
+
+	OrbitCamera camera;
+	pr::GraphicsContext& context;
+	pr::Renderer::Ptr renderer;
+	pr::Scene::Ptr scene;
+	pr::Profiler profiler;
+
+	pr::TextureCubeMap::Ptr skybox;
+	std::vector<std::string> sceneFiles;
+	rapidjson::Document results;
+
+	Application(const Application&) = delete;
+	Application& operator=(const Application&) = delete;
+public:
+	Application(const BenchSettings& settings);
+	~Application();
+	bool init();
+	bool loadScene(const std::string& filename);
+	void initCamera();
+	void runScene(const std::string& filename);
+	void addResults(const std::string& filename, double loadTime);
+	void writeResults();
+	void loop();
+	void shutdown();
+};
+
+#endif // INCLUDED_APPLICATION
\ No newline at end of file
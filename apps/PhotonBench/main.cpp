@@ -0,0 +1,57 @@
+#include "Application.h"
+
+void printUsage()
+{
+	std::cout << "usage: PhotonBench <scene list> [-frames N] [-width W] [-height H] [-api gl|null] [-env panorama.hdr] [-out results.json]" << std::endl;
+	std::cout << "the scene list contains one glTF file per line, lines starting with # are ignored" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printUsage();
+		return 1;
+	}
+
+	BenchSettings settings;
+	settings.sceneList = argv[1];
+	for (int i = 2; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		std::string value = argv[i + 1];
+		if (option.compare("-frames") == 0)
+			settings.numFrames = std::stoi(value);
+		else if (option.compare("-width") == 0)
+			settings.width = std::stoi(value);
+		else if (option.compare("-height") == 0)
+			settings.height = std::stoi(value);
+		else if (option.compare("-out") == 0)
+			settings.outputFile = value;
+		else if (option.compare("-env") == 0)
+			settings.environment = value;
+#ifdef GPU_BACKEND_OPENGL
+		else if (option.compare("-api") == 0 && value.compare("gl") == 0)
+			settings.api = pr::GraphicsAPI::OpenGL;
+#endif
+#ifdef GPU_BACKEND_NULL
+		else if (option.compare("-api") == 0 && value.compare("null") == 0)
+			settings.api = pr::GraphicsAPI::Null;
+#endif
+		else
+		{
+			std::cout << "unknown option " << option << " " << value << std::endl;
+			printUsage();
+			return 1;
+		}
+	}
+
+	Application app(settings);
+	if (app.init())
+	{
+		app.loop();
+	}
+	app.shutdown();
+
+	return 0;
+}
\ No newline at end of file
@@ -343,7 +343,7 @@ void Application::loop()
 		//	auto node = assetManager.getNodeFromPath("DamagedHelmet\\DamagedHelmet.gltf");
 		//	auto root = assetManager.getEntity(node->entityIndex);
 		//	scene->addRoot(root);
-		//	scene->initDescriptors(renderer->getDescriptorPool());
+		//	renderer->initDescriptors(scene);
 		//	renderer->buildCmdBuffer(scene, swapchain);
 		//	renderer->buildScatterCmdBuffer(scene);
 
@@ -375,6 +375,8 @@ void Application::loop()
 		renderer->renderToTexture(scene);
 		if (context.getCurrentAPI() == pr::GraphicsAPI::Direct3D11)
 			renderer->buildCmdBuffer(scene, swapchain);
+		else
+			renderer->updateCmdBuffer(scene, swapchain); // records the culled draws again if they changed
 		auto mainCmdBuf = renderer->getCommandBuffer(currentBuffer);
 		context.submitCommandBuffer(swapchain, mainCmdBuf);
 		swapchain->present(mainCmdBuf);
@@ -1,6 +1,7 @@
 #include "Component.h"
 
 unsigned int pr::Component::globalIDCount = 0;
+std::atomic<uint32> pr::RenderQueueVersion::state(0);
 
 namespace pr
 {
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <Platform/Types.h>
+
+#include <atomic>
 #include <memory>
 
 namespace pr
@@ -18,6 +21,14 @@ namespace pr
 		unsigned int id;
 		static unsigned int globalIDCount;
 	};
+
+	// Change counter for the render state, which is shared between scenes through meshes and materials.
+	// Scenes only re-sort their render queues when it changed, hierarchy changes are counted per root
+	// entity (see Entity::getStructureVersion) and rebuild only the queues of the scene they are in.
+	struct RenderQueueVersion
+	{
+		static std::atomic<uint32> state; // render type, priority, enable state or materials of renderables changed
+	};
 }
 
 #endif // INCLUDED_COMPONENT
\ No newline at end of file
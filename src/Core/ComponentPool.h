@@ -0,0 +1,126 @@
+#ifndef INCLUDED_COMPONENTPOOL
+#define INCLUDED_COMPONENTPOOL
+
+#pragma once
+
+#include <Platform/Types.h>
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace pr
+{
+	class Entity;
+
+	class ComponentPoolBase
+	{
+	public:
+		virtual ~ComponentPoolBase() {}
+		virtual void remove(uint32 entityID) = 0;
+	};
+
+	// Sparse set with the components of one type of all entities. The sparse array maps entity IDs
+	// to slots in the dense arrays, which are kept packed by moving the last slot into removed ones,
+	// so iterating over all components of a type is a linear scan without touching the hierarchy.
+	// Entities can be built on loading threads while the main thread uses other entities, so changes
+	// lock the pool exclusively and lookups and scans share the lock.
+	template<typename T>
+	class ComponentPool : public ComponentPoolBase
+	{
+	public:
+		// the pools are never destroyed, entities held by other static objects may outlive them
+		static ComponentPool<T>& get()
+		{
+			static ComponentPool<T>* pool = new ComponentPool<T>();
+			return *pool;
+		}
+
+		// returns true if the entity didn't have a component of this type yet
+		bool insert(Entity* entity, uint32 entityID, std::shared_ptr<T> component)
+		{
+			std::unique_lock<std::shared_mutex> lock(mutex);
+			if (entityID >= sparse.size())
+				sparse.resize(entityID + 1, invalid);
+
+			uint32 slot = sparse[entityID];
+			if (slot != invalid)
+			{
+				components[slot] = component;
+				return false;
+			}
+
+			sparse[entityID] = static_cast<uint32>(entities.size());
+			entityIDs.push_back(entityID);
+			entities.push_back(entity);
+			components.push_back(component);
+			return true;
+		}
+
+		void remove(uint32 entityID)
+		{
+			std::unique_lock<std::shared_mutex> lock(mutex);
+			if (entityID >= sparse.size() || sparse[entityID] == invalid)
+				return;
+
+			uint32 slot = sparse[entityID];
+			uint32 last = static_cast<uint32>(entities.size() - 1);
+			if (slot != last)
+			{
+				entityIDs[slot] = entityIDs[last];
+				entities[slot] = entities[last];
+				components[slot] = components[last];
+				sparse[entityIDs[slot]] = slot;
+			}
+			entityIDs.pop_back();
+			entities.pop_back();
+			components.pop_back();
+			sparse[entityID] = invalid;
+		}
+
+		std::shared_ptr<T> find(uint32 entityID) const
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			if (entityID >= sparse.size() || sparse[entityID] == invalid)
+				return nullptr;
+			return components[sparse[entityID]];
+		}
+
+		uint32 size() const
+		{
+			return static_cast<uint32>(entities.size());
+		}
+
+		// held while scanning the dense arrays with size, getEntity and getComponent
+		std::shared_lock<std::shared_mutex> lockShared() const
+		{
+			return std::shared_lock<std::shared_mutex>(mutex);
+		}
+
+		Entity* getEntity(uint32 index) const
+		{
+			return entities[index];
+		}
+
+		std::shared_ptr<T>& getComponent(uint32 index)
+		{
+			return components[index];
+		}
+
+	private:
+		ComponentPool() {}
+		ComponentPool(const ComponentPool&) = delete;
+		ComponentPool& operator=(const ComponentPool&) = delete;
+
+		static constexpr uint32 invalid = 0xFFFFFFFF;
+
+		std::vector<uint32> sparse;
+		std::vector<uint32> entityIDs;
+		std::vector<Entity*> entities;
+		std::vector<std::shared_ptr<T>> components;
+		mutable std::shared_mutex mutex;
+	};
+}
+
+#endif // INCLUDED_COMPONENTPOOL
\ No newline at end of file
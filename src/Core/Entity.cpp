@@ -1,3 +1,3 @@
 #include "Entity.h"
 
-unsigned int pr::Entity::globalIDCount = 0;
\ No newline at end of file
+std::atomic<unsigned int> pr::Entity::globalIDCount(0);
\ No newline at end of file
@@ -4,12 +4,13 @@
 #pragma once
 
 #include "Component.h"
+#include "ComponentPool.h"
 #include "Transform.h"
 #include <Platform/Types.h>
 
+#include <atomic>
 #include <map>
 #include <string>
-#include <typeindex>
 #include <vector>
 #include <iostream>
 
@@ -21,27 +22,33 @@ namespace pr
 		std::string name;
 		std::string uri;
 		std::shared_ptr<Entity> parent = nullptr;
+		Entity* root; // topmost parent, the parent is only set on creation
+		std::atomic<uint32> structureVersion; // changes of the hierarchy below this root
 		std::vector<std::shared_ptr<Entity>> children;
-		std::map<std::type_index, Component::Ptr> components;
+		std::vector<ComponentPoolBase*> pools; // the components are stored in the pool of their type
+		Transform::Ptr transform; // cached, every entity has one
 
 		bool prefab = false;
 		bool active = true;
 		unsigned int id;
 
-		static unsigned int globalIDCount;
+		static std::atomic<unsigned int> globalIDCount; // entities are also created on loading threads
 
 	public:
 		Entity(const std::string& name, std::shared_ptr<Entity> parent) : name(name), parent(parent)
 		{
-			auto t = Transform::Ptr(new Transform());
-			addComponent(t);
-			id = globalIDCount;
-			globalIDCount++;
+			id = globalIDCount++;
+			root = parent ? parent->root : this;
+			structureVersion = 0;
+			transform = Transform::Ptr(new Transform());
+			addComponent(transform);
 			//std::cout << "creating entity " << std::to_string(id) << std::endl;
 		}
 
 		~Entity()
 		{
+			for (auto pool : pools)
+				pool->remove(id);
 			//std::cout << "destroying entity " << std::to_string(id) << std::endl;
 		}
 
@@ -49,64 +56,65 @@ namespace pr
 		std::shared_ptr<T> addComponent()
 		{
 			std::shared_ptr<T> component(new T);
-			components[typeid(T)] = component;
+			addComponent(component);
 			return component;
 		}
 
 		template<typename T>
 		void addComponent(std::shared_ptr<T> component)
 		{
-			components[typeid(T)] = component;
+			auto& pool = ComponentPool<T>::get();
+			if (pool.insert(this, id, component))
+				pools.push_back(&pool);
+			root->structureVersion++;
 		}
 
 		template<typename T>
 		std::shared_ptr<T> getComponent()
 		{
-			if (components.find(typeid(T)) != components.end())
-			{
-				return std::dynamic_pointer_cast<T>(components[typeid(T)]);
-			}
-			return nullptr;
+			return ComponentPool<T>::get().find(id);
 		}
 
 		template<typename T>
 		std::vector<std::shared_ptr<T>> getComponentsInChildren(bool onlyActive = false)
 		{
 			std::vector<std::shared_ptr<T>> allComponents;
-			if (onlyActive && !active)
-				return allComponents;
-			auto rootComponent = getComponent<T>();
-			if (rootComponent)
-				allComponents.push_back(rootComponent);
-			for (auto c : children)
-			{
-				auto childComponents = c->getComponentsInChildren<T>(onlyActive);
-				for (auto childComp : childComponents)
-					allComponents.push_back(childComp);
-			}
+			collectComponents<T>(allComponents, onlyActive);
 			return allComponents;
 		}
 
+		// entities of this subtree with a component T in hierarchy order, for per frame queries
+		// over a whole scene use Scene::forEachComponent which scans the component pool instead
 		template<typename T>
 		std::vector<std::shared_ptr<Entity>> getChildrenWithComponent(bool onlyActive = false)
 		{
 			std::vector<std::shared_ptr<Entity>> entities;
-			if (onlyActive && !active)
-				return entities;
-			if (getComponent<T>())
-				entities.push_back(shared_from_this());
-			for (auto c : children)
-			{
-				auto chiledEntities = c->getChildrenWithComponent<T>(onlyActive);
-				for (auto child : chiledEntities)
-					entities.push_back(child);
-			}
+			collectEntities<T>(entities, onlyActive);
 			return entities;
 		}
 
+		// topmost parent of this entity
+		Entity* getRoot()
+		{
+			return root;
+		}
+
+		// incremented on the root when entities or components of its hierarchy are added, activated or deactivated
+		uint32 getStructureVersion()
+		{
+			return root->structureVersion;
+		}
+
 		void addChild(std::shared_ptr<Entity> child)
 		{
 			children.push_back(child);
+			child->transform->setParent(transform.get());
+			if (child->root != root)
+			{
+				child->root->structureVersion++; // the subtree left its old hierarchy
+				child->setRoot(root);
+			}
+			root->structureVersion++;
 		}
 
 		void getAllNodes(std::map<int, std::shared_ptr<Entity>>& nodes)
@@ -116,13 +124,16 @@ namespace pr
 				child->getAllNodes(nodes);
 		}
 
-		void update(glm::mat4 parentTransform)
+		void update(const glm::mat4& parentTransform, bool parentChanged = false)
 		{
-			auto t = getComponent<Transform>();
-			t->update(parentTransform);
-			auto T = t->getTransform();
-			for (auto c : children)
-				c->update(T);
+			// nothing changed in this subtree, all world transforms are still valid
+			if (!parentChanged && !transform->isDirty() && !transform->hasDirtyChildren())
+				return;
+
+			bool changed = transform->update(parentTransform, parentChanged);
+			glm::mat4 T = transform->getTransform();
+			for (auto& c : children)
+				c->update(T, changed);
 		}
 
 		void setName(const std::string& name)
@@ -187,6 +198,9 @@ namespace pr
 		void clearParent()
 		{
 			parent = nullptr;
+			root->structureVersion++;
+			root = this;
+			transform->setParent(nullptr);
 			for (auto c : children)
 				c->clearParent();
 		}
@@ -199,6 +213,8 @@ namespace pr
 		// TODO: set subtree aswell...
 		void setActive(bool active)
 		{
+			if (this->active != active)
+				root->structureVersion++;
 			this->active = active;
 		}
 
@@ -222,6 +238,37 @@ namespace pr
 		{
 			return std::make_shared<Entity>(name, parent);
 		}
+
+	private:
+		void setRoot(Entity* root)
+		{
+			this->root = root;
+			for (auto c : children)
+				c->setRoot(root);
+		}
+
+		template<typename T>
+		void collectComponents(std::vector<std::shared_ptr<T>>& allComponents, bool onlyActive)
+		{
+			if (onlyActive && !active)
+				return;
+			auto component = getComponent<T>();
+			if (component)
+				allComponents.push_back(component);
+			for (auto& c : children)
+				c->collectComponents<T>(allComponents, onlyActive);
+		}
+
+		template<typename T>
+		void collectEntities(std::vector<std::shared_ptr<Entity>>& entities, bool onlyActive)
+		{
+			if (onlyActive && !active)
+				return;
+			if (getComponent<T>())
+				entities.push_back(shared_from_this());
+			for (auto& c : children)
+				c->collectEntities<T>(entities, onlyActive);
+		}
 	};
 }
 
@@ -0,0 +1,141 @@
+#include "Jobs.h"
+
+#include <algorithm>
+
+namespace pr
+{
+	static thread_local uint32 queueIndex = 0;
+
+	JobSystem::JobSystem()
+	{
+		uint32 numWorkers = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+		for (uint32 i = 0; i <= numWorkers; i++)
+			queues.push_back(std::make_unique<Queue>());
+		for (uint32 i = 1; i <= numWorkers; i++)
+			workers.push_back(std::thread(&JobSystem::workerLoop, this, i));
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			running = false;
+		}
+		wakeUp.notify_all();
+		for (auto& t : workers)
+			t.join();
+	}
+
+	void JobSystem::run(Job job, JobCounter& counter)
+	{
+		counter.pending++;
+		auto wrapped = [job, &counter]() {
+			job();
+			counter.pending--;
+		};
+
+		if (workers.empty())
+		{
+			wrapped();
+			return;
+		}
+
+		// counted before it is queued so the count never drops below zero when it is stolen right away
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			queuedJobs++;
+		}
+		{
+			auto& queue = *queues[queueIndex];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.push_back(wrapped);
+		}
+		wakeUp.notify_one();
+	}
+
+	void JobSystem::wait(JobCounter& counter)
+	{
+		while (counter.pending > 0)
+		{
+			if (!tryRunJob(queueIndex))
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::parallelFor(uint32 count, uint32 minBatchSize, const std::function<void(uint32)>& func)
+	{
+		if (count == 0)
+			return;
+
+		// a few batches per thread so threads that finish early can steal the rest
+		uint32 numBatches = std::min(getNumThreads() * 4, (count + minBatchSize - 1) / std::max(minBatchSize, 1u));
+		if (numBatches <= 1)
+		{
+			for (uint32 i = 0; i < count; i++)
+				func(i);
+			return;
+		}
+
+		JobCounter counter;
+		uint32 batchSize = (count + numBatches - 1) / numBatches;
+		for (uint32 start = 0; start < count; start += batchSize)
+		{
+			uint32 end = std::min(start + batchSize, count);
+			run([&func, start, end]() {
+				for (uint32 i = start; i < end; i++)
+					func(i);
+			}, counter);
+		}
+		wait(counter);
+	}
+
+	void JobSystem::workerLoop(uint32 index)
+	{
+		queueIndex = index;
+		while (true)
+		{
+			if (tryRunJob(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			wakeUp.wait(lock, [this]() { return queuedJobs > 0 || !running; });
+			if (!running)
+				return;
+		}
+	}
+
+	bool JobSystem::tryRunJob(uint32 index)
+	{
+		// own queue first, newest job first as its data is most likely still in the cache
+		Job job;
+		{
+			auto& queue = *queues[index];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+			}
+		}
+
+		// steal the oldest job of another queue, those are usually the largest pieces of work left
+		uint32 numQueues = static_cast<uint32>(queues.size());
+		for (uint32 i = 1; i < numQueues && !job; i++)
+		{
+			auto& queue = *queues[(index + i) % numQueues];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			}
+		}
+
+		if (!job)
+			return false;
+
+		queuedJobs--;
+		job();
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef INCLUDED_JOBS
+#define INCLUDED_JOBS
+
+#pragma once
+
+#include <Platform/Types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pr
+{
+	// number of jobs of one group that are not finished yet
+	struct JobCounter
+	{
+		std::atomic<uint32> pending{ 0 };
+	};
+
+	// Thread pool with one job queue per thread. Threads take the newest jobs of their own queue
+	// and steal the oldest ones from the other queues when theirs is empty. Threads that wait for
+	// a group of jobs execute queued jobs in the meantime, so jobs can start and wait for other jobs.
+	class JobSystem
+	{
+	public:
+		typedef std::function<void()> Job;
+
+		static JobSystem& getInstance()
+		{
+			static JobSystem instance;
+			return instance;
+		}
+
+		void run(Job job, JobCounter& counter);
+		void wait(JobCounter& counter);
+
+		// calls func(i) for all i in [0, count) and returns when all calls are done,
+		// consecutive indices are grouped into jobs of at least minBatchSize calls
+		void parallelFor(uint32 count, uint32 minBatchSize, const std::function<void(uint32)>& func);
+
+		uint32 getNumThreads()
+		{
+			return static_cast<uint32>(workers.size()) + 1; // the calling thread takes part as well
+		}
+
+	private:
+		JobSystem();
+		~JobSystem();
+
+		struct Queue
+		{
+			std::deque<Job> jobs;
+			std::mutex mutex;
+		};
+
+		void workerLoop(uint32 index);
+		bool tryRunJob(uint32 index);
+
+		std::vector<std::unique_ptr<Queue>> queues; // queue 0 is shared by all threads outside of the pool
+		std::vector<std::thread> workers;
+		std::atomic<uint32> queuedJobs{ 0 };
+		std::mutex sleepMutex;
+		std::condition_variable wakeUp;
+		bool running = true;
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+	};
+}
+
+#endif // INCLUDED_JOBS
\ No newline at end of file
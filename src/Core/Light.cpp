@@ -45,6 +45,7 @@ namespace pr
 		uniformData.type = static_cast<int>(type);
 		uniformData.on = on;
 		uniformData.castShadows = castShadows;
+		uniformData.shadowIndex = shadowIndex;
 	}
 
 	void Light::updateLightViewProjection(UserCamera& camera, Transform::Ptr transform)
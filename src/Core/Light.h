@@ -32,7 +32,7 @@ namespace pr
 		int type;
 		int on;
 		int castShadows;
-		uint32 padding;
+		int shadowIndex; // slot in the tile table of the shadow atlas, -1 if there is none
 	};
 
 	class Light : public Component
@@ -54,6 +54,9 @@ namespace pr
 		void setLuminousPower(float lumen);
 		void setColorTemp(int temp);
 		void setCastShadows(bool cashShadows) { this->castShadows = cashShadows;  }
+		void setShadowIndex(int index) { shadowIndex = index; }
+		bool getCastShadows() { return castShadows; }
+		int getShadowIndex() { return shadowIndex; }
 		float getLumen() { return lumen; }
 		float getRange() { return range; }
 		LightType getType() { return type; }
@@ -76,6 +79,7 @@ namespace pr
 		float outerConeAngle = glm::quarter_pi<float>();
 		bool on = true;
 		bool castShadows = true;
+		int shadowIndex = -1;
 
 		std::vector<glm::mat4> lightViewProjection;
 	};
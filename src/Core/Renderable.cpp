@@ -1,5 +1,6 @@
 #include "Renderable.h"
 #include <Graphics/GraphicsContext.h>
+#include <cstring>
 namespace pr
 {
 	Renderable::Renderable(pr::Mesh::Ptr mesh, RenderType type) : 
@@ -26,6 +27,8 @@ namespace pr
 
 	Renderable::~Renderable()
 	{
+		if (modelUniforms)
+			modelUniforms->release(modelOffset);
 	}
 
 	void Renderable::setMesh(pr::Mesh::Ptr mesh)
@@ -39,22 +42,35 @@ namespace pr
 			if (mat->isTransmissive())
 				type = RenderType::Transparent;
 		}
+		RenderQueueVersion::state++;
 	}
 
-	void Renderable::setDescriptor(GPU::DescriptorPool::Ptr descriptorPool)
+	void Renderable::setDescriptor(GPU::DescriptorPool::Ptr descriptorPool, GPU::UniformAllocator::Ptr modelUniforms, GPU::DescriptorSet::Ptr modelDescriptorSet)
 	{
-		auto& ctx = GraphicsContext::getInstance();
-		modelUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(UniformData), 0);
+		if (this->modelUniforms != modelUniforms)
+		{
+			if (this->modelUniforms)
+				this->modelUniforms->release(modelOffset);
 
-		descriptorSet = descriptorPool->createDescriptorSet("Model", 1);
-		descriptorSet->addDescriptor(modelUBO->getDescriptor());
-		descriptorSet->update();
+			// without a block of its own the renderable is not drawn, see hasModelData
+			this->modelUniforms = nullptr;
+			if (modelUniforms->allocate(modelOffset))
+				this->modelUniforms = modelUniforms;
+		}
+		descriptorSet = modelDescriptorSet;
 
 		mesh->setDescriptor(descriptorPool);
 	}
 
 	void Renderable::update(glm::mat4 modelMatrix)
 	{
+		// skins are computed before the renderables are updated
+		if (isSkinnedMesh())
+			worldBoundingBox = skin->getPosedBounds(mesh->getBoundingBox()).transform(modelMatrix);
+		else
+			worldBoundingBox = mesh->getBoundingBox().transform(modelMatrix);
+		localToWorld = modelMatrix;
+
 		UniformData model;
 		if (pr::GraphicsContext::getInstance().getCurrentAPI() == pr::GraphicsAPI::Direct3D11)
 		{
@@ -82,28 +98,41 @@ namespace pr
 		model.lightMapIndex = lightMapIndex;
 		model.lightMapST = glm::vec4(lightMapOffset, lightMapScale);
 		model.reflectionProbeIndex = specularProbeIndex;
+		model.shadowCascades = shadowCascades;
 		for (int i = 0; i < sh9.size(); i++)
 			model.sh[i] = glm::vec4(sh9[i], 0.0f);
 
-		modelUBO->uploadMapped(&model);
+		if (modelUniforms)
+			modelUniforms->write(modelOffset, &model);
 	}
 
-	void Renderable::render(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline)
+	void Renderable::render(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, float lodError)
 	{
-		if (enabled)
+		if (enabled && modelUniforms)
 		{
-			cmdBuffer->bindDescriptorSets(pipeline, descriptorSet, 1);
+			cmdBuffer->bindDescriptorSets(pipeline, descriptorSet, 1, modelOffset);
 			if (skin)
 				skin->bind(cmdBuffer, pipeline);
-			mesh->draw(cmdBuffer, pipeline);
+			mesh->draw(cmdBuffer, pipeline, lodError);
+		}
+	}
+
+	void Renderable::renderCulled(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, GPU::Buffer::Ptr indexBuffer, const std::vector<DrawRange>& ranges, float lodError)
+	{
+		if (enabled && modelUniforms)
+		{
+			cmdBuffer->bindDescriptorSets(pipeline, descriptorSet, 1, modelOffset);
+			if (skin)
+				skin->bind(cmdBuffer, pipeline);
+			mesh->drawCulled(cmdBuffer, pipeline, indexBuffer, ranges, lodError);
 		}
 	}
 
 	void Renderable::renderDepth(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline)
 	{
-		if (enabled)
+		if (enabled && modelUniforms)
 		{
-			cmdBuffer->bindDescriptorSets(pipeline, descriptorSet, 1);
+			cmdBuffer->bindDescriptorSets(pipeline, descriptorSet, 1, modelOffset);
 			if (skin)
 				skin->bind(cmdBuffer, pipeline);
 			mesh->drawDepth(cmdBuffer, pipeline);
@@ -118,11 +147,13 @@ namespace pr
 	void Renderable::setType(RenderType type)
 	{
 		this->type = type;
+		RenderQueueVersion::state++;
 	}
 
 	void Renderable::setPriority(uint32 priority)
 	{
 		this->priority = priority;
+		RenderQueueVersion::state++;
 	}
 
 	void Renderable::setDiffuseMode(int mode)
@@ -152,6 +183,11 @@ namespace pr
 		this->sh9 = sh9;
 	}
 
+	const std::vector<glm::vec3>& Renderable::getProbeSH9()
+	{
+		return sh9;
+	}
+
 	bool Renderable::isSkinnedMesh()
 	{
 		return (skin != nullptr);
@@ -182,6 +218,16 @@ namespace pr
 		return mesh->getBoundingBox();
 	}
 
+	AABB Renderable::getWorldBoundingBox()
+	{
+		return worldBoundingBox;
+	}
+
+	glm::mat4 Renderable::getLocalToWorld()
+	{
+		return localToWorld;
+	}
+
 	pr::Mesh::Ptr Renderable::getMesh()
 	{
 		return mesh;
@@ -205,6 +251,7 @@ namespace pr
 	void Renderable::setEnabled(bool enabled)
 	{
 		this->enabled = enabled;
+		RenderQueueVersion::state++;
 	}
 
 	std::string Renderable::getShaderName()
@@ -247,6 +294,27 @@ namespace pr
 		return specularProbeIndex;
 	}
 
+	uint32 Renderable::getUniformOffset()
+	{
+		return modelOffset;
+	}
+
+	void Renderable::setShadowCascades(int mask)
+	{
+		if (mask == shadowCascades)
+			return;
+
+		// only the mask changes, so patch the model data that was written last
+		shadowCascades = mask;
+		if (modelUniforms)
+		{
+			UniformData model;
+			std::memcpy(&model, modelUniforms->getBlockData(modelOffset), sizeof(model));
+			model.shadowCascades = mask;
+			modelUniforms->write(modelOffset, &model);
+		}
+	}
+
 	std::string Renderable::getReflName()
 	{
 		return reflName;
@@ -6,6 +6,7 @@
 #include "Component.h"
 #include <Graphics/Mesh.h>
 #include <Graphics/Skin.h>
+#include <GPU/UniformAllocator.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 
@@ -23,9 +24,10 @@ namespace pr
 		Renderable(pr::Mesh::Ptr mesh, RenderType type = RenderType::Opaque);
 		~Renderable();
 		void setMesh(pr::Mesh::Ptr mesh);
-		void setDescriptor(GPU::DescriptorPool::Ptr descriptorPool);
+		void setDescriptor(GPU::DescriptorPool::Ptr descriptorPool, GPU::UniformAllocator::Ptr modelUniforms, GPU::DescriptorSet::Ptr modelDescriptorSet);
 		void update(glm::mat4 modelMatrix);
-		void render(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline);
+		void render(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, float lodError = 0.0f);
+		void renderCulled(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, GPU::Buffer::Ptr indexBuffer, const std::vector<DrawRange>& ranges, float lodError = 0.0f);
 		void renderDepth(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline);
 		void setSkin(pr::Skin::Ptr skin);
 		void setType(RenderType type);
@@ -35,13 +37,17 @@ namespace pr
 		void setLightMapST(glm::vec2 offsect, glm::vec2 scale);
 		void setReflectionProbe(std::string name, int index);
 		void setProbeSH9(std::vector<glm::vec3>& sh9);
+		const std::vector<glm::vec3>& getProbeSH9();
 		bool isSkinnedMesh();
 		bool hasMorphtargets();
 		bool isTransmissive();
 		bool isEnabled() { return enabled; }
+		bool hasModelData() { return modelUniforms != nullptr; }
 		void setCurrentWeights(std::vector<float> weights);
 		pr::Skin::Ptr getSkin();
 		AABB getBoundingBox();
+		AABB getWorldBoundingBox();
+		glm::mat4 getLocalToWorld();
 		pr::Mesh::Ptr getMesh();
 		uint32 getNumPrimitives();
 		uint32 getNumVariants();
@@ -55,6 +61,8 @@ namespace pr
 		int getDiffuseMode();
 		int getLMIndex();
 		int getRPIndex();
+		uint32 getUniformOffset();
+		void setShadowCascades(int mask);
 		std::string getReflName();
 
 		struct UniformData
@@ -69,7 +77,9 @@ namespace pr
 			glm::vec4 lightMapST = glm::vec4(0);
 			glm::vec4 sh[9];
 			int reflectionProbeIndex = 0;
-			int paddint[3];
+			int instanceOffset = -1; // first matrix in the instance buffer, -1 if not instanced
+			int shadowCascades = 0xF; // one bit per shadow cascade the renderable is drawn into
+			int padding;
 		};
 
 
@@ -83,11 +93,15 @@ namespace pr
 		pr::Mesh::Ptr mesh = nullptr;
 		pr::Skin::Ptr skin = nullptr;
 		GPU::DescriptorSet::Ptr descriptorSet;
-		GPU::Buffer::Ptr modelUBO = nullptr;
+		GPU::UniformAllocator::Ptr modelUniforms = nullptr;
+		uint32 modelOffset = 0;
 		std::vector<float> morphWeights;
+		AABB worldBoundingBox;
+		glm::mat4 localToWorld = glm::mat4(1);
 		bool enabled = true;
 		bool castShadow = true;
 		bool receiveShadow = true;
+		int shadowCascades = 0xF;
 
 		int diffuseMode = 0; // 0 - lightprobe(cubemap), 1 - lightprobe(SH), 2 - lightmap
 		int lightMapIndex = -1;
@@ -1,8 +1,11 @@
 #include "Scene.h"
 
 #include <Core/Animator.h>
+#include <Core/Jobs.h>
 #include <Core/Renderable.h>
+#include <Graphics/JointPalette.h>
 #include <Math/Intersection.h>
+#include <algorithm>
 #include <set>
 
 #include <glm/gtc/matrix_inverse.hpp>
@@ -19,9 +22,16 @@ namespace pr
 	{
 		std::cout << "destroyed scene " << name << std::endl;
 
-		for (auto root : rootNodes)
-			root->clearParent();
+		// the hierarchies can be shared with other scenes or the asset manager, only the ones
+		// referenced by nothing but this scene and their children are unlinked to free them
+		for (auto& root : rootNodes)
+			if (root.use_count() == 1 + root->numChildren())
+				root->clearParent();
 		rootNodes.clear();
+		rootSet.clear();
+		renderItems.clear();
+		opaqueQueue.clear();
+		transparentQueue.clear();
 	}
 
 	void Scene::destroy()
@@ -32,6 +42,8 @@ namespace pr
 	void Scene::addRoot(pr::Entity::Ptr root)
 	{
 		rootNodes.push_back(root);
+		rootSet.insert(root.get());
+		queuesValid = false;
 	}
 
 	void Scene::addLightDesc(GPU::DescriptorSet::Ptr lightDescSet)
@@ -63,21 +75,16 @@ namespace pr
 		this->shProbes = probes;
 	}
 
-	void Scene::initDescriptors(GPU::DescriptorPool::Ptr descriptorPool)
+	void Scene::initDescriptors(GPU::DescriptorPool::Ptr descriptorPool, GPU::UniformAllocator::Ptr modelUniforms, GPU::DescriptorSet::Ptr modelDescriptorSet)
 	{
-		for (auto root : rootNodes)
-		{
-			for (auto e : root->getChildrenWithComponent<Renderable>())
-			{
-				auto t = e->getComponent<Transform>();
-				auto r = e->getComponent<Renderable>();
-				r->setDescriptor(descriptorPool);
-				r->update(t->getTransform());
-
-				if (r->isSkinnedMesh())
-					r->getSkin()->setDescriptor(descriptorPool);
-			}
-		}
+		forEachComponent<Renderable>([&](Entity* e, Renderable::Ptr& r) {
+			auto t = e->getComponent<Transform>();
+			r->setDescriptor(descriptorPool, modelUniforms, modelDescriptorSet);
+			r->update(t->getTransform());
+
+			if (r->isSkinnedMesh())
+				r->getSkin()->setDescriptor(descriptorPool);
+		});
 	}
 
 	void Scene::initLightProbes(ReflectionProbes& rp, std::vector<pr::TextureCubeMap::Ptr>& lightProbes)
@@ -403,40 +410,68 @@ namespace pr
 
 	void Scene::update(float dt)
 	{
-		for (auto root : rootNodes)
-		{
-			auto a = root->getComponent<Animator>();
-			if (a)
-				a->update(dt);
-
-			root->update(glm::mat4(1.0f));
+		auto& jobs = JobSystem::getInstance();
 
+		// animators only change the nodes of their own hierarchy
+		jobs.parallelFor(static_cast<uint32>(rootNodes.size()), 1, [this, dt](uint32 i) {
+			auto a = rootNodes[i]->getComponent<Animator>();
 			if (a)
-			{
-				for (auto e : root->getChildrenWithComponent<Renderable>())
-				{
-					auto r = e->getComponent<Renderable>();
-					if (r->hasMorphtargets())
-					{
-						r->setCurrentWeights(a->getWeights());
-					}
+				a->update(dt);
+		});
 
-					if (r->isSkinnedMesh())
-					{
-						auto nodes = a->getNodes();
-						auto skin = r->getSkin();
-						skin->computeJoints(nodes);
-					}
-				}
-			}
+		// once the roots are updated the subtrees of their children are independent
+		subtrees.clear();
+		for (auto root : rootNodes)
+		{
+			auto t = root->getComponent<Transform>();
+			if (!t->isDirty() && !t->hasDirtyChildren())
+				continue;
 
-			for (auto e : root->getChildrenWithComponent<Renderable>())
-			{
-				auto t = e->getComponent<Transform>();
-				auto r = e->getComponent<Renderable>();
-				r->update(t->getTransform());
-			}
+			changeVersion++;
+			bool changed = t->update(glm::mat4(1.0f), false);
+			for (int i = 0; i < root->numChildren(); i++)
+				subtrees.push_back({ root->getChild(i).get(), t.get(), changed });
 		}
+		jobs.parallelFor(static_cast<uint32>(subtrees.size()), 1, [this](uint32 i) {
+			auto& subtree = subtrees[i];
+			subtree.entity->update(subtree.parent->getTransform(), subtree.parentChanged);
+		});
+
+		// skins can be shared by several renderables, each one is only computed once
+		updateItems.clear();
+		skinItems.clear();
+		forEachComponent<Renderable>([this](Entity* e, Renderable::Ptr& r) {
+			auto a = e->getRoot()->getComponent<Animator>();
+			updateItems.push_back({ e, r.get(), a.get() });
+			if (a && r->isSkinnedMesh())
+				skinItems.push_back({ r->getSkin().get(), a.get() });
+		});
+		std::sort(skinItems.begin(), skinItems.end(), [](const SkinItem& s0, const SkinItem& s1) {
+			return s0.skin < s1.skin;
+		});
+		skinItems.erase(std::unique(skinItems.begin(), skinItems.end(), [](const SkinItem& s0, const SkinItem& s1) {
+			return s0.skin == s1.skin;
+		}), skinItems.end());
+
+		jobs.parallelFor(static_cast<uint32>(skinItems.size()), 1, [this](uint32 i) {
+			auto nodes = skinItems[i].animator->getNodes();
+			skinItems[i].skin->computeJoints(nodes);
+		});
+
+		jobs.parallelFor(static_cast<uint32>(updateItems.size()), 64, [this](uint32 i) {
+			auto& item = updateItems[i];
+			if (item.animator && item.renderable->hasMorphtargets())
+				item.renderable->setCurrentWeights(item.animator->getWeights());
+
+			auto t = item.entity->getComponent<Transform>();
+			item.renderable->update(t->getTransform());
+		});
+
+		// the GPU buffers are only written from this thread
+		for (auto& item : skinItems)
+			item.skin->uploadJoints();
+		if (!skinItems.empty() && JointPalette::isSupported())
+			JointPalette::getInstance().upload();
 	}
 
 	void Scene::switchVariant(int index)
@@ -470,23 +505,16 @@ namespace pr
 	AABB Scene::getBoundingBox()
 	{
 		AABB sceneBox;
+		forEachComponent<Renderable>([&sceneBox](Entity* e, Renderable::Ptr& r) {
+			auto t = e->getComponent<Transform>();
 
-		//auto rootNodes = scene->getRootNodes();
-		for (auto root : rootNodes)
-		{
-			for (auto e : root->getChildrenWithComponent<Renderable>())
-			{
-				auto t = e->getComponent<Transform>();
-				auto r = e->getComponent<Renderable>();
-
-				AABB bbox = r->getBoundingBox();
-				glm::mat4 M = t->getTransform();
-				glm::vec3 minPoint = glm::vec3(M * glm::vec4(bbox.getMinPoint(), 1.0f));
-				glm::vec3 maxPoint = glm::vec3(M * glm::vec4(bbox.getMaxPoint(), 1.0f));
-				sceneBox.expand(minPoint);
-				sceneBox.expand(maxPoint);
-			}
-		}
+			AABB bbox = r->getBoundingBox();
+			glm::mat4 M = t->getTransform();
+			glm::vec3 minPoint = glm::vec3(M * glm::vec4(bbox.getMinPoint(), 1.0f));
+			glm::vec3 maxPoint = glm::vec3(M * glm::vec4(bbox.getMaxPoint(), 1.0f));
+			sceneBox.expand(minPoint);
+			sceneBox.expand(maxPoint);
+		});
 
 		return sceneBox;
 	}
@@ -571,100 +599,129 @@ namespace pr
 		return entities;
 	}
 
-	std::vector<std::pair<std::string, std::vector<Entity::Ptr>>> Scene::getOpaqueEntities()
+	void Scene::updateRenderQueues()
 	{
-		std::map<int, std::map<std::string, std::vector<Entity::Ptr>>> mapping;
-		for (auto entity : rootNodes)
-		{
-			std::string name = entity->getName();
-			auto models = entity->getChildrenWithComponent<Renderable>(true);
-			for (auto m : models)
-			{
-				auto r = m->getComponent<Renderable>();
-				if (r->isEnabled() && r->getType() == RenderType::Opaque)
-				{
-					unsigned int p = r->getPriority();
-					if (mapping.find(p) == mapping.end())
-						mapping.insert(std::make_pair(p, std::map<std::string, std::vector<Entity::Ptr>>()));
+		// the root counters only increase, so their sum changes whenever one of them does
+		uint32 rootVersions = 0;
+		for (auto root : rootNodes)
+			rootVersions += root->getStructureVersion();
+		uint32 renderState = RenderQueueVersion::state;
 
-					auto mesh = r->getMesh();
-					auto subMeshes = mesh->getSubMeshes();
-					std::set<std::string> usedShader;
-					for (auto s : subMeshes)
-					{
-						auto mat = s.material;
-						if (mat) // TODO: add pink debug material when it is missing
-						{
-							std::string shaderName = mat->getShaderName();
-							if (usedShader.find(shaderName) != usedShader.end())
-								continue;
+		bool structureChanged = structureVersion != rootVersions;
+		bool stateChanged = stateVersion != renderState;
+		if (queuesValid && !structureChanged && !stateChanged)
+			return;
 
-							auto& shaderMapping = mapping[p];
-							if (shaderMapping.find(shaderName) == shaderMapping.end())
-								shaderMapping.insert(std::make_pair(shaderName, std::vector<Entity::Ptr>()));
-							shaderMapping[shaderName].push_back(m);
-							usedShader.insert(shaderName);
-						}
-					}
-				}
+		// the flat item list only depends on the hierarchy, state changes just re-sort the batches
+		if (!queuesValid || structureChanged)
+		{
+			renderItems.clear();
+			for (auto root : rootNodes)
+			{
+				auto models = root->getChildrenWithComponent<Renderable>(true);
+				for (auto m : models)
+					renderItems.push_back({ m, m->getComponent<Renderable>() });
 			}
 		}
 
-		std::vector<std::pair<std::string, std::vector<Entity::Ptr>>> renderQueue;
-		for (auto [_, shaderMapping] : mapping)
-			for (auto [name, models] : shaderMapping)
-				renderQueue.push_back(std::make_pair(name, models));
+		buildRenderQueue(RenderType::Opaque, opaqueQueue);
+		buildRenderQueue(RenderType::Transparent, transparentQueue);
 
-		return renderQueue;
+		structureVersion = rootVersions;
+		stateVersion = renderState;
+		queuesValid = true;
+		queueVersion++;
+		changeVersion++;
 	}
 
-	std::vector<std::pair<std::string, std::vector<Entity::Ptr>>> Scene::getTransparentEntities()
+	void Scene::buildRenderQueue(RenderType type, std::vector<RenderBatch>& queue)
 	{
-		std::map<int, std::map<std::string, std::vector<Entity::Ptr>>> mapping;
-		for (auto entity : rootNodes)
+		struct QueueEntry
 		{
-			auto models = entity->getChildrenWithComponent<Renderable>(true);
-			for (auto m : models)
+			uint32 priority;
+			uint32 pipelineID;
+			uint32 materialID;
+			uint32 itemIndex;
+			Material* material;
+		};
+
+		std::vector<QueueEntry> entries;
+		std::vector<uint32> usedPipelines;
+		for (uint32 i = 0; i < renderItems.size(); i++)
+		{
+			auto r = renderItems[i].renderable;
+			if (!r->isEnabled() || r->getType() != type)
+				continue;
+
+			// each entity is added once for every pipeline used by its submeshes
+			usedPipelines.clear();
+			auto& subMeshes = r->getMesh()->getSubMeshes();
+			for (auto& s : subMeshes)
 			{
-				auto r = m->getComponent<Renderable>();
-				if (r->isEnabled() && r->getType() == RenderType::Transparent)
-				{
-					unsigned int p = r->getPriority();
-					if (mapping.find(p) == mapping.end())
-						mapping.insert(std::make_pair(p, std::map<std::string, std::vector<Entity::Ptr>>()));
+				auto mat = s.material;
+				if (!mat) // TODO: add pink debug material when it is missing
+					continue;
 
-					auto mesh = r->getMesh();
-					auto subMeshes = mesh->getSubMeshes();
-					std::set<std::string> usedShader;
-					for (auto s : subMeshes)
-					{
-						auto mat = s.material;
-						std::string shaderName = mat->getShaderName();
-						if (usedShader.find(shaderName) != usedShader.end())
-							continue;
-
-						auto& shaderMapping = mapping[p];
-						if (shaderMapping.find(shaderName) == shaderMapping.end())
-							shaderMapping.insert(std::make_pair(shaderName, std::vector<Entity::Ptr>()));
-						shaderMapping[shaderName].push_back(m);
-						usedShader.insert(shaderName);
-					}
-				}
+				uint32 pipelineID = mat->getShaderID();
+				if (std::find(usedPipelines.begin(), usedPipelines.end(), pipelineID) != usedPipelines.end())
+					continue;
+				usedPipelines.push_back(pipelineID);
+
+				// opaque entities are grouped by material, transparent ones keep the scene order
+				uint32 materialID = (type == RenderType::Opaque) ? mat->getID() : 0;
+				entries.push_back({ r->getPriority(), pipelineID, materialID, i, mat.get() });
 			}
 		}
 
-		std::vector<std::pair<std::string, std::vector<Entity::Ptr>>> renderQueue;
-		for (auto [_, shaderMapping] : mapping)
+		std::stable_sort(entries.begin(), entries.end(), [](const QueueEntry& a, const QueueEntry& b) {
+			if (a.priority != b.priority)
+				return a.priority < b.priority;
+			if (a.pipelineID != b.pipelineID)
+				return a.pipelineID < b.pipelineID;
+			return a.materialID < b.materialID;
+		});
+
+		queue.clear();
+		for (auto& entry : entries)
 		{
-			for (auto it = shaderMapping.rbegin(); it != shaderMapping.rend(); ++it)
-			{
-				auto name = it->first;
-				auto models = it->second;
-				renderQueue.push_back(std::make_pair(name, models));
-			}
+			if (queue.empty() || queue.back().priority != entry.priority || queue.back().pipelineID != entry.pipelineID)
+				queue.push_back({ entry.priority, entry.pipelineID, entry.material->getShaderName(), {} });
+			queue.back().entities.push_back(renderItems[entry.itemIndex].entity);
 		}
 
-		return renderQueue;
+		// within a priority level opaque batches are drawn in ascending and transparent ones
+		// in descending shader name order
+		bool ascending = (type == RenderType::Opaque);
+		std::stable_sort(queue.begin(), queue.end(), [ascending](const RenderBatch& a, const RenderBatch& b) {
+			if (a.priority != b.priority)
+				return a.priority < b.priority;
+			return ascending ? a.shaderName < b.shaderName : b.shaderName < a.shaderName;
+		});
+	}
+
+	const std::vector<RenderBatch>& Scene::getOpaqueEntities()
+	{
+		updateRenderQueues();
+		return opaqueQueue;
+	}
+
+	const std::vector<RenderBatch>& Scene::getTransparentEntities()
+	{
+		updateRenderQueues();
+		return transparentQueue;
+	}
+
+	uint32 Scene::getQueueVersion()
+	{
+		updateRenderQueues();
+		return queueVersion;
+	}
+
+	uint32 Scene::getChangeVersion()
+	{
+		// changes of the render queues are only picked up when the queues are requested
+		updateRenderQueues();
+		return changeVersion;
 	}
 
 	std::vector<pr::Entity::Ptr> Scene::getRootNodes()
@@ -5,12 +5,18 @@
 
 #include <Core/Entity.h>
 #include <Core/LightProbe.h>
+#include <Core/Renderable.h>
 #include <Graphics/Texture.h>
 #include <GPU/DescriptorPool.h>
+#include <GPU/UniformAllocator.h>
 #include <LightData.h>
 
+#include <unordered_set>
+
 namespace pr
 {
+	class Animator;
+
 	struct ReflectionProbe
 	{
 		glm::vec4 position;
@@ -34,6 +40,15 @@ namespace pr
 		std::vector<glm::vec3> positions;
 	};
 
+	// all entities of one priority level that are drawn with the same pipeline
+	struct RenderBatch
+	{
+		uint32 priority;
+		uint32 pipelineID;
+		std::string shaderName;
+		std::vector<Entity::Ptr> entities;
+	};
+
 	class Scene
 	{
 	public:
@@ -47,7 +62,7 @@ namespace pr
 		void setLightMaps(pr::Texture2DArray::Ptr lightMaps);
 		void setDirMaps(pr::Texture2DArray::Ptr dirMaps);
 		void setSHProbes(pr::SHLightProbes& probes);
-		void initDescriptors(GPU::DescriptorPool::Ptr descriptorPool);
+		void initDescriptors(GPU::DescriptorPool::Ptr descriptorPool, GPU::UniformAllocator::Ptr modelUniforms, GPU::DescriptorSet::Ptr modelDescriptorSet);
 		void initLightProbes(ReflectionProbes& rp, std::vector<pr::TextureCubeMap::Ptr>& lightProbes);
 		void computeSHLightprobes();
 		void computeProbeMapping();
@@ -66,8 +81,10 @@ namespace pr
 		}
 		AABB getBoundingBox();
 		std::vector<Entity::Ptr> selectModelsRaycast(glm::vec3 start, glm::vec3 end);
-		std::vector<std::pair<std::string, std::vector<Entity::Ptr>>> getOpaqueEntities();
-		std::vector<std::pair<std::string, std::vector<Entity::Ptr>>> getTransparentEntities();
+		const std::vector<RenderBatch>& getOpaqueEntities();
+		const std::vector<RenderBatch>& getTransparentEntities();
+		uint32 getQueueVersion();
+		uint32 getChangeVersion();
 		std::vector<pr::Entity::Ptr> getRootNodes();
 		pr::TextureCubeMap::Ptr getSkybox();
 		std::string getName() { return name; }
@@ -76,6 +93,23 @@ namespace pr
 			return selectedModel;
 		}
 
+		// calls func(entity, component) for all entities of this scene with a component T. This is a
+		// linear scan over the component pool, the order is not the hierarchy order but the same for
+		// every call as long as no components are added or removed. The pool stays locked during the
+		// scan, so func must neither add or remove components nor look up components of type T.
+		template<typename T, typename Func>
+		void forEachComponent(Func func)
+		{
+			auto& pool = ComponentPool<T>::get();
+			auto lock = pool.lockShared();
+			for (uint32 i = 0; i < pool.size(); i++)
+			{
+				Entity* entity = pool.getEntity(i);
+				if (rootSet.find(entity->getRoot()) != rootSet.end())
+					func(entity, pool.getComponent(i));
+			}
+		}
+
 		typedef std::shared_ptr<Scene> Ptr;
 		static Ptr create(const std::string& name)
 		{
@@ -86,10 +120,55 @@ namespace pr
 		Scene(const Scene&) = delete;
 		Scene& operator=(const Scene&) = delete;
 
+		struct RenderItem
+		{
+			Entity::Ptr entity;
+			Renderable::Ptr renderable;
+		};
+
+		// work lists of the parallel update, kept between frames to reuse their memory
+		struct Subtree
+		{
+			Entity* entity;
+			Transform* parent;
+			bool parentChanged;
+		};
+
+		struct UpdateItem
+		{
+			Entity* entity;
+			Renderable* renderable;
+			Animator* animator;
+		};
+
+		struct SkinItem
+		{
+			Skin* skin;
+			Animator* animator;
+		};
+
+		void updateRenderQueues();
+		void buildRenderQueue(RenderType type, std::vector<RenderBatch>& queue);
+
 		std::string name;
 		std::vector<pr::Entity::Ptr> rootNodes;
+		std::unordered_set<Entity*> rootSet; // for the scene lookups of the component pool scans
 		Entity::Ptr selectedModel;
 
+		// render queues persist between frames and are only rebuilt when the hierarchy or the render state changed
+		std::vector<RenderItem> renderItems;
+		std::vector<RenderBatch> opaqueQueue;
+		std::vector<RenderBatch> transparentQueue;
+		uint32 structureVersion = 0;
+		uint32 stateVersion = 0;
+		bool queuesValid = false;
+		uint32 queueVersion = 0; // incremented when the render queues are rebuilt
+		uint32 changeVersion = 0; // incremented when the render queues are rebuilt or transforms changed
+
+		std::vector<Subtree> subtrees;
+		std::vector<UpdateItem> updateItems;
+		std::vector<SkinItem> skinItems;
+
 		// IBL
 		pr::TextureCubeMap::Ptr skybox;
 
@@ -56,16 +56,44 @@ namespace pr
 		glm::mat4 R = glm::mat4_cast(localRotation);
 		glm::mat4 S = glm::scale(glm::mat4(1.0f), localScale);
 		localTransform = T * R * S;
+		markDirty();
 	}
 
-	void Transform::update(glm::mat4 parentTransform)
+	void Transform::markDirty()
 	{
-		transform = parentTransform * localTransform;
-		normalTransform = glm::inverseTranspose(glm::mat3(transform));
+		dirty = true;
 
+		// flag the path to the root, so the update only has to descend into changed subtrees
+		for (Transform* p = parent; p != nullptr && !p->childrenDirty; p = p->parent)
+			p->childrenDirty = true;
+	}
+
+	void Transform::decompose()
+	{
 		glm::vec3 skew;
 		glm::vec4 persp;
 		glm::decompose(transform, scale, rotation, position, skew, persp);
+		decomposed = true;
+	}
+
+	void Transform::setParent(Transform* parent)
+	{
+		this->parent = parent;
+		markDirty();
+	}
+
+	bool Transform::update(const glm::mat4& parentTransform, bool parentChanged)
+	{
+		bool changed = dirty || parentChanged;
+		if (changed)
+		{
+			transform = parentTransform * localTransform;
+			normalDirty = true;
+			decomposed = false;
+		}
+		dirty = false;
+		childrenDirty = false;
+		return changed;
 	}
 
 	void Transform::translate(glm::vec3 t)
@@ -92,6 +120,11 @@ namespace pr
 
 	glm::mat3 Transform::getNormalMatrix()
 	{
+		if (normalDirty)
+		{
+			normalTransform = glm::inverseTranspose(glm::mat3(transform));
+			normalDirty = false;
+		}
 		return normalTransform;
 	}
 
@@ -117,16 +150,22 @@ namespace pr
 
 	glm::vec3 Transform::getPosition()
 	{
+		if (!decomposed)
+			decompose();
 		return position;
 	}
 
 	glm::quat Transform::getRotation()
 	{
+		if (!decomposed)
+			decompose();
 		return rotation;
 	}
 
 	glm::vec3 Transform::getScale()
 	{
+		if (!decomposed)
+			decompose();
 		return scale;
 	}
 
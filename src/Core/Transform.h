@@ -41,8 +41,19 @@ namespace pr
 		glm::mat4 transform;
 		glm::mat3 normalTransform;
 
+		// the world transform is only recomputed for dirty nodes and their subtrees,
+		// world position/rotation/scale and the normal matrix are derived on demand
+		Transform* parent = nullptr;
+		bool dirty = true;
+		bool childrenDirty = false;
+		bool decomposed = true;
+		bool normalDirty = false;
+
 		AABB boundingBox;
 
+		void markDirty();
+		void decompose();
+
 	public:
 		Transform();
 		~Transform();
@@ -51,7 +62,10 @@ namespace pr
 		void setLocalScale(glm::vec3 s);
 		void setLocalTransform(glm::mat4 M);
 		void updateLocalTransform();
-		void update(glm::mat4 parentTransform);
+		void setParent(Transform* parent);
+		bool update(const glm::mat4& parentTransform, bool parentChanged);
+		bool isDirty() { return dirty; }
+		bool hasDirtyChildren() { return childrenDirty; }
 		void translate(glm::vec3 t);
 		void rotate(float angle, glm::vec3 axis);
 		void setBounds(AABB& aabb);
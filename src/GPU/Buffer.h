@@ -24,6 +24,7 @@ namespace GPU
 		virtual ~Buffer() = 0 {}
 		virtual void uploadMapped(void* data) = 0;
 		virtual void uploadStaged(void* data) = 0;
+		virtual void uploadStaged(void* data, uint32 offset, uint32 byteCount) = 0;
 		virtual Descriptor::Ptr getDescriptor() = 0;
 		virtual uint8* getMappedPointer() = 0;
 		uint32 getSize()
@@ -35,13 +35,16 @@ namespace GPU
 		virtual void bindPipeline(ComputePipeline::Ptr pipeline) = 0;
 		virtual void pushConstants(GraphicsPipeline::Ptr pipeline, ShaderStage stage, uint32 offset, uint32 size, const void* values) = 0;
 		virtual void bindDescriptorSets(GraphicsPipeline::Ptr pipeline, DescriptorSet::Ptr descriptorSet, uint32 firstSet) = 0;
+		virtual void bindDescriptorSets(GraphicsPipeline::Ptr pipeline, DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset) = 0;
 		virtual void bindDescriptorSets(ComputePipeline::Ptr pipeline, DescriptorSet::Ptr descriptorSet, uint32 firstSet) = 0;
 		virtual void bindVertexBuffers(Buffer::Ptr vertexBuffer) = 0;
+		virtual void bindVertexBuffers(uint32 binding, Buffer::Ptr vertexBuffer) = 0;
 		virtual void bindIndexBuffers(Buffer::Ptr indexBuffer, IndexType indexType) = 0;
 		virtual void setCullMode(int mode) = 0;
-		virtual void drawIndexed(uint32 indexCount, GPU::Topology topology) = 0;
+		virtual void drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex) = 0;
 		virtual void drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset) = 0;
-		virtual void drawArrays(uint32 vertexCount) = 0;
+		virtual void drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex) = 0;
+		virtual void drawArrays(uint32 vertexCount, uint32 firstVertex) = 0;
 		virtual void dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ) = 0;
 		virtual void pipelineBarrier() = 0;
 		virtual void flush() = 0;
@@ -10,6 +10,7 @@
 #include "ImageView.h"
 #include "Sampler.h"
 #include "Swapchain.h"
+#include "UniformAllocator.h"
 
 #include <Platform/Window.h>
 
@@ -30,6 +31,7 @@ namespace GPU
 		virtual ImageDescriptor::Ptr createImageDescriptor(Image::Ptr image, ImageView::Ptr view, Sampler::Ptr sampler) = 0;
 		virtual Sampler::Ptr createSampler(uint32 levels) = 0;
 		virtual Swapchain::Ptr createSwapchain(Window::Ptr window) = 0;
+		virtual UniformAllocator::Ptr createUniformAllocator(uint32 blockSize, uint32 maxBlocks) = 0;
 		virtual void submitCommandBuffer(GPU::CommandBuffer::Ptr prevCmdBuf, GPU::CommandBuffer::Ptr nextCmdBuf) = 0;
 		virtual void submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf) = 0;
 		virtual void waitDeviceIdle() = 0;
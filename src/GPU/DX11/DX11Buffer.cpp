@@ -67,6 +67,20 @@ namespace DX11
 		deviceContext->Unmap(buffer.Get(), 0);
 	}
 
+	void Buffer::uploadStaged(void* data, uint32 offset, uint32 byteCount)
+	{
+		// the buffers are dynamic, so a range is only written without discarding the rest
+		D3D11_MAPPED_SUBRESOURCE mappedResource;
+		HRESULT result = deviceContext->Map(buffer.Get(), 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedResource);
+		if (FAILED(result))
+		{
+			std::cout << "error mapping DX11 buffer range!" << std::endl;
+			return;
+		}
+		std::memcpy(static_cast<uint8*>(mappedResource.pData) + offset, data, byteCount);
+		deviceContext->Unmap(buffer.Get(), 0);
+	}
+
 	GPU::Descriptor::Ptr Buffer::getDescriptor()
 	{
 		return BufferDescriptor::create(buffer);
@@ -16,6 +16,7 @@ namespace DX11
 		~Buffer();
 		void uploadMapped(void* data);
 		void uploadStaged(void* data);
+		void uploadStaged(void* data, uint32 offset, uint32 byteCount);
 		GPU::Descriptor::Ptr getDescriptor();
 		uint8* getMappedPointer();
 		ComPtr<ID3D11Buffer> getBuffer()
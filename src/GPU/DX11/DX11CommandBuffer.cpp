@@ -238,27 +238,29 @@ namespace DX11
 	class CmdBindDescriptorSets : public Command
 	{
 	public:
-		CmdBindDescriptorSets(DX11::DescriptorSet::Ptr descriptorSet, std::vector<int> bindings) :
+		CmdBindDescriptorSets(DX11::DescriptorSet::Ptr descriptorSet, std::vector<int> bindings, uint32 dynamicOffset) :
 			descriptorSet(descriptorSet),
-			bindings(bindings)
+			bindings(bindings),
+			dynamicOffset(dynamicOffset)
 		{
 		}
 
 		void execute()
 		{
 			//auto bindings = pipeline->getLayoutBindings(descriptorSet->getLayoutName());
-			descriptorSet->bind(deviceContext, bindings);
+			descriptorSet->bind(deviceContext, bindings, dynamicOffset);
 		}
 
 		typedef std::shared_ptr<CmdBindDescriptorSets> Ptr;
-		static Ptr create(DX11::DescriptorSet::Ptr descriptorSet, std::vector<int> bindings)
+		static Ptr create(DX11::DescriptorSet::Ptr descriptorSet, std::vector<int> bindings, uint32 dynamicOffset = 0)
 		{
-			return std::make_shared<CmdBindDescriptorSets>(descriptorSet, bindings);
+			return std::make_shared<CmdBindDescriptorSets>(descriptorSet, bindings, dynamicOffset);
 		}
 
 	private:
 		DX11::DescriptorSet::Ptr descriptorSet;
 		std::vector<int> bindings;
+		uint32 dynamicOffset;
 
 		CmdBindDescriptorSets(const CmdBindDescriptorSets&) = delete;
 		CmdBindDescriptorSets& operator=(const CmdBindDescriptorSets&) = delete;
@@ -267,7 +269,8 @@ namespace DX11
 	class CmdBindVertexBuffers : public Command
 	{
 	public:
-		CmdBindVertexBuffers(DX11::Buffer::Ptr buffer) :
+		CmdBindVertexBuffers(uint32 slot, DX11::Buffer::Ptr buffer) :
+			slot(slot),
 			buffer(buffer)
 		{
 		}
@@ -277,16 +280,17 @@ namespace DX11
 			auto dx11Buffer = buffer->getBuffer();
 			uint32 offset = 0;
 			uint32 stride = buffer->getStride();
-			deviceContext->IASetVertexBuffers(0, 1, dx11Buffer.GetAddressOf(), &stride, &offset);
+			deviceContext->IASetVertexBuffers(slot, 1, dx11Buffer.GetAddressOf(), &stride, &offset);
 		}
 
 		typedef std::shared_ptr<CmdBindVertexBuffers> Ptr;
-		static Ptr create(DX11::Buffer::Ptr buffer)
+		static Ptr create(uint32 slot, DX11::Buffer::Ptr buffer)
 		{
-			return std::make_shared<CmdBindVertexBuffers>(buffer);
+			return std::make_shared<CmdBindVertexBuffers>(slot, buffer);
 		}
 
 	private:
+		uint32 slot;
 		DX11::Buffer::Ptr buffer;
 
 		CmdBindVertexBuffers(const CmdBindVertexBuffers&) = delete;
@@ -352,32 +356,71 @@ namespace DX11
 	class CmdDrawIndexed : public Command
 	{
 	public:
-		CmdDrawIndexed(uint32 indexCount, GPU::Topology topology) :
+		CmdDrawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex) :
 			indexCount(indexCount),
-			topology(topology)
+			topology(topology),
+			firstIndex(firstIndex),
+			baseVertex(baseVertex)
 		{
 		}
 
 		void execute()
 		{
 			deviceContext->IASetPrimitiveTopology(getTopology(topology)); // TODO: put in pipeline
-			deviceContext->DrawIndexed(indexCount, 0, 0);
+			deviceContext->DrawIndexed(indexCount, firstIndex, baseVertex);
 		}
 
 		typedef std::shared_ptr<CmdDrawIndexed> Ptr;
-		static Ptr create(uint32 indexCount, GPU::Topology topology)
+		static Ptr create(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
 		{
-			return std::make_shared<CmdDrawIndexed>(indexCount, topology);
+			return std::make_shared<CmdDrawIndexed>(indexCount, topology, firstIndex, baseVertex);
 		}
 
 	private:
 		uint32 indexCount;
 		GPU::Topology topology;
+		uint32 firstIndex;
+		int32 baseVertex;
 
 		CmdDrawIndexed(const CmdDrawIndexed&) = delete;
 		CmdDrawIndexed& operator=(const CmdDrawIndexed&) = delete;
 	};
 
+	class CmdDrawIndexedInstanced : public Command
+	{
+	public:
+		CmdDrawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex) :
+			indexCount(indexCount),
+			instanceCount(instanceCount),
+			topology(topology),
+			firstIndex(firstIndex),
+			baseVertex(baseVertex)
+		{
+		}
+
+		void execute()
+		{
+			deviceContext->IASetPrimitiveTopology(getTopology(topology)); // TODO: put in pipeline
+			deviceContext->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, baseVertex, 0);
+		}
+
+		typedef std::shared_ptr<CmdDrawIndexedInstanced> Ptr;
+		static Ptr create(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
+		{
+			return std::make_shared<CmdDrawIndexedInstanced>(indexCount, instanceCount, topology, firstIndex, baseVertex);
+		}
+
+	private:
+		uint32 indexCount;
+		uint32 instanceCount;
+		GPU::Topology topology;
+		uint32 firstIndex;
+		int32 baseVertex;
+
+		CmdDrawIndexedInstanced(const CmdDrawIndexedInstanced&) = delete;
+		CmdDrawIndexedInstanced& operator=(const CmdDrawIndexedInstanced&) = delete;
+	};
+
 	class CmdDrawIndexedBaseVertex : public Command
 	{
 	public:
@@ -473,6 +516,47 @@ namespace DX11
 		CmdDispatchCompute& operator=(const CmdDispatchCompute&) = delete;
 	};
 
+	class CmdCopySubresource : public Command
+	{
+	public:
+		CmdCopySubresource(ComPtr<ID3D11Resource> src, uint32 srcSubresource, ComPtr<ID3D11Resource> dst, uint32 dstSubresource, const D3D11_BOX* srcBox, uint32 dstX, uint32 dstY) :
+			src(src),
+			srcSubresource(srcSubresource),
+			dst(dst),
+			dstSubresource(dstSubresource),
+			hasBox(srcBox != NULL),
+			dstX(dstX),
+			dstY(dstY)
+		{
+			if (srcBox)
+				box = *srcBox;
+		}
+
+		void execute()
+		{
+			deviceContext->CopySubresourceRegion(dst.Get(), dstSubresource, dstX, dstY, 0, src.Get(), srcSubresource, hasBox ? &box : NULL);
+		}
+
+		typedef std::shared_ptr<CmdCopySubresource> Ptr;
+		static Ptr create(ComPtr<ID3D11Resource> src, uint32 srcSubresource, ComPtr<ID3D11Resource> dst, uint32 dstSubresource, const D3D11_BOX* srcBox, uint32 dstX, uint32 dstY)
+		{
+			return std::make_shared<CmdCopySubresource>(src, srcSubresource, dst, dstSubresource, srcBox, dstX, dstY);
+		}
+
+	private:
+		ComPtr<ID3D11Resource> src;
+		uint32 srcSubresource;
+		ComPtr<ID3D11Resource> dst;
+		uint32 dstSubresource;
+		bool hasBox;
+		D3D11_BOX box;
+		uint32 dstX;
+		uint32 dstY;
+
+		CmdCopySubresource(const CmdCopySubresource&) = delete;
+		CmdCopySubresource& operator=(const CmdCopySubresource&) = delete;
+	};
+
 	CommandBuffer::CommandBuffer() :
 		deviceContext(Device::getInstance().getDeviceContext())
 	{
@@ -531,6 +615,9 @@ namespace DX11
 	void CommandBuffer::begin()
 	{
 		commands.clear();
+		for (uint32 i = 0; i < GPU::maxVertexBindings; i++)
+			boundVertexBuffers[i] = nullptr;
+		boundIndexBuffer = nullptr;
 	}
 
 	void CommandBuffer::end()
@@ -625,6 +712,15 @@ namespace DX11
 		commands.push_back(CmdBindDescriptorSets::create(dx11DescriptorSet, bindings));
 	}
 
+	void CommandBuffer::bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset)
+	{
+		auto dx11Pipeline = std::dynamic_pointer_cast<GraphicsPipeline>(pipeline);
+		auto dx11DescriptorSet = std::dynamic_pointer_cast<DescriptorSet>(descriptorSet);
+		auto bindings = dx11Pipeline->getLayoutBindings(dx11DescriptorSet->getLayoutName());
+
+		commands.push_back(CmdBindDescriptorSets::create(dx11DescriptorSet, bindings, dynamicOffset));
+	}
+
 	void CommandBuffer::bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet)
 	{
 		auto dx11Pipeline = std::dynamic_pointer_cast<ComputePipeline>(pipeline);
@@ -637,18 +733,33 @@ namespace DX11
 
 	void CommandBuffer::bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer)
 	{
+		bindVertexBuffers(0, vertexBuffer);
+	}
+
+	void CommandBuffer::bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer)
+	{
+		// primitives of the geometry pool share their buffers, so most binds are redundant
 		auto dx11VBO = std::dynamic_pointer_cast<Buffer>(vertexBuffer);
+		if (dx11VBO.get() == boundVertexBuffers[binding])
+			return;
+
+		boundVertexBuffers[binding] = dx11VBO.get();
 		//auto dx11Buffer = dx11VBO->getBuffer();
 		//uint32 offset = 0;
 		//uint32 stride = dx11VBO->getStride();
 		//deviceContext->IASetVertexBuffers(0, 1, dx11Buffer.GetAddressOf(), &stride, &offset);
 
-		commands.push_back(CmdBindVertexBuffers::create(dx11VBO));
+		commands.push_back(CmdBindVertexBuffers::create(binding, dx11VBO));
 	}
 
 	void CommandBuffer::bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType)
 	{
 		auto dx11IBO = std::dynamic_pointer_cast<Buffer>(indexBuffer);
+		if (dx11IBO.get() == boundIndexBuffer && indexType == boundIndexType)
+			return;
+
+		boundIndexBuffer = dx11IBO.get();
+		boundIndexType = indexType;
 		//auto dx11Buffer = dx11IBO->getBuffer();
 		//deviceContext->IASetIndexBuffer(dx11Buffer.Get(), getIndexType(indexType), 0);
 
@@ -663,12 +774,12 @@ namespace DX11
 		commands.push_back(CmdSetCullMode::create(rasterStates[mode]));
 	}
 
-	void CommandBuffer::drawIndexed(uint32 indexCount, GPU::Topology topology)
+	void CommandBuffer::drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
 	{
 		//deviceContext->IASetPrimitiveTopology(getTopology(topology)); // TODO: put in pipeline
 		//deviceContext->DrawIndexed(indexCount, 0, 0);
 
-		commands.push_back(CmdDrawIndexed::create(indexCount, topology));
+		commands.push_back(CmdDrawIndexed::create(indexCount, topology, firstIndex, baseVertex));
 	}
 
 	void CommandBuffer::drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset)
@@ -679,7 +790,12 @@ namespace DX11
 		commands.push_back(CmdDrawIndexedBaseVertex::create(indexCount, indexOffset, vertexOffset));
 	}
 
-	void CommandBuffer::drawArrays(uint32 vertexCount)
+	void CommandBuffer::drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
+	{
+		commands.push_back(CmdDrawIndexedInstanced::create(indexCount, instanceCount, topology, firstIndex, baseVertex));
+	}
+
+	void CommandBuffer::drawArrays(uint32 vertexCount, uint32 firstVertex)
 	{
 		// TODO: draw array buffers
 	}
@@ -703,6 +819,16 @@ namespace DX11
 	{
 	}
 
+	void CommandBuffer::copySubresource(ComPtr<ID3D11Resource> src, uint32 srcSubresource, ComPtr<ID3D11Resource> dst, uint32 dstSubresource)
+	{
+		commands.push_back(CmdCopySubresource::create(src, srcSubresource, dst, dstSubresource, NULL, 0, 0));
+	}
+
+	void CommandBuffer::copySubresourceRegion(ComPtr<ID3D11Resource> src, uint32 srcSubresource, const D3D11_BOX& srcBox, ComPtr<ID3D11Resource> dst, uint32 dstSubresource, uint32 dstX, uint32 dstY)
+	{
+		commands.push_back(CmdCopySubresource::create(src, srcSubresource, dst, dstSubresource, &srcBox, dstX, dstY));
+	}
+
 	void CommandBuffer::flush()
 	{
 		for (auto cmd : commands)
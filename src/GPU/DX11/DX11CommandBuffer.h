@@ -46,17 +46,23 @@ namespace DX11
 		void bindPipeline(GPU::ComputePipeline::Ptr pipeline);
 		void pushConstants(GPU::GraphicsPipeline::Ptr pipeline, GPU::ShaderStage stage, uint32 offset, uint32 size, const void* values);
 		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
+		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset);
 		void bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
 		void bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer);
+		void bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer);
 		void bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType);
 		void setCullMode(int mode);
-		void drawIndexed(uint32 indexCount, GPU::Topology topology);
+		void drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
 		void drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset);
-		void drawArrays(uint32 vertexCount);
+		void drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
+		void drawArrays(uint32 vertexCount, uint32 firstVertex);
 		void dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ);
 		void pipelineBarrier();
 		void flush();
 
+		void copySubresource(ComPtr<ID3D11Resource> src, uint32 srcSubresource, ComPtr<ID3D11Resource> dst, uint32 dstSubresource);
+		void copySubresourceRegion(ComPtr<ID3D11Resource> src, uint32 srcSubresource, const D3D11_BOX& srcBox, ComPtr<ID3D11Resource> dst, uint32 dstSubresource, uint32 dstX, uint32 dstY);
+
 		typedef std::shared_ptr<CommandBuffer> Ptr;
 		static Ptr create()
 		{
@@ -67,6 +73,9 @@ namespace DX11
 		ComPtr<ID3D11DeviceContext> deviceContext;
 		std::vector<ComPtr<ID3D11RasterizerState>> rasterStates;
 		std::vector<Command::Ptr> commands;
+		Buffer* boundVertexBuffers[GPU::maxVertexBindings] = {};
+		Buffer* boundIndexBuffer = nullptr;
+		GPU::IndexType boundIndexType = GPU::IndexType::uint32;
 
 		unsigned int id;
 		static unsigned int globalIDCount;
@@ -95,6 +95,11 @@ namespace DX11
 		return Swapchain::create(window);
 	}
 
+	GPU::UniformAllocator::Ptr Context::createUniformAllocator(uint32 blockSize, uint32 maxBlocks)
+	{
+		return UniformAllocator::create(blockSize, maxBlocks, 1, 16);
+	}
+
 	void Context::submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf)
 	{
 		nextCmdBuf->flush();
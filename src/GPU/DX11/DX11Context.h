@@ -12,6 +12,7 @@
 #include <GPU/DX11/DX11ImageView.h>
 #include <GPU/DX11/DX11Sampler.h>
 #include <GPU/DX11/DX11Swapchain.h>
+#include <GPU/DX11/DX11UniformAllocator.h>
 #include <GPU/DX11/DX11Device.h>
 #include <GPU/Enums.h>
 
@@ -44,6 +45,7 @@ namespace DX11
 		GPU::ImageDescriptor::Ptr createImageDescriptor(GPU::Image::Ptr image, GPU::ImageView::Ptr view, GPU::Sampler::Ptr sampler);
 		GPU::Sampler::Ptr createSampler(uint32 levels);
 		GPU::Swapchain::Ptr createSwapchain(Window::Ptr window);
+		GPU::UniformAllocator::Ptr createUniformAllocator(uint32 blockSize, uint32 maxBlocks);
 		void submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void submitCommandBuffer(GPU::CommandBuffer::Ptr prevCmdBuf, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void waitDeviceIdle() {}
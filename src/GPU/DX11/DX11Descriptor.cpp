@@ -12,6 +12,29 @@ namespace DX11
 		return buffer;
 	}
 
+	DynamicBufferDescriptor::DynamicBufferDescriptor(ComPtr<ID3D11Buffer> buffer, GPU::UniformAllocator* allocator) :
+		buffer(buffer),
+		allocator(allocator)
+	{
+
+	}
+
+	ComPtr<ID3D11Buffer> DynamicBufferDescriptor::getBuffer()
+	{
+		return buffer;
+	}
+
+	void DynamicBufferDescriptor::upload(ComPtr<ID3D11DeviceContext> deviceContext, uint32 dynamicOffset)
+	{
+		D3D11_MAPPED_SUBRESOURCE mappedResource;
+		HRESULT result = deviceContext->Map(buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+		if (SUCCEEDED(result))
+		{
+			std::memcpy(mappedResource.pData, allocator->getBlockData(dynamicOffset), allocator->getDataSize());
+			deviceContext->Unmap(buffer.Get(), 0);
+		}
+	}
+
 	ImageDescriptor::ImageDescriptor(ComPtr<ID3D11Resource> texture, ComPtr<ID3D11ShaderResourceView> view, ComPtr<ID3D11SamplerState> sampler) :
 		texture(texture),
 		srv(view),
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <GPU/Descriptor.h>
+#include <GPU/UniformAllocator.h>
 #include <GPU/DX11/DX11Platform.h>
 
 namespace DX11
@@ -24,6 +25,24 @@ namespace DX11
 		ComPtr<ID3D11Buffer> buffer;
 	};
 
+	class DynamicBufferDescriptor : public GPU::BufferDescriptor
+	{
+	public:
+		DynamicBufferDescriptor(ComPtr<ID3D11Buffer> buffer, GPU::UniformAllocator* allocator);
+		ComPtr<ID3D11Buffer> getBuffer();
+		void upload(ComPtr<ID3D11DeviceContext> deviceContext, uint32 dynamicOffset);
+
+		typedef std::shared_ptr<DynamicBufferDescriptor> Ptr;
+		static Ptr create(ComPtr<ID3D11Buffer> buffer, GPU::UniformAllocator* allocator)
+		{
+			return std::make_shared<DynamicBufferDescriptor>(buffer, allocator);
+		}
+
+	private:
+		ComPtr<ID3D11Buffer> buffer;
+		GPU::UniformAllocator* allocator;
+	};
+
 	class ImageDescriptor : public GPU::ImageDescriptor
 	{
 	public:
@@ -64,7 +64,7 @@ namespace DX11
 		descriptors.push_back(descriptor);
 	}
 
-	void DescriptorSet::bind(ComPtr<ID3D11DeviceContext> deviceContext, std::vector<int> bindings)
+	void DescriptorSet::bind(ComPtr<ID3D11DeviceContext> deviceContext, std::vector<int> bindings, uint32 dynamicOffset)
 	{
 		for (int i = 0; i < descriptors.size(); i++)
 		{
@@ -89,6 +89,19 @@ namespace DX11
 				if (layoutBinding.shaderStage & GPU::ShaderStage::Compute)
 					deviceContext->CSSetConstantBuffers(bindings[i], 1, buffer.GetAddressOf());
 			}
+			else if (std::dynamic_pointer_cast<DynamicBufferDescriptor>(desc))
+			{
+				auto dxDynamicDesc = std::dynamic_pointer_cast<DynamicBufferDescriptor>(desc);
+				dxDynamicDesc->upload(deviceContext, dynamicOffset);
+				auto buffer = dxDynamicDesc->getBuffer();
+
+				if (layoutBinding.shaderStage & GPU::ShaderStage::Vertex)
+					deviceContext->VSSetConstantBuffers(bindings[i], 1, buffer.GetAddressOf());
+				if (layoutBinding.shaderStage & GPU::ShaderStage::Geometry)
+					deviceContext->GSSetConstantBuffers(bindings[i], 1, buffer.GetAddressOf());
+				if (layoutBinding.shaderStage & GPU::ShaderStage::Fragment)
+					deviceContext->PSSetConstantBuffers(bindings[i], 1, buffer.GetAddressOf());
+			}
 
 			// TODO: wow this is a mess... DirectX has seperate functions for each shader stage to set resources
 			//		 we need a way to check if the current pipeline is compute or graphics to use the correct functions.
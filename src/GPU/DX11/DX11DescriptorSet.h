@@ -17,7 +17,7 @@ namespace DX11
 		void update();
 		void updateVariable();
 		void addDescriptor(GPU::Descriptor::Ptr descriptor);
-		void bind(ComPtr<ID3D11DeviceContext> deviceContext, std::vector<int> bindings);
+		void bind(ComPtr<ID3D11DeviceContext> deviceContext, std::vector<int> bindings, uint32 dynamicOffset = 0);
 		std::string getLayoutName();
 		void unbindShaderRes();
 
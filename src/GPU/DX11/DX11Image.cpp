@@ -1,4 +1,5 @@
 #include "DX11Image.h"
+#include "DX11CommandBuffer.h"
 #include "DX11Device.h"
 #include <iostream>
 
@@ -160,6 +161,31 @@ namespace DX11
 
 	}
 
+	void Image::copyLayers(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount)
+	{
+		auto dxCmdBuf = std::dynamic_pointer_cast<CommandBuffer>(cmdBuf);
+		auto dst = std::dynamic_pointer_cast<Image>(dstImage);
+		for (uint32 layer = baseLayer; layer < baseLayer + layerCount; layer++)
+			dxCmdBuf->copySubresource(texture, D3D11CalcSubresource(0, layer, levels), dst->getTexture(), D3D11CalcSubresource(0, layer, dst->levels));
+	}
+
+	void Image::copyRegions(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, const std::vector<GPU::ImageRegion>& regions)
+	{
+		auto dxCmdBuf = std::dynamic_pointer_cast<CommandBuffer>(cmdBuf);
+		auto dst = std::dynamic_pointer_cast<Image>(dstImage);
+		for (auto& r : regions)
+		{
+			D3D11_BOX box;
+			box.left = r.srcX;
+			box.top = r.srcY;
+			box.front = 0;
+			box.right = r.srcX + r.width;
+			box.bottom = r.srcY + r.height;
+			box.back = 1;
+			dxCmdBuf->copySubresourceRegion(texture, 0, box, dst->getTexture(), 0, r.dstX, r.dstY);
+		}
+	}
+
 	void Image::setImageLayout()
 	{
 
@@ -21,6 +21,10 @@ namespace DX11
 			case GPU::VertexAttribFormat::Vector3F: format = DXGI_FORMAT_R32G32B32_FLOAT; break;
 			case GPU::VertexAttribFormat::Vector4F: format = DXGI_FORMAT_R32G32B32A32_FLOAT; break;
 			case GPU::VertexAttribFormat::Vectur4UC: format = DXGI_FORMAT_R8G8B8A8_UNORM; break;
+			case GPU::VertexAttribFormat::Vector2H: format = DXGI_FORMAT_R16G16_FLOAT; break;
+			case GPU::VertexAttribFormat::Vector2SN16: format = DXGI_FORMAT_R16G16_SNORM; break;
+			case GPU::VertexAttribFormat::Vector4SN16: format = DXGI_FORMAT_R16G16B16A16_SNORM; break;
+			case GPU::VertexAttribFormat::Vector4UB: format = DXGI_FORMAT_R8G8B8A8_UINT; break;
 		}
 		return format;
 	}
@@ -100,14 +104,19 @@ namespace DX11
 		std::vector<D3D11_INPUT_ELEMENT_DESC> inputAttributes;
 		for (auto& vertexAttrib : inputDescription.inputAttributes)
 		{
+			bool perInstance = false;
+			for (auto& binding : inputDescription.inputBindings)
+				if (binding.binding == vertexAttrib.binding)
+					perInstance = binding.inputRate == GPU::VertexInputeRate::Instance;
+
 			D3D11_INPUT_ELEMENT_DESC inputDesc;
 			inputDesc.SemanticName = vertexAttrib.name.c_str();
 			inputDesc.SemanticIndex = vertexAttrib.index;
 			inputDesc.Format = getVertexFormat(vertexAttrib.format);
-			inputDesc.InputSlot = 0;
-			inputDesc.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-			inputDesc.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-			inputDesc.InstanceDataStepRate = 0;
+			inputDesc.InputSlot = vertexAttrib.binding;
+			inputDesc.InputSlotClass = perInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+			inputDesc.AlignedByteOffset = vertexAttrib.offset;
+			inputDesc.InstanceDataStepRate = perInstance ? 1 : 0;
 			inputAttributes.push_back(inputDesc);
 		}
 
@@ -129,7 +138,8 @@ namespace DX11
 			auto layoutBindings = glDescriptorPool->getLayout(layoutName);
 			for (auto dslb : layoutBindings)
 			{
-				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer)
+				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer ||
+					dslb.descriptorType == GPU::DescriptorType::UniformBufferDynamic)
 				{
 					setBindings.push_back(bufferDescriptorCount);
 					bufferDescriptorCount++;
@@ -371,7 +381,8 @@ namespace DX11
 			auto layoutBindings = glDescriptorPool->getLayout(layoutName);
 			for (auto dslb : layoutBindings)
 			{
-				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer)
+				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer ||
+					dslb.descriptorType == GPU::DescriptorType::UniformBufferDynamic)
 				{
 					setBindings.push_back(bufferDescriptorCount);
 					bufferDescriptorCount++;
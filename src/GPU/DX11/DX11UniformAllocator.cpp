@@ -0,0 +1,44 @@
+#include "DX11UniformAllocator.h"
+#include "DX11Device.h"
+#include <iostream>
+
+namespace DX11
+{
+	UniformAllocator::UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment) :
+		GPU::UniformAllocator(blockSize, maxBlocks, numFrames, alignment)
+	{
+		auto device = Device::getInstance().getDevice();
+
+		D3D11_BUFFER_DESC bufferDesc;
+		bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+		bufferDesc.ByteWidth = this->blockSize;
+		bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		bufferDesc.MiscFlags = 0;
+		bufferDesc.StructureByteStride = 0;
+
+		HRESULT result = device->CreateBuffer(&bufferDesc, NULL, &buffer);
+		if (FAILED(result))
+		{
+			std::cout << "error creating DX11 uniform buffer!" << std::endl;
+		}
+	}
+
+	UniformAllocator::~UniformAllocator()
+	{
+	}
+
+	GPU::Descriptor::Ptr UniformAllocator::getDescriptor()
+	{
+		return DynamicBufferDescriptor::create(buffer, this);
+	}
+
+	uint8* UniformAllocator::mapFrame(uint32 frame)
+	{
+		return nullptr;
+	}
+
+	void UniformAllocator::unmapFrame(uint32 frame, uint32 size)
+	{
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef INCLUDED_DX11UNIFORMALLOCATOR
+#define INCLUDED_DX11UNIFORMALLOCATOR
+
+#pragma once
+
+#include <GPU/UniformAllocator.h>
+#include <GPU/DX11/DX11Platform.h>
+#include <GPU/DX11/DX11Descriptor.h>
+
+namespace DX11
+{
+	// D3D11 has no persistently mapped buffers, the blocks stay in the CPU copy
+	// and are written into a single constant buffer when they are bound.
+	class UniformAllocator : public GPU::UniformAllocator
+	{
+	public:
+		UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment);
+		~UniformAllocator();
+		GPU::Descriptor::Ptr getDescriptor();
+
+		typedef std::shared_ptr<UniformAllocator> Ptr;
+		static Ptr create(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment)
+		{
+			return std::make_shared<UniformAllocator>(blockSize, maxBlocks, numFrames, alignment);
+		}
+
+	private:
+		uint8* mapFrame(uint32 frame);
+		void unmapFrame(uint32 frame, uint32 size);
+
+		ComPtr<ID3D11Buffer> buffer;
+
+		UniformAllocator(const UniformAllocator&) = delete;
+		UniformAllocator& operator=(const UniformAllocator&) = delete;
+	};
+}
+
+#endif // INCLUDED_DX11UNIFORMALLOCATOR
\ No newline at end of file
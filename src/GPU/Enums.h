@@ -37,14 +37,20 @@ namespace GPU
 		Vector2F,
 		Vector3F,
 		Vector4F,
-		Vectur4UC
+		Vectur4UC,
+		Vector2H,
+		Vector2SN16,
+		Vector4SN16,
+		Vector4UB
 	};
 
 	enum class DescriptorType
 	{
 		UniformBuffer,
+		UniformBufferDynamic,
 		CombinedImageSampler,
-		StorageImage
+		StorageImage,
+		StorageBuffer
 	};
 
 	enum class ShaderStage
@@ -31,6 +31,12 @@ namespace GL
 		//glBufferData(target, size, data, GL_STATIC_DRAW);
 	}
 
+	void Buffer::uploadStaged(void* data, uint32 offset, uint32 byteCount)
+	{
+		glBindBuffer(target, buffer);
+		glBufferSubData(target, offset, byteCount, data);
+	}
+
 	GPU::Descriptor::Ptr Buffer::getDescriptor()
 	{
 		return BufferDescriptor::create(buffer);
@@ -16,6 +16,7 @@ namespace GL
 		~Buffer();
 		void uploadMapped(void* data);
 		void uploadStaged(void* data);
+		void uploadStaged(void* data, uint32 offset, uint32 byteCount);
 		uint8* getMappedPointer() { return data; }
 		uint32 getStride() { return stride; }
 		GPU::Descriptor::Ptr getDescriptor();
@@ -1,510 +1,190 @@
 #include "GLCommandBuffer.h"
 #include "GLEnums.h"
-namespace GL
-{
-	class CmdBeginRenderPass : public Command
-	{
-	public:
-		CmdBeginRenderPass(GL::Framebuffer::Ptr framebuffer) :
-			framebuffer(framebuffer)
-		{
 
-		}
-		~CmdBeginRenderPass() {}
-
-		void execute()
-		{
-			glm::vec4 color = framebuffer->getClearColor();
-			glClearColor(color.r, color.g, color.b, color.a);
-			glClearDepth(1.0f);
+#include <cstring>
 
-			// TODO: this is a work around for the default framebuffer
-			if (framebuffer->getNumAttachments() > 0 || framebuffer->hasDepthAttachment())
-			{
-				framebuffer->bind();
-				framebuffer->setDrawBuffers();
-			}
-			if (framebuffer->clearOnLoad())
-			{
-				glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-				glDepthMask(GL_TRUE);
-				glStencilMask(0xFF);
-				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-			}
-		}
-
-		typedef std::shared_ptr<CmdBeginRenderPass> Ptr;
-		static Ptr create(GL::Framebuffer::Ptr framebuffer)
-		{
-			return std::make_shared<CmdBeginRenderPass>(framebuffer);
-		}
-
-	private:
-		GL::Framebuffer::Ptr framebuffer;
-
-		CmdBeginRenderPass(const CmdBeginRenderPass&) = delete;
-		CmdBeginRenderPass& operator=(const CmdBeginRenderPass&) = delete;
-	};
-
-	class CmdEndRenderPass : public Command
+namespace GL
+{
+	struct CmdBeginRenderPass
 	{
-	public:
-		CmdEndRenderPass()
-		{
-
-		}
-
-		void execute()
-		{
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		}
-
-		typedef std::shared_ptr<CmdEndRenderPass> Ptr;
-		static Ptr create()
-		{
-			return std::make_shared<CmdEndRenderPass>();
-		}
-
-	private:
-		CmdEndRenderPass(const CmdEndRenderPass&) = delete;
-		CmdEndRenderPass& operator=(const CmdEndRenderPass&) = delete;
+		Framebuffer* framebuffer;
 	};
 
-	class CmdSetViewport : public Command
+	struct CmdSetViewport
 	{
-	public:
-		CmdSetViewport(float x, float y, float width, float height) :
-			x(x), y(y), width(width), height(height)
-		{
-		}
-
-		void execute()
-		{
-			glViewport((GLint)x, (GLint)y, (GLsizei)width, (GLsizei)height);
-		}
-
-		typedef std::shared_ptr<CmdSetViewport> Ptr;
-		static Ptr create(float x, float y, float width, float height)
-		{
-			return std::make_shared<CmdSetViewport>(x, y, width, height);
-		}
-
-	private:
 		float x;
 		float y;
 		float width;
 		float height;
-
-		CmdSetViewport(const CmdSetViewport&) = delete;
-		CmdSetViewport& operator=(const CmdSetViewport&) = delete;
 	};
 
-	class CmdSetScissor : public Command
+	struct CmdSetScissor
 	{
-	public:
-		CmdSetScissor(int32 x, int32 y, uint32 width, uint32 height) :
-			x(x), y(y), width(width), height(height)
-		{
-		}
-
-		void execute()
-		{
-			glScissor(x, y, width, height);
-		}
-
-		typedef std::shared_ptr<CmdSetScissor> Ptr;
-		static Ptr create(int32 x, int32 y, uint32 width, uint32 height)
-		{
-			return std::make_shared<CmdSetScissor>(x, y, width, height);
-		}
-
-	private:
 		GLint x;
 		GLint y;
 		GLsizei width;
 		GLsizei height;
-
-		CmdSetScissor(const CmdSetScissor&) = delete;
-		CmdSetScissor& operator=(const CmdSetScissor&) = delete;
 	};
 
-	class CmdBindGraphicsPipeline : public Command
+	struct CmdBindGraphicsPipeline
 	{
-	public:
-		CmdBindGraphicsPipeline(GL::GraphicsPipeline::Ptr pipeline) :
-			pipeline(pipeline)
-		{
-		}
-
-		void execute()
-		{
-			pipeline->use();
-		}
-
-		typedef std::shared_ptr<CmdBindGraphicsPipeline> Ptr;
-		static Ptr create(GL::GraphicsPipeline::Ptr pipeline)
-		{
-			return std::make_shared<CmdBindGraphicsPipeline>(pipeline);
-		}
-
-	private:
-		GL::GraphicsPipeline::Ptr pipeline;
-
-		CmdBindGraphicsPipeline(const CmdBindGraphicsPipeline&) = delete;
-		CmdBindGraphicsPipeline& operator=(const CmdBindGraphicsPipeline&) = delete;
+		GraphicsPipeline* pipeline;
 	};
 
-	class CmdBindComputePipeline : public Command
+	struct CmdBindComputePipeline
 	{
-	public:
-		CmdBindComputePipeline(GL::ComputePipeline::Ptr pipeline) :
-			pipeline(pipeline)
-		{
-		}
-
-		void execute()
-		{
-			pipeline->use();
-		}
-
-		typedef std::shared_ptr<CmdBindComputePipeline> Ptr;
-		static Ptr create(GL::ComputePipeline::Ptr pipeline)
-		{
-			return std::make_shared<CmdBindComputePipeline>(pipeline);
-		}
-
-	private:
-		GL::ComputePipeline::Ptr pipeline;
-
-		CmdBindComputePipeline(const CmdBindComputePipeline&) = delete;
-		CmdBindComputePipeline& operator=(const CmdBindComputePipeline&) = delete;
+		ComputePipeline* pipeline;
 	};
 
-	class CmdPushConstants : public Command
+	struct CmdPushConstants // followed by size bytes of data
 	{
-	public:
-		CmdPushConstants(GL::GraphicsPipeline::Ptr pipeline, uint8* data, uint32 size) :
-			pipeline(pipeline),
-			size(size)
-		{
-			this->data = new uint8[size];
-			std::memcpy(this->data, data, size);
-		}
-
-		void execute()
-		{
-			pipeline->pushConstants(data);
-		}
-
-		typedef std::shared_ptr<CmdPushConstants> Ptr;
-		static Ptr create(GL::GraphicsPipeline::Ptr pipeline, uint8* data, uint32 size)
-		{
-			return std::make_shared<CmdPushConstants>(pipeline, data, size);
-		}
-
-	private:
-		uint8* data;
+		GraphicsPipeline* pipeline;
 		uint32 size;
-		GL::GraphicsPipeline::Ptr pipeline;
-
-		CmdPushConstants(const CmdPushConstants&) = delete;
-		CmdPushConstants& operator=(const CmdPushConstants&) = delete;
 	};
 
-
-	class CmdBindDescriptorSets : public Command
+	struct CmdBindDescriptorSets // followed by numBindings ints
 	{
-	public:
-		CmdBindDescriptorSets(GL::DescriptorSet::Ptr descriptorSet, std::vector<int> bindings) :
-			descriptorSet(descriptorSet),
-			bindings(bindings)
-		{
-		}
-
-		void execute()
-		{
-			//auto bindings = pipeline->getLayoutBindings(descriptorSet->getLayoutName());
-			descriptorSet->bind(bindings);
-		}
-
-		typedef std::shared_ptr<CmdBindDescriptorSets> Ptr;
-		static Ptr create(GL::DescriptorSet::Ptr descriptorSet, std::vector<int> bindings)
-		{
-			return std::make_shared<CmdBindDescriptorSets>(descriptorSet, bindings);
-		}
-
-	private:
-		GL::DescriptorSet::Ptr descriptorSet;
-		std::vector<int> bindings;
-
-		CmdBindDescriptorSets(const CmdBindDescriptorSets&) = delete;
-		CmdBindDescriptorSets& operator=(const CmdBindDescriptorSets&) = delete;
+		DescriptorSet* descriptorSet;
+		uint32 numBindings;
+		uint32 dynamicOffset;
 	};
 
-	class CmdBindVertexBuffers : public Command
+	struct CmdBindVertexBuffers
 	{
-	public:
-		CmdBindVertexBuffers(GLuint buffer,	GLsizei stride) :
-			buffer(buffer),
-			stride(stride)
-		{
-		}
-
-		void execute()
-		{
-			glBindVertexBuffer(0, buffer, 0, stride);
-		}
-
-		typedef std::shared_ptr<CmdBindVertexBuffers> Ptr;
-		static Ptr create(GLuint buffer, GLsizei stride)
-		{
-			return std::make_shared<CmdBindVertexBuffers>(buffer, stride);
-		}
-
-	private:
+		uint32 binding;
 		GLuint buffer;
 		GLsizei stride;
-
-		CmdBindVertexBuffers(const CmdBindVertexBuffers&) = delete;
-		CmdBindVertexBuffers& operator=(const CmdBindVertexBuffers&) = delete;
 	};
 
-
-	class CmdBindIndexBuffers : public Command
+	struct CmdBindIndexBuffers
 	{
-	public:
-		CmdBindIndexBuffers(GLuint buffer) :
-			buffer(buffer)
-		{
-		}
-
-		void execute()
-		{
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
-		}
-
-		typedef std::shared_ptr<CmdBindIndexBuffers> Ptr;
-		static Ptr create(GLuint buffer)
-		{
-			return std::make_shared<CmdBindIndexBuffers>(buffer);
-		}
-
-	private:
 		GLuint buffer;
-
-		CmdBindIndexBuffers(const CmdBindIndexBuffers&) = delete;
-		CmdBindIndexBuffers& operator=(const CmdBindIndexBuffers&) = delete;
 	};
 
-	class CmdSetCullMode : public Command
+	struct CmdSetCullMode
 	{
-	public:
-		CmdSetCullMode(int mode) :
-			mode(mode)
-		{
-		}
-
-		void execute()
-		{
-			if (mode > 0)
-				glEnable(GL_CULL_FACE);
-
-			switch (mode)
-			{
-			case 0: glDisable(GL_CULL_FACE); break;
-			case 1: glCullFace(GL_FRONT); break;
-			case 2: glCullFace(GL_BACK); break;
-			case 3: glCullFace(GL_FRONT_AND_BACK); break;
-			}
-		}
-
-		typedef std::shared_ptr<CmdSetCullMode> Ptr;
-		static Ptr create(int mode)
-		{
-			return std::make_shared<CmdSetCullMode>(mode);
-		}
-
-	private:
 		int mode;
-
-		CmdSetCullMode(const CmdSetCullMode&) = delete;
-		CmdSetCullMode& operator=(const CmdSetCullMode&) = delete;
 	};
 
-	class CmdDrawIndexed : public Command
+	struct CmdDrawIndexed
 	{
-	public:
-		CmdDrawIndexed(uint32 indexCount, GPU::Topology topology) :
-			indexCount(indexCount),
-			topology(topology)
-		{
-		}
-
-		void execute()
-		{
-			glDrawElements(getTopology(topology), indexCount, GL_UNSIGNED_INT, 0);
-		}
-
-		typedef std::shared_ptr<CmdDrawIndexed> Ptr;
-		static Ptr create(uint32 indexCount, GPU::Topology topology)
-		{
-			return std::make_shared<CmdDrawIndexed>(indexCount, topology);
-		}
-
-	private:
 		uint32 indexCount;
 		GPU::Topology topology;
-
-		CmdDrawIndexed(const CmdDrawIndexed&) = delete;
-		CmdDrawIndexed& operator=(const CmdDrawIndexed&) = delete;
+		uint32 firstIndex;
+		int32 baseVertex;
 	};
 
-	class CmdDrawIndexedBaseVertex : public Command
+	struct CmdDrawIndexedBaseVertex
 	{
-	public:
-		CmdDrawIndexedBaseVertex(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset) :
-			indexCount(indexCount),
-			indexOffset(indexOffset),
-			vertexOffset(vertexOffset)
-		{
-		}
-
-		void execute()
-		{
-			glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, (void*)(intptr_t)(indexOffset * sizeof(GLushort)), vertexOffset);
-		}
-
-		typedef std::shared_ptr<CmdDrawIndexedBaseVertex> Ptr;
-		static Ptr create(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset)
-		{
-			return std::make_shared<CmdDrawIndexedBaseVertex>(indexCount, indexOffset, vertexOffset);
-		}
-
-	private:
 		uint32 indexCount;
 		uint32 indexOffset;
 		uint32 vertexOffset;
-
-		CmdDrawIndexedBaseVertex(const CmdDrawIndexedBaseVertex&) = delete;
-		CmdDrawIndexedBaseVertex& operator=(const CmdDrawIndexedBaseVertex&) = delete;
 	};
 
-	class CmdDrawArrays : public Command
+	struct CmdDrawIndexedInstanced
 	{
-	public:
-		CmdDrawArrays(uint32 vertexCount) :
-			vertexCount(vertexCount)
-		{
-		}
-
-		void execute()
-		{
-			glDrawArrays(GL_TRIANGLES, 0, vertexCount);
-		}
-
-		typedef std::shared_ptr<CmdDrawArrays> Ptr;
-		static Ptr create(uint32 vertexCount)
-		{
-			return std::make_shared<CmdDrawArrays>(vertexCount);
-		}
+		uint32 indexCount;
+		uint32 instanceCount;
+		GPU::Topology topology;
+		uint32 firstIndex;
+		int32 baseVertex;
+	};
 
-	private:
+	struct CmdDrawArrays
+	{
 		uint32 vertexCount;
-
-		CmdDrawArrays(const CmdDrawArrays&) = delete;
-		CmdDrawArrays& operator=(const CmdDrawArrays&) = delete;
+		uint32 firstVertex;
 	};
 
-	class CmdDispatchCompute : public Command
+	struct CmdDispatchCompute
 	{
-	public:
-		CmdDispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ) :
-			grpCountX(grpCountX),
-			grpCountY(grpCountY),
-			grpCountZ(grpCountZ)
-		{
-		}
-
-		void execute()
-		{
-			glDispatchCompute(grpCountX, grpCountY, grpCountZ);
-		}
-
-		typedef std::shared_ptr<CmdDispatchCompute> Ptr;
-		static Ptr create(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ)
-		{
-			return std::make_shared<CmdDispatchCompute>(grpCountX, grpCountY, grpCountZ);
-		}
-
-	private:
 		uint32 grpCountX;
 		uint32 grpCountY;
 		uint32 grpCountZ;
-
-		CmdDispatchCompute(const CmdDispatchCompute&) = delete;
-		CmdDispatchCompute& operator=(const CmdDispatchCompute&) = delete;
 	};
 
-	class CmdPipelineBarrier : public Command
+	struct CmdGenerateMipmap
 	{
-	public:
-		CmdPipelineBarrier()
-		{
-		}
+		GLenum target;
+		GLuint texture;
+	};
 
-		void execute()
-		{
-			glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-		}
+	struct CmdCopyImage
+	{
+		GLenum srcTarget;
+		GLuint srcTexture;
+		GLenum dstTarget;
+		GLuint dstTexture;
+		uint32 srcX;
+		uint32 srcY;
+		uint32 dstX;
+		uint32 dstY;
+		uint32 width;
+		uint32 height;
+		uint32 baseLayer;
+		uint32 layerCount;
+	};
 
-		typedef std::shared_ptr<CmdPipelineBarrier> Ptr;
-		static Ptr create()
-		{
-			return std::make_shared<CmdPipelineBarrier>();
-		}
+	CommandBuffer::CommandBuffer()
+	{
+		arena.reserve(64 * 1024);
+	}
 
-	private:
-		CmdPipelineBarrier(const CmdPipelineBarrier&) = delete;
-		CmdPipelineBarrier& operator=(const CmdPipelineBarrier&) = delete;
-	};
+	CommandBuffer::~CommandBuffer()
+	{}
 
-	class CmdGenerateMipmap : public Command
+	uint8* CommandBuffer::allocate(CommandType type, uint32 payloadSize)
 	{
-	public:
-		CmdGenerateMipmap(GLenum target, GLuint texture) :
-			target(target),
-			texture(texture)
-		{
-		}
+		// keep every command 8 byte aligned so the pointers in the payload can be read directly
+		uint32 size = (uint32)(sizeof(CommandHeader) + payloadSize + 7) & ~7u;
+		size_t offset = arena.size();
+		arena.resize(offset + size);
 
-		void execute()
-		{
-			glBindTexture(target, texture);
-			glGenerateMipmap(target);
-		}
+		CommandHeader* header = reinterpret_cast<CommandHeader*>(arena.data() + offset);
+		header->type = type;
+		header->size = size;
+		return arena.data() + offset + sizeof(CommandHeader);
+	}
 
-		typedef std::shared_ptr<CmdGenerateMipmap> Ptr;
-		static Ptr create(GLenum target, GLuint texture)
-		{
-			return std::make_shared<CmdGenerateMipmap>(target, texture);
-		}
+	template<typename T>
+	T* CommandBuffer::record(CommandType type, uint32 extraSize)
+	{
+		return reinterpret_cast<T*>(allocate(type, sizeof(T) + extraSize));
+	}
 
-	private:
-		GLenum target;
-		GLuint texture;
-		CmdGenerateMipmap(const CmdGenerateMipmap&) = delete;
-		CmdGenerateMipmap& operator=(const CmdGenerateMipmap&) = delete;
-	};
+	bool CommandBuffer::isSetBound(uint32 set, DescriptorSet* descriptorSet, const std::vector<int>* bindings, uint32 dynamicOffset)
+	{
+		if (set >= boundSets.size())
+			boundSets.resize(set + 1);
 
-	CommandBuffer::CommandBuffer()
-	{}
+		BoundSet& bound = boundSets[set];
+		if (bound.descriptorSet == descriptorSet && bound.bindings == bindings && bound.dynamicOffset == dynamicOffset)
+			return true;
 
-	CommandBuffer::~CommandBuffer()
-	{}
+		bound.descriptorSet = descriptorSet;
+		bound.bindings = bindings;
+		bound.dynamicOffset = dynamicOffset;
+		return false;
+	}
+
+	void CommandBuffer::resetBoundState()
+	{
+		// vertex and index buffers are part of the VAO which is switched by the pipeline
+		boundPipeline = nullptr;
+		boundSets.clear();
+		for (uint32 i = 0; i < GPU::maxVertexBindings; i++)
+		{
+			boundVertexBuffers[i] = 0;
+			boundStrides[i] = 0;
+		}
+		boundIndexBuffer = 0;
+	}
 
 	void CommandBuffer::begin()
 	{
-		commands.clear();
+		arena.clear();
+		resetBoundState();
+		boundCullMode = -1;
 	}
 
 	void CommandBuffer::end()
@@ -514,162 +194,379 @@ namespace GL
 
 	void CommandBuffer::beginRenderPass(GPU::Framebuffer::Ptr framebuffer)
 	{
-		auto glFramebuffer = std::dynamic_pointer_cast<Framebuffer>(framebuffer);
-		commands.push_back(CmdBeginRenderPass::create(glFramebuffer));
-		//glm::vec4 color = glFramebuffer->getClearColor();
-		//glClearColor(color.r, color.g, color.b, color.a);
-		//glClearDepth(1.0f);
-
-		//// TODO: this is a work around for the default framebuffer
-		//if (glFramebuffer->getNumAttachments() > 0 || glFramebuffer->hasDepthAttachment())
-		//{
-		//	glFramebuffer->bind();
-		//	glFramebuffer->setDrawBuffers();
-		//}
-		//if (glFramebuffer->clearOnLoad())
-		//{
-		//	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		//}
+		// clearing overwrites the write masks that are set by the pipeline
+		resetBoundState();
+		auto cmd = record<CmdBeginRenderPass>(CommandType::BeginRenderPass);
+		cmd->framebuffer = static_cast<Framebuffer*>(framebuffer.get());
 	}
 
 	void CommandBuffer::endRenderPass()
 	{
-		//glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-		commands.push_back(CmdEndRenderPass::create());
+		allocate(CommandType::EndRenderPass, 0);
 	}
 
 	void CommandBuffer::setViewport(float x, float y, float width, float height)
 	{
-		//glViewport(x, y, width, height);
-
-		commands.push_back(CmdSetViewport::create(x, y, width, height));
+		auto cmd = record<CmdSetViewport>(CommandType::SetViewport);
+		cmd->x = x;
+		cmd->y = y;
+		cmd->width = width;
+		cmd->height = height;
 	}
 
 	void CommandBuffer::setScissor(int32 x, int32 y, uint32 width, uint32 height)
 	{
-		//glScissor(x, y, width, height);
-
-		commands.push_back(CmdSetScissor::create(x, y, width, height));
+		auto cmd = record<CmdSetScissor>(CommandType::SetScissor);
+		cmd->x = x;
+		cmd->y = y;
+		cmd->width = width;
+		cmd->height = height;
 	}
 
 	void CommandBuffer::bindPipeline(GPU::GraphicsPipeline::Ptr pipeline)
 	{
-		auto glPipeline = std::dynamic_pointer_cast<GraphicsPipeline>(pipeline);
-		//glPipeline->use();
+		auto glPipeline = static_cast<GraphicsPipeline*>(pipeline.get());
+		if (glPipeline == boundPipeline)
+			return;
 
-		commands.push_back(CmdBindGraphicsPipeline::create(glPipeline));
+		resetBoundState();
+		boundPipeline = glPipeline;
+		auto cmd = record<CmdBindGraphicsPipeline>(CommandType::BindGraphicsPipeline);
+		cmd->pipeline = glPipeline;
 	}
 
 	void CommandBuffer::bindPipeline(GPU::ComputePipeline::Ptr pipeline)
 	{
-		auto glPipeline = std::dynamic_pointer_cast<ComputePipeline>(pipeline);
-		//glPipeline->use();
-
-		commands.push_back(CmdBindComputePipeline::create(glPipeline));
+		resetBoundState();
+		auto cmd = record<CmdBindComputePipeline>(CommandType::BindComputePipeline);
+		cmd->pipeline = static_cast<ComputePipeline*>(pipeline.get());
 	}
 
 	void CommandBuffer::pushConstants(GPU::GraphicsPipeline::Ptr pipeline, GPU::ShaderStage stage, uint32 offset, uint32 size, const void* values)
 	{
-		auto glPipeline = std::dynamic_pointer_cast<GraphicsPipeline>(pipeline);
-		//glPipeline->pushConstants((uint8*)values);
-
-		commands.push_back(CmdPushConstants::create(glPipeline, (uint8*)values, size));
+		auto cmd = record<CmdPushConstants>(CommandType::PushConstants, size);
+		cmd->pipeline = static_cast<GraphicsPipeline*>(pipeline.get());
+		cmd->size = size;
+		std::memcpy(cmd + 1, values, size);
 	}
 
 	void CommandBuffer::bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet)
 	{
-		auto glPipeline = std::dynamic_pointer_cast<GraphicsPipeline>(pipeline);
-		auto glDescriptorSet = std::dynamic_pointer_cast<DescriptorSet>(descriptorSet);
-		auto bindings = glPipeline->getLayoutBindings(glDescriptorSet->getLayoutName());
-		//glDescriptorSet->bind(bindings);
+		auto glPipeline = static_cast<GraphicsPipeline*>(pipeline.get());
+		auto glDescriptorSet = static_cast<DescriptorSet*>(descriptorSet.get());
+		auto& bindings = glPipeline->getLayoutBindings(glDescriptorSet->getLayoutName());
+		if (isSetBound(firstSet, glDescriptorSet, &bindings, 0))
+			return;
+
+		uint32 numBindings = (uint32)bindings.size();
+		auto cmd = record<CmdBindDescriptorSets>(CommandType::BindDescriptorSets, numBindings * sizeof(int));
+		cmd->descriptorSet = glDescriptorSet;
+		cmd->numBindings = numBindings;
+		cmd->dynamicOffset = 0;
+		std::memcpy(cmd + 1, bindings.data(), numBindings * sizeof(int));
+	}
 
-		commands.push_back(CmdBindDescriptorSets::create(glDescriptorSet, bindings));
+	void CommandBuffer::bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset)
+	{
+		auto glPipeline = static_cast<GraphicsPipeline*>(pipeline.get());
+		auto glDescriptorSet = static_cast<DescriptorSet*>(descriptorSet.get());
+		auto& bindings = glPipeline->getLayoutBindings(glDescriptorSet->getLayoutName());
+		if (isSetBound(firstSet, glDescriptorSet, &bindings, dynamicOffset))
+			return;
+
+		// the offset is resolved against the current uniform segment on replay
+		uint32 numBindings = (uint32)bindings.size();
+		auto cmd = record<CmdBindDescriptorSets>(CommandType::BindDescriptorSets, numBindings * sizeof(int));
+		cmd->descriptorSet = glDescriptorSet;
+		cmd->numBindings = numBindings;
+		cmd->dynamicOffset = dynamicOffset;
+		std::memcpy(cmd + 1, bindings.data(), numBindings * sizeof(int));
 	}
 
 	void CommandBuffer::bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet)
 	{
-		auto glPipeline = std::dynamic_pointer_cast<ComputePipeline>(pipeline);
-		auto glDescriptorSet = std::dynamic_pointer_cast<DescriptorSet>(descriptorSet);
-		auto bindings = glPipeline->getLayoutBindings(glDescriptorSet->getLayoutName());
-		//glDescriptorSet->bind(bindings);
-
-		commands.push_back(CmdBindDescriptorSets::create(glDescriptorSet, bindings));
+		auto glPipeline = static_cast<ComputePipeline*>(pipeline.get());
+		auto glDescriptorSet = static_cast<DescriptorSet*>(descriptorSet.get());
+		auto& bindings = glPipeline->getLayoutBindings(glDescriptorSet->getLayoutName());
+		boundSets.clear();
+
+		uint32 numBindings = (uint32)bindings.size();
+		auto cmd = record<CmdBindDescriptorSets>(CommandType::BindDescriptorSets, numBindings * sizeof(int));
+		cmd->descriptorSet = glDescriptorSet;
+		cmd->numBindings = numBindings;
+		cmd->dynamicOffset = 0;
+		std::memcpy(cmd + 1, bindings.data(), numBindings * sizeof(int));
 	}
 
 	void CommandBuffer::bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer)
 	{
-		auto vbo = std::dynamic_pointer_cast<Buffer>(vertexBuffer);
-		//glBindVertexBuffer(0, vbo->getID(), 0, vbo->getStride());
+		bindVertexBuffers(0, vertexBuffer);
+	}
+
+	void CommandBuffer::bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer)
+	{
+		auto vbo = static_cast<Buffer*>(vertexBuffer.get());
+		if (vbo->getID() == boundVertexBuffers[binding] && (GLsizei)vbo->getStride() == boundStrides[binding])
+			return;
 
-		commands.push_back(CmdBindVertexBuffers::create(vbo->getID(), vbo->getStride()));
+		boundVertexBuffers[binding] = vbo->getID();
+		boundStrides[binding] = (GLsizei)vbo->getStride();
+		auto cmd = record<CmdBindVertexBuffers>(CommandType::BindVertexBuffers);
+		cmd->binding = binding;
+		cmd->buffer = vbo->getID();
+		cmd->stride = vbo->getStride();
 	}
 
 	void CommandBuffer::bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType)
 	{
-		auto vbo = std::dynamic_pointer_cast<Buffer>(indexBuffer);
-		//vbo->bind();
-		commands.push_back(CmdBindIndexBuffers::create(vbo->getID()));
+		auto ibo = static_cast<Buffer*>(indexBuffer.get());
+		if (ibo->getID() == boundIndexBuffer)
+			return;
+
+		boundIndexBuffer = ibo->getID();
+		auto cmd = record<CmdBindIndexBuffers>(CommandType::BindIndexBuffers);
+		cmd->buffer = ibo->getID();
 	}
 
 	void CommandBuffer::setCullMode(int mode)
 	{
-		//if (mode > 0)
-		//	glEnable(GL_CULL_FACE);
-
-		//switch (mode)
-		//{
-		//	case 0: glDisable(GL_CULL_FACE); break;
-		//	case 1: glCullFace(GL_FRONT); break;
-		//	case 2: glCullFace(GL_BACK); break;
-		//	case 3: glCullFace(GL_FRONT_AND_BACK); break;
-		//}
+		if (mode == boundCullMode)
+			return;
 
-		commands.push_back(CmdSetCullMode::create(mode));
+		boundCullMode = mode;
+		auto cmd = record<CmdSetCullMode>(CommandType::SetCullMode);
+		cmd->mode = mode;
 	}
 
-	void CommandBuffer::drawIndexed(uint32 indexCount, GPU::Topology topology)
+	void CommandBuffer::drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
 	{
-		//glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
-
-		commands.push_back(CmdDrawIndexed::create(indexCount, topology));
+		auto cmd = record<CmdDrawIndexed>(CommandType::DrawIndexed);
+		cmd->indexCount = indexCount;
+		cmd->topology = topology;
+		cmd->firstIndex = firstIndex;
+		cmd->baseVertex = baseVertex;
 	}
 
 	void CommandBuffer::drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset)
 	{
 		// TODO: get index type and stride from index buffer
-		//glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, (void*)(intptr_t)(indexOffset * sizeof(GLushort)), vertexOffset);
-		commands.push_back(CmdDrawIndexedBaseVertex::create(indexCount, indexOffset, vertexOffset));
+		auto cmd = record<CmdDrawIndexedBaseVertex>(CommandType::DrawIndexedBaseVertex);
+		cmd->indexCount = indexCount;
+		cmd->indexOffset = indexOffset;
+		cmd->vertexOffset = vertexOffset;
 	}
 
-	void CommandBuffer::drawArrays(uint32 vertexCount)
+	void CommandBuffer::drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
 	{
-		//glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+		auto cmd = record<CmdDrawIndexedInstanced>(CommandType::DrawIndexedInstanced);
+		cmd->indexCount = indexCount;
+		cmd->instanceCount = instanceCount;
+		cmd->topology = topology;
+		cmd->firstIndex = firstIndex;
+		cmd->baseVertex = baseVertex;
+	}
 
-		commands.push_back(CmdDrawArrays::create(vertexCount));
+	void CommandBuffer::drawArrays(uint32 vertexCount, uint32 firstVertex)
+	{
+		auto cmd = record<CmdDrawArrays>(CommandType::DrawArrays);
+		cmd->vertexCount = vertexCount;
+		cmd->firstVertex = firstVertex;
 	}
 
 	void CommandBuffer::dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ)
 	{
-		//glDispatchCompute(grpCountX, grpCountY, grpCountZ);
-		commands.push_back(CmdDispatchCompute::create(grpCountX, grpCountY, grpCountZ));
+		auto cmd = record<CmdDispatchCompute>(CommandType::DispatchCompute);
+		cmd->grpCountX = grpCountX;
+		cmd->grpCountY = grpCountY;
+		cmd->grpCountZ = grpCountZ;
 	}
 
 	void CommandBuffer::pipelineBarrier()
 	{
-		//glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-
-		commands.push_back(CmdPipelineBarrier::create());
+		allocate(CommandType::PipelineBarrier, 0);
 	}
 
 	void CommandBuffer::flush()
 	{
-		for (auto cmd : commands)
-			cmd->execute();
+		const uint8* ptr = arena.data();
+		const uint8* end = ptr + arena.size();
+		while (ptr < end)
+		{
+			auto header = reinterpret_cast<const CommandHeader*>(ptr);
+			const uint8* payload = ptr + sizeof(CommandHeader);
+			ptr += header->size;
+
+			switch (header->type)
+			{
+				case CommandType::BeginRenderPass:
+				{
+					auto cmd = reinterpret_cast<const CmdBeginRenderPass*>(payload);
+					Framebuffer* framebuffer = cmd->framebuffer;
+					glm::vec4 color = framebuffer->getClearColor();
+					glClearColor(color.r, color.g, color.b, color.a);
+					glClearDepth(1.0f);
+
+					// TODO: this is a work around for the default framebuffer
+					if (framebuffer->getNumAttachments() > 0 || framebuffer->hasDepthAttachment())
+					{
+						framebuffer->bind();
+						framebuffer->setDrawBuffers();
+					}
+					if (framebuffer->clearOnLoad())
+					{
+						glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+						glDepthMask(GL_TRUE);
+						glStencilMask(0xFF);
+						glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+					}
+					break;
+				}
+				case CommandType::EndRenderPass:
+				{
+					glBindFramebuffer(GL_FRAMEBUFFER, 0);
+					break;
+				}
+				case CommandType::SetViewport:
+				{
+					auto cmd = reinterpret_cast<const CmdSetViewport*>(payload);
+					glViewport((GLint)cmd->x, (GLint)cmd->y, (GLsizei)cmd->width, (GLsizei)cmd->height);
+					break;
+				}
+				case CommandType::SetScissor:
+				{
+					auto cmd = reinterpret_cast<const CmdSetScissor*>(payload);
+					glScissor(cmd->x, cmd->y, cmd->width, cmd->height);
+					break;
+				}
+				case CommandType::BindGraphicsPipeline:
+				{
+					auto cmd = reinterpret_cast<const CmdBindGraphicsPipeline*>(payload);
+					cmd->pipeline->use();
+					break;
+				}
+				case CommandType::BindComputePipeline:
+				{
+					auto cmd = reinterpret_cast<const CmdBindComputePipeline*>(payload);
+					cmd->pipeline->use();
+					break;
+				}
+				case CommandType::PushConstants:
+				{
+					auto cmd = reinterpret_cast<const CmdPushConstants*>(payload);
+					cmd->pipeline->pushConstants((uint8*)(cmd + 1));
+					break;
+				}
+				case CommandType::BindDescriptorSets:
+				{
+					auto cmd = reinterpret_cast<const CmdBindDescriptorSets*>(payload);
+					cmd->descriptorSet->bind(reinterpret_cast<const int*>(cmd + 1), cmd->numBindings, cmd->dynamicOffset);
+					break;
+				}
+				case CommandType::BindVertexBuffers:
+				{
+					auto cmd = reinterpret_cast<const CmdBindVertexBuffers*>(payload);
+					glBindVertexBuffer(cmd->binding, cmd->buffer, 0, cmd->stride);
+					break;
+				}
+				case CommandType::BindIndexBuffers:
+				{
+					auto cmd = reinterpret_cast<const CmdBindIndexBuffers*>(payload);
+					glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cmd->buffer);
+					break;
+				}
+				case CommandType::SetCullMode:
+				{
+					auto cmd = reinterpret_cast<const CmdSetCullMode*>(payload);
+					if (cmd->mode > 0)
+						glEnable(GL_CULL_FACE);
+
+					switch (cmd->mode)
+					{
+					case 0: glDisable(GL_CULL_FACE); break;
+					case 1: glCullFace(GL_FRONT); break;
+					case 2: glCullFace(GL_BACK); break;
+					case 3: glCullFace(GL_FRONT_AND_BACK); break;
+					}
+					break;
+				}
+				case CommandType::DrawIndexed:
+				{
+					auto cmd = reinterpret_cast<const CmdDrawIndexed*>(payload);
+					void* indices = (void*)(intptr_t)(cmd->firstIndex * sizeof(GLuint));
+					glDrawElementsBaseVertex(getTopology(cmd->topology), cmd->indexCount, GL_UNSIGNED_INT, indices, cmd->baseVertex);
+					break;
+				}
+				case CommandType::DrawIndexedBaseVertex:
+				{
+					auto cmd = reinterpret_cast<const CmdDrawIndexedBaseVertex*>(payload);
+					glDrawElementsBaseVertex(GL_TRIANGLES, cmd->indexCount, GL_UNSIGNED_SHORT, (void*)(intptr_t)(cmd->indexOffset * sizeof(GLushort)), cmd->vertexOffset);
+					break;
+				}
+				case CommandType::DrawIndexedInstanced:
+				{
+					auto cmd = reinterpret_cast<const CmdDrawIndexedInstanced*>(payload);
+					void* indices = (void*)(intptr_t)(cmd->firstIndex * sizeof(GLuint));
+					glDrawElementsInstancedBaseVertex(getTopology(cmd->topology), cmd->indexCount, GL_UNSIGNED_INT, indices, cmd->instanceCount, cmd->baseVertex);
+					break;
+				}
+				case CommandType::DrawArrays:
+				{
+					auto cmd = reinterpret_cast<const CmdDrawArrays*>(payload);
+					glDrawArrays(GL_TRIANGLES, cmd->firstVertex, cmd->vertexCount);
+					break;
+				}
+				case CommandType::DispatchCompute:
+				{
+					auto cmd = reinterpret_cast<const CmdDispatchCompute*>(payload);
+					glDispatchCompute(cmd->grpCountX, cmd->grpCountY, cmd->grpCountZ);
+					break;
+				}
+				case CommandType::PipelineBarrier:
+				{
+					glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+					break;
+				}
+				case CommandType::GenerateMipmap:
+				{
+					auto cmd = reinterpret_cast<const CmdGenerateMipmap*>(payload);
+					glBindTexture(cmd->target, cmd->texture);
+					glGenerateMipmap(cmd->target);
+					break;
+				}
+				case CommandType::CopyImage:
+				{
+					auto cmd = reinterpret_cast<const CmdCopyImage*>(payload);
+					glCopyImageSubData(cmd->srcTexture, cmd->srcTarget, 0, cmd->srcX, cmd->srcY, cmd->baseLayer,
+						cmd->dstTexture, cmd->dstTarget, 0, cmd->dstX, cmd->dstY, cmd->baseLayer,
+						cmd->width, cmd->height, cmd->layerCount);
+					break;
+				}
+			}
+		}
 	}
 
 	void CommandBuffer::generateMipmap(GLenum target, GLuint texture)
 	{
-		commands.push_back(CmdGenerateMipmap::create(target, texture));
+		// rebinds a texture on the active unit
+		boundSets.clear();
+		auto cmd = record<CmdGenerateMipmap>(CommandType::GenerateMipmap);
+		cmd->target = target;
+		cmd->texture = texture;
+	}
+	void CommandBuffer::copyImage(GLenum srcTarget, GLuint srcTexture, GLenum dstTarget, GLuint dstTexture, uint32 srcX, uint32 srcY, uint32 dstX, uint32 dstY, uint32 width, uint32 height, uint32 baseLayer, uint32 layerCount)
+	{
+		auto cmd = record<CmdCopyImage>(CommandType::CopyImage);
+		cmd->srcTarget = srcTarget;
+		cmd->srcTexture = srcTexture;
+		cmd->dstTarget = dstTarget;
+		cmd->dstTexture = dstTexture;
+		cmd->srcX = srcX;
+		cmd->srcY = srcY;
+		cmd->dstX = dstX;
+		cmd->dstY = dstY;
+		cmd->width = width;
+		cmd->height = height;
+		cmd->baseLayer = baseLayer;
+		cmd->layerCount = layerCount;
 	}
 }
\ No newline at end of file
@@ -11,16 +11,34 @@
 
 namespace GL
 {
-	class Command
+	enum class CommandType : uint32
 	{
-	public:
-		Command() {}
-		virtual ~Command() = 0 {}
-		virtual void execute() = 0;
-		typedef std::shared_ptr<Command> Ptr;
-	private:
-		Command(const Command&) = delete;
-		Command& operator=(const Command&) = delete;
+		BeginRenderPass,
+		EndRenderPass,
+		SetViewport,
+		SetScissor,
+		BindGraphicsPipeline,
+		BindComputePipeline,
+		PushConstants,
+		BindDescriptorSets,
+		BindVertexBuffers,
+		BindIndexBuffers,
+		SetCullMode,
+		DrawIndexed,
+		DrawIndexedBaseVertex,
+		DrawIndexedInstanced,
+		DrawArrays,
+		DispatchCompute,
+		PipelineBarrier,
+		GenerateMipmap,
+		CopyImage
+	};
+
+	// every command in the arena starts with this header, size includes header and payload
+	struct CommandHeader
+	{
+		CommandType type;
+		uint32 size;
 	};
 
 	class CommandBuffer : public GPU::CommandBuffer
@@ -39,18 +57,22 @@ namespace GL
 		void bindPipeline(GPU::ComputePipeline::Ptr pipeline);
 		void pushConstants(GPU::GraphicsPipeline::Ptr pipeline, GPU::ShaderStage stage, uint32 offset, uint32 size, const void* values);
 		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
+		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset);
 		void bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
 		void bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer);
+		void bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer);
 		void bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType);
 		void setCullMode(int mode);
-		void drawIndexed(uint32 indexCount, GPU::Topology topology);
+		void drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
 		void drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset);
-		void drawArrays(uint32 vertexCount);
+		void drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
+		void drawArrays(uint32 vertexCount, uint32 firstVertex);
 		void dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ);
 		void pipelineBarrier();
 		void flush();
 
 		void generateMipmap(GLenum target, GLuint texture);
+		void copyImage(GLenum srcTarget, GLuint srcTexture, GLenum dstTarget, GLuint dstTexture, uint32 srcX, uint32 srcY, uint32 dstX, uint32 dstY, uint32 width, uint32 height, uint32 baseLayer, uint32 layerCount);
 
 		typedef std::shared_ptr<CommandBuffer> Ptr;
 		static Ptr create()
@@ -59,7 +81,31 @@ namespace GL
 		}
 
 	private:
-		std::vector<Command::Ptr> commands;
+		uint8* allocate(CommandType type, uint32 payloadSize);
+		template<typename T>
+		T* record(CommandType type, uint32 extraSize = 0);
+		bool isSetBound(uint32 set, DescriptorSet* descriptorSet, const std::vector<int>* bindings, uint32 dynamicOffset);
+		void resetBoundState();
+
+		// Commands are recorded as POD structs into a linear arena that is reused between frames.
+		// Only raw pointers to pipelines, framebuffers and descriptor sets are stored, so like
+		// in Vulkan these objects have to stay alive until the buffer is re-recorded.
+		std::vector<uint8> arena;
+
+		// State of the last recorded binds, redundant binds are dropped while recording so they
+		// are not replayed every frame. Anything a pipeline or a render pass touches is reset.
+		struct BoundSet
+		{
+			DescriptorSet* descriptorSet = nullptr;
+			const std::vector<int>* bindings = nullptr;
+			uint32 dynamicOffset = 0;
+		};
+		GraphicsPipeline* boundPipeline = nullptr;
+		std::vector<BoundSet> boundSets;
+		GLuint boundVertexBuffers[GPU::maxVertexBindings] = {};
+		GLsizei boundStrides[GPU::maxVertexBindings] = {};
+		GLuint boundIndexBuffer = 0;
+		int boundCullMode = -1;
 
 		CommandBuffer(const CommandBuffer&) = delete;
 		CommandBuffer& operator=(const CommandBuffer&) = delete;
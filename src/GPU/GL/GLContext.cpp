@@ -66,6 +66,8 @@ namespace GL
 
 		glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 		glDepthFunc(GL_LEQUAL);
+
+		programCache = ProgramCache::create("../../../../cache/shaders/gl");
 	}
 
 	Context::~Context() 
@@ -92,7 +94,7 @@ namespace GL
 
 	GPU::ComputePipeline::Ptr Context::createComputePipeline(std::string name)
 	{
-		return ComputePipeline::create(name);
+		return ComputePipeline::create(name, programCache);
 	}
 
 	GPU::DescriptorPool::Ptr Context::createDescriptorPool()
@@ -107,7 +109,7 @@ namespace GL
 
 	GPU::GraphicsPipeline::Ptr Context::createGraphicsPipeline(GPU::Framebuffer::Ptr framebuffer, std::string name, int numAttachments)
 	{
-		return GraphicsPipeline::create(name);
+		return GraphicsPipeline::create(name, programCache);
 	}
 
 	GPU::Image::Ptr Context::createImage(GPU::ImageParameters params)
@@ -137,6 +139,13 @@ namespace GL
 		return Swapchain::create(deviceContext, width, height);
 	}
 
+	GPU::UniformAllocator::Ptr Context::createUniformAllocator(uint32 blockSize, uint32 maxBlocks)
+	{
+		GLint alignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		return UniformAllocator::create(blockSize, maxBlocks, 3, (uint32)alignment);
+	}
+
 	void Context::submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf)
 	{
 		nextCmdBuf->flush();
@@ -8,10 +8,12 @@
 #include <GPU/GL/GLBuffer.h>
 #include <GPU/GL/GLDescriptorPool.h>
 #include <GPU/GL/GLPipeline.h>
+#include <GPU/GL/GLProgramCache.h>
 #include <GPU/GL/GLImage.h>
 #include <GPU/GL/GLImageView.h>
 #include <GPU/GL/GLSampler.h>
 #include <GPU/GL/GLSwapchain.h>
+#include <GPU/GL/GLUniformAllocator.h>
 #include <GPU/GL/GLPlatform.h>
 #include <GPU/Enums.h>
 #include <Windows.h>
@@ -41,6 +43,7 @@ namespace GL
 		GPU::ImageDescriptor::Ptr createImageDescriptor(GPU::Image::Ptr image, GPU::ImageView::Ptr view, GPU::Sampler::Ptr sampler);
 		GPU::Sampler::Ptr createSampler(uint32 levels);
 		GPU::Swapchain::Ptr createSwapchain(Window::Ptr window);
+		GPU::UniformAllocator::Ptr createUniformAllocator(uint32 blockSize, uint32 maxBlocks);
 		void submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void submitCommandBuffer(GPU::CommandBuffer::Ptr prevCmdBuf, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void waitDeviceIdle() {}
@@ -76,6 +79,7 @@ namespace GL
 		HWND hwnd;
 		HDC deviceContext;
 		HGLRC glContext;
+		ProgramCache::Ptr programCache;
 
 		Context(const Context&) = delete;
 		Context& operator=(const Context&) = delete;
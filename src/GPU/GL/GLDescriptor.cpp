@@ -13,6 +13,28 @@ namespace GL
 		return buffer;
 	}
 
+	DynamicBufferDescriptor::DynamicBufferDescriptor(GLuint buffer, GPU::UniformAllocator* allocator) :
+		buffer(buffer),
+		allocator(allocator)
+	{
+
+	}
+
+	GLuint DynamicBufferDescriptor::getBuffer()
+	{
+		return buffer;
+	}
+
+	GLintptr DynamicBufferDescriptor::getOffset(uint32 dynamicOffset)
+	{
+		return allocator->getFrameOffset() + dynamicOffset;
+	}
+
+	GLsizeiptr DynamicBufferDescriptor::getRange()
+	{
+		return allocator->getDataSize();
+	}
+
 	ImageDescriptor::ImageDescriptor(GLenum target, GLuint texture, GLuint sampler) :
 		target(target),
 		texture(texture),
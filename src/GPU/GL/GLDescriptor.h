@@ -4,6 +4,7 @@
 #pragma once
 
 #include <GPU/Descriptor.h>
+#include <GPU/UniformAllocator.h>
 #include <GPU/GL/GLPlatform.h>
 
 namespace GL
@@ -24,6 +25,25 @@ namespace GL
 		GLuint buffer;
 	};
 
+	class DynamicBufferDescriptor : public GPU::BufferDescriptor
+	{
+	public:
+		DynamicBufferDescriptor(GLuint buffer, GPU::UniformAllocator* allocator);
+		GLuint getBuffer();
+		GLintptr getOffset(uint32 dynamicOffset);
+		GLsizeiptr getRange();
+
+		typedef std::shared_ptr<DynamicBufferDescriptor> Ptr;
+		static Ptr create(GLuint buffer, GPU::UniformAllocator* allocator)
+		{
+			return std::make_shared<DynamicBufferDescriptor>(buffer, allocator);
+		}
+
+	private:
+		GLuint buffer;
+		GPU::UniformAllocator* allocator;
+	};
+
 	class ImageDescriptor : public GPU::ImageDescriptor
 	{
 	public:
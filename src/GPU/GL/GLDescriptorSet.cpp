@@ -21,50 +21,42 @@ namespace GL
 
 	}
 
-	void DescriptorSet::bind(std::vector<int> bindings)
+	void DescriptorSet::bind(const int* bindings, uint32 numBindings, uint32 dynamicOffset)
 	{
-		for (int i = 0; i < descriptors.size(); i++)
+		for (int i = 0; i < descriptors.size() && i < (int)numBindings; i++)
 		{
-			auto desc = descriptors[i];
-			GPU::DescriptorSetLayoutBinding layoutBinding;
-			if (i < dslb.size())
-				layoutBinding = dslb[i];
-			else
-				layoutBinding = dslb[dslb.size() - 1]; // TODO: Quick fix for array descriptors...
-			if (std::dynamic_pointer_cast<BufferDescriptor>(desc))
+			auto desc = descriptors[i].get();
+			const GPU::DescriptorSetLayoutBinding& layoutBinding = i < dslb.size() ? dslb[i] : dslb[dslb.size() - 1]; // TODO: Quick fix for array descriptors...
+			if (auto glBufferDesc = dynamic_cast<BufferDescriptor*>(desc))
 			{
-				auto glBufferDesc = std::dynamic_pointer_cast<BufferDescriptor>(desc);
 				GLuint buffer = glBufferDesc->getBuffer();
-				glBindBufferBase(GL_UNIFORM_BUFFER, bindings[i], buffer);
+				if (layoutBinding.descriptorType == GPU::DescriptorType::StorageBuffer)
+					glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bindings[i], buffer);
+				else
+					glBindBufferBase(GL_UNIFORM_BUFFER, bindings[i], buffer);
+			}
+			else if (auto glDynamicDesc = dynamic_cast<DynamicBufferDescriptor*>(desc))
+			{
+				GLuint buffer = glDynamicDesc->getBuffer();
+				GLintptr offset = glDynamicDesc->getOffset(dynamicOffset);
+				glBindBufferRange(GL_UNIFORM_BUFFER, bindings[i], buffer, offset, glDynamicDesc->getRange());
 			}
-			if (std::dynamic_pointer_cast<ImageDescriptor>(desc))
+			else if (auto glImageDesc = dynamic_cast<ImageDescriptor*>(desc))
 			{
+				GLenum target = glImageDesc->getTarget();
+				GLuint texture = glImageDesc->getTexture();
+				GLuint sampler = glImageDesc->getSampler();
+				glActiveTexture(GL_TEXTURE0 + bindings[i]);
+				glBindTexture(target, texture);
 				if (layoutBinding.descriptorType == GPU::DescriptorType::CombinedImageSampler)
-				{
-					auto glImageDesc = std::dynamic_pointer_cast<ImageDescriptor>(desc);
-					GLenum target = glImageDesc->getTarget();
-					GLuint texture = glImageDesc->getTexture();
-					GLuint sampler = glImageDesc->getSampler();
-					glActiveTexture(GL_TEXTURE0 + bindings[i]);
-					glBindTexture(target, texture);
 					glBindSampler(bindings[i], sampler);
-				}
 				else
-				{
-					auto glImageDesc = std::dynamic_pointer_cast<ImageDescriptor>(desc);
-					GLenum target = glImageDesc->getTarget();
-					GLuint texture = glImageDesc->getTexture();
-					GLuint sampler = glImageDesc->getSampler();
-					glActiveTexture(GL_TEXTURE0 + bindings[i]);
-					glBindTexture(target, texture);
 					glBindImageTexture(bindings[i], texture, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA16F);
-					//std::cout << "unknow image descriptor type: " << (int)layoutBinding.descriptorType << std::endl;
-				}
 			}
 		}
 	}
 
-	std::string DescriptorSet::getLayoutName()
+	const std::string& DescriptorSet::getLayoutName()
 	{
 		return layoutName;
 	}
@@ -20,8 +20,8 @@ namespace GL
 		{
 			descriptors.push_back(descriptor);
 		}
-		void bind(std::vector<int> bindings);
-		std::string getLayoutName();
+		void bind(const int* bindings, uint32 numBindings, uint32 dynamicOffset = 0);
+		const std::string& getLayoutName();
 
 		typedef std::shared_ptr<DescriptorSet> Ptr;
 		static Ptr create(std::string layoutName, std::vector<GPU::DescriptorSetLayoutBinding>& dslb)
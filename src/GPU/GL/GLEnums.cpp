@@ -11,6 +11,8 @@ namespace GL
 			target = GL_ELEMENT_ARRAY_BUFFER;
 		else if (usage & GPU::BufferUsage::UniformBuffer)
 			target = GL_UNIFORM_BUFFER;
+		else if (usage & GPU::BufferUsage::StorageBuffer)
+			target = GL_SHADER_STORAGE_BUFFER;
 		return target;
 	}
 
@@ -36,10 +38,44 @@ namespace GL
 			case GPU::VertexAttribFormat::Vector3F: size = 3; break;
 			case GPU::VertexAttribFormat::Vector4F: size = 4; break;
 			case GPU::VertexAttribFormat::Vectur4UC: size = 4; break;
+			case GPU::VertexAttribFormat::Vector2H: size = 2; break;
+			case GPU::VertexAttribFormat::Vector2SN16: size = 2; break;
+			case GPU::VertexAttribFormat::Vector4SN16: size = 4; break;
+			case GPU::VertexAttribFormat::Vector4UB: size = 4; break;
 		}
 		return size;
 	}
 
+	GLenum getType(GPU::VertexAttribFormat format)
+	{
+		GLenum type;
+		switch (format)
+		{
+			case GPU::VertexAttribFormat::Vector1F:
+			case GPU::VertexAttribFormat::Vector2F:
+			case GPU::VertexAttribFormat::Vector3F:
+			case GPU::VertexAttribFormat::Vector4F: type = GL_FLOAT; break;
+			case GPU::VertexAttribFormat::Vectur4UC: type = GL_UNSIGNED_BYTE; break;
+			case GPU::VertexAttribFormat::Vector2H: type = GL_HALF_FLOAT; break;
+			case GPU::VertexAttribFormat::Vector2SN16:
+			case GPU::VertexAttribFormat::Vector4SN16: type = GL_SHORT; break;
+			case GPU::VertexAttribFormat::Vector4UB: type = GL_UNSIGNED_BYTE; break;
+		}
+		return type;
+	}
+
+	bool isNormalized(GPU::VertexAttribFormat format)
+	{
+		return format == GPU::VertexAttribFormat::Vectur4UC ||
+			format == GPU::VertexAttribFormat::Vector2SN16 ||
+			format == GPU::VertexAttribFormat::Vector4SN16;
+	}
+
+	bool isInteger(GPU::VertexAttribFormat format)
+	{
+		return format == GPU::VertexAttribFormat::Vector4UB;
+	}
+
 	GLenum getTopology(GPU::Topology topology)
 	{
 		return (GLenum)topology;
@@ -11,6 +11,9 @@ namespace GL
 	GLenum getBufferTarget(GPU::BufferUsage usage);
 	GLenum getShaderType(GPU::ShaderStage stage);
 	GLenum getSize(GPU::VertexAttribFormat format);
+	GLenum getType(GPU::VertexAttribFormat format);
+	bool isNormalized(GPU::VertexAttribFormat format);
+	bool isInteger(GPU::VertexAttribFormat format);
 	GLenum getTopology(GPU::Topology topology);
 }
 
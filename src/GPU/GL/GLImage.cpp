@@ -89,6 +89,21 @@ namespace GL
 		glCmdBuf->generateMipmap(target, texture);
 	}
 
+	void Image::copyLayers(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount)
+	{
+		auto glCmdBuf = std::dynamic_pointer_cast<CommandBuffer>(cmdBuf);
+		auto dst = std::dynamic_pointer_cast<Image>(dstImage);
+		glCmdBuf->copyImage(target, texture, dst->getTexTarget(), dst->getTexture(), 0, 0, 0, 0, extent.width, extent.height, baseLayer, layerCount);
+	}
+
+	void Image::copyRegions(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, const std::vector<GPU::ImageRegion>& regions)
+	{
+		auto glCmdBuf = std::dynamic_pointer_cast<CommandBuffer>(cmdBuf);
+		auto dst = std::dynamic_pointer_cast<Image>(dstImage);
+		for (auto& r : regions)
+			glCmdBuf->copyImage(target, texture, dst->getTexTarget(), dst->getTexture(), r.srcX, r.srcY, r.dstX, r.dstY, r.width, r.height, 0, 1);
+	}
+
 	void Image::setImageLayout()
 	{
 
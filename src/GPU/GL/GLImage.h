@@ -56,6 +56,8 @@ namespace GL
 		void uploadData(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize, uint32 layer, uint32 level);
 		void uploadArray(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize);
 		void generateMipmaps(GPU::CommandBuffer::Ptr cmdBuf);
+		void copyLayers(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount);
+		void copyRegions(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, const std::vector<GPU::ImageRegion>& regions);
 		void setImageLayout();
 		void layoutTransitionShader(GPU::CommandBuffer::Ptr cmdBuf);
 		void layoutTransitionStorage(GPU::CommandBuffer::Ptr cmdBuf);
@@ -3,8 +3,45 @@
 
 namespace GL
 {
-	GraphicsPipeline::GraphicsPipeline(std::string name) : 
-		GPU::GraphicsPipeline(name)
+	bool buildProgram(Program& program, std::vector<ShaderSource>& sources, ProgramCache::Ptr programCache)
+	{
+		uint64 key = 0;
+		if (programCache)
+		{
+			key = programCache->computeKey(sources);
+			if (programCache->load(key, program))
+				return true;
+		}
+
+		for (auto& src : sources)
+		{
+			Shader shader(src.type);
+			if (shader.compile(src.code.c_str()))
+			{
+				program.attachShader(shader);
+			}
+			else
+			{
+				std::cout << "error compiling shader " << std::endl;
+				std::cout << shader.getErrorLog() << std::endl;
+			}
+		}
+
+		if (programCache)
+			program.setBinaryRetrievable();
+
+		if (!program.link())
+			return false;
+
+		if (programCache)
+			programCache->store(key, program);
+
+		return true;
+	}
+
+	GraphicsPipeline::GraphicsPipeline(std::string name, ProgramCache::Ptr programCache) : 
+		GPU::GraphicsPipeline(name),
+		programCache(programCache)
 	{
 		glGenVertexArrays(1, &vao);
 	}
@@ -17,26 +54,31 @@ namespace GL
 	void GraphicsPipeline::setVertexInputDescripton(GPU::VertexDescription& inputDescription)
 	{
 		glBindVertexArray(vao);
-		uint32 bindingIndex = inputDescription.binding;
-		uint32 stride = inputDescription.stride;
-		auto inputRate = inputDescription.inputRate; // TODO: add divisor if per instance
-		for (int i = 0; i < inputDescription.inputAttributes.size(); i++)
+		for (auto& binding : inputDescription.inputBindings)
+		{
+			// the stride is set when the buffer is bound
+			GLuint divisor = binding.inputRate == GPU::VertexInputeRate::Instance ? 1 : 0;
+			glVertexBindingDivisor(binding.binding, divisor);
+		}
+
+		for (auto& attrib : inputDescription.inputAttributes)
 		{
-			auto attrib = inputDescription.inputAttributes[i];
 			GLuint attribIndex = attrib.location;
-			GLint size = getSize(attrib.format); // TODO: add other formats beside float...
+			GLint size = getSize(attrib.format);
+			GLenum type = getType(attrib.format);
 			glEnableVertexAttribArray(attribIndex);
-			glVertexAttribBinding(attribIndex, bindingIndex);
-			if (attrib.format == GPU::VertexAttribFormat::Vectur4UC)
-				glVertexAttribFormat(attribIndex, size, GL_UNSIGNED_BYTE, GL_TRUE, attrib.offset);
+			glVertexAttribBinding(attribIndex, attrib.binding);
+			if (isInteger(attrib.format))
+				glVertexAttribIFormat(attribIndex, size, type, attrib.offset);
 			else
-				glVertexAttribFormat(attribIndex, size, GL_FLOAT, GL_FALSE, attrib.offset);
+				glVertexAttribFormat(attribIndex, size, type, isNormalized(attrib.format), attrib.offset);
 		}
 	}
 
 	void GraphicsPipeline::setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts)
 	{
 		uint32 bufferDescriptorCount = 0;
+		uint32 storageDescriptorCount = 0;
 		uint32 imageDescriptorCount = 0;
 		auto glDescriptorPool = std::dynamic_pointer_cast<DescriptorPool>(descriptorPool);
 		for (auto layoutName : setLayouts)
@@ -45,11 +87,17 @@ namespace GL
 			auto layoutBindings = glDescriptorPool->getLayout(layoutName);
 			for (auto dslb : layoutBindings)
 			{
-				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer)
+				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer ||
+					dslb.descriptorType == GPU::DescriptorType::UniformBufferDynamic)
 				{
 					setBindings.push_back(bufferDescriptorCount);
 					bufferDescriptorCount++;
 				}
+				else if (dslb.descriptorType == GPU::DescriptorType::StorageBuffer)
+				{
+					setBindings.push_back(storageDescriptorCount);
+					storageDescriptorCount++;
+				}
 				else if (dslb.descriptorType == GPU::DescriptorType::CombinedImageSampler)
 				{
 					for (uint32 i = 0; i < dslb.count; i++)
@@ -80,17 +128,8 @@ namespace GL
 
 	void GraphicsPipeline::addShaderStage(std::string code, GPU::ShaderStage stage)
 	{
-		GLenum shaderType = getShaderType(stage);
-		Shader shader(shaderType);
-		if (shader.compile(code.c_str()))
-		{
-			program.attachShader(shader);
-		}
-		else
-		{
-			std::cout << "error compiling shader " << std::endl;
-			std::cout << shader.getErrorLog() << std::endl;
-		}
+		// compilation is deferred to createProgram, so a cached binary can be used instead
+		shaderSources.push_back(ShaderSource(getShaderType(stage), code));
 	}
 
 	void GraphicsPipeline::pushConstants(uint8* data)
@@ -153,7 +192,7 @@ namespace GL
 
 	void GraphicsPipeline::createProgram()
 	{
-		if (program.link())
+		if (buildProgram(program, shaderSources, programCache))
 		{
 			program.loadUniforms();
 		}
@@ -162,6 +201,7 @@ namespace GL
 			std::cout << "error linking shader program " << std::endl;
 			std::cout << program.getErrorLog() << std::endl;
 		}
+		shaderSources.clear();
 	}
 
 	void GraphicsPipeline::use()
@@ -211,13 +251,14 @@ namespace GL
 		program.use();
 	}
 
-	std::vector<int> GraphicsPipeline::getLayoutBindings(std::string name)
+	const std::vector<int>& GraphicsPipeline::getLayoutBindings(const std::string& name)
 	{
 		return layout[name];
 	}
 
-	ComputePipeline::ComputePipeline(std::string name) :
-		GPU::ComputePipeline(name)
+	ComputePipeline::ComputePipeline(std::string name, ProgramCache::Ptr programCache) :
+		GPU::ComputePipeline(name),
+		programCache(programCache)
 	{
 
 	}
@@ -228,6 +269,7 @@ namespace GL
 	void ComputePipeline::setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts)
 	{
 		uint32 bufferDescriptorCount = 0;
+		uint32 storageDescriptorCount = 0;
 		uint32 imageDescriptorCount = 0;
 		auto glDescriptorPool = std::dynamic_pointer_cast<GL::DescriptorPool>(descriptorPool);
 		for (auto layoutName : setLayouts)
@@ -236,11 +278,17 @@ namespace GL
 			auto layoutBindings = glDescriptorPool->getLayout(layoutName);
 			for (auto dslb : layoutBindings)
 			{
-				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer)
+				if (dslb.descriptorType == GPU::DescriptorType::UniformBuffer ||
+					dslb.descriptorType == GPU::DescriptorType::UniformBufferDynamic)
 				{
 					setBindings.push_back(bufferDescriptorCount);
 					bufferDescriptorCount++;
 				}
+				else if (dslb.descriptorType == GPU::DescriptorType::StorageBuffer)
+				{
+					setBindings.push_back(storageDescriptorCount);
+					storageDescriptorCount++;
+				}
 				else if (dslb.descriptorType == GPU::DescriptorType::CombinedImageSampler ||
 						 dslb.descriptorType == GPU::DescriptorType::StorageImage)
 				{
@@ -258,22 +306,12 @@ namespace GL
 	void ComputePipeline::addShaderStage(std::string code, GPU::ShaderStage stage)
 	{
 		// TODO: check if compute shader
-		GLenum shaderType = GL_COMPUTE_SHADER;
-		GL::Shader shader(shaderType);
-		if (shader.compile(code.c_str()))
-		{
-			program.attachShader(shader);
-		}
-		else
-		{
-			std::cout << "error compiling shader " << std::endl;
-			std::cout << shader.getErrorLog() << std::endl;
-		}
+		shaderSources.push_back(ShaderSource(GL_COMPUTE_SHADER, code));
 	}
 
 	void ComputePipeline::createProgram()
 	{
-		if (program.link())
+		if (buildProgram(program, shaderSources, programCache))
 		{
 			program.loadUniforms();
 		}
@@ -282,6 +320,7 @@ namespace GL
 			std::cout << "error linking shader program " << std::endl;
 			std::cout << program.getErrorLog() << std::endl;
 		}
+		shaderSources.clear();
 	}
 
 	void ComputePipeline::use()
@@ -289,7 +328,7 @@ namespace GL
 		program.use();
 	}
 
-	std::vector<int> ComputePipeline::getLayoutBindings(std::string name)
+	const std::vector<int>& ComputePipeline::getLayoutBindings(const std::string& name)
 	{
 		return layout[name];
 	}
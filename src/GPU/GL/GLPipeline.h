@@ -6,6 +6,7 @@
 #include <GPU/Pipeline.h>
 #include <GPU/GL/GLBuffer.h>
 #include <GPU/GL/GLProgram.h>
+#include <GPU/GL/GLProgramCache.h>
 #include <GPU/GL/GLDescriptorPool.h>
 #include <GPU/GL/GLSampler.h>
 #include <glm/glm.hpp>
@@ -13,10 +14,11 @@
 namespace GL
 {
 	GLenum getShaderType(GPU::ShaderStage stage);
+	bool buildProgram(Program& program, std::vector<ShaderSource>& sources, ProgramCache::Ptr programCache);
 	class GraphicsPipeline : public GPU::GraphicsPipeline
 	{
 	public:	
-		GraphicsPipeline(std::string name);
+		GraphicsPipeline(std::string name, ProgramCache::Ptr programCache);
 		~GraphicsPipeline();
 		void setVertexInputDescripton(GPU::VertexDescription& inputDescription);
 		void setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts);
@@ -32,16 +34,18 @@ namespace GL
 		void setWindingOrder(int frontFace);
 		void createProgram();
 		void use();
-		std::vector<int> getLayoutBindings(std::string name);
+		const std::vector<int>& getLayoutBindings(const std::string& name);
 
 		typedef std::shared_ptr<GraphicsPipeline> Ptr;
-		static Ptr create(std::string name)
+		static Ptr create(std::string name, ProgramCache::Ptr programCache)
 		{
-			return std::make_shared<GraphicsPipeline>(name);
+			return std::make_shared<GraphicsPipeline>(name, programCache);
 		}
 	private:
 		GLuint vao = 0;
 		GL::Program program;
+		ProgramCache::Ptr programCache;
+		std::vector<ShaderSource> shaderSources;
 		GL::Buffer::Ptr pushConstantUBO;
 		std::map<std::string, std::vector<int>> layout;
 
@@ -63,21 +67,23 @@ namespace GL
 	class ComputePipeline : public GPU::ComputePipeline
 	{
 	public:
-		ComputePipeline(std::string name);
+		ComputePipeline(std::string name, ProgramCache::Ptr programCache);
 		~ComputePipeline();
 		void setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts);
 		void addShaderStage(std::string code, GPU::ShaderStage stage);
 		void createProgram();
 		void use();
-		std::vector<int> getLayoutBindings(std::string name);
+		const std::vector<int>& getLayoutBindings(const std::string& name);
 		typedef std::shared_ptr<ComputePipeline> Ptr;
-		static Ptr create(std::string name)
+		static Ptr create(std::string name, ProgramCache::Ptr programCache)
 		{
-			return std::make_shared<ComputePipeline>(name);
+			return std::make_shared<ComputePipeline>(name, programCache);
 		}
 
 	private:
 		GL::Program program;
+		ProgramCache::Ptr programCache;
+		std::vector<ShaderSource> shaderSources;
 		std::map<std::string, std::vector<int>> layout;
 		ComputePipeline(const ComputePipeline&) = delete;
 		ComputePipeline& operator=(const ComputePipeline&) = delete;
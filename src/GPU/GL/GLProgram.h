@@ -4,6 +4,7 @@
 #pragma once
 
 #include "GLShader.h"
+#include <Platform/Types.h>
 #include <iostream>
 #include <map>
 #include <string>
@@ -48,6 +49,31 @@ namespace GL
 			return (status == GL_TRUE);
 		}
 
+		void setBinaryRetrievable()
+		{
+			glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+
+		bool loadBinary(GLenum format, const std::vector<uint8>& binary)
+		{
+			GLint status;
+			glProgramBinary(id, format, binary.data(), (GLsizei)binary.size());
+			glGetProgramiv(id, GL_LINK_STATUS, &status);
+			return (status == GL_TRUE);
+		}
+
+		bool getBinary(GLenum& format, std::vector<uint8>& binary)
+		{
+			GLint len = 0;
+			glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &len);
+			if (len <= 0)
+				return false;
+
+			binary.resize(len);
+			glGetProgramBinary(id, len, 0, &format, binary.data());
+			return true;
+		}
+
 		std::string getErrorLog() const
 		{
 			GLint len;
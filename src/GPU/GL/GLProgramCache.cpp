@@ -0,0 +1,120 @@
+#include "GLProgramCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace GL
+{
+	const uint32 programCacheMagic = 0x42505250; // "PRPB"
+
+	uint64 hashFNV1a(uint64 hash, const void* data, size_t size)
+	{
+		const uint8* bytes = static_cast<const uint8*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	ProgramCache::ProgramCache(const std::string& directory) :
+		directory(directory)
+	{
+		GLint numFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+		if (numFormats == 0)
+		{
+			std::cout << "program binaries not supported, shader cache disabled" << std::endl;
+			return;
+		}
+
+		std::error_code ec;
+		fs::create_directories(directory, ec);
+		if (ec)
+		{
+			std::cout << "error creating shader cache directory " << directory << std::endl;
+			return;
+		}
+
+		// binaries are only valid for the driver that created them
+		driverInfo += (const char*)glGetString(GL_VENDOR);
+		driverInfo += (const char*)glGetString(GL_RENDERER);
+		driverInfo += (const char*)glGetString(GL_VERSION);
+		enabled = true;
+	}
+
+	uint64 ProgramCache::computeKey(const std::vector<ShaderSource>& sources)
+	{
+		uint64 hash = 0xcbf29ce484222325ull;
+		hash = hashFNV1a(hash, driverInfo.data(), driverInfo.size());
+		for (auto& src : sources)
+		{
+			hash = hashFNV1a(hash, &src.type, sizeof(GLenum));
+			hash = hashFNV1a(hash, src.code.data(), src.code.size());
+		}
+		return hash;
+	}
+
+	bool ProgramCache::load(uint64 key, Program& program)
+	{
+		if (!enabled)
+			return false;
+
+		std::ifstream file(getFileName(key), std::ios::binary);
+		if (!file.is_open())
+			return false;
+
+		uint32 magic = 0;
+		uint32 format = 0;
+		uint32 size = 0;
+		file.read((char*)&magic, sizeof(uint32));
+		file.read((char*)&format, sizeof(uint32));
+		file.read((char*)&size, sizeof(uint32));
+		if (!file || magic != programCacheMagic)
+			return false;
+
+		std::vector<uint8> binary(size);
+		file.read((char*)binary.data(), size);
+		if (!file)
+			return false;
+
+		// a driver update can reject the binary, the program is recompiled in that case
+		return program.loadBinary(format, binary);
+	}
+
+	void ProgramCache::store(uint64 key, Program& program)
+	{
+		if (!enabled)
+			return;
+
+		GLenum format = 0;
+		std::vector<uint8> binary;
+		if (!program.getBinary(format, binary))
+			return;
+
+		std::ofstream file(getFileName(key), std::ios::binary);
+		if (!file.is_open())
+		{
+			std::cout << "error writing shader cache file " << getFileName(key) << std::endl;
+			return;
+		}
+
+		uint32 size = static_cast<uint32>(binary.size());
+		file.write((char*)&programCacheMagic, sizeof(uint32));
+		file.write((char*)&format, sizeof(uint32));
+		file.write((char*)&size, sizeof(uint32));
+		file.write((char*)binary.data(), size);
+	}
+
+	std::string ProgramCache::getFileName(uint64 key)
+	{
+		std::stringstream ss;
+		ss << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+		return ss.str();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef INCLUDED_GLPROGRAMCACHE
+#define INCLUDED_GLPROGRAMCACHE
+
+#pragma once
+
+#include <GPU/GL/GLPlatform.h>
+#include <GPU/GL/GLProgram.h>
+#include <Platform/Types.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GL
+{
+	struct ShaderSource
+	{
+		GLenum type;
+		std::string code;
+		ShaderSource(GLenum type, const std::string& code) : 
+			type(type),
+			code(code)
+		{
+
+		}
+	};
+
+	// Stores linked program binaries on disk. The key is a hash of the final shader sources
+	// (includes expanded and defines prepended) and the driver that produced the binary.
+	class ProgramCache
+	{
+	public:
+		ProgramCache(const std::string& directory);
+		uint64 computeKey(const std::vector<ShaderSource>& sources);
+		bool load(uint64 key, Program& program);
+		void store(uint64 key, Program& program);
+
+		typedef std::shared_ptr<ProgramCache> Ptr;
+		static Ptr create(const std::string& directory)
+		{
+			return std::make_shared<ProgramCache>(directory);
+		}
+	private:
+		std::string getFileName(uint64 key);
+
+		std::string directory;
+		std::string driverInfo;
+		bool enabled = false;
+
+		ProgramCache(const ProgramCache&) = delete;
+		ProgramCache& operator=(const ProgramCache&) = delete;
+	};
+}
+
+#endif // INCLUDED_GLPROGRAMCACHE
\ No newline at end of file
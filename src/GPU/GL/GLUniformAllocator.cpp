@@ -0,0 +1,66 @@
+#include "GLUniformAllocator.h"
+#include <iostream>
+
+namespace GL
+{
+	UniformAllocator::UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment) :
+		GPU::UniformAllocator(blockSize, maxBlocks, numFrames, alignment),
+		fences(numFrames, 0)
+	{
+		GLsizeiptr size = (GLsizeiptr)getFrameSize() * numFrames;
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+		glBufferStorage(GL_UNIFORM_BUFFER, size, NULL, flags);
+		data = static_cast<uint8*>(glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags));
+		if (data == nullptr)
+			std::cout << "error: could not map uniform buffer!" << std::endl;
+	}
+
+	UniformAllocator::~UniformAllocator()
+	{
+		for (auto fence : fences)
+			if (fence)
+				glDeleteSync(fence);
+		glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+		glUnmapBuffer(GL_UNIFORM_BUFFER);
+		glDeleteBuffers(1, &buffer);
+	}
+
+	GPU::Descriptor::Ptr UniformAllocator::getDescriptor()
+	{
+		return DynamicBufferDescriptor::create(buffer, this);
+	}
+
+	GLuint UniformAllocator::getID()
+	{
+		return buffer;
+	}
+
+	uint8* UniformAllocator::mapFrame(uint32 frame)
+	{
+		// all draws reading the previous segment are issued at this point
+		uint32 prevFrame = (frame + numFrames - 1) % numFrames;
+		if (fences[prevFrame])
+			glDeleteSync(fences[prevFrame]);
+		fences[prevFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		if (fences[frame])
+		{
+			GLenum result = glClientWaitSync(fences[frame], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED)
+				std::cout << "error: waiting for uniform buffer segment " << frame << " failed!" << std::endl;
+			glDeleteSync(fences[frame]);
+			fences[frame] = 0;
+		}
+
+		if (data == nullptr)
+			return nullptr;
+		return data + frame * getFrameSize();
+	}
+
+	void UniformAllocator::unmapFrame(uint32 frame, uint32 size)
+	{
+		// buffer is mapped coherent, nothing to flush
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef INCLUDED_GLUNIFORMALLOCATOR
+#define INCLUDED_GLUNIFORMALLOCATOR
+
+#pragma once
+
+#include <GPU/UniformAllocator.h>
+#include <GPU/GL/GLPlatform.h>
+#include <GPU/GL/GLDescriptor.h>
+
+namespace GL
+{
+	class UniformAllocator : public GPU::UniformAllocator
+	{
+	public:
+		UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment);
+		~UniformAllocator();
+		GPU::Descriptor::Ptr getDescriptor();
+		GLuint getID();
+
+		typedef std::shared_ptr<UniformAllocator> Ptr;
+		static Ptr create(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment)
+		{
+			return std::make_shared<UniformAllocator>(blockSize, maxBlocks, numFrames, alignment);
+		}
+
+	private:
+		uint8* mapFrame(uint32 frame);
+		void unmapFrame(uint32 frame, uint32 size);
+
+		uint8* data = nullptr;
+		GLuint buffer;
+		std::vector<GLsync> fences;
+
+		UniformAllocator(const UniformAllocator&) = delete;
+		UniformAllocator& operator=(const UniformAllocator&) = delete;
+	};
+}
+
+#endif // INCLUDED_GLUNIFORMALLOCATOR
\ No newline at end of file
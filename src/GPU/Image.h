@@ -40,6 +40,21 @@ namespace GPU
 		}
 	};
 
+	struct ImageRegion
+	{
+		uint32 srcX;
+		uint32 srcY;
+		uint32 dstX;
+		uint32 dstY;
+		uint32 width;
+		uint32 height;
+		ImageRegion(uint32 srcX, uint32 srcY, uint32 dstX, uint32 dstY, uint32 width, uint32 height) :
+			srcX(srcX), srcY(srcY), dstX(dstX), dstY(dstY), width(width), height(height)
+		{
+
+		}
+	};
+
 	struct ImageParameters
 	{
 		ViewType type = ViewType::View2D;
@@ -76,6 +91,11 @@ namespace GPU
 		virtual void uploadData(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize, uint32 layer, uint32 level) = 0;
 		virtual void uploadArray(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize) = 0;
 		virtual void generateMipmaps(GPU::CommandBuffer::Ptr cmdBuf) = 0;
+		// copies level 0 of the given layers into an image of the same size and format,
+		// afterwards the destination layers can be loaded by a render pass without clearing
+		virtual void copyLayers(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<Image> dstImage, uint32 baseLayer, uint32 layerCount) = 0;
+		// same as copyLayers for rectangles of level 0 in the first layer
+		virtual void copyRegions(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<Image> dstImage, const std::vector<ImageRegion>& regions) = 0;
 		virtual void setImageLayout() = 0;
 		virtual void layoutTransitionShader(GPU::CommandBuffer::Ptr cmdBuf) = 0;
 		virtual void layoutTransitionStorage(GPU::CommandBuffer::Ptr cmdBuf) = 0;
@@ -0,0 +1,47 @@
+#include "NullBuffer.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace Null
+{
+	Buffer::Buffer(GPU::BufferUsage usage, uint32 size, uint32 stride) :
+		GPU::Buffer(usage, size, stride),
+		storage(size, 0)
+	{
+
+	}
+
+	Buffer::~Buffer()
+	{
+
+	}
+
+	void Buffer::uploadMapped(void* data)
+	{
+		std::memcpy(storage.data(), data, size);
+		numUploads++;
+	}
+
+	void Buffer::uploadStaged(void* data)
+	{
+		std::memcpy(storage.data(), data, size);
+		numUploads++;
+	}
+
+	void Buffer::uploadStaged(void* data, uint32 offset, uint32 byteCount)
+	{
+		if (offset + byteCount > size)
+		{
+			std::cout << "error: buffer upload out of range" << std::endl;
+			return;
+		}
+		std::memcpy(storage.data() + offset, data, byteCount);
+		numUploads++;
+	}
+
+	GPU::Descriptor::Ptr Buffer::getDescriptor()
+	{
+		return BufferDescriptor::create(storage.data(), size);
+	}
+}
\ No newline at end of file
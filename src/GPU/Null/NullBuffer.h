@@ -0,0 +1,39 @@
+#ifndef INCLUDED_NULLBUFFER
+#define INCLUDED_NULLBUFFER
+
+#pragma once
+
+#include <GPU/Buffer.h>
+#include <GPU/Null/NullDescriptor.h>
+
+namespace Null
+{
+	class Buffer : public GPU::Buffer
+	{
+	public:
+		Buffer(GPU::BufferUsage usage, uint32 size, uint32 stride);
+		~Buffer();
+		void uploadMapped(void* data);
+		void uploadStaged(void* data);
+		void uploadStaged(void* data, uint32 offset, uint32 byteCount);
+		uint8* getMappedPointer() { return storage.data(); }
+		GPU::Descriptor::Ptr getDescriptor();
+		GPU::BufferUsage getUsage() { return usage; }
+		uint32 getNumUploads() { return numUploads; }
+
+		typedef std::shared_ptr<Buffer> Ptr;
+		static Ptr create(GPU::BufferUsage usage, uint32 size, uint32 stride)
+		{
+			return std::make_shared<Buffer>(usage, size, stride);
+		}
+
+	private:
+		std::vector<uint8> storage;
+		uint32 numUploads = 0;
+
+		Buffer(const Buffer&) = delete;
+		Buffer& operator=(const Buffer&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLBUFFER
\ No newline at end of file
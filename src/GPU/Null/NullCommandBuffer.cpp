@@ -0,0 +1,189 @@
+#include "NullCommandBuffer.h"
+
+#include <cstring>
+
+namespace Null
+{
+	static uint32 floatBits(float f)
+	{
+		uint32 bits;
+		std::memcpy(&bits, &f, sizeof(float));
+		return bits;
+	}
+
+	CommandBuffer::CommandBuffer()
+	{
+
+	}
+
+	CommandBuffer::~CommandBuffer()
+	{
+
+	}
+
+	void CommandBuffer::record(CommandType type, const void* object, uint32 a0, uint32 a1, uint32 a2, uint32 a3, uint32 a4)
+	{
+		Command cmd;
+		cmd.type = type;
+		cmd.object = object;
+		cmd.args[0] = a0;
+		cmd.args[1] = a1;
+		cmd.args[2] = a2;
+		cmd.args[3] = a3;
+		cmd.args[4] = a4;
+		commands.push_back(cmd);
+		stats.numCommands++;
+	}
+
+	void CommandBuffer::begin()
+	{
+		// keep the allocations around, buffers are re-recorded every frame
+		commands.clear();
+		payload.clear();
+		stats = CommandStats();
+		recording = true;
+		for (uint32 i = 0; i < GPU::maxVertexBindings; i++)
+			boundVertexBuffers[i] = nullptr;
+		boundIndexBuffer = nullptr;
+	}
+
+	void CommandBuffer::end()
+	{
+		recording = false;
+	}
+
+	void CommandBuffer::beginRenderPass(GPU::Framebuffer::Ptr framebuffer)
+	{
+		record(CommandType::BeginRenderPass, framebuffer.get(), framebuffer->getWidth(), framebuffer->getHeight());
+		stats.numRenderPasses++;
+	}
+
+	void CommandBuffer::endRenderPass()
+	{
+		record(CommandType::EndRenderPass, nullptr);
+	}
+
+	void CommandBuffer::setViewport(float x, float y, float width, float height)
+	{
+		record(CommandType::SetViewport, nullptr, floatBits(x), floatBits(y), floatBits(width), floatBits(height));
+	}
+
+	void CommandBuffer::setScissor(int32 x, int32 y, uint32 width, uint32 height)
+	{
+		record(CommandType::SetScissor, nullptr, (uint32)x, (uint32)y, width, height);
+	}
+
+	void CommandBuffer::bindPipeline(GPU::GraphicsPipeline::Ptr pipeline)
+	{
+		record(CommandType::BindGraphicsPipeline, pipeline.get());
+		stats.numPipelineBinds++;
+	}
+
+	void CommandBuffer::bindPipeline(GPU::ComputePipeline::Ptr pipeline)
+	{
+		record(CommandType::BindComputePipeline, pipeline.get());
+		stats.numPipelineBinds++;
+	}
+
+	void CommandBuffer::pushConstants(GPU::GraphicsPipeline::Ptr pipeline, GPU::ShaderStage stage, uint32 offset, uint32 size, const void* values)
+	{
+		uint32 payloadOffset = (uint32)payload.size();
+		const uint8* bytes = static_cast<const uint8*>(values);
+		payload.insert(payload.end(), bytes, bytes + size);
+		record(CommandType::PushConstants, pipeline.get(), offset, size, payloadOffset, (uint32)stage);
+		stats.numPushConstants++;
+	}
+
+	void CommandBuffer::bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet)
+	{
+		record(CommandType::BindDescriptorSets, descriptorSet.get(), firstSet);
+		stats.numDescriptorSetBinds++;
+	}
+
+	void CommandBuffer::bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset)
+	{
+		record(CommandType::BindDescriptorSets, descriptorSet.get(), firstSet, dynamicOffset);
+		stats.numDescriptorSetBinds++;
+	}
+
+	void CommandBuffer::bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet)
+	{
+		record(CommandType::BindDescriptorSets, descriptorSet.get(), firstSet);
+		stats.numDescriptorSetBinds++;
+	}
+
+	void CommandBuffer::bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer)
+	{
+		bindVertexBuffers(0, vertexBuffer);
+	}
+
+	void CommandBuffer::bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer)
+	{
+		// the same redundant bind filtering as the GL backend, so the stats match
+		if (vertexBuffer.get() == boundVertexBuffers[binding])
+			return;
+
+		boundVertexBuffers[binding] = vertexBuffer.get();
+		record(CommandType::BindVertexBuffers, vertexBuffer.get(), vertexBuffer->getStride(), binding);
+		stats.numBufferBinds++;
+	}
+
+	void CommandBuffer::bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType)
+	{
+		if (indexBuffer.get() == boundIndexBuffer)
+			return;
+
+		boundIndexBuffer = indexBuffer.get();
+		record(CommandType::BindIndexBuffers, indexBuffer.get(), (uint32)indexType);
+		stats.numBufferBinds++;
+	}
+
+	void CommandBuffer::setCullMode(int mode)
+	{
+		record(CommandType::SetCullMode, nullptr, (uint32)mode);
+	}
+
+	void CommandBuffer::drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
+	{
+		record(CommandType::DrawIndexed, nullptr, indexCount, firstIndex, (uint32)baseVertex, (uint32)topology);
+		stats.numDrawCalls++;
+		stats.numVertices += indexCount;
+	}
+
+	void CommandBuffer::drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset)
+	{
+		record(CommandType::DrawIndexed, nullptr, indexCount, indexOffset, vertexOffset);
+		stats.numDrawCalls++;
+		stats.numVertices += indexCount;
+	}
+
+	void CommandBuffer::drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
+	{
+		record(CommandType::DrawIndexedInstanced, nullptr, indexCount, instanceCount, firstIndex, (uint32)baseVertex, (uint32)topology);
+		stats.numDrawCalls++;
+		stats.numVertices += indexCount * instanceCount;
+	}
+
+	void CommandBuffer::drawArrays(uint32 vertexCount, uint32 firstVertex)
+	{
+		record(CommandType::DrawArrays, nullptr, vertexCount, firstVertex);
+		stats.numDrawCalls++;
+		stats.numVertices += vertexCount;
+	}
+
+	void CommandBuffer::dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ)
+	{
+		record(CommandType::DispatchCompute, nullptr, grpCountX, grpCountY, grpCountZ);
+		stats.numDispatches++;
+	}
+
+	void CommandBuffer::pipelineBarrier()
+	{
+		record(CommandType::PipelineBarrier, nullptr);
+	}
+
+	void CommandBuffer::flush()
+	{
+		// nothing to execute, the recorded stream is kept for inspection until the next begin()
+	}
+}
\ No newline at end of file
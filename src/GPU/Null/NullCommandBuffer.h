@@ -0,0 +1,127 @@
+#ifndef INCLUDED_NULLCOMMANDBUFFER
+#define INCLUDED_NULLCOMMANDBUFFER
+
+#pragma once
+
+#include <GPU/CommandBuffer.h>
+#include <GPU/Null/NullBuffer.h>
+#include <GPU/Null/NullPipeline.h>
+#include <GPU/Null/NullDescriptorSet.h>
+#include <GPU/Null/NullFramebuffer.h>
+
+namespace Null
+{
+	enum class CommandType
+	{
+		BeginRenderPass,
+		EndRenderPass,
+		SetViewport,
+		SetScissor,
+		BindGraphicsPipeline,
+		BindComputePipeline,
+		PushConstants,
+		BindDescriptorSets,
+		BindVertexBuffers,
+		BindIndexBuffers,
+		SetCullMode,
+		DrawIndexed,
+		DrawIndexedInstanced,
+		DrawArrays,
+		DispatchCompute,
+		PipelineBarrier
+	};
+
+	// Plain record of one recorded call. 'object' points at the bound resource
+	// (framebuffer, pipeline, set, buffer), args hold the integer/float parameters
+	// and push constant data lives in the command buffers payload array.
+	struct Command
+	{
+		CommandType type;
+		const void* object = nullptr;
+		uint32 args[5] = { 0, 0, 0, 0, 0 };
+	};
+
+	struct CommandStats
+	{
+		uint32 numCommands = 0;
+		uint32 numRenderPasses = 0;
+		uint32 numPipelineBinds = 0;
+		uint32 numDescriptorSetBinds = 0;
+		uint32 numBufferBinds = 0;
+		uint32 numPushConstants = 0;
+		uint32 numDrawCalls = 0;
+		uint32 numDispatches = 0;
+		uint32 numVertices = 0;
+
+		CommandStats& operator+= (const CommandStats& s)
+		{
+			numCommands += s.numCommands;
+			numRenderPasses += s.numRenderPasses;
+			numPipelineBinds += s.numPipelineBinds;
+			numDescriptorSetBinds += s.numDescriptorSetBinds;
+			numBufferBinds += s.numBufferBinds;
+			numPushConstants += s.numPushConstants;
+			numDrawCalls += s.numDrawCalls;
+			numDispatches += s.numDispatches;
+			numVertices += s.numVertices;
+			return *this;
+		}
+	};
+
+	class CommandBuffer : public GPU::CommandBuffer
+	{
+	public:
+		CommandBuffer();
+		~CommandBuffer();
+
+		void begin();
+		void end();
+		void beginRenderPass(GPU::Framebuffer::Ptr framebuffer);
+		void endRenderPass();
+		void setViewport(float x, float y, float width, float height);
+		void setScissor(int32 x, int32 y, uint32 width, uint32 height);
+		void bindPipeline(GPU::GraphicsPipeline::Ptr pipeline);
+		void bindPipeline(GPU::ComputePipeline::Ptr pipeline);
+		void pushConstants(GPU::GraphicsPipeline::Ptr pipeline, GPU::ShaderStage stage, uint32 offset, uint32 size, const void* values);
+		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
+		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset);
+		void bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
+		void bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer);
+		void bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer);
+		void bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType);
+		void setCullMode(int mode);
+		void drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
+		void drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset);
+		void drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
+		void drawArrays(uint32 vertexCount, uint32 firstVertex);
+		void dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ);
+		void pipelineBarrier();
+		void flush();
+
+		const std::vector<Command>& getCommands() { return commands; }
+		const uint8* getPayload(const Command& cmd) { return payload.data() + cmd.args[2]; }
+		CommandStats getStats() { return stats; }
+		bool isRecording() { return recording; }
+
+		typedef std::shared_ptr<CommandBuffer> Ptr;
+		static Ptr create()
+		{
+			return std::make_shared<CommandBuffer>();
+		}
+
+	private:
+		void record(CommandType type, const void* object, uint32 a0 = 0, uint32 a1 = 0, uint32 a2 = 0, uint32 a3 = 0, uint32 a4 = 0);
+
+		std::vector<Command> commands;
+		std::vector<uint8> payload;
+		CommandStats stats;
+		bool recording = false;
+		const void* boundVertexBuffers[GPU::maxVertexBindings] = {};
+		const void* boundIndexBuffer = nullptr;
+
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLCOMMANDBUFFER
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "NullContext.h"
+
+namespace Null
+{
+	Context::Context()
+	{
+
+	}
+
+	Context::~Context()
+	{
+
+	}
+
+	GPU::Buffer::Ptr Context::createBuffer(GPU::BufferUsage usage, uint32 size, uint32 stride)
+	{
+		bufferMemory += size;
+		return Buffer::create(usage, size, stride);
+	}
+
+	GPU::CommandBuffer::Ptr Context::allocateCommandBuffer()
+	{
+		return CommandBuffer::create();
+	}
+
+	GPU::ComputePipeline::Ptr Context::createComputePipeline(std::string name)
+	{
+		return ComputePipeline::create(name);
+	}
+
+	GPU::DescriptorPool::Ptr Context::createDescriptorPool()
+	{
+		return DescriptorPool::create();
+	}
+
+	GPU::Framebuffer::Ptr Context::createFramebuffer(uint32 width, uint32 height, uint32 layers, bool offscreen, bool clear)
+	{
+		return Framebuffer::create(width, height, clear);
+	}
+
+	GPU::GraphicsPipeline::Ptr Context::createGraphicsPipeline(GPU::Framebuffer::Ptr framebuffer, std::string name, int numAttachments)
+	{
+		return GraphicsPipeline::create(name);
+	}
+
+	GPU::Image::Ptr Context::createImage(GPU::ImageParameters params)
+	{
+		return Image::create(params);
+	}
+
+	GPU::ImageDescriptor::Ptr Context::createImageDescriptor(GPU::Image::Ptr image, GPU::ImageView::Ptr view, GPU::Sampler::Ptr sampler)
+	{
+		return ImageDescriptor::create(image.get(), view.get(), sampler.get());
+	}
+
+	GPU::Sampler::Ptr Context::createSampler(uint32 levels)
+	{
+		return Sampler::create(levels);
+	}
+
+	GPU::Swapchain::Ptr Context::createSwapchain(Window::Ptr window)
+	{
+		return Swapchain::create(window->getWidth(), window->getHeight());
+	}
+
+	GPU::Swapchain::Ptr Context::createSwapchain(uint32 width, uint32 height)
+	{
+		return Swapchain::create(width, height);
+	}
+
+	GPU::UniformAllocator::Ptr Context::createUniformAllocator(uint32 blockSize, uint32 maxBlocks)
+	{
+		auto allocator = UniformAllocator::create(blockSize, maxBlocks, 3, 256);
+		bufferMemory += allocator->getFrameSize() * allocator->getNumFrames();
+		return allocator;
+	}
+
+	void Context::submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf)
+	{
+		submit(nextCmdBuf);
+	}
+
+	void Context::submitCommandBuffer(GPU::CommandBuffer::Ptr prevCmdBuf, GPU::CommandBuffer::Ptr nextCmdBuf)
+	{
+		submit(nextCmdBuf);
+	}
+
+	void Context::submit(GPU::CommandBuffer::Ptr cmdBuf)
+	{
+		auto nullCmdBuf = std::dynamic_pointer_cast<CommandBuffer>(cmdBuf);
+		nullCmdBuf->flush();
+		submittedStats += nullCmdBuf->getStats();
+		numSubmits++;
+	}
+
+	void Context::resetStats()
+	{
+		submittedStats = CommandStats();
+		numSubmits = 0;
+	}
+}
\ No newline at end of file
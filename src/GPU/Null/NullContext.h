@@ -0,0 +1,67 @@
+#ifndef INCLUDED_NULLCONTEXT
+#define INCLUDED_NULLCONTEXT
+
+#pragma once
+
+#include <Platform/Window.h>
+#include <GPU/Context.h>
+#include <GPU/Null/NullBuffer.h>
+#include <GPU/Null/NullCommandBuffer.h>
+#include <GPU/Null/NullDescriptorPool.h>
+#include <GPU/Null/NullPipeline.h>
+#include <GPU/Null/NullImage.h>
+#include <GPU/Null/NullImageView.h>
+#include <GPU/Null/NullSampler.h>
+#include <GPU/Null/NullSwapchain.h>
+#include <GPU/Null/NullUniformAllocator.h>
+#include <GPU/Enums.h>
+
+namespace Null
+{
+	// Headless backend: resources live in CPU memory and command buffers only
+	// record, so the CPU side of a frame can be measured without a window or GPU.
+	class Context : public GPU::Context
+	{
+	public:
+		Context();
+		~Context();
+		GPU::Buffer::Ptr createBuffer(GPU::BufferUsage usage, uint32 size, uint32 stride);
+		GPU::CommandBuffer::Ptr allocateCommandBuffer();
+		GPU::ComputePipeline::Ptr createComputePipeline(std::string name);
+		GPU::DescriptorPool::Ptr createDescriptorPool();
+		GPU::Framebuffer::Ptr createFramebuffer(uint32 width, uint32 height, uint32 layers, bool offscreen, bool clear);
+		GPU::GraphicsPipeline::Ptr createGraphicsPipeline(GPU::Framebuffer::Ptr framebuffer, std::string name, int numAttachments);
+		GPU::Image::Ptr createImage(GPU::ImageParameters params);
+		GPU::ImageDescriptor::Ptr createImageDescriptor(GPU::Image::Ptr image, GPU::ImageView::Ptr view, GPU::Sampler::Ptr sampler);
+		GPU::Sampler::Ptr createSampler(uint32 levels);
+		GPU::Swapchain::Ptr createSwapchain(Window::Ptr window);
+		GPU::Swapchain::Ptr createSwapchain(uint32 width, uint32 height);
+		GPU::UniformAllocator::Ptr createUniformAllocator(uint32 blockSize, uint32 maxBlocks);
+		void submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf);
+		void submitCommandBuffer(GPU::CommandBuffer::Ptr prevCmdBuf, GPU::CommandBuffer::Ptr nextCmdBuf);
+		void waitDeviceIdle() {}
+
+		CommandStats getSubmittedStats() { return submittedStats; }
+		uint32 getNumSubmits() { return numSubmits; }
+		uint32 getBufferMemory() { return bufferMemory; }
+		void resetStats();
+
+		typedef std::shared_ptr<Context> Ptr;
+		static Ptr create()
+		{
+			return std::make_shared<Context>();
+		}
+
+	private:
+		void submit(GPU::CommandBuffer::Ptr cmdBuf);
+
+		CommandStats submittedStats;
+		uint32 numSubmits = 0;
+		uint32 bufferMemory = 0;
+
+		Context(const Context&) = delete;
+		Context& operator=(const Context&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLCONTEXT
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "NullDescriptor.h"
+
+namespace Null
+{
+	BufferDescriptor::BufferDescriptor(uint8* data, uint32 size) :
+		data(data),
+		size(size)
+	{
+
+	}
+
+	uint8* BufferDescriptor::getData()
+	{
+		return data;
+	}
+
+	uint32 BufferDescriptor::getSize()
+	{
+		return size;
+	}
+
+	ImageDescriptor::ImageDescriptor(const void* image, const void* imageView, const void* sampler) :
+		image(image),
+		imageView(imageView),
+		sampler(sampler)
+	{
+
+	}
+
+	const void* ImageDescriptor::getImage()
+	{
+		return image;
+	}
+
+	const void* ImageDescriptor::getImageView()
+	{
+		return imageView;
+	}
+
+	const void* ImageDescriptor::getSampler()
+	{
+		return sampler;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef INCLUDED_NULLDESCRIPTOR
+#define INCLUDED_NULLDESCRIPTOR
+
+#pragma once
+
+#include <GPU/Descriptor.h>
+#include <Platform/Types.h>
+
+namespace Null
+{
+	class BufferDescriptor : public GPU::BufferDescriptor
+	{
+	public:
+		BufferDescriptor(uint8* data, uint32 size);
+		uint8* getData();
+		uint32 getSize();
+
+		typedef std::shared_ptr<BufferDescriptor> Ptr;
+		static Ptr create(uint8* data, uint32 size)
+		{
+			return std::make_shared<BufferDescriptor>(data, size);
+		}
+
+	private:
+		uint8* data;
+		uint32 size;
+	};
+
+	class ImageDescriptor : public GPU::ImageDescriptor
+	{
+	public:
+		ImageDescriptor(const void* image, const void* imageView, const void* sampler);
+		const void* getImage();
+		const void* getImageView();
+		const void* getSampler();
+
+		typedef std::shared_ptr<ImageDescriptor> Ptr;
+		static Ptr create(const void* image, const void* imageView, const void* sampler)
+		{
+			return std::make_shared<ImageDescriptor>(image, imageView, sampler);
+		}
+
+	private:
+		const void* image;
+		const void* imageView;
+		const void* sampler;
+	};
+}
+
+#endif // INCLUDED_NULLDESCRIPTOR
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "NullDescriptorPool.h"
+
+#include <iostream>
+
+namespace Null
+{
+	DescriptorPool::DescriptorPool()
+	{
+
+	}
+
+	DescriptorPool::~DescriptorPool()
+	{
+
+	}
+
+	void DescriptorPool::addDescriptorSetLayout(std::string name, std::vector<GPU::DescriptorSetLayoutBinding>& bindings)
+	{
+		setBindings[name] = bindings;
+	}
+
+	GPU::DescriptorSet::Ptr DescriptorPool::createDescriptorSet(std::string name, uint32 count)
+	{
+		if (setBindings.find(name) == setBindings.end())
+			std::cout << "error: no descriptor set layout " << name << std::endl;
+		return DescriptorSet::create(name, setBindings[name]);
+	}
+
+	std::vector<GPU::DescriptorSetLayoutBinding> DescriptorPool::getLayout(std::string name)
+	{
+		return setBindings[name];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef INCLUDED_NULLDESCRIPTORPOOL
+#define INCLUDED_NULLDESCRIPTORPOOL
+
+#pragma once
+
+#include <GPU/DescriptorPool.h>
+#include <GPU/Null/NullDescriptorSet.h>
+
+namespace Null
+{
+	class DescriptorPool : public GPU::DescriptorPool
+	{
+	public:
+		DescriptorPool();
+		~DescriptorPool();
+		void addDescriptorSetLayout(std::string name, std::vector<GPU::DescriptorSetLayoutBinding>& bindings);
+		GPU::DescriptorSet::Ptr createDescriptorSet(std::string name, uint32 count);
+		std::vector<GPU::DescriptorSetLayoutBinding> getLayout(std::string name);
+
+		typedef std::shared_ptr<DescriptorPool> Ptr;
+		static Ptr create()
+		{
+			return std::make_shared<DescriptorPool>();
+		}
+
+	private:
+		std::map<std::string, std::vector<GPU::DescriptorSetLayoutBinding>> setBindings;
+
+		DescriptorPool(const DescriptorPool&) = delete;
+		DescriptorPool& operator=(const DescriptorPool&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLDESCRIPTORPOOL
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "NullDescriptorSet.h"
+
+namespace Null
+{
+	DescriptorSet::DescriptorSet(std::string layoutName, std::vector<GPU::DescriptorSetLayoutBinding>& dslb) :
+		layoutName(layoutName),
+		dslb(dslb)
+	{
+
+	}
+
+	DescriptorSet::~DescriptorSet()
+	{
+
+	}
+
+	void DescriptorSet::update()
+	{
+		numUpdates++;
+	}
+
+	void DescriptorSet::updateVariable()
+	{
+		numUpdates++;
+	}
+
+	std::string DescriptorSet::getLayoutName()
+	{
+		return layoutName;
+	}
+
+	uint32 DescriptorSet::getNumDescriptors()
+	{
+		return (uint32)descriptors.size();
+	}
+
+	uint32 DescriptorSet::getNumUpdates()
+	{
+		return numUpdates;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef INCLUDED_NULLDESCRIPTORSET
+#define INCLUDED_NULLDESCRIPTORSET
+
+#pragma once
+
+#include <GPU/DescriptorPool.h>
+#include <GPU/Null/NullDescriptor.h>
+
+namespace Null
+{
+	class DescriptorSet : public GPU::DescriptorSet
+	{
+	public:
+		DescriptorSet(std::string layoutName, std::vector<GPU::DescriptorSetLayoutBinding>& dslb);
+		~DescriptorSet();
+
+		void update();
+		void updateVariable();
+		void addDescriptor(GPU::Descriptor::Ptr descriptor)
+		{
+			descriptors.push_back(descriptor);
+		}
+		std::string getLayoutName();
+		uint32 getNumDescriptors();
+		uint32 getNumUpdates();
+
+		typedef std::shared_ptr<DescriptorSet> Ptr;
+		static Ptr create(std::string layoutName, std::vector<GPU::DescriptorSetLayoutBinding>& dslb)
+		{
+			return std::make_shared<DescriptorSet>(layoutName, dslb);
+		}
+
+	private:
+		std::string layoutName;
+		std::vector<GPU::DescriptorSetLayoutBinding> dslb;
+		uint32 numUpdates = 0;
+
+		DescriptorSet(const DescriptorSet&) = delete;
+		DescriptorSet& operator=(const DescriptorSet&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLDESCRIPTORSET
\ No newline at end of file
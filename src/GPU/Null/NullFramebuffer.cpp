@@ -0,0 +1,57 @@
+#include "NullFramebuffer.h"
+
+namespace Null
+{
+	Framebuffer::Framebuffer(uint32 width, uint32 height, bool clear) :
+		width(width),
+		height(height),
+		clear(clear)
+	{
+
+	}
+
+	Framebuffer::~Framebuffer()
+	{
+
+	}
+
+	void Framebuffer::addAttachment(GPU::ImageView::Ptr imageView)
+	{
+		attachments.push_back(imageView);
+	}
+
+	void Framebuffer::createFramebuffer()
+	{
+
+	}
+
+	void Framebuffer::setClearColor(glm::vec4 color)
+	{
+		clearColor = color;
+	}
+
+	uint32 Framebuffer::getWidth()
+	{
+		return width;
+	}
+
+	uint32 Framebuffer::getHeight()
+	{
+		return height;
+	}
+
+	glm::vec4 Framebuffer::getClearColor()
+	{
+		return clearColor;
+	}
+
+	uint32 Framebuffer::getNumAttachments()
+	{
+		return (uint32)attachments.size();
+	}
+
+	bool Framebuffer::clearOnLoad()
+	{
+		return clear;
+	}
+}
\ No newline at end of file
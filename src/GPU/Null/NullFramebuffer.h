@@ -0,0 +1,44 @@
+#ifndef INCLUDED_NULLFRAMEBUFFER
+#define INCLUDED_NULLFRAMEBUFFER
+
+#pragma once
+
+#include <GPU/Framebuffer.h>
+#include <Platform/Types.h>
+#include <vector>
+
+namespace Null
+{
+	class Framebuffer : public GPU::Framebuffer
+	{
+	public:
+		Framebuffer(uint32 width, uint32 height, bool clear);
+		~Framebuffer();
+		void addAttachment(GPU::ImageView::Ptr imageView);
+		void createFramebuffer();
+		void setClearColor(glm::vec4 color);
+		uint32 getWidth();
+		uint32 getHeight();
+		glm::vec4 getClearColor();
+		uint32 getNumAttachments();
+		bool clearOnLoad();
+
+		typedef std::shared_ptr<Framebuffer> Ptr;
+		static Ptr create(uint32 width, uint32 height, bool clear)
+		{
+			return std::make_shared<Framebuffer>(width, height, clear);
+		}
+
+	private:
+		std::vector<GPU::ImageView::Ptr> attachments;
+		uint32 width;
+		uint32 height;
+		glm::vec4 clearColor = glm::vec4(0, 0, 0, 1);
+		bool clear = true;
+
+		Framebuffer(const Framebuffer&) = delete;
+		Framebuffer& operator=(const Framebuffer&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLFRAMEBUFFER
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "NullImage.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace Null
+{
+	Image::Image(GPU::ImageParameters params) :
+		GPU::Image(params)
+	{
+		if (type == GPU::ViewType::ViewCubeMap)
+			layers = 6;
+	}
+
+	Image::~Image()
+	{
+
+	}
+
+	void Image::uploadData(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize, uint32 layer, uint32 level)
+	{
+		if (layer >= layers || level >= levels)
+		{
+			std::cout << "error: image upload out of range (layer " << layer << ", level " << level << ")" << std::endl;
+			return;
+		}
+
+		uint32 index = layer * levels + level;
+		subResources[index].assign(data, data + dataSize);
+	}
+
+	void Image::uploadArray(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize)
+	{
+		uint32 layerSize = dataSize / layers;
+		for (uint32 layer = 0; layer < layers; layer++)
+			uploadData(cmdBuf, data + layer * layerSize, layerSize, layer, 0);
+	}
+
+	void Image::generateMipmaps(GPU::CommandBuffer::Ptr cmdBuf)
+	{
+
+	}
+
+	void Image::copyLayers(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount)
+	{
+		auto dst = std::dynamic_pointer_cast<Image>(dstImage);
+		for (uint32 layer = baseLayer; layer < baseLayer + layerCount; layer++)
+		{
+			auto it = subResources.find(layer * levels);
+			if (it != subResources.end())
+				dst->subResources[layer * dst->levels] = it->second;
+			else
+				dst->subResources.erase(layer * dst->levels);
+		}
+	}
+
+	void Image::copyRegions(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, const std::vector<GPU::ImageRegion>& regions)
+	{
+		auto dst = std::dynamic_pointer_cast<Image>(dstImage);
+		auto it = subResources.find(0);
+		if (it == subResources.end())
+			return;
+
+		auto& srcData = it->second;
+		uint32 srcPixels = extent.width * extent.height;
+		uint32 pixelSize = srcPixels > 0 ? static_cast<uint32>(srcData.size()) / srcPixels : 0;
+		auto& dstData = dst->subResources[0];
+		dstData.resize(dst->extent.width * dst->extent.height * pixelSize);
+		for (auto& r : regions)
+		{
+			for (uint32 y = 0; y < r.height; y++)
+			{
+				uint32 srcOffset = ((r.srcY + y) * extent.width + r.srcX) * pixelSize;
+				uint32 dstOffset = ((r.dstY + y) * dst->extent.width + r.dstX) * pixelSize;
+				std::memcpy(dstData.data() + dstOffset, srcData.data() + srcOffset, r.width * pixelSize);
+			}
+		}
+	}
+
+	void Image::setImageLayout()
+	{
+
+	}
+
+	void Image::layoutTransitionShader(GPU::CommandBuffer::Ptr cmdBuf)
+	{
+
+	}
+
+	void Image::layoutTransitionStorage(GPU::CommandBuffer::Ptr cmdBuf)
+	{
+
+	}
+
+	GPU::ImageView::Ptr Image::createImageView()
+	{
+		GPU::SubResourceRange range(0, 0, levels, layers);
+		return ImageView::create(this, type, format, range);
+	}
+
+	GPU::ImageView::Ptr Image::createImageView(GPU::ViewType viewType, GPU::SubResourceRange range)
+	{
+		return ImageView::create(this, viewType, format, range);
+	}
+
+	uint8* Image::getData(uint32 layer, uint32 level)
+	{
+		uint32 index = layer * levels + level;
+		if (subResources.find(index) == subResources.end())
+			return nullptr;
+		return subResources[index].data();
+	}
+
+	uint32 Image::getMemorySize()
+	{
+		uint32 size = 0;
+		for (auto& [index, data] : subResources)
+			size += (uint32)data.size();
+		return size;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef INCLUDED_NULLIMAGE
+#define INCLUDED_NULLIMAGE
+
+#pragma once
+#include <GPU/Image.h>
+#include <GPU/Null/NullImageView.h>
+#include <map>
+
+namespace Null
+{
+	class Image : public GPU::Image
+	{
+	public:
+		Image(GPU::ImageParameters params);
+		~Image();
+		void uploadData(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize, uint32 layer, uint32 level);
+		void uploadArray(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize);
+		void generateMipmaps(GPU::CommandBuffer::Ptr cmdBuf);
+		void copyLayers(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount);
+		void copyRegions(GPU::CommandBuffer::Ptr cmdBuf, std::shared_ptr<GPU::Image> dstImage, const std::vector<GPU::ImageRegion>& regions);
+		void setImageLayout();
+		void layoutTransitionShader(GPU::CommandBuffer::Ptr cmdBuf);
+		void layoutTransitionStorage(GPU::CommandBuffer::Ptr cmdBuf);
+		GPU::ImageView::Ptr createImageView();
+		GPU::ImageView::Ptr createImageView(GPU::ViewType viewType, GPU::SubResourceRange range);
+		uint8* getData(uint32 layer, uint32 level);
+		uint32 getMemorySize();
+
+		typedef std::shared_ptr<Image> Ptr;
+		static Ptr create(GPU::ImageParameters params)
+		{
+			return std::make_shared<Image>(params);
+		}
+
+	private:
+		// subresources are only allocated once data is uploaded, render targets never touch CPU memory
+		std::map<uint32, std::vector<uint8>> subResources;
+
+		Image(const Image&) = delete;
+		Image& operator=(const Image&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLIMAGE
\ No newline at end of file
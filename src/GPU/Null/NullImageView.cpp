@@ -0,0 +1,27 @@
+#include "NullImageView.h"
+
+namespace Null
+{
+	ImageView::ImageView(const void* parentImage, GPU::ViewType type, GPU::Format format, GPU::SubResourceRange& subRange) :
+		GPU::ImageView(format, subRange),
+		image(parentImage),
+		type(type)
+	{
+
+	}
+
+	ImageView::~ImageView()
+	{
+
+	}
+
+	const void* ImageView::getImage()
+	{
+		return image;
+	}
+
+	GPU::ViewType ImageView::getViewType()
+	{
+		return type;
+	}
+}
\ No newline at end of file
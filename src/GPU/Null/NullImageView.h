@@ -0,0 +1,33 @@
+#ifndef INCLUDED_NULLIMAGEVIEW
+#define INCLUDED_NULLIMAGEVIEW
+
+#pragma once
+
+#include <GPU/ImageView.h>
+
+namespace Null
+{
+	class ImageView : public GPU::ImageView
+	{
+	public:
+		ImageView(const void* parentImage, GPU::ViewType type, GPU::Format format, GPU::SubResourceRange& subRange);
+		~ImageView();
+		const void* getImage();
+		GPU::ViewType getViewType();
+
+		typedef std::shared_ptr<ImageView> Ptr;
+		static Ptr create(const void* parentImage, GPU::ViewType type, GPU::Format format, GPU::SubResourceRange& subRange)
+		{
+			return std::make_shared<ImageView>(parentImage, type, format, subRange);
+		}
+
+	private:
+		const void* image;
+		GPU::ViewType type;
+
+		ImageView(const ImageView&) = delete;
+		ImageView& operator=(const ImageView&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLIMAGEVIEW
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "NullPipeline.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace Null
+{
+	GraphicsPipeline::GraphicsPipeline(std::string name) :
+		GPU::GraphicsPipeline(name)
+	{
+
+	}
+
+	GraphicsPipeline::~GraphicsPipeline()
+	{
+
+	}
+
+	void GraphicsPipeline::setVertexInputDescripton(GPU::VertexDescription& inputDescription)
+	{
+		vertexDescription = inputDescription;
+	}
+
+	void GraphicsPipeline::setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts)
+	{
+		this->setLayouts = setLayouts;
+	}
+
+	void GraphicsPipeline::setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts, std::vector<GPU::PushConstant> pushConstants)
+	{
+		this->setLayouts = setLayouts;
+		this->pushConstants = pushConstants;
+	}
+
+	void GraphicsPipeline::addShaderStage(std::string code, GPU::ShaderStage stage)
+	{
+		if (code.empty())
+			std::cout << "error: empty shader stage in pipeline " << getPipelineName() << std::endl;
+		shaderStages[stage] = (uint32)code.size();
+	}
+
+	void GraphicsPipeline::setDepthTest(bool depthTestEnabled, bool depthWriteEnabled)
+	{
+		this->depthTestEnabled = depthTestEnabled;
+		this->depthWriteEnabled = depthWriteEnabled;
+	}
+
+	void GraphicsPipeline::setStencilTest(bool stencilTestEnabled, uint32 stencilMask, uint32 refValue, GPU::CompareOp compareOp)
+	{
+		this->stencilTestEnabled = stencilTestEnabled;
+		this->stencilMask = stencilMask;
+		this->stencilRefValue = refValue;
+		this->stencilCompOp = compareOp;
+	}
+
+	void GraphicsPipeline::setColorMask(bool red, bool green, bool blue, bool alpha)
+	{
+		colorMask[0] = red;
+		colorMask[1] = green;
+		colorMask[2] = blue;
+		colorMask[3] = alpha;
+	}
+
+	void GraphicsPipeline::setBlending(bool blendingEnabled)
+	{
+		this->blendingEnabled = blendingEnabled;
+	}
+
+	void GraphicsPipeline::setScissorTest(bool scissorTestEnabled)
+	{
+		this->scissorTestEnabled = scissorTestEnabled;
+	}
+
+	void GraphicsPipeline::setCullMode(int mode)
+	{
+		this->cullMode = mode;
+	}
+
+	void GraphicsPipeline::setWindingOrder(int frontFace)
+	{
+		this->frontFace = frontFace;
+	}
+
+	void GraphicsPipeline::createProgram()
+	{
+		if (shaderStages.find(GPU::ShaderStage::Vertex) == shaderStages.end())
+			std::cout << "error: pipeline " << getPipelineName() << " has no vertex stage" << std::endl;
+		created = true;
+	}
+
+	uint32 GraphicsPipeline::getPushConstantSize()
+	{
+		uint32 size = 0;
+		for (auto& p : pushConstants)
+			size = std::max(size, p.offset + p.size);
+		return size;
+	}
+
+	ComputePipeline::ComputePipeline(std::string name) :
+		GPU::ComputePipeline(name)
+	{
+
+	}
+
+	ComputePipeline::~ComputePipeline()
+	{
+
+	}
+
+	void ComputePipeline::setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts)
+	{
+		this->setLayouts = setLayouts;
+	}
+
+	void ComputePipeline::addShaderStage(std::string code, GPU::ShaderStage stage)
+	{
+		if (code.empty())
+			std::cout << "error: empty shader stage in pipeline " << getPipelineName() << std::endl;
+		shaderSize = (uint32)code.size();
+	}
+
+	void ComputePipeline::createProgram()
+	{
+		created = true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef INCLUDED_NULLPIPELINE
+#define INCLUDED_NULLPIPELINE
+
+#pragma once
+
+#include <GPU/Pipeline.h>
+#include <GPU/Null/NullDescriptorPool.h>
+#include <map>
+
+namespace Null
+{
+	class GraphicsPipeline : public GPU::GraphicsPipeline
+	{
+	public:
+		GraphicsPipeline(std::string name);
+		~GraphicsPipeline();
+		void setVertexInputDescripton(GPU::VertexDescription& inputDescription);
+		void setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts);
+		void setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts, std::vector<GPU::PushConstant> pushConstants);
+		void addShaderStage(std::string code, GPU::ShaderStage stage);
+		void setDepthTest(bool depthTestEnabled, bool depthWriteEnabled);
+		void setStencilTest(bool stencilTestEnabled, uint32 stencilMask, uint32 refValue, GPU::CompareOp compareOp);
+		void setColorMask(bool red, bool green, bool blue, bool alpha);
+		void setBlending(bool blendingEnabled);
+		void setScissorTest(bool scissorTestEnabled);
+		void setCullMode(int mode);
+		void setWindingOrder(int frontFace);
+		void createProgram();
+		bool isCreated() { return created; }
+		std::vector<std::string> getSetLayouts() { return setLayouts; }
+		uint32 getPushConstantSize();
+
+		typedef std::shared_ptr<GraphicsPipeline> Ptr;
+		static Ptr create(std::string name)
+		{
+			return std::make_shared<GraphicsPipeline>(name);
+		}
+	private:
+		GPU::VertexDescription vertexDescription;
+		std::vector<std::string> setLayouts;
+		std::vector<GPU::PushConstant> pushConstants;
+		std::map<GPU::ShaderStage, uint32> shaderStages; // stage -> code size
+		bool created = false;
+
+		bool depthTestEnabled = true;
+		bool depthWriteEnabled = true;
+		bool stencilTestEnabled = false;
+		uint32 stencilMask = 0x00;
+		uint32 stencilRefValue = 0;
+		GPU::CompareOp stencilCompOp = GPU::CompareOp::Always;
+		bool colorMask[4] = { true, true, true, true };
+		bool scissorTestEnabled = false;
+		bool blendingEnabled = true;
+		int cullMode = 0;
+		int frontFace = 0;
+
+		GraphicsPipeline(const GraphicsPipeline&) = delete;
+		GraphicsPipeline& operator=(const GraphicsPipeline&) = delete;
+	};
+
+	class ComputePipeline : public GPU::ComputePipeline
+	{
+	public:
+		ComputePipeline(std::string name);
+		~ComputePipeline();
+		void setLayout(GPU::DescriptorPool::Ptr descriptorPool, std::vector<std::string> setLayouts);
+		void addShaderStage(std::string code, GPU::ShaderStage stage);
+		void createProgram();
+		bool isCreated() { return created; }
+		std::vector<std::string> getSetLayouts() { return setLayouts; }
+
+		typedef std::shared_ptr<ComputePipeline> Ptr;
+		static Ptr create(std::string name)
+		{
+			return std::make_shared<ComputePipeline>(name);
+		}
+
+	private:
+		std::vector<std::string> setLayouts;
+		uint32 shaderSize = 0;
+		bool created = false;
+
+		ComputePipeline(const ComputePipeline&) = delete;
+		ComputePipeline& operator=(const ComputePipeline&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLPIPELINE
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "NullSampler.h"
+
+namespace Null
+{
+	Sampler::Sampler(uint32 levels) :
+		GPU::Sampler(levels),
+		levels(levels)
+	{
+
+	}
+
+	Sampler::~Sampler()
+	{
+
+	}
+
+	void Sampler::setAddressMode(GPU::AddressMode modeS, GPU::AddressMode modeT, GPU::AddressMode modeR)
+	{
+		addressMode[0] = modeS;
+		addressMode[1] = modeT;
+		addressMode[2] = modeR;
+	}
+
+	void Sampler::setAddressMode(GPU::AddressMode mode)
+	{
+		setAddressMode(mode, mode, mode);
+	}
+
+	void Sampler::setFilter(GPU::Filter minFilter, GPU::Filter magFilter)
+	{
+		this->minFilter = minFilter;
+		this->magFilter = magFilter;
+	}
+
+	void Sampler::setCompareMode(bool enable)
+	{
+		compareEnabled = enable;
+	}
+
+	void Sampler::setCompareOp(GPU::CompareOp op)
+	{
+		compareOp = op;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef INCLUDED_NULLSAMPLER
+#define INCLUDED_NULLSAMPLER
+
+#pragma once
+
+#include <GPU/Sampler.h>
+
+namespace Null
+{
+	class Sampler : public GPU::Sampler
+	{
+	public:
+		Sampler(uint32 levels);
+		~Sampler();
+		void setAddressMode(GPU::AddressMode modeS, GPU::AddressMode modeT, GPU::AddressMode modeR);
+		void setAddressMode(GPU::AddressMode mode);
+		void setFilter(GPU::Filter minFilter, GPU::Filter magFilter);
+		void setCompareMode(bool enable);
+		void setCompareOp(GPU::CompareOp op);
+
+		typedef std::shared_ptr<Sampler> Ptr;
+		static Ptr create(uint32 levels)
+		{
+			return std::make_shared<Sampler>(levels);
+		}
+	private:
+		uint32 levels;
+		GPU::AddressMode addressMode[3] = { GPU::AddressMode::Repeat, GPU::AddressMode::Repeat, GPU::AddressMode::Repeat };
+		GPU::Filter minFilter = GPU::Filter::Linear;
+		GPU::Filter magFilter = GPU::Filter::Linear;
+		bool compareEnabled = false;
+		GPU::CompareOp compareOp = GPU::CompareOp::Never;
+
+		Sampler(const Sampler&) = delete;
+		Sampler& operator=(const Sampler&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLSAMPLER
\ No newline at end of file
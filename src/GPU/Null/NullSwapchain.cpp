@@ -0,0 +1,40 @@
+#include "NullSwapchain.h"
+
+namespace Null
+{
+	Swapchain::Swapchain(uint32 width, uint32 height) :
+		GPU::Swapchain(width, height)
+	{
+		framebuffer = Framebuffer::create(width, height, true);
+		framebuffer->setClearColor(glm::vec4(0.0f, 0.0f, 0.3f, 1.0f));
+	}
+
+	Swapchain::~Swapchain()
+	{
+
+	}
+
+	void Swapchain::resize(uint32 width, uint32 height)
+	{
+		this->width = width;
+		this->height = height;
+
+		framebuffer = Framebuffer::create(width, height, true);
+		framebuffer->setClearColor(glm::vec4(0.0f, 0.0f, 0.3f, 1.0f));
+	}
+
+	int Swapchain::acquireNextFrame()
+	{
+		return 0;
+	}
+
+	void Swapchain::present(GPU::CommandBuffer::Ptr lastBuffer)
+	{
+		numPresented++;
+	}
+
+	GPU::Framebuffer::Ptr Swapchain::getFramebuffer(uint32 index)
+	{
+		return framebuffer;
+	}
+}
\ No newline at end of file
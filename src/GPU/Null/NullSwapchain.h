@@ -0,0 +1,34 @@
+#ifndef INCLUDED_NULLSWAPCHAIN
+#define INCLUDED_NULLSWAPCHAIN
+
+#pragma once
+
+#include <GPU/Swapchain.h>
+#include <GPU/Null/NullFramebuffer.h>
+
+namespace Null
+{
+	class Swapchain : public GPU::Swapchain
+	{
+	public:
+		Swapchain(uint32 width, uint32 height);
+		~Swapchain();
+		void resize(uint32 width, uint32 height);
+		int acquireNextFrame();
+		void present(GPU::CommandBuffer::Ptr lastBuffer);
+		GPU::Framebuffer::Ptr getFramebuffer(uint32 index);
+		uint32 getNumPresented() { return numPresented; }
+
+		typedef std::shared_ptr<Swapchain> Ptr;
+		static Ptr create(uint32 width, uint32 height)
+		{
+			return std::make_shared<Swapchain>(width, height);
+		}
+
+	private:
+		Null::Framebuffer::Ptr framebuffer;
+		uint32 numPresented = 0;
+	};
+}
+
+#endif // INCLUDED_NULLSWAPCHAIN
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "NullUniformAllocator.h"
+
+namespace Null
+{
+	UniformAllocator::UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment) :
+		GPU::UniformAllocator(blockSize, maxBlocks, numFrames, alignment)
+	{
+		storage.resize(getFrameSize() * numFrames);
+	}
+
+	UniformAllocator::~UniformAllocator()
+	{
+	}
+
+	GPU::Descriptor::Ptr UniformAllocator::getDescriptor()
+	{
+		return BufferDescriptor::create(storage.data(), dataSize);
+	}
+
+	uint8* UniformAllocator::mapFrame(uint32 frame)
+	{
+		return storage.data() + frame * getFrameSize();
+	}
+
+	void UniformAllocator::unmapFrame(uint32 frame, uint32 size)
+	{
+		numFlushes++;
+		bytesFlushed += size;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef INCLUDED_NULLUNIFORMALLOCATOR
+#define INCLUDED_NULLUNIFORMALLOCATOR
+
+#pragma once
+
+#include <GPU/UniformAllocator.h>
+#include <GPU/Null/NullDescriptor.h>
+
+namespace Null
+{
+	class UniformAllocator : public GPU::UniformAllocator
+	{
+	public:
+		UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment);
+		~UniformAllocator();
+		GPU::Descriptor::Ptr getDescriptor();
+		uint32 getNumFlushes() { return numFlushes; }
+		uint32 getBytesFlushed() { return bytesFlushed; }
+
+		typedef std::shared_ptr<UniformAllocator> Ptr;
+		static Ptr create(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment)
+		{
+			return std::make_shared<UniformAllocator>(blockSize, maxBlocks, numFrames, alignment);
+		}
+
+	private:
+		uint8* mapFrame(uint32 frame);
+		void unmapFrame(uint32 frame, uint32 size);
+
+		std::vector<uint8> storage;
+		uint32 numFlushes = 0;
+		uint32 bytesFlushed = 0;
+
+		UniformAllocator(const UniformAllocator&) = delete;
+		UniformAllocator& operator=(const UniformAllocator&) = delete;
+	};
+}
+
+#endif // INCLUDED_NULLUNIFORMALLOCATOR
\ No newline at end of file
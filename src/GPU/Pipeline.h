@@ -32,11 +32,27 @@ namespace GPU
 		}
 	};
 
+	struct VertexInputBinding
+	{
+		uint32 binding;
+		uint32 stride;
+		VertexInputeRate inputRate;
+
+		VertexInputBinding(uint32 binding, uint32 stride, VertexInputeRate inputRate = VertexInputeRate::Vertex) :
+			binding(binding),
+			stride(stride),
+			inputRate(inputRate)
+		{
+
+		}
+	};
+
+	// vertex buffers can be bound to the bindings 0 to maxVertexBindings - 1
+	const uint32 maxVertexBindings = 8;
+
 	struct VertexDescription
 	{
-		uint32 binding = 0;
-		uint32 stride = 0;
-		VertexInputeRate inputRate = VertexInputeRate::Vertex;
+		std::vector<VertexInputBinding> inputBindings;
 		std::vector<VertexInputAttribute> inputAttributes;
 	};
 
@@ -0,0 +1,122 @@
+#ifndef INCLUDED_UNIFORMALLOCATOR
+#define INCLUDED_UNIFORMALLOCATOR
+
+#pragma once
+
+#include "Descriptor.h"
+#include <Platform/Types.h>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace GPU
+{
+	// Hands out fixed size, aligned blocks of one large uniform buffer that is mapped once.
+	// Blocks are written to a CPU copy and committed by flush() into the next of numFrames
+	// segments, so the CPU never writes into a segment that might still be read by the GPU.
+	// Blocks are bound with a dynamic offset which is relative to the current segment.
+	class UniformAllocator
+	{
+	public:
+		UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment) :
+			dataSize(blockSize),
+			blockSize((blockSize + alignment - 1) / alignment * alignment),
+			maxBlocks(maxBlocks),
+			numFrames(numFrames)
+		{
+			staging.resize(this->blockSize * maxBlocks);
+		}
+		virtual ~UniformAllocator() {}
+		virtual Descriptor::Ptr getDescriptor() = 0;
+
+		// returns false if all blocks are in use, a block is never handed out twice
+		bool allocate(uint32& offset)
+		{
+			uint32 index = 0;
+			if (!freeBlocks.empty())
+			{
+				index = freeBlocks.back();
+				freeBlocks.pop_back();
+			}
+			else if (numBlocks < maxBlocks)
+			{
+				index = numBlocks++;
+			}
+			else
+			{
+				std::cout << "error: uniform allocator is full, max. blocks: " << maxBlocks << std::endl;
+				return false;
+			}
+			offset = index * blockSize;
+			return true;
+		}
+		void release(uint32 offset)
+		{
+			freeBlocks.push_back(offset / blockSize);
+		}
+		void write(uint32 offset, const void* data)
+		{
+			std::memcpy(staging.data() + offset, data, dataSize);
+			dirty = true;
+		}
+		void flush()
+		{
+			if (!dirty)
+				return;
+
+			uint32 size = numBlocks * blockSize;
+			frameIndex = (frameIndex + 1) % numFrames;
+			uint8* dst = mapFrame(frameIndex);
+			if (dst)
+				std::memcpy(dst, staging.data(), size);
+			unmapFrame(frameIndex, size);
+			dirty = false;
+		}
+		const uint8* getBlockData(uint32 offset)
+		{
+			return staging.data() + offset;
+		}
+		uint32 getFrameOffset()
+		{
+			return frameIndex * blockSize * maxBlocks;
+		}
+		uint32 getFrameSize()
+		{
+			return blockSize * maxBlocks;
+		}
+		uint32 getDataSize()
+		{
+			return dataSize;
+		}
+		uint32 getBlockSize()
+		{
+			return blockSize;
+		}
+		uint32 getNumFrames()
+		{
+			return numFrames;
+		}
+		typedef std::shared_ptr<UniformAllocator> Ptr;
+	protected:
+		virtual uint8* mapFrame(uint32 frame) = 0;
+		virtual void unmapFrame(uint32 frame, uint32 size) = 0;
+
+		uint32 dataSize = 0;
+		uint32 blockSize = 0;
+		uint32 maxBlocks = 0;
+		uint32 numFrames = 1;
+	private:
+		std::vector<uint8> staging;
+		std::vector<uint32> freeBlocks;
+		uint32 numBlocks = 0;
+		uint32 frameIndex = 0;
+		std::atomic<bool> dirty{ false }; // blocks may be written from several threads
+
+		UniformAllocator(const UniformAllocator&) = delete;
+		UniformAllocator& operator=(const UniformAllocator&) = delete;
+	};
+}
+
+#endif // INCLUDED_UNIFORMALLOCATOR
\ No newline at end of file
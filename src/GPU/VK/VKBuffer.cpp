@@ -109,7 +109,12 @@ namespace VK
 
 	void Buffer::uploadStaged(void* data)
 	{
-		auto stagingBuffer = VK::Buffer::create(GPU::BufferUsage::TransferSrc, size, 0);
+		uploadStaged(data, 0, size);
+	}
+
+	void Buffer::uploadStaged(void* data, uint32 offset, uint32 byteCount)
+	{
+		auto stagingBuffer = VK::Buffer::create(GPU::BufferUsage::TransferSrc, byteCount, 0);
 		stagingBuffer->uploadMapped(data);
 
 		//auto& ctx = VK::Context::getInstance();
@@ -122,8 +127,8 @@ namespace VK
 
 		vk::BufferCopy region;
 		region.srcOffset = 0;
-		region.dstOffset = 0;
-		region.size = size;
+		region.dstOffset = offset;
+		region.size = byteCount;
 		copyCmd.copyBuffer(stagingBuffer->getBuffer(), buffer, region);
 
 		copyCmd.end();
@@ -22,6 +22,7 @@ namespace VK
 		void flush(uint32 size, uint32 offset);
 		void uploadMapped(void* data);
 		void uploadStaged(void* data);
+		void uploadStaged(void* data, uint32 offset, uint32 byteCount);
 		uint8* getMappedPointer();
 		GPU::Descriptor::Ptr getDescriptor();
 		vk::Buffer getBuffer();
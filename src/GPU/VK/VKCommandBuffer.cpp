@@ -29,6 +29,7 @@ namespace VK
 
 		vkCmdSetCullModeEXT = reinterpret_cast<PFN_vkCmdSetCullModeEXT>(vkGetDeviceProcAddr(device, "vkCmdSetCullModeEXT"));
 		vkCmdSetPrimitiveTopologyEXT = reinterpret_cast<PFN_vkCmdSetPrimitiveTopologyEXT>(vkGetDeviceProcAddr(device, "vkCmdSetPrimitiveTopologyEXT"));
+		vkCmdBindVertexBuffers2EXT = reinterpret_cast<PFN_vkCmdBindVertexBuffers2EXT>(vkGetDeviceProcAddr(device, "vkCmdBindVertexBuffers2EXT"));
 	}
 
 	CommandBuffer::~CommandBuffer()
@@ -41,6 +42,9 @@ namespace VK
 	{
 		vk::CommandBufferBeginInfo commandBufferBeginInfo;
 		commandBuffer.begin(commandBufferBeginInfo);
+		for (uint32 i = 0; i < GPU::maxVertexBindings; i++)
+			boundVertexBuffers[i] = nullptr;
+		boundIndexBuffer = nullptr;
 	}
 
 	void CommandBuffer::end()
@@ -120,6 +124,13 @@ namespace VK
 		commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, vkPipeline->getPipelineLayout(), firstSet, vkDescriptorSet->getDescriptorSet(), {});
 	}
 
+	void CommandBuffer::bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset)
+	{
+		auto vkPipeline = std::dynamic_pointer_cast<GraphicsPipeline>(pipeline);
+		auto vkDescriptorSet = std::dynamic_pointer_cast<DescriptorSet>(descriptorSet);
+		commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, vkPipeline->getPipelineLayout(), firstSet, vkDescriptorSet->getDescriptorSet(), dynamicOffset);
+	}
+
 	void CommandBuffer::bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet)
 	{
 		auto vkPipeline = std::dynamic_pointer_cast<ComputePipeline>(pipeline);
@@ -130,14 +141,32 @@ namespace VK
 
 	void CommandBuffer::bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer)
 	{
+		bindVertexBuffers(0, vertexBuffer);
+	}
+
+	void CommandBuffer::bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer)
+	{
+		// primitives of the geometry pool share their buffers, so most binds are redundant
 		auto vkBuffer = std::dynamic_pointer_cast<Buffer>(vertexBuffer);
-		vk::DeviceSize offset = 0;
-		commandBuffer.bindVertexBuffers(0, vkBuffer->getBuffer(), offset);
+		if (vkBuffer->getBuffer() == boundVertexBuffers[binding])
+			return;
+
+		// the stride is dynamic, so the default attribute buffers can be bound with a stride of 0
+		boundVertexBuffers[binding] = vkBuffer->getBuffer();
+		VkBuffer buffer = vkBuffer->getBuffer();
+		VkDeviceSize offset = 0;
+		VkDeviceSize stride = vkBuffer->getStride();
+		vkCmdBindVertexBuffers2EXT(commandBuffer, binding, 1, &buffer, &offset, nullptr, &stride);
 	}
 
 	void CommandBuffer::bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType)
 	{
 		auto vkBuffer = std::dynamic_pointer_cast<Buffer>(indexBuffer);
+		if (vkBuffer->getBuffer() == boundIndexBuffer && indexType == boundIndexType)
+			return;
+
+		boundIndexBuffer = vkBuffer->getBuffer();
+		boundIndexType = indexType;
 		commandBuffer.bindIndexBuffer(vkBuffer->getBuffer(), 0, getIndexType(indexType));
 	}
 
@@ -147,11 +176,11 @@ namespace VK
 		vkCmdSetCullModeEXT(commandBuffer, flags);
 	}
 
-	void CommandBuffer::drawIndexed(uint32 indexCount, GPU::Topology topology)
+	void CommandBuffer::drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
 	{
 		VkPrimitiveTopology vkTopology = (VkPrimitiveTopology)getTopology(topology);
 		vkCmdSetPrimitiveTopologyEXT(commandBuffer, vkTopology);
-		commandBuffer.drawIndexed(indexCount, 1, 0, 0, 0);
+		commandBuffer.drawIndexed(indexCount, 1, firstIndex, baseVertex, 0);
 	}
 
 	void CommandBuffer::drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset)
@@ -161,9 +190,16 @@ namespace VK
 		commandBuffer.drawIndexed(indexCount, 1, indexOffset, vertexOffset, 0);
 	}
 
-	void CommandBuffer::drawArrays(uint32 vertexCount)
+	void CommandBuffer::drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex)
+	{
+		VkPrimitiveTopology vkTopology = (VkPrimitiveTopology)getTopology(topology);
+		vkCmdSetPrimitiveTopologyEXT(commandBuffer, vkTopology);
+		commandBuffer.drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, 0);
+	}
+
+	void CommandBuffer::drawArrays(uint32 vertexCount, uint32 firstVertex)
 	{
-		commandBuffer.draw(vertexCount, 1, 0, 0);
+		commandBuffer.draw(vertexCount, 1, firstVertex, 0);
 	}
 
 	void CommandBuffer::dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ)
@@ -31,13 +31,16 @@ namespace VK
 		void bindPipeline(GPU::ComputePipeline::Ptr pipeline);
 		void pushConstants(GPU::GraphicsPipeline::Ptr pipeline, GPU::ShaderStage stage, uint32 offset, uint32 size, const void* values);
 		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
+		void bindDescriptorSets(GPU::GraphicsPipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet, uint32 dynamicOffset);
 		void bindDescriptorSets(GPU::ComputePipeline::Ptr pipeline, GPU::DescriptorSet::Ptr descriptorSet, uint32 firstSet);
 		void bindVertexBuffers(GPU::Buffer::Ptr vertexBuffer);
+		void bindVertexBuffers(uint32 binding, GPU::Buffer::Ptr vertexBuffer);
 		void bindIndexBuffers(GPU::Buffer::Ptr indexBuffer, GPU::IndexType indexType);
 		void setCullMode(int mode);
-		void drawIndexed(uint32 indexCount, GPU::Topology topology);
+		void drawIndexed(uint32 indexCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
 		void drawIndexed(uint32 indexCount, uint32 indexOffset, uint32 vertexOffset);
-		void drawArrays(uint32 vertexCount);
+		void drawIndexedInstanced(uint32 indexCount, uint32 instanceCount, GPU::Topology topology, uint32 firstIndex, int32 baseVertex);
+		void drawArrays(uint32 vertexCount, uint32 firstVertex);
 		void dispatchCompute(uint32 grpCountX, uint32 grpCountY, uint32 grpCountZ);
 		void pipelineBarrier();
 		void flush();
@@ -56,9 +59,13 @@ namespace VK
 		vk::Fence fence;
 		vk::Semaphore semaphore;
 		vk::CommandBuffer commandBuffer;
+		vk::Buffer boundVertexBuffers[GPU::maxVertexBindings];
+		vk::Buffer boundIndexBuffer;
+		GPU::IndexType boundIndexType = GPU::IndexType::uint32;
 		
 		PFN_vkCmdSetCullModeEXT vkCmdSetCullModeEXT = nullptr;
 		PFN_vkCmdSetPrimitiveTopologyEXT vkCmdSetPrimitiveTopologyEXT = nullptr;
+		PFN_vkCmdBindVertexBuffers2EXT vkCmdBindVertexBuffers2EXT = nullptr;
 		
 		CommandBuffer(const CommandBuffer&) = delete;
 		CommandBuffer& operator=(const CommandBuffer&) = delete;
@@ -110,6 +110,14 @@ namespace VK
 		return swapchain;
 	}
 
+	GPU::UniformAllocator::Ptr Context::createUniformAllocator(uint32 blockSize, uint32 maxBlocks)
+	{
+		// command buffers are recorded once per swapchain image with the dynamic offsets
+		// baked in, so only a single segment can be used here
+		uint32 alignment = (uint32)Device::getInstance().getLimits().minUniformBufferOffsetAlignment;
+		return UniformAllocator::create(blockSize, maxBlocks, 1, alignment);
+	}
+
 	void Context::submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf)
 	{
 		auto vkSwapchain = std::dynamic_pointer_cast<Swapchain>(swapchain);
@@ -13,6 +13,7 @@
 #include <GPU/VK/VKPipeline.h>
 #include <GPU/VK/VKSampler.h>
 #include <GPU/VK/VKSwapchain.h>
+#include <GPU/VK/VKUniformAllocator.h>
 #include <GPU/VK/VKPlatform.h>
 #include <GPU/Enums.h>
 #include <iostream>
@@ -48,6 +49,7 @@ namespace VK
 		GPU::ImageDescriptor::Ptr createImageDescriptor(GPU::Image::Ptr image, GPU::ImageView::Ptr view, GPU::Sampler::Ptr sampler);
 		GPU::Sampler::Ptr createSampler(uint32 levels);
 		GPU::Swapchain::Ptr createSwapchain(Window::Ptr window);
+		GPU::UniformAllocator::Ptr createUniformAllocator(uint32 blockSize, uint32 maxBlocks);
 		void submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void submitCommandBuffer(GPU::CommandBuffer::Ptr prevCmdBuf, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void waitDeviceIdle();
@@ -13,8 +13,10 @@ namespace VK
 		switch (type)
 		{
 			case GPU::DescriptorType::UniformBuffer: descType = vk::DescriptorType::eUniformBuffer; break;
+			case GPU::DescriptorType::UniformBufferDynamic: descType = vk::DescriptorType::eUniformBufferDynamic; break;
 			case GPU::DescriptorType::CombinedImageSampler: descType = vk::DescriptorType::eCombinedImageSampler; break;
 			case GPU::DescriptorType::StorageImage: descType = vk::DescriptorType::eStorageImage; break;
+			case GPU::DescriptorType::StorageBuffer: descType = vk::DescriptorType::eStorageBuffer; break;
 		}
 		return descType;
 	}
@@ -22,10 +24,12 @@ namespace VK
 	DescriptorPool::DescriptorPool() :
 		device(Device::getInstance().getDevice())
 	{
-		std::array<vk::DescriptorPoolSize, 3> poolSizes = {
+		std::array<vk::DescriptorPoolSize, 5> poolSizes = {
 			{{vk::DescriptorType::eUniformBuffer, 2500},
+			 {vk::DescriptorType::eUniformBufferDynamic, 16},
 			 {vk::DescriptorType::eCombinedImageSampler, 6000},
-			 {vk::DescriptorType::eStorageImage, 100}
+			 {vk::DescriptorType::eStorageImage, 100},
+			 {vk::DescriptorType::eStorageBuffer, 100}
 			}
 		};
 		vk::DescriptorPoolCreateInfo descriptorPoolCreateInfo({}, 3200, poolSizes);
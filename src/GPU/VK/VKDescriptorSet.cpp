@@ -66,7 +66,12 @@ namespace VK
 			{
 				auto vkBufferDesc = std::dynamic_pointer_cast<BufferDescriptor>(descriptors[i]);
 				vk::DescriptorBufferInfo bufferInfo = vkBufferDesc->getDescriptor();
-				vk::WriteDescriptorSet writeDS(descriptorSet, i, 0, vk::DescriptorType::eUniformBuffer, {}, bufferInfo);
+				vk::DescriptorType descType = vk::DescriptorType::eUniformBuffer;
+				if (layoutBinding.descriptorType == GPU::DescriptorType::UniformBufferDynamic)
+					descType = vk::DescriptorType::eUniformBufferDynamic;
+				else if (layoutBinding.descriptorType == GPU::DescriptorType::StorageBuffer)
+					descType = vk::DescriptorType::eStorageBuffer;
+				vk::WriteDescriptorSet writeDS(descriptorSet, i, 0, descType, {}, bufferInfo);
 				device.updateDescriptorSets(writeDS, {});
 			}
 			if (std::dynamic_pointer_cast<ImageDescriptor>(descriptors[i]))
@@ -96,9 +96,14 @@ namespace VK
 		descriptorIndexingFeatures.runtimeDescriptorArray = true;
 		descriptorIndexingFeatures.descriptorBindingVariableDescriptorCount = true;
 
+		// gl_BaseVertex is needed to find the morph targets of primitives in the geometry pool
+		auto drawParametersFeatures = vk::PhysicalDeviceShaderDrawParametersFeatures();
+		drawParametersFeatures.shaderDrawParameters = true;
+		drawParametersFeatures.pNext = &descriptorIndexingFeatures;
+
 		auto extendedDynamicStateFeatures = vk::PhysicalDeviceExtendedDynamicStateFeaturesEXT();
 		extendedDynamicStateFeatures.extendedDynamicState = true;
-		extendedDynamicStateFeatures.pNext = &descriptorIndexingFeatures;
+		extendedDynamicStateFeatures.pNext = &drawParametersFeatures;
 
 		vk::DeviceCreateInfo deviceInfo({}, queueCreateInfos, {}, requiredDeviceExtensions, &features, &extendedDynamicStateFeatures);
 		device = gpu.createDevice(deviceInfo);
@@ -40,6 +40,10 @@ namespace VK
 		{
 			return allocator;
 		}
+		vk::PhysicalDeviceLimits getLimits()
+		{
+			return gpu.getProperties().limits;
+		}
 		vk::Queue getSuitableGraphicsQueue();
 		uint32_t getQueueFamilyIndex(vk::QueueFlagBits queueFlags);
 		uint32_t getQueueByFlags(vk::QueueFlags requiredQueueFlags, uint32_t queueIndex);
@@ -12,6 +12,10 @@ namespace VK
 		case GPU::VertexAttribFormat::Vector3F: format = vk::Format::eR32G32B32Sfloat; break;
 		case GPU::VertexAttribFormat::Vector4F: format = vk::Format::eR32G32B32A32Sfloat; break;
 		case GPU::VertexAttribFormat::Vectur4UC: format = vk::Format::eR8G8B8A8Unorm; break;
+		case GPU::VertexAttribFormat::Vector2H: format = vk::Format::eR16G16Sfloat; break;
+		case GPU::VertexAttribFormat::Vector2SN16: format = vk::Format::eR16G16Snorm; break;
+		case GPU::VertexAttribFormat::Vector4SN16: format = vk::Format::eR16G16B16A16Snorm; break;
+		case GPU::VertexAttribFormat::Vector4UB: format = vk::Format::eR8G8B8A8Uint; break;
 		}
 		return format;
 	}
@@ -283,6 +283,79 @@ namespace VK
 		cmdBuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader, {}, nullptr, nullptr, imageMemoryBarrier);
 	}
 
+	void Image::copyLayers(GPU::CommandBuffer::Ptr commandBuffer, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount)
+	{
+		vk::ImageAspectFlags aspect = (format == GPU::Format::DEPTH32) ? vk::ImageAspectFlagBits::eDepth : vk::ImageAspectFlagBits::eColor;
+		vk::ImageCopy region;
+		region.srcSubresource = vk::ImageSubresourceLayers(aspect, 0, baseLayer, layerCount);
+		region.dstSubresource = vk::ImageSubresourceLayers(aspect, 0, baseLayer, layerCount);
+		region.extent = vk::Extent3D(extent.width, extent.height, 1);
+		copy(commandBuffer, dstImage, baseLayer, layerCount, { region });
+	}
+
+	void Image::copyRegions(GPU::CommandBuffer::Ptr commandBuffer, std::shared_ptr<GPU::Image> dstImage, const std::vector<GPU::ImageRegion>& regions)
+	{
+		vk::ImageAspectFlags aspect = (format == GPU::Format::DEPTH32) ? vk::ImageAspectFlagBits::eDepth : vk::ImageAspectFlagBits::eColor;
+		std::vector<vk::ImageCopy> copyRegions;
+		for (auto& r : regions)
+		{
+			vk::ImageCopy region;
+			region.srcSubresource = vk::ImageSubresourceLayers(aspect, 0, 0, 1);
+			region.srcOffset = vk::Offset3D(r.srcX, r.srcY, 0);
+			region.dstSubresource = vk::ImageSubresourceLayers(aspect, 0, 0, 1);
+			region.dstOffset = vk::Offset3D(r.dstX, r.dstY, 0);
+			region.extent = vk::Extent3D(r.width, r.height, 1);
+			copyRegions.push_back(region);
+		}
+		copy(commandBuffer, dstImage, 0, 1, copyRegions);
+	}
+
+	void Image::copy(GPU::CommandBuffer::Ptr commandBuffer, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount, const std::vector<vk::ImageCopy>& regions)
+	{
+		auto cmdBuf = std::dynamic_pointer_cast<VK::CommandBuffer>(commandBuffer)->getCommandBuffer();
+		auto dst = std::dynamic_pointer_cast<VK::Image>(dstImage);
+
+		bool depth = (format == GPU::Format::DEPTH32);
+		vk::ImageAspectFlags aspect = depth ? vk::ImageAspectFlagBits::eDepth : vk::ImageAspectFlagBits::eColor;
+		vk::ImageSubresourceRange subresourceRange(aspect, 0, 1, baseLayer, layerCount);
+
+		// both images are sampled before, the destination is loaded by the next render pass
+		vk::ImageMemoryBarrier barriers[2];
+		barriers[0].image = image;
+		barriers[0].subresourceRange = subresourceRange;
+		barriers[0].srcAccessMask = vk::AccessFlagBits::eShaderRead;
+		barriers[0].dstAccessMask = vk::AccessFlagBits::eTransferRead;
+		barriers[0].oldLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		barriers[0].newLayout = vk::ImageLayout::eTransferSrcOptimal;
+		barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barriers[1] = barriers[0];
+		barriers[1].image = dst->getImage();
+		barriers[1].dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+		barriers[1].newLayout = vk::ImageLayout::eTransferDstOptimal;
+		cmdBuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, nullptr, nullptr, barriers);
+
+		cmdBuf.copyImage(image, vk::ImageLayout::eTransferSrcOptimal, dst->getImage(), vk::ImageLayout::eTransferDstOptimal, regions);
+
+		barriers[0].srcAccessMask = vk::AccessFlagBits::eTransferRead;
+		barriers[0].dstAccessMask = vk::AccessFlagBits::eShaderRead;
+		barriers[0].oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+		barriers[0].newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		barriers[1].srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+		barriers[1].oldLayout = vk::ImageLayout::eTransferDstOptimal;
+		if (depth)
+		{
+			barriers[1].dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+			barriers[1].newLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+		}
+		else
+		{
+			barriers[1].dstAccessMask = vk::AccessFlagBits::eShaderRead;
+			barriers[1].newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		}
+		cmdBuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eAllCommands, {}, nullptr, nullptr, barriers);
+	}
+
 	void Image::setImageLayout()
 	{
 		imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
@@ -23,6 +23,8 @@ namespace VK
 		void uploadData(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize, uint32 layer, uint32 level);
 		void uploadArray(GPU::CommandBuffer::Ptr cmdBuf, uint8* data, uint32 dataSize);
 		void generateMipmaps(GPU::CommandBuffer::Ptr commandBuffer);
+		void copyLayers(GPU::CommandBuffer::Ptr commandBuffer, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount);
+		void copyRegions(GPU::CommandBuffer::Ptr commandBuffer, std::shared_ptr<GPU::Image> dstImage, const std::vector<GPU::ImageRegion>& regions);
 		void setImageLayout();
 		void layoutTransition(vk::CommandBuffer cmdBuf, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, vk::AccessFlags srcAccessMask, vk::AccessFlags dstAccessMask);
 		void layoutTransition(vk::CommandBuffer cmdBuf, vk::ImageLayout oldLayout, vk::ImageLayout newLayout, vk::AccessFlags srcAccessMask, vk::AccessFlags dstAccessMask, uint32 mip);
@@ -40,6 +42,8 @@ namespace VK
 		}
 		
 	private:
+		void copy(GPU::CommandBuffer::Ptr commandBuffer, std::shared_ptr<GPU::Image> dstImage, uint32 baseLayer, uint32 layerCount, const std::vector<vk::ImageCopy>& regions);
+
 		vk::Device device;
 		vk::Image image;
 		vk::ImageLayout imageLayout = vk::ImageLayout::eUndefined;
@@ -58,6 +58,7 @@ namespace VK
 		dynamicStateEnables.push_back(vk::DynamicState::eScissor);
 		dynamicStateEnables.push_back(vk::DynamicState::eCullModeEXT);
 		dynamicStateEnables.push_back(vk::DynamicState::ePrimitiveTopologyEXT);
+		dynamicStateEnables.push_back(vk::DynamicState::eVertexInputBindingStrideEXT);
 		dynamicState = vk::PipelineDynamicStateCreateInfo({}, dynamicStateEnables);
 	}
 
@@ -72,9 +73,15 @@ namespace VK
 
 	void GraphicsPipeline::setVertexInputDescripton(GPU::VertexDescription& inputDescription)
 	{
-		vertexInputBinding.binding = inputDescription.binding;
-		vertexInputBinding.stride = inputDescription.stride;
-		vertexInputBinding.inputRate = static_cast<vk::VertexInputRate>((int)inputDescription.inputRate);
+		for (auto& binding : inputDescription.inputBindings)
+		{
+			vk::VertexInputBindingDescription vertexInputBinding;
+			vertexInputBinding.binding = binding.binding;
+			vertexInputBinding.stride = binding.stride;
+			vertexInputBinding.inputRate = static_cast<vk::VertexInputRate>((int)binding.inputRate);
+			vertexInputBindings.push_back(vertexInputBinding);
+		}
+
 		for (auto& attrib : inputDescription.inputAttributes)
 		{
 			vk::VertexInputAttributeDescription vertexInputAttrib;
@@ -91,7 +98,7 @@ namespace VK
 		}
 		else
 		{
-			vertexInputState = vk::PipelineVertexInputStateCreateInfo({}, vertexInputBinding, vertexInputAttributes);
+			vertexInputState = vk::PipelineVertexInputStateCreateInfo({}, vertexInputBindings, vertexInputAttributes);
 		}
 	}
 
@@ -48,7 +48,7 @@ namespace VK
 		std::vector<vk::PipelineShaderStageCreateInfo> shaderStageInfos;
 
 		// vertex input
-		vk::VertexInputBindingDescription vertexInputBinding;
+		std::vector<vk::VertexInputBindingDescription> vertexInputBindings;
 		std::vector<vk::VertexInputAttributeDescription> vertexInputAttributes;
 
 		// state infos
@@ -0,0 +1,32 @@
+#include "VKUniformAllocator.h"
+
+namespace VK
+{
+	UniformAllocator::UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment) :
+		GPU::UniformAllocator(blockSize, maxBlocks, numFrames, alignment)
+	{
+		buffer = Buffer::create(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, getFrameSize() * numFrames, 0);
+		buffer->map();
+	}
+
+	UniformAllocator::~UniformAllocator()
+	{
+		buffer->unmap();
+	}
+
+	GPU::Descriptor::Ptr UniformAllocator::getDescriptor()
+	{
+		vk::DescriptorBufferInfo descriptorBufferInfo(buffer->getBuffer(), 0, dataSize);
+		return BufferDescriptor::create(descriptorBufferInfo);
+	}
+
+	uint8* UniformAllocator::mapFrame(uint32 frame)
+	{
+		return buffer->getMappedPointer() + frame * getFrameSize();
+	}
+
+	void UniformAllocator::unmapFrame(uint32 frame, uint32 size)
+	{
+		buffer->flush(size, frame * getFrameSize());
+	}
+}
\ No newline at end of file
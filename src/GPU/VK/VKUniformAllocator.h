@@ -0,0 +1,35 @@
+#ifndef INCLUDED_VKUNIFORMALLOCATOR
+#define INCLUDED_VKUNIFORMALLOCATOR
+
+#pragma once
+
+#include <GPU/UniformAllocator.h>
+#include <GPU/VK/VKBuffer.h>
+
+namespace VK
+{
+	class UniformAllocator : public GPU::UniformAllocator
+	{
+	public:
+		UniformAllocator(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment);
+		~UniformAllocator();
+		GPU::Descriptor::Ptr getDescriptor();
+
+		typedef std::shared_ptr<UniformAllocator> Ptr;
+		static Ptr create(uint32 blockSize, uint32 maxBlocks, uint32 numFrames, uint32 alignment)
+		{
+			return std::make_shared<UniformAllocator>(blockSize, maxBlocks, numFrames, alignment);
+		}
+
+	private:
+		uint8* mapFrame(uint32 frame);
+		void unmapFrame(uint32 frame, uint32 size);
+
+		Buffer::Ptr buffer;
+
+		UniformAllocator(const UniformAllocator&) = delete;
+		UniformAllocator& operator=(const UniformAllocator&) = delete;
+	};
+}
+
+#endif // INCLUDED_VKUNIFORMALLOCATOR
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -165,8 +166,23 @@ namespace pr
 			maxTime = glm::max(maxTime, time);
 			minTime = glm::max(minTime, time);
 
+			valuesPerKey = static_cast<uint32>(values.size());
 			times.push_back(time);
-			this->values.push_back(values);
+			this->values.insert(this->values.end(), values.begin(), values.end());
+		}
+
+		// sets all keyframes at once, values holds valuesPerKey consecutive elements per keyframe
+		void setValues(const std::vector<float>& times, const std::vector<Type>& values)
+		{
+			if (times.empty())
+				return;
+
+			this->times = times;
+			this->values = values;
+			valuesPerKey = static_cast<uint32>(values.size() / times.size());
+			minTime = times.front();
+			maxTime = times.back();
+			cursor = 0;
 		}
 
 		Type mix(Type a, Type b, float f)
@@ -174,27 +190,44 @@ namespace pr
 			return glm::mix(a, b, f);
 		}
 
+		Type getValue(uint32 keyIndex, uint32 elementIndex)
+		{
+			return values[keyIndex * valuesPerKey + elementIndex];
+		}
+
+		// returns the keyframe index k with times[k] <= time < times[k + 1],
+		// time has to be inside the range of the channel
+		uint32 findKeyframe(float time)
+		{
+			// during playback time only moves forward by a fraction of a key per frame,
+			// so check the cached keyframe and its successor before searching
+			uint32 lastIndex = static_cast<uint32>(times.size()) - 1;
+			if (cursor < lastIndex && times[cursor] <= time)
+			{
+				if (time < times[cursor + 1])
+					return cursor;
+				if (cursor + 1 < lastIndex && time < times[cursor + 2])
+					return ++cursor;
+			}
+
+			// after seeks or loops fall back to binary search
+			auto it = std::upper_bound(times.begin(), times.end(), time);
+			cursor = static_cast<uint32>(it - times.begin()) - 1;
+			return cursor;
+		}
+
 		Type interpolate(float time)
 		{
 			if (time < times[0] || time >= times[times.size() - 1])
-				return values[0][0];
+				return values[0];
 
 			// get the first index in time that is before the current time
-			int index = 0;
-			for (int i = 0; i < times.size() - 1; i++)
-			{
-				if (time < times[i + 1])
-				{
-					index = i;
-					break;
-				}
-			}
-			
-			int nextIndex = index + 1;
+			uint32 index = findKeyframe(time);
+			uint32 nextIndex = index + 1;
 			float deltaTime = times[nextIndex] - times[index];
 			float factor = (time - times[index]) / deltaTime;
-			Type start = values[index][0];
-			Type end = values[nextIndex][0];
+			Type start = getValue(index, 0);
+			Type end = getValue(nextIndex, 0);
 			Type result = Type();
 			switch (interpolation)
 			{
@@ -213,10 +246,10 @@ namespace pr
 				}
 				case Interpolation::CUBIC:
 				{
-					Type a_k1 = values[nextIndex][0];
-					Type v_k = values[index][1];
-					Type v_k1 = values[nextIndex][1];
-					Type b_k = values[index][2];
+					Type a_k1 = getValue(nextIndex, 0);
+					Type v_k = getValue(index, 1);
+					Type v_k1 = getValue(nextIndex, 1);
+					Type b_k = getValue(index, 2);
 
 					float t_k = times[index];
 					float t_k1 = times[nextIndex];
@@ -243,33 +276,23 @@ namespace pr
 
 		std::vector<Type> interpolateElements(float time)
 		{
-			auto firstValue = values[0];
+			std::vector<Type> firstValue(values.begin(), values.begin() + valuesPerKey);
 			if (times.size() == 1)
 				return firstValue;
 			if (time < times[0] || time >= times[times.size() - 1])
 				return firstValue;
 
-			int index = 0;
-			for (int i = 0; i < times.size() - 1; i++)
-			{
-				if (time < times[i + 1])
-				{
-					index = i;
-					break;
-				}
-			}
-
-			std::vector<Type> result;
-			int numValues = static_cast<int>(values[0].size());
-			int nextIndex = index + 1;
+			uint32 index = findKeyframe(time);
+			uint32 nextIndex = index + 1;
 			float deltaTime = times[nextIndex] - times[index];
 			float factor = (time - times[index]) / deltaTime;
-			for (int i = 0; i < numValues; i++)
+
+			std::vector<Type> result(valuesPerKey);
+			for (uint32 i = 0; i < valuesPerKey; i++)
 			{
-				Type start = values[index][i];
-				Type end = values[nextIndex][i];
-				Type w = glm::mix(start, end, factor);
-				result.push_back(w);
+				Type start = getValue(index, i);
+				Type end = getValue(nextIndex, i);
+				result[i] = glm::mix(start, end, factor);
 			}
 			return result;
 		}
@@ -281,7 +304,9 @@ namespace pr
 		}
 	private:
 		std::vector<float> times;
-		std::vector<std::vector<Type>> values;
+		std::vector<Type> values; // all keyframe values, valuesPerKey elements per keyframe
+		uint32 valuesPerKey = 1;
+		uint32 cursor = 0; // last keyframe found, playback continues from here
 		Interpolation interpolation = Interpolation::LINEAR;
 	};
 
@@ -0,0 +1,64 @@
+#include "DrawList.h"
+
+#include <algorithm>
+
+namespace pr
+{
+	void DrawList::clear()
+	{
+		draws.clear();
+		keys.clear();
+	}
+
+	void DrawList::add(uint32 layer, uint32 pipelineID, uint32 materialID, float depth, Renderable::Ptr renderable, GPU::GraphicsPipeline::Ptr pipeline, int instanceGroup, float lodError, int meshletDraw)
+	{
+		SortKey sortKey;
+		sortKey.key = makeKey(layer, pipelineID, materialID, depth);
+		sortKey.index = static_cast<uint32>(draws.size());
+		keys.push_back(sortKey);
+		draws.push_back({ renderable, pipeline, instanceGroup, lodError, meshletDraw });
+	}
+
+	uint64 DrawList::makeKey(uint32 layer, uint32 pipelineID, uint32 materialID, float depth)
+	{
+		// depth is the normalized view depth, quantized to 24 bits
+		uint64 d = static_cast<uint64>(std::clamp(depth, 0.0f, 1.0f) * 0xFFFFFF);
+		uint64 l = std::min(layer, 0xFFu);
+		uint64 p = pipelineID & 0xFFF;
+		uint64 m = materialID & 0xFFFFF;
+		if (transparent || layer > 0) // the layers above the opaque one are alpha blended
+			return (l << 56) | ((0xFFFFFF - d) << 32) | (p << 20) | m;
+		else
+			return (l << 56) | (p << 44) | (m << 24) | d;
+	}
+
+	void DrawList::sort()
+	{
+		// LSD radix sort with 8 bit digits, digits that are equal for all keys are skipped
+		uint32 count = static_cast<uint32>(keys.size());
+		if (count < 2)
+			return;
+
+		tempKeys.resize(count);
+		for (uint32 shift = 0; shift < 64; shift += 8)
+		{
+			uint32 histogram[256] = {};
+			for (auto& k : keys)
+				histogram[(k.key >> shift) & 0xFF]++;
+			if (histogram[(keys[0].key >> shift) & 0xFF] == count)
+				continue;
+
+			uint32 offset = 0;
+			for (uint32 i = 0; i < 256; i++)
+			{
+				uint32 n = histogram[i];
+				histogram[i] = offset;
+				offset += n;
+			}
+
+			for (auto& k : keys)
+				tempKeys[histogram[(k.key >> shift) & 0xFF]++] = k;
+			keys.swap(tempKeys);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef INCLUDED_DRAWLIST
+#define INCLUDED_DRAWLIST
+
+#pragma once
+
+#include <Core/Renderable.h>
+#include <Platform/Types.h>
+#include <vector>
+
+namespace pr
+{
+	// A list of draws for one render pass, ordered by a 64 bit sort key:
+	// opaque:      layer (8) | pipeline (12) | material (20) | depth front to back (24)
+	// transparent: layer (8) | depth back to front (24) | pipeline (12) | material (20)
+	// In the opaque pass only layer 0 is opaque, the blended layers above use the transparent key.
+	class DrawList
+	{
+	public:
+		struct Draw
+		{
+			Renderable::Ptr renderable;
+			GPU::GraphicsPipeline::Ptr pipeline;
+			int instanceGroup = -1;
+			float lodError = 0.0f; // object space error the LOD of the primitives may have
+			int meshletDraw = -1; // culled index ranges of the primitives, see MeshletCulling
+		};
+
+		DrawList(bool transparent) :
+			transparent(transparent)
+		{}
+
+		void clear();
+		void add(uint32 layer, uint32 pipelineID, uint32 materialID, float depth, Renderable::Ptr renderable, GPU::GraphicsPipeline::Ptr pipeline, int instanceGroup = -1, float lodError = 0.0f, int meshletDraw = -1);
+		void sort();
+		bool empty() { return keys.empty(); }
+		uint32 size() { return static_cast<uint32>(keys.size()); }
+		Draw& getDraw(uint32 index) { return draws[keys[index].index]; }
+
+	private:
+		struct SortKey
+		{
+			uint64 key;
+			uint32 index;
+		};
+
+		uint64 makeKey(uint32 layer, uint32 pipelineID, uint32 materialID, float depth);
+
+		bool transparent;
+		std::vector<Draw> draws;
+		std::vector<SortKey> keys;
+		std::vector<SortKey> tempKeys;
+
+		DrawList(const DrawList&) = delete;
+		DrawList& operator=(const DrawList&) = delete;
+	};
+}
+
+#endif // INCLUDED_DRAWLIST
\ No newline at end of file
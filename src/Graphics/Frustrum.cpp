@@ -50,6 +50,43 @@ namespace Math
 		bottom = Plane(p, glm::cross(frontMultFar + u * halfVSide, r));
 	}
 
+	Frustrum::Frustrum(const glm::mat4& VP)
+	{
+		// extract the planes from the rows of the view projection matrix (Gribb/Hartmann)
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++)
+			rows[i] = glm::vec4(VP[0][i], VP[1][i], VP[2][i], VP[3][i]);
+
+		auto makePlane = [](glm::vec4 coeff) {
+			float len = glm::length(glm::vec3(coeff));
+			Plane plane;
+			plane.normal = glm::vec3(coeff) / len;
+			plane.distance = -coeff.w / len;
+			return plane;
+		};
+
+		left = makePlane(rows[3] + rows[0]);
+		right = makePlane(rows[3] - rows[0]);
+		bottom = makePlane(rows[3] + rows[1]);
+		top = makePlane(rows[3] - rows[1]);
+		nearP = makePlane(rows[3] + rows[2]);
+		farP = makePlane(rows[3] - rows[2]);
+	}
+
+	bool Frustrum::isInside(AABB& worldBox)
+	{
+		return nearP.isInside(worldBox) && farP.isInside(worldBox) &&
+			right.isInside(worldBox) && left.isInside(worldBox) &&
+			top.isInside(worldBox) && bottom.isInside(worldBox);
+	}
+
+	bool Frustrum::isInside(glm::vec3 center, float radius)
+	{
+		return nearP.getSignedDistance(center) >= -radius && farP.getSignedDistance(center) >= -radius &&
+			right.getSignedDistance(center) >= -radius && left.getSignedDistance(center) >= -radius &&
+			top.getSignedDistance(center) >= -radius && bottom.getSignedDistance(center) >= -radius;
+	}
+
 	bool Frustrum::isInside(AABB& bbox, glm::mat4 localToWorld)
 	{
 		glm::vec3 maxPoint = bbox.getMaxPoint();
@@ -169,26 +206,15 @@ namespace Math
 
 	std::vector<glm::mat4> creatCMViews(glm::vec3 position, float zNear, float zFar)
 	{
+		// the faces are tiles of the shadow atlas, the shaders select them with the same table
 		glm::mat4 P = glm::perspective(glm::radians(90.0f), 1.0f, zNear, zFar);
 		std::vector<glm::mat4> VP;
-		if (pr::GraphicsContext::getInstance().getCurrentAPI() == pr::GraphicsAPI::Direct3D11)
-		{
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0, 1.0, 0.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0, 1.0, 0.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, -1.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, 0.0, 1.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0, 1.0, 0.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 0.0, -1.0), glm::vec3(0.0, 1.0, 0.0)));
-		}
-		else
-		{
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, 0.0, -1.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0, -1.0, 0.0)));
-			VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 0.0, -1.0), glm::vec3(0.0, -1.0, 0.0)));
-		}
+		VP.push_back(P * glm::lookAt(position, position + glm::vec3(1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0)));
+		VP.push_back(P * glm::lookAt(position, position + glm::vec3(-1.0, 0.0, 0.0), glm::vec3(0.0, -1.0, 0.0)));
+		VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 1.0, 0.0), glm::vec3(0.0, 0.0, 1.0)));
+		VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, -1.0, 0.0), glm::vec3(0.0, 0.0, -1.0)));
+		VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 0.0, 1.0), glm::vec3(0.0, -1.0, 0.0)));
+		VP.push_back(P * glm::lookAt(position, position + glm::vec3(0.0, 0.0, -1.0), glm::vec3(0.0, -1.0, 0.0)));
 		return VP;
 	}
 }
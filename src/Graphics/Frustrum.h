@@ -28,8 +28,12 @@ namespace Math
 		Plane top;
 		Plane bottom;
 
+		Frustrum() {}
 		Frustrum(FPSCamera& camera);
+		Frustrum(const glm::mat4& VP);
 		bool isInside(AABB& bbox, glm::mat4 localToWorld);
+		bool isInside(AABB& worldBox);
+		bool isInside(glm::vec3 center, float radius);
 	};
 
 	// TODO: integrate in Frustrum class
@@ -130,6 +130,7 @@ namespace pr
 		
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
+#ifdef GPU_BACKEND_OPENGL
 			if (ctx.getCurrentAPI() == GraphicsAPI::OpenGL)
 			{
 				ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
@@ -139,8 +140,9 @@ namespace pr
 				platformIO.Platform_SwapBuffers = GL::Context::swapBuffers;
 				platformIO.Platform_RenderWindow = GL::Context::platformWindow;
 			}
+#endif
 #ifdef GPU_BACKEND_DX11
-			else if (ctx.getCurrentAPI() == GraphicsAPI::Direct3D11)
+			if (ctx.getCurrentAPI() == GraphicsAPI::Direct3D11)
 			{
 				ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
 				platformIO.Renderer_CreateWindow = DX11::Context::createWindow;
@@ -216,9 +218,7 @@ namespace pr
 		auto& ctx = GraphicsContext::getInstance();
 		{
 			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(ImDrawVert);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
+			vertexInputDescription.inputBindings.push_back(GPU::VertexInputBinding(0, sizeof(ImDrawVert)));
 			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector2F, offsetof(ImDrawVert, pos)));
 			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector2F, offsetof(ImDrawVert, uv)));
 			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vectur4UC, offsetof(ImDrawVert, col)));
@@ -239,6 +239,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string versionStr = "#version 460 core\n";
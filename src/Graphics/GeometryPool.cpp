@@ -0,0 +1,195 @@
+#include "GeometryPool.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace pr
+{
+	RangeAllocator::RangeAllocator(uint32 capacity) :
+		capacity(capacity),
+		freeCount(capacity)
+	{
+		if (capacity > 0)
+			freeRanges[0] = capacity;
+	}
+
+	RangeAllocator::~RangeAllocator()
+	{
+
+	}
+
+	bool RangeAllocator::allocate(uint32 count, uint32& offset)
+	{
+		offset = 0;
+		if (count == 0)
+			return true;
+
+		for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+		{
+			if (it->second < count)
+				continue;
+
+			offset = it->first;
+			uint32 remaining = it->second - count;
+			freeRanges.erase(it);
+			if (remaining > 0)
+				freeRanges[offset + count] = remaining;
+			freeCount -= count;
+			return true;
+		}
+		return false;
+	}
+
+	void RangeAllocator::release(uint32 offset, uint32 count)
+	{
+		if (count == 0)
+			return;
+
+		freeCount += count;
+		auto next = freeRanges.lower_bound(offset);
+		if (next != freeRanges.end() && offset + count == next->first)
+		{
+			count += next->second;
+			next = freeRanges.erase(next);
+		}
+
+		if (next != freeRanges.begin())
+		{
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == offset)
+			{
+				prev->second += count;
+				return;
+			}
+		}
+		freeRanges[offset] = count;
+	}
+
+	GeometryRange GeometryPool::allocate(const VertexLayout& layout, uint32 vertexCount, uint32 indexCount)
+	{
+		GeometryRange range;
+		range.vertexCount = vertexCount;
+		range.indexCount = indexCount;
+
+		for (auto block : blocks)
+		{
+			if (!(block->layout == layout))
+				continue;
+			if (!block->vertices.allocate(vertexCount, range.firstVertex))
+				continue;
+			if (!block->indices.allocate(indexCount, range.firstIndex))
+			{
+				block->vertices.release(range.firstVertex, vertexCount);
+				continue;
+			}
+			range.block = block;
+			return range;
+		}
+
+		// primitives larger than a block get a block of their own
+		auto& ctx = GraphicsContext::getInstance();
+		uint32 vertexCapacity = std::max(vertexCount, blockVertices);
+		uint32 indexCapacity = std::max(indexCount, blockIndices);
+		auto block = std::make_shared<GeometryBlock>(layout, vertexCapacity, indexCapacity);
+		block->vertexBuffers.resize(static_cast<uint32>(VertexStream::Count));
+		for (uint32 i = 0; i < block->vertexBuffers.size(); i++)
+		{
+			VertexStream stream = VertexStream(i);
+			if (!layout.hasStream(stream))
+				continue;
+			uint32 stride = VertexLayout::getStride(stream);
+			block->vertexBuffers[i] = ctx.createBuffer(GPU::BufferUsage::VertexBuffer | GPU::BufferUsage::TransferDst, vertexCapacity * stride, stride);
+		}
+		block->indexBuffer = ctx.createBuffer(GPU::BufferUsage::IndexBuffer | GPU::BufferUsage::TransferDst, indexCapacity * sizeof(uint32), sizeof(uint32));
+		block->vertices.allocate(vertexCount, range.firstVertex);
+		block->indices.allocate(indexCount, range.firstIndex);
+		blocks.push_back(block);
+
+		range.block = block;
+		return range;
+	}
+
+	void GeometryPool::uploadVertices(const GeometryRange& range, VertexStream stream, void* data)
+	{
+		if (!range.block || !range.block->layout.hasStream(stream))
+		{
+			std::cout << "error: geometry range has no vertex stream " << static_cast<uint32>(stream) << std::endl;
+			return;
+		}
+
+		uint32 stride = VertexLayout::getStride(stream);
+		auto buffer = range.block->vertexBuffers[static_cast<uint32>(stream)];
+		if (range.vertexCount > 0)
+			buffer->uploadStaged(data, range.firstVertex * stride, range.vertexCount * stride);
+	}
+
+	void GeometryPool::uploadIndices(const GeometryRange& range, void* indices)
+	{
+		if (!range.block)
+		{
+			std::cout << "error: geometry range is not allocated" << std::endl;
+			return;
+		}
+
+		if (range.indexCount > 0)
+			range.block->indexBuffer->uploadStaged(indices, range.firstIndex * sizeof(uint32), range.indexCount * sizeof(uint32));
+	}
+
+	void GeometryPool::bind(GPU::CommandBuffer::Ptr cmdBuffer, const GeometryRange& range)
+	{
+		// the buffers are shared with the other primitives of the block, so the binds are mostly skipped
+		auto block = range.block;
+		for (uint32 i = 0; i < block->vertexBuffers.size(); i++)
+		{
+			auto buffer = block->vertexBuffers[i];
+			if (!buffer)
+				buffer = getDefaultBuffer(VertexStream(i));
+			cmdBuffer->bindVertexBuffers(i, buffer);
+		}
+		if (range.indexCount > 0)
+			cmdBuffer->bindIndexBuffers(block->indexBuffer, GPU::IndexType::uint32);
+	}
+
+	void GeometryPool::release(GeometryRange& range)
+	{
+		auto block = range.block;
+		if (!block)
+			return;
+
+		block->vertices.release(range.firstVertex, range.vertexCount);
+		block->indices.release(range.firstIndex, range.indexCount);
+		range = GeometryRange();
+
+		// keep one block around, so loading the next scene does not recreate the buffers
+		bool empty = block->vertices.getFreeCount() == block->vertices.getCapacity() &&
+			block->indices.getFreeCount() == block->indices.getCapacity();
+		if (empty && blocks.size() > 1)
+			blocks.erase(std::remove(blocks.begin(), blocks.end(), block), blocks.end());
+	}
+
+	void GeometryPool::clear()
+	{
+		// ranges that are still in use keep their block alive until they are released
+		blocks.clear();
+		defaultBuffers.clear();
+	}
+
+	GPU::Buffer::Ptr GeometryPool::getDefaultBuffer(VertexStream stream)
+	{
+		uint32 index = static_cast<uint32>(stream);
+		if (defaultBuffers.empty())
+			defaultBuffers.resize(static_cast<uint32>(VertexStream::Count));
+
+		if (!defaultBuffers[index])
+		{
+			std::vector<uint8> data;
+			VertexLayout::encodeDefault(stream, data);
+
+			auto& ctx = GraphicsContext::getInstance();
+			uint32 size = static_cast<uint32>(data.size());
+			defaultBuffers[index] = ctx.createBuffer(GPU::BufferUsage::VertexBuffer | GPU::BufferUsage::TransferDst, size, 0);
+			defaultBuffers[index]->uploadStaged(data.data(), 0, size);
+		}
+		return defaultBuffers[index];
+	}
+}
\ No newline at end of file
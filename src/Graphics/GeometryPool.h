@@ -0,0 +1,113 @@
+#ifndef INCLUDED_GEOMETRYPOOL
+#define INCLUDED_GEOMETRYPOOL
+
+#pragma once
+
+#include <Graphics/GraphicsContext.h>
+#include <Graphics/VertexLayout.h>
+#include <Platform/Types.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace pr
+{
+	// First fit allocator for ranges of elements. The free ranges are kept sorted by their
+	// offset, so a released range is merged with its free neighbours right away.
+	class RangeAllocator
+	{
+	public:
+		RangeAllocator(uint32 capacity);
+		~RangeAllocator();
+
+		bool allocate(uint32 count, uint32& offset);
+		void release(uint32 offset, uint32 count);
+		uint32 getCapacity()
+		{
+			return capacity;
+		}
+		uint32 getFreeCount()
+		{
+			return freeCount;
+		}
+
+	private:
+		std::map<uint32, uint32> freeRanges; // offset -> count
+		uint32 capacity;
+		uint32 freeCount;
+
+		RangeAllocator(const RangeAllocator&) = delete;
+		RangeAllocator& operator=(const RangeAllocator&) = delete;
+	};
+
+	// Shared vertex streams and index buffer, all primitives in a block have the same vertex layout.
+	// Only the streams of the layout have a buffer, the vertex range is the same in all of them.
+	struct GeometryBlock
+	{
+		std::vector<GPU::Buffer::Ptr> vertexBuffers; // one per stream
+		GPU::Buffer::Ptr indexBuffer;
+		VertexLayout layout;
+		RangeAllocator vertices;
+		RangeAllocator indices;
+
+		GeometryBlock(const VertexLayout& layout, uint32 vertexCapacity, uint32 indexCapacity) :
+			layout(layout),
+			vertices(vertexCapacity),
+			indices(indexCapacity)
+		{
+
+		}
+		typedef std::shared_ptr<GeometryBlock> Ptr;
+	};
+
+	// The part of a block used by one primitive. The indices are relative to the first vertex,
+	// which is passed as base vertex to the draw call.
+	struct GeometryRange
+	{
+		GeometryBlock::Ptr block;
+		uint32 firstVertex = 0;
+		uint32 vertexCount = 0;
+		uint32 firstIndex = 0;
+		uint32 indexCount = 0;
+	};
+
+	// Sub-allocates the geometry of all primitives from a few large vertex and index buffers,
+	// instead of creating two buffers per primitive. Primitives in the same block share their
+	// buffer bindings, so draws only differ in the first index and base vertex. A new block is
+	// created when no block has enough space left and empty blocks are dropped from the pool.
+	class GeometryPool
+	{
+	public:
+		GeometryRange allocate(const VertexLayout& layout, uint32 vertexCount, uint32 indexCount);
+		void uploadVertices(const GeometryRange& range, VertexStream stream, void* data);
+		void uploadIndices(const GeometryRange& range, void* indices);
+		void bind(GPU::CommandBuffer::Ptr cmdBuffer, const GeometryRange& range);
+		void release(GeometryRange& range);
+		void clear();
+		uint32 getNumBlocks()
+		{
+			return static_cast<uint32>(blocks.size());
+		}
+		static GeometryPool& getInstance()
+		{
+			static GeometryPool instance;
+			return instance;
+		}
+
+		static const uint32 blockVertices = 1 << 18;
+		static const uint32 blockIndices = 1 << 20;
+
+	private:
+		GeometryPool() {}
+		GPU::Buffer::Ptr getDefaultBuffer(VertexStream stream);
+
+		std::vector<GeometryBlock::Ptr> blocks;
+		std::vector<GPU::Buffer::Ptr> defaultBuffers; // single default value per stream, bound with a stride of 0
+
+		GeometryPool(const GeometryPool&) = delete;
+		GeometryPool& operator=(const GeometryPool&) = delete;
+	};
+}
+
+#endif // INCLUDED_GEOMETRYPOOL
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "GraphicsContext.h"
+#include "GeometryPool.h"
+#include "JointPalette.h"
 
 
 namespace pr
@@ -11,15 +13,22 @@ namespace pr
 #ifdef GPU_BACKEND_DX11
 			case GraphicsAPI::Direct3D11 : context = DX11::Context::create(); break;
 #endif
+#ifdef GPU_BACKEND_OPENGL
 			case GraphicsAPI::OpenGL: context = GL::Context::create(window); break;
+#endif
 #ifdef GPU_BACKEND_VULKAN
 			case GraphicsAPI::Vulkan: context = VK::Context::create(); break;
+#endif
+#ifdef GPU_BACKEND_NULL
+			case GraphicsAPI::Null: context = Null::Context::create(); break;
 #endif
 		}
 	}
 
 	void GraphicsContext::destroy()
 	{		
+		GeometryPool::getInstance().clear();
+		JointPalette::getInstance().clear();
 		context.reset();
 	}
 
@@ -30,13 +39,16 @@ namespace pr
 
 	void GraphicsContext::makeCurrent()
 	{
+#ifdef GPU_BACKEND_OPENGL
 		if (api == GraphicsAPI::OpenGL)
 		{
 			auto glContext = std::dynamic_pointer_cast<GL::Context>(context);
 			glContext->makeCurrent();
 		}
+#endif
 	}
 
+#ifdef GPU_BACKEND_OPENGL
 	void GraphicsContext::makeCurrent(HDC hDc)
 	{
 		if (api == GraphicsAPI::OpenGL)
@@ -45,6 +57,7 @@ namespace pr
 			glContext->makeCurrent(hDc);
 		}
 	}
+#endif
 
 	GPU::Buffer::Ptr GraphicsContext::createBuffer(GPU::BufferUsage usage, uint32 size, uint32 stride)
 	{
@@ -96,6 +109,11 @@ namespace pr
 		return context->createSwapchain(window);
 	}
 
+	GPU::UniformAllocator::Ptr GraphicsContext::createUniformAllocator(uint32 blockSize, uint32 maxBlocks)
+	{
+		return context->createUniformAllocator(blockSize, maxBlocks);
+	}
+
 	void GraphicsContext::submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf)
 	{
 		context->submitCommandBuffer(swapchain, nextCmdBuf);
@@ -6,13 +6,18 @@
 #include <Platform/Types.h>
 #include <Platform/Window.h>
 
+#ifdef GPU_BACKEND_OPENGL
 #include <GPU/GL/GLContext.h>
+#endif
 #ifdef GPU_BACKEND_DX11
 #include <GPU/DX11/DX11Context.h>
 #endif
 #ifdef GPU_BACKEND_VULKAN
 #include <GPU/VK/VKContext.h>
 #endif
+#ifdef GPU_BACKEND_NULL
+#include <GPU/Null/NullContext.h>
+#endif
 
 namespace pr
 {
@@ -20,7 +25,8 @@ namespace pr
 	{
 		Direct3D11,
 		OpenGL,
-		Vulkan
+		Vulkan,
+		Null
 	};
 	class GraphicsRessource
 	{
@@ -52,11 +58,14 @@ namespace pr
 		GPU::ImageDescriptor::Ptr createImageDescriptor(GPU::Image::Ptr image, GPU::ImageView::Ptr view, GPU::Sampler::Ptr sampler);
 		GPU::Sampler::Ptr createSampler(uint32 levels);
 		GPU::Swapchain::Ptr createSwapchain(Window::Ptr window);
+		GPU::UniformAllocator::Ptr createUniformAllocator(uint32 blockSize, uint32 maxBlocks);
 		void submitCommandBuffer(GPU::Swapchain::Ptr swapchain, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void submitCommandBuffer(GPU::CommandBuffer::Ptr prevCmdBuf, GPU::CommandBuffer::Ptr nextCmdBuf);
 		void waitDeviceIdle();
 		void makeCurrent();
+#ifdef GPU_BACKEND_OPENGL
 		void makeCurrent(HDC hDc);
+#endif
 		GraphicsAPI getCurrentAPI() { return api; }
 		GPU::Context::Ptr getContext()
 		{
@@ -0,0 +1,73 @@
+#include "JointPalette.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace pr
+{
+	bool JointPalette::allocate(uint32 numJoints, uint32& offset)
+	{
+		if (!joints.allocate(numJoints, offset))
+		{
+			std::cout << "error: joint palette is full, max. joints: " << maxJoints << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	void JointPalette::release(uint32 offset, uint32 numJoints)
+	{
+		joints.release(offset, numJoints);
+	}
+
+	void JointPalette::write(uint32 offset, const std::vector<glm::vec4>& jointRows)
+	{
+		if (rows.empty())
+			rows.resize(maxJoints * 3, glm::vec4(0.0f));
+
+		uint32 first = offset * 3;
+		uint32 count = static_cast<uint32>(jointRows.size());
+		std::copy(jointRows.begin(), jointRows.end(), rows.begin() + first);
+		dirtyBegin = std::min(dirtyBegin, first);
+		dirtyEnd = std::max(dirtyEnd, first + count);
+	}
+
+	void JointPalette::upload()
+	{
+		if (dirtyBegin >= dirtyEnd)
+			return;
+
+		uint32 rowSize = sizeof(glm::vec4);
+		getBuffer()->uploadStaged(rows.data() + dirtyBegin, dirtyBegin * rowSize, (dirtyEnd - dirtyBegin) * rowSize);
+		dirtyBegin = maxJoints * 3;
+		dirtyEnd = 0;
+	}
+
+	void JointPalette::clear()
+	{
+		// the buffer belongs to the context, ranges of skins that are still alive stay allocated
+		// and are uploaded again to the buffer of the next context
+		buffer = nullptr;
+		if (!rows.empty())
+		{
+			dirtyBegin = 0;
+			dirtyEnd = static_cast<uint32>(rows.size());
+		}
+	}
+
+	GPU::Buffer::Ptr JointPalette::getBuffer()
+	{
+		if (buffer == nullptr)
+		{
+			auto& ctx = GraphicsContext::getInstance();
+			buffer = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::StorageBuffer, maxJoints * 3 * sizeof(glm::vec4), 0);
+		}
+		return buffer;
+	}
+
+	bool JointPalette::isSupported()
+	{
+		GraphicsAPI api = GraphicsContext::getInstance().getCurrentAPI();
+		return api == GraphicsAPI::OpenGL || api == GraphicsAPI::Null;
+	}
+}
\ No newline at end of file
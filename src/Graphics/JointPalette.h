@@ -0,0 +1,56 @@
+#ifndef INCLUDED_JOINTPALETTE
+#define INCLUDED_JOINTPALETTE
+
+#pragma once
+
+#include <Graphics/GeometryPool.h>
+#include <Platform/Types.h>
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace pr
+{
+	// Joint matrices of all skins in one storage buffer. Every skin gets a range of it and passes
+	// the offset of that range to the shaders, so the number of joints is not limited by the size
+	// of a uniform block. A joint is stored as the three rows of its affine matrix, the shaders
+	// derive the normal matrix from them. Only the ranges written since the last upload are copied.
+	class JointPalette
+	{
+	public:
+		bool allocate(uint32 numJoints, uint32& offset);
+		void release(uint32 offset, uint32 numJoints);
+		void write(uint32 offset, const std::vector<glm::vec4>& jointRows);
+		void upload();
+		void clear();
+		GPU::Buffer::Ptr getBuffer();
+
+		// the storage buffer is only read by the GLSL sources that are compiled at runtime
+		static bool isSupported();
+		static JointPalette& getInstance()
+		{
+			static JointPalette instance;
+			return instance;
+		}
+
+		static const uint32 maxJoints = 1 << 16;
+
+	private:
+		JointPalette() :
+			joints(maxJoints)
+		{
+
+		}
+
+		RangeAllocator joints;
+		std::vector<glm::vec4> rows;
+		GPU::Buffer::Ptr buffer;
+		uint32 dirtyBegin = maxJoints * 3; // rows written since the last upload
+		uint32 dirtyEnd = 0;
+
+		JointPalette(const JointPalette&) = delete;
+		JointPalette& operator=(const JointPalette&) = delete;
+	};
+}
+
+#endif // INCLUDED_JOINTPALETTE
\ No newline at end of file
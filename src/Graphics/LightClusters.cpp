@@ -0,0 +1,203 @@
+#include "LightClusters.h"
+#include <Graphics/GraphicsContext.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace pr
+{
+	// lights without a range are culled where their intensity falls below this value
+	const float minLightIntensity = 0.001f;
+
+	LightClusters::LightClusters()
+	{
+
+	}
+
+	LightClusters::~LightClusters()
+	{
+
+	}
+
+	void LightClusters::init(GPU::DescriptorPool::Ptr descriptorPool)
+	{
+		auto& ctx = GraphicsContext::getInstance();
+
+		const uint32 headerSize = sizeof(ClusterGridHeader) / sizeof(uint32);
+		lightData.resize(maxLights);
+		clusterData.resize(headerSize + numClusters * 2, 0);
+		indexData.resize(maxLightIndices, 0);
+		clusterCounts.resize(numClusters, 0);
+
+		auto usage = GPU::BufferUsage::TransferDst | GPU::BufferUsage::StorageBuffer;
+		lightBuffer = ctx.createBuffer(usage, maxLights * sizeof(LightUniformData), 0);
+		clusterBuffer = ctx.createBuffer(usage, static_cast<uint32>(clusterData.size() * sizeof(uint32)), 0);
+		indexBuffer = ctx.createBuffer(usage, maxLightIndices * sizeof(uint32), 0);
+		lightBuffer->uploadMapped(lightData.data());
+		clusterBuffer->uploadMapped(clusterData.data());
+		indexBuffer->uploadMapped(indexData.data());
+
+		descriptorSet = descriptorPool->createDescriptorSet("Clusters", 1);
+		descriptorSet->addDescriptor(lightBuffer->getDescriptor());
+		descriptorSet->addDescriptor(clusterBuffer->getDescriptor());
+		descriptorSet->addDescriptor(indexBuffer->getDescriptor());
+		descriptorSet->update();
+	}
+
+	void LightClusters::update(const std::vector<LightUniformData>& lights, const glm::mat4& V, const glm::mat4& P, float zNear, float zFar, uint32 width, uint32 height)
+	{
+		if (!descriptorSet)
+			return;
+
+		uint32 numLights = static_cast<uint32>(lights.size());
+		if (numLights > maxLights)
+		{
+			std::cout << "error: too many lights for clustering, max. lights: " << maxLights << std::endl;
+			numLights = maxLights;
+		}
+		std::copy(lights.begin(), lights.begin() + numLights, lightData.begin());
+
+		// exponential depth slices, the same distribution as used for the volumes
+		sliceScale = static_cast<float>(slices) / std::log2(zFar / zNear);
+		sliceBias = -std::log2(zNear) * sliceScale;
+
+		// find the clusters that each light overlaps and count the lights per cluster
+		visibleLights.clear();
+		std::fill(clusterCounts.begin(), clusterCounts.end(), 0);
+		for (uint32 i = 0; i < numLights; i++)
+		{
+			LightBounds bounds;
+			bounds.index = i;
+			if (!lights[i].on || !getClusterBounds(lights[i], V, P, zNear, zFar, bounds.minCluster, bounds.maxCluster))
+				continue;
+
+			for (uint32 z = bounds.minCluster.z; z <= bounds.maxCluster.z; z++)
+				for (uint32 y = bounds.minCluster.y; y <= bounds.maxCluster.y; y++)
+					for (uint32 x = bounds.minCluster.x; x <= bounds.maxCluster.x; x++)
+						clusterCounts[(z * tilesY + y) * tilesX + x]++;
+			visibleLights.push_back(bounds);
+		}
+
+		// prefix sum over the counts gives the offset of each cluster in the index list
+		ClusterGridHeader header;
+		header.size = glm::uvec4(tilesX, tilesY, slices, numLights);
+		header.scale = glm::vec4((float)tilesX / (float)width, (float)tilesY / (float)height, sliceScale, sliceBias);
+		std::memcpy(clusterData.data(), &header, sizeof(header));
+
+		uint32* grid = clusterData.data() + sizeof(ClusterGridHeader) / sizeof(uint32);
+		uint32 offset = 0;
+		bool overflow = false;
+		for (uint32 c = 0; c < numClusters; c++)
+		{
+			uint32 count = std::min(clusterCounts[c], maxLightIndices - offset);
+			overflow |= (count < clusterCounts[c]);
+			grid[c * 2 + 0] = offset;
+			grid[c * 2 + 1] = 0;
+			clusterCounts[c] = count;
+			offset += count;
+		}
+		if (overflow)
+			std::cout << "error: light index list is full, max. indices: " << maxLightIndices << std::endl;
+
+		// fill the index lists, lights stay in scene order inside a cluster
+		for (auto& bounds : visibleLights)
+		{
+			for (uint32 z = bounds.minCluster.z; z <= bounds.maxCluster.z; z++)
+			{
+				for (uint32 y = bounds.minCluster.y; y <= bounds.maxCluster.y; y++)
+				{
+					for (uint32 x = bounds.minCluster.x; x <= bounds.maxCluster.x; x++)
+					{
+						uint32 c = (z * tilesY + y) * tilesX + x;
+						uint32& count = grid[c * 2 + 1];
+						if (count < clusterCounts[c])
+						{
+							indexData[grid[c * 2] + count] = bounds.index;
+							count++;
+						}
+					}
+				}
+			}
+		}
+
+		lightBuffer->uploadMapped(lightData.data());
+		clusterBuffer->uploadMapped(clusterData.data());
+		indexBuffer->uploadMapped(indexData.data());
+	}
+
+	bool LightClusters::getClusterBounds(const LightUniformData& light, const glm::mat4& V, const glm::mat4& P, float zNear, float zFar, glm::uvec3& minCluster, glm::uvec3& maxCluster)
+	{
+		minCluster = glm::uvec3(0);
+		maxCluster = glm::uvec3(tilesX - 1, tilesY - 1, slices - 1);
+
+		// directional lights affect every cluster
+		if (light.type == static_cast<int>(LightType::DIRECTIONAL))
+			return true;
+
+		float radius = light.range;
+		if (radius <= 0.0f)
+		{
+			float maxIntensity = light.intensity * glm::max(light.color.r, glm::max(light.color.g, light.color.b));
+			radius = glm::sqrt(glm::max(maxIntensity, 0.0f) / minLightIntensity);
+		}
+
+		glm::vec3 center = glm::vec3(light.position);
+		if (light.type == static_cast<int>(LightType::SPOT))
+		{
+			// bounding sphere of the cone, the outer angle is restored from the scale and offset
+			glm::vec3 dir = glm::normalize(glm::vec3(light.direction));
+			float cosOuter = glm::clamp(-light.angleOffset / light.angleScale, 0.0f, 1.0f);
+			if (cosOuter < glm::cos(glm::quarter_pi<float>()))
+			{
+				center += dir * radius * cosOuter;
+				radius = radius * glm::sqrt(1.0f - cosOuter * cosOuter);
+			}
+			else
+			{
+				radius = radius / (2.0f * glm::max(cosOuter, 0.001f));
+				center += dir * radius;
+			}
+		}
+
+		glm::vec3 viewCenter = glm::vec3(V * glm::vec4(center, 1.0f));
+		float depth = -viewCenter.z;
+		if (depth + radius < zNear || depth - radius > zFar)
+			return false;
+
+		minCluster.z = getSlice(glm::max(depth - radius, zNear));
+		maxCluster.z = getSlice(glm::min(depth + radius, zFar));
+
+		// lights that intersect the near plane cover the whole screen
+		if (depth - radius <= zNear)
+			return true;
+
+		// project the corners of the view space box around the sphere
+		glm::vec2 ndcMin = glm::vec2(1.0f);
+		glm::vec2 ndcMax = glm::vec2(-1.0f);
+		for (int i = 0; i < 8; i++)
+		{
+			glm::vec3 offset = glm::vec3((i & 1) ? radius : -radius, (i & 2) ? radius : -radius, (i & 4) ? radius : -radius);
+			glm::vec4 clip = P * glm::vec4(viewCenter + offset, 1.0f);
+			glm::vec2 ndc = glm::vec2(clip) / clip.w;
+			ndcMin = glm::min(ndcMin, ndc);
+			ndcMax = glm::max(ndcMax, ndc);
+		}
+		if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f)
+			return false;
+
+		glm::vec2 tileMin = (glm::clamp(ndcMin, -1.0f, 1.0f) * 0.5f + 0.5f) * glm::vec2(tilesX, tilesY);
+		glm::vec2 tileMax = (glm::clamp(ndcMax, -1.0f, 1.0f) * 0.5f + 0.5f) * glm::vec2(tilesX, tilesY);
+		minCluster.x = glm::min(static_cast<uint32>(tileMin.x), tilesX - 1);
+		minCluster.y = glm::min(static_cast<uint32>(tileMin.y), tilesY - 1);
+		maxCluster.x = glm::min(static_cast<uint32>(tileMax.x), tilesX - 1);
+		maxCluster.y = glm::min(static_cast<uint32>(tileMax.y), tilesY - 1);
+		return true;
+	}
+
+	uint32 LightClusters::getSlice(float depth)
+	{
+		float slice = std::log2(depth) * sliceScale + sliceBias;
+		return static_cast<uint32>(glm::clamp(slice, 0.0f, static_cast<float>(slices - 1)));
+	}
+}
\ No newline at end of file
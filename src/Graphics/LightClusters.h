@@ -0,0 +1,75 @@
+#ifndef INCLUDED_LIGHTCLUSTERS
+#define INCLUDED_LIGHTCLUSTERS
+
+#pragma once
+
+#include <Core/Light.h>
+#include <GPU/DescriptorPool.h>
+#include <GPU/Buffer.h>
+#include <Platform/Types.h>
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace pr
+{
+	struct ClusterGridHeader
+	{
+		glm::uvec4 size;	// tiles in x and y, depth slices, number of lights
+		glm::vec4 scale;	// pixels to tiles (xy), depth slice scale and bias (zw)
+	};
+
+	// Assigns the punctual lights to a froxel grid over the view frustum. The grid has screen
+	// space tiles in x and y and exponential depth slices in z. Each light is bound by a sphere
+	// (spot lights by the bounding sphere of their cone), which is binned on the CPU into all
+	// clusters it overlaps. The lights, the grid (offset and count per cluster) and the light
+	// index lists are stored in storage buffers, so a fragment only loops over its cluster.
+	class LightClusters
+	{
+	public:
+		LightClusters();
+		~LightClusters();
+
+		void init(GPU::DescriptorPool::Ptr descriptorPool);
+		void update(const std::vector<LightUniformData>& lights, const glm::mat4& V, const glm::mat4& P, float zNear, float zFar, uint32 width, uint32 height);
+		GPU::DescriptorSet::Ptr getDescriptorSet()
+		{
+			return descriptorSet;
+		}
+
+		static const uint32 maxLights = 1024;
+		static const uint32 maxLightIndices = 65536;
+		static const uint32 tilesX = 16;
+		static const uint32 tilesY = 9;
+		static const uint32 slices = 24;
+		static const uint32 numClusters = tilesX * tilesY * slices;
+
+	private:
+		bool getClusterBounds(const LightUniformData& light, const glm::mat4& V, const glm::mat4& P, float zNear, float zFar, glm::uvec3& minCluster, glm::uvec3& maxCluster);
+		uint32 getSlice(float depth);
+
+		GPU::Buffer::Ptr lightBuffer;
+		GPU::Buffer::Ptr clusterBuffer;
+		GPU::Buffer::Ptr indexBuffer;
+		GPU::DescriptorSet::Ptr descriptorSet;
+
+		struct LightBounds
+		{
+			uint32 index;
+			glm::uvec3 minCluster;
+			glm::uvec3 maxCluster;
+		};
+		std::vector<LightBounds> visibleLights;
+		std::vector<LightUniformData> lightData;
+		std::vector<uint32> clusterData;
+		std::vector<uint32> indexData;
+		std::vector<uint32> clusterCounts;
+		float sliceScale = 0.0f;
+		float sliceBias = 0.0f;
+
+		LightClusters(const LightClusters&) = delete;
+		LightClusters& operator=(const LightClusters&) = delete;
+	};
+}
+
+#endif // INCLUDED_LIGHTCLUSTERS
\ No newline at end of file
@@ -1,3 +1,19 @@
 #include "Material.h"
 
-uint32 pr::Material::matCount = 0;
\ No newline at end of file
+uint32 pr::Material::matCount = 0;
+
+namespace pr
+{
+	uint32 Material::registerShader(const std::string& shaderName)
+	{
+		// shader names are interned so render queues can be keyed by integer pipeline IDs
+		static std::map<std::string, uint32> shaderIDs;
+		auto it = shaderIDs.find(shaderName);
+		if (it != shaderIDs.end())
+			return it->second;
+
+		uint32 id = static_cast<uint32>(shaderIDs.size());
+		shaderIDs.insert(std::make_pair(shaderName, id));
+		return id;
+	}
+}
\ No newline at end of file
@@ -158,6 +158,7 @@ namespace pr
 		{
 			matID = matCount;
 			matCount++;
+			shaderID = registerShader(shaderName);
 		}
 		~Material() {}
 
@@ -404,6 +405,8 @@ namespace pr
 		void setShaderName(std::string shaderName)
 		{
 			this->shaderName = shaderName;
+			shaderID = registerShader(shaderName);
+			RenderQueueVersion::state++;
 		}
 
 		std::string getName()
@@ -416,6 +419,11 @@ namespace pr
 			return shaderName;
 		}
 
+		uint32 getShaderID()
+		{
+			return shaderID;
+		}
+
 		std::vector<Property::Ptr> getProperties()
 		{
 			return properties;
@@ -443,6 +451,7 @@ namespace pr
 		}
 
 		static uint32 matCount;
+		static uint32 registerShader(const std::string& shaderName);
 		uint32 getID()
 		{
 			return matID;
@@ -452,6 +461,7 @@ namespace pr
 		{
 			alphaMode = mode;
 			alphaCutOff = cutOff;
+			RenderQueueVersion::state++;
 		}
 
 		void setMainColor(glm::vec4 color)
@@ -461,6 +471,7 @@ namespace pr
 		
 	private:
 		uint32 matID;
+		uint32 shaderID;
 		std::string name;
 		std::string shaderName;
 
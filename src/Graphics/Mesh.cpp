@@ -27,7 +27,7 @@ namespace pr
 			subMesh.primitive->flipWindingOrder();
 	}
 
-	void Mesh::draw(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline)
+	void Mesh::draw(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, float lodError)
 	{
 		for (auto subMesh : subMeshes)
 		{
@@ -44,7 +44,7 @@ namespace pr
 
 				mat->bindMainMat(cmdBuffer, pipeline);
 				subMesh.primitive->bind(cmdBuffer, pipeline);
-				subMesh.primitive->draw(cmdBuffer);
+				subMesh.primitive->draw(cmdBuffer, lodError);
 
 				if (mat->isDoubleSided())
 					cmdBuffer->setCullMode(2);
@@ -52,6 +52,32 @@ namespace pr
 		}
 	}
 
+	void Mesh::drawCulled(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, GPU::Buffer::Ptr indexBuffer, const std::vector<DrawRange>& ranges, float lodError)
+	{
+		// culled primitives are drawn from their range of the index buffer, the others as usual
+		for (uint32 i = 0; i < subMeshes.size(); i++)
+		{
+			auto& subMesh = subMeshes[i];
+			auto& range = ranges[i];
+			if (range.culled && range.indexCount == 0)
+				continue;
+
+			auto mat = subMesh.material;
+			if (mat->isDoubleSided())
+				cmdBuffer->setCullMode(0);
+
+			mat->bindMainMat(cmdBuffer, pipeline);
+			subMesh.primitive->bind(cmdBuffer, pipeline);
+			if (range.culled)
+				subMesh.primitive->drawIndices(cmdBuffer, indexBuffer, range.firstIndex, range.indexCount);
+			else
+				subMesh.primitive->draw(cmdBuffer, lodError);
+
+			if (mat->isDoubleSided())
+				cmdBuffer->setCullMode(2);
+		}
+	}
+
 	void Mesh::drawDepth(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline)
 	{
 		for (auto subMesh : subMeshes)
@@ -70,6 +96,23 @@ namespace pr
 		}
 	}
 
+	void Mesh::drawInstanced(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, uint32 instanceCount, float lodError)
+	{
+		for (auto subMesh : subMeshes)
+		{
+			auto mat = subMesh.material;
+
+			if (mat->isDoubleSided())
+				cmdBuffer->setCullMode(0);
+
+			mat->bindMainMat(cmdBuffer, pipeline);
+			subMesh.primitive->drawInstanced(cmdBuffer, instanceCount, lodError);
+
+			if (mat->isDoubleSided())
+				cmdBuffer->setCullMode(2);
+		}
+	}
+
 	void Mesh::setDescriptor(GPU::DescriptorPool::Ptr descriptorPool)
 	{
 		for (auto subMesh : subMeshes)
@@ -117,7 +160,7 @@ namespace pr
 	AABB Mesh::getBoundingBox()
 	{
 		AABB boundingBox;
-		for (auto subMesh : subMeshes)
+		for (auto& subMesh : subMeshes)
 			boundingBox.expand(subMesh.primitive->getBoundingBox());
 		return boundingBox;
 	}
@@ -139,6 +182,7 @@ namespace pr
 			if (index < subMesh.variants.size())
 				subMesh.material = subMesh.variants[index];
 		}
+		RenderQueueVersion::state++;
 	}
 
 	std::string Mesh::getShaderName()
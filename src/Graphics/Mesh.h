@@ -30,8 +30,10 @@ namespace pr
 		void addVariant(std::string name);
 		void setMorphWeights(std::vector<float>& weights);
 		void flipWindingOrder();
-		void draw(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline);
+		void draw(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, float lodError = 0.0f);
+		void drawCulled(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, GPU::Buffer::Ptr indexBuffer, const std::vector<DrawRange>& ranges, float lodError = 0.0f);
 		void drawDepth(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline);
+		void drawInstanced(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, uint32 instanceCount, float lodError = 0.0f);
 		void setDescriptor(GPU::DescriptorPool::Ptr descriptorPool);
 		void setMaterial(unsigned int index, pr::Material::Ptr material);
 		bool hasMorphTargets();
@@ -0,0 +1,101 @@
+#include "MeshletCulling.h"
+#include <Graphics/GraphicsContext.h>
+#include <algorithm>
+
+namespace pr
+{
+	MeshletCulling::MeshletCulling()
+	{
+
+	}
+
+	MeshletCulling::~MeshletCulling()
+	{
+
+	}
+
+	void MeshletCulling::clear()
+	{
+		draws.clear();
+		indices.clear();
+		numMeshlets = 0;
+		numVisibleMeshlets = 0;
+	}
+
+	int MeshletCulling::cull(Renderable::Ptr renderable, Math::Frustrum& frustum, glm::vec3 cameraPosition, float lodError)
+	{
+		// the bounds of skinned or morphed meshes don't match the posed vertices
+		if (renderable->isSkinnedMesh() || renderable->hasMorphtargets())
+			return -1;
+
+		// spheres are tested in world space, the cones in object space where the meshlet
+		// normals are, facing is kept by any affine transform
+		glm::mat4 M = renderable->getLocalToWorld();
+		glm::vec3 localCamera = glm::vec3(glm::inverse(M) * glm::vec4(cameraPosition, 1.0f));
+		float scale = glm::max(glm::length(glm::vec3(M[0])), glm::max(glm::length(glm::vec3(M[1])), glm::length(glm::vec3(M[2]))));
+
+		auto& subMeshes = renderable->getMesh()->getSubMeshes();
+		std::vector<DrawRange> ranges(subMeshes.size());
+		bool culled = false;
+		for (uint32 i = 0; i < subMeshes.size(); i++)
+		{
+			auto& subMesh = subMeshes[i];
+			auto& meshlets = subMesh.primitive->getMeshlets();
+			if (meshlets.size() < minMeshlets || !subMesh.primitive->usesFullDetail(lodError))
+				continue;
+
+			bool cullBackfaces = subMesh.material && !subMesh.material->isDoubleSided();
+			auto& primIndices = subMesh.primitive->getIndices();
+			DrawRange& range = ranges[i];
+			range.culled = true;
+			range.firstIndex = static_cast<uint32>(indices.size());
+			for (auto& m : meshlets)
+			{
+				glm::vec3 center = glm::vec3(M * glm::vec4(m.center, 1.0f));
+				if (!frustum.isInside(center, m.radius * scale))
+					continue;
+
+				if (cullBackfaces)
+				{
+					glm::vec3 dir = m.center - localCamera;
+					if (glm::dot(dir, m.coneAxis) >= m.coneCutoff * glm::length(dir) + m.radius)
+						continue;
+				}
+
+				auto first = primIndices.begin() + m.firstIndex;
+				indices.insert(indices.end(), first, first + m.triangleCount * 3);
+				numVisibleMeshlets++;
+			}
+			range.indexCount = static_cast<uint32>(indices.size()) - range.firstIndex;
+			numMeshlets += static_cast<uint32>(meshlets.size());
+			culled = true;
+		}
+
+		if (!culled)
+			return -1;
+
+		draws.push_back(ranges);
+		return static_cast<int>(draws.size() - 1);
+	}
+
+	void MeshletCulling::upload()
+	{
+		if (indices.empty())
+			return;
+
+		uint32 count = static_cast<uint32>(indices.size());
+		if (count > capacity)
+		{
+			auto& ctx = GraphicsContext::getInstance();
+			capacity = std::max(count, capacity * 2);
+			indexBuffer = ctx.createBuffer(GPU::BufferUsage::IndexBuffer | GPU::BufferUsage::TransferDst, capacity * sizeof(uint32), sizeof(uint32));
+		}
+		indexBuffer->uploadStaged(indices.data(), 0, count * sizeof(uint32));
+	}
+
+	void MeshletCulling::draw(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, Renderable::Ptr renderable, int drawIndex, float lodError)
+	{
+		// primitives without meshlets still select their LOD on their own
+		renderable->renderCulled(cmdBuffer, pipeline, indexBuffer, draws[drawIndex], lodError);
+	}
+}
\ No newline at end of file
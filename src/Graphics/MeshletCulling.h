@@ -0,0 +1,62 @@
+#ifndef INCLUDED_MESHLETCULLING
+#define INCLUDED_MESHLETCULLING
+
+#pragma once
+
+#include <Core/Renderable.h>
+#include <Graphics/Frustrum.h>
+#include <GPU/Buffer.h>
+#include <Platform/Types.h>
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace pr
+{
+	// Culls the meshlets of large primitives on the CPU, against the view frustum and by their
+	// normal cones. The indices of the remaining meshlets are compacted into one index buffer
+	// that is refilled every frame, the primitives are then drawn from their range in it.
+	// Smaller primitives and LOD levels other than the full detail are drawn as usual.
+	class MeshletCulling
+	{
+	public:
+		MeshletCulling();
+		~MeshletCulling();
+
+		void clear();
+		int cull(Renderable::Ptr renderable, Math::Frustrum& frustum, glm::vec3 cameraPosition, float lodError);
+		void upload();
+		void draw(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline, Renderable::Ptr renderable, int drawIndex, float lodError);
+		uint32 getNumMeshlets()
+		{
+			return numMeshlets;
+		}
+		uint32 getNumVisibleMeshlets()
+		{
+			return numVisibleMeshlets;
+		}
+		const std::vector<DrawRange>& getRanges(int drawIndex)
+		{
+			return draws[drawIndex];
+		}
+		GPU::Buffer::Ptr getIndexBuffer()
+		{
+			return indexBuffer;
+		}
+
+		static const uint32 minMeshlets = 64; // primitives with less meshlets are not worth the copy
+
+	private:
+		std::vector<std::vector<DrawRange>> draws; // ranges of all sub meshes per culled draw
+		std::vector<uint32> indices;
+		GPU::Buffer::Ptr indexBuffer;
+		uint32 capacity = 0;
+		uint32 numMeshlets = 0;
+		uint32 numVisibleMeshlets = 0;
+
+		MeshletCulling(const MeshletCulling&) = delete;
+		MeshletCulling& operator=(const MeshletCulling&) = delete;
+	};
+}
+
+#endif // INCLUDED_MESHLETCULLING
\ No newline at end of file
@@ -66,23 +66,8 @@ namespace pr
 	{
 		auto& ctx = GraphicsContext::getInstance();
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[3].index = 1;
-			vertexInputDescription.inputAttributes[4].name = "BLENDINDICES";
-			vertexInputDescription.inputAttributes[5].name = "BLENDWEIGHT";
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Color, VertexStream::Skin };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "Material" };
 			unlitPipeline = ctx.createGraphicsPipeline(maskFramebuffer, "Unlit", 1);
@@ -90,6 +75,7 @@ namespace pr
 			std::cout << "compiling Unlit shader" << std::endl;
 			switch (ctx.getCurrentAPI())
 			{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -125,23 +111,8 @@ namespace pr
 		}
 
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[3].index = 1;
-			vertexInputDescription.inputAttributes[4].name = "BLENDINDICES";
-			vertexInputDescription.inputAttributes[5].name = "BLENDWEIGHT";
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Color, VertexStream::Skin };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "Material" };
 			unlitPipelineStencil = ctx.createGraphicsPipeline(outlineFramebuffer, "Unlit", 1);
@@ -151,6 +122,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -186,22 +158,8 @@ namespace pr
 		}
 
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "NORMAL";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].index = 1;
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::Normal, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Color };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<std::string> setLayouts = { "Outline" };
 			outlinePipeline = ctx.createGraphicsPipeline(outlineFramebuffer, "Outline", 1);
@@ -211,6 +169,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
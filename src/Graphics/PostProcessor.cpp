@@ -139,22 +139,8 @@ namespace pr
 	{
 		auto& ctx = GraphicsContext::getInstance();
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "NORMAL";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].index = 1;
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::Normal, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Color };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<std::string> setLayouts = { "PostProcess" };
 			postProcessPipeline = ctx.createGraphicsPipeline(finalFBO, "PostProcess", 1);
@@ -164,6 +150,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -199,22 +186,8 @@ namespace pr
 		}
 
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "NORMAL";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].index = 1;
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::Normal, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Color };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<GPU::PushConstant> pushConstants;
 			pushConstants.push_back(GPU::PushConstant(GPU::ShaderStage::Fragment, 0, sizeof(UpSampleParams)));
@@ -227,6 +200,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -263,22 +237,8 @@ namespace pr
 		}
 
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "NORMAL";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].index = 1;
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::Normal, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Color };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<GPU::PushConstant> pushConstants;
 			pushConstants.push_back(GPU::PushConstant(GPU::ShaderStage::Fragment, 0, sizeof(DownSampleParams)));
@@ -291,6 +251,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -174,6 +174,92 @@ pr::Primitive::Ptr createUVSphere(glm::vec3 position, float radius, unsigned int
 	return sphere;
 }
 
+void TriangleSurface::buildMeshlets()
+{
+	// consecutive triangles are merged until a limit is reached, so the meshlets follow the
+	// vertex cache order of the indices
+	meshlets.clear();
+	if (indices.empty())
+		return;
+
+	std::vector<uint32> meshletIDs(vertices.size(), 0xFFFFFFFF);
+	uint32 id = 0;
+	Meshlet meshlet;
+	for (uint32 i = 0; i < indices.size(); i += 3)
+	{
+		uint32 newVertices = 0;
+		for (uint32 j = 0; j < 3; j++)
+			if (meshletIDs[indices[i + j]] != id)
+				newVertices++;
+
+		if (meshlet.vertexCount + newVertices > maxMeshletVertices || meshlet.triangleCount == maxMeshletTriangles)
+		{
+			meshlets.push_back(meshlet);
+			meshlet = Meshlet();
+			meshlet.firstIndex = i;
+			id++;
+		}
+
+		for (uint32 j = 0; j < 3; j++)
+		{
+			uint32 index = indices[i + j];
+			if (meshletIDs[index] != id)
+			{
+				meshletIDs[index] = id;
+				meshlet.vertexCount++;
+			}
+		}
+		meshlet.triangleCount++;
+	}
+	meshlets.push_back(meshlet);
+
+	calcMeshletBounds();
+}
+
+void TriangleSurface::calcMeshletBounds()
+{
+	for (auto& m : meshlets)
+	{
+		uint32 lastIndex = m.firstIndex + m.triangleCount * 3;
+		AABB box;
+		for (uint32 i = m.firstIndex; i < lastIndex; i++)
+			box.expand(vertices[indices[i]].position);
+
+		m.center = box.getCenter();
+		m.radius = 0.0f;
+		for (uint32 i = m.firstIndex; i < lastIndex; i++)
+			m.radius = glm::max(m.radius, glm::distance(m.center, vertices[indices[i]].position));
+
+		std::vector<glm::vec3> normals;
+		glm::vec3 axis = glm::vec3(0);
+		for (uint32 i = m.firstIndex; i < lastIndex; i += 3)
+		{
+			glm::vec3 p0 = vertices[indices[i]].position;
+			glm::vec3 p1 = vertices[indices[i + 1]].position;
+			glm::vec3 p2 = vertices[indices[i + 2]].position;
+			glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+			float len = glm::length(n);
+			if (len == 0.0f)
+				continue;
+			normals.push_back(n / len);
+			axis += n / len;
+		}
+
+		m.coneAxis = glm::vec3(0, 0, 1);
+		m.coneCutoff = 2.0f;
+		float len = glm::length(axis);
+		if (len == 0.0f)
+			continue;
+
+		m.coneAxis = axis / len;
+		float minDot = 1.0f;
+		for (auto& n : normals)
+			minDot = glm::min(minDot, glm::dot(m.coneAxis, n));
+		if (minDot > 0.0f) // normals spread less than 90 degrees
+			m.coneCutoff = glm::sqrt(1.0f - minDot * minDot);
+	}
+}
+
 uint32 pr::Primitive::primCount = 0;
 
 namespace pr
@@ -217,6 +303,13 @@ namespace pr
 			boundingBox.expand(v.position);
 		}
 
+		surface.calcMeshletBounds();
+
+		// the LOD errors are distances in object space
+		float scale = glm::max(glm::length(glm::vec3(T[0])), glm::max(glm::length(glm::vec3(T[1])), glm::length(glm::vec3(T[2]))));
+		for (auto& lod : surface.lods)
+			lod.error *= scale;
+
 		updateGeometry(surface);
 	}
 
@@ -226,17 +319,64 @@ namespace pr
 		updateGeometry(surface);
 	}
 
-	void Primitive::draw(GPU::CommandBuffer::Ptr cmdBuffer)
+	void Primitive::draw(GPU::CommandBuffer::Ptr cmdBuffer, float lodError)
 	{
-		cmdBuffer->bindVertexBuffers(vertexBuffer);
+		GeometryPool::getInstance().bind(cmdBuffer, geometry);
 
 		if (indexCount > 0)
 		{
-			cmdBuffer->bindIndexBuffers(indexBuffer, GPU::IndexType::uint32);
-			cmdBuffer->drawIndexed(indexCount, topology);
+			uint32 firstIndex, count;
+			selectLod(lodError, firstIndex, count);
+			cmdBuffer->drawIndexed(count, topology, firstIndex, geometry.firstVertex);
 		}
 		else
-			cmdBuffer->drawArrays(vertexCount);
+		{
+			cmdBuffer->drawArrays(vertexCount, geometry.firstVertex);
+		}
+	}
+
+	void Primitive::drawInstanced(GPU::CommandBuffer::Ptr cmdBuffer, uint32 instanceCount, float lodError)
+	{
+		// only indexed primitives are instanced
+		uint32 firstIndex, count;
+		selectLod(lodError, firstIndex, count);
+		GeometryPool::getInstance().bind(cmdBuffer, geometry);
+		cmdBuffer->drawIndexedInstanced(count, instanceCount, topology, firstIndex, geometry.firstVertex);
+	}
+
+	void Primitive::drawIndices(GPU::CommandBuffer::Ptr cmdBuffer, GPU::Buffer::Ptr indexBuffer, uint32 firstIndex, uint32 indexCount)
+	{
+		// indices that are relative to the first vertex of the primitive, but stored in another buffer
+		GeometryPool::getInstance().bind(cmdBuffer, geometry);
+		cmdBuffer->bindIndexBuffers(indexBuffer, GPU::IndexType::uint32);
+		cmdBuffer->drawIndexed(indexCount, topology, firstIndex, geometry.firstVertex);
+	}
+
+	bool Primitive::usesFullDetail(float lodError)
+	{
+		return surface.lods.empty() || surface.lods[0].error > lodError;
+	}
+
+	uint32 Primitive::getLodLevel(float lodError)
+	{
+		uint32 level = 0;
+		while (level < surface.lods.size() && surface.lods[level].error <= lodError)
+			level++;
+		return level;
+	}
+
+	void Primitive::selectLod(float lodError, uint32& firstIndex, uint32& count)
+	{
+		// coarsest level that is still within the error, the LOD indices follow the full detail indices
+		firstIndex = geometry.firstIndex;
+		count = indexCount;
+		for (auto& lod : surface.lods)
+		{
+			if (lod.error > lodError)
+				break;
+			firstIndex = geometry.firstIndex + indexCount + lod.firstIndex;
+			count = lod.indexCount;
+		}
 	}
 
 	void Primitive::update(GPU::DescriptorPool::Ptr descriptorPool)
@@ -277,25 +417,41 @@ namespace pr
 
 	void Primitive::createData()
 	{
-		auto& ctx = GraphicsContext::getInstance();
+		auto& pool = GeometryPool::getInstance();
+		pool.release(geometry);
 
-		uint32 vertByteCount = static_cast<uint32>(surface.vertices.size()) * sizeof(Vertex);
-		uint32 idxByteCount = static_cast<uint32>(surface.indices.size()) * sizeof(uint32);
-		vertexBuffer = ctx.createBuffer(GPU::BufferUsage::VertexBuffer | GPU::BufferUsage::TransferDst, vertByteCount, sizeof(Vertex));
-		if (!surface.indices.empty())
-			indexBuffer = ctx.createBuffer(GPU::BufferUsage::IndexBuffer | GPU::BufferUsage::TransferDst, idxByteCount, sizeof(uint32));
+		uint32 numVertices = static_cast<uint32>(surface.vertices.size());
+		uint32 numIndices = static_cast<uint32>(surface.indices.size() + surface.lodIndices.size());
+		layout = VertexLayout::fromVertices(surface.vertices);
+		geometry = pool.allocate(layout, numVertices, numIndices);
 	}
 
 	void Primitive::uploadData()
 	{
-		vertexBuffer->uploadStaged(surface.vertices.data());
-		if (!surface.indices.empty())
-			indexBuffer->uploadStaged(surface.indices.data());
+		auto& pool = GeometryPool::getInstance();
+		std::vector<uint8> data;
+		for (uint32 i = 0; i < static_cast<uint32>(VertexStream::Count); i++)
+		{
+			VertexStream stream = VertexStream(i);
+			if (!layout.hasStream(stream))
+				continue;
+			VertexLayout::encode(surface.vertices, stream, data);
+			pool.uploadVertices(geometry, stream, data.data());
+		}
+		if (surface.lodIndices.empty())
+		{
+			pool.uploadIndices(geometry, surface.indices.data());
+		}
+		else
+		{
+			std::vector<uint32> indices = surface.indices;
+			indices.insert(indices.end(), surface.lodIndices.begin(), surface.lodIndices.end());
+			pool.uploadIndices(geometry, indices.data());
+		}
 	}
 
 	void Primitive::destroyData()
 	{
-		vertexBuffer.reset();
-		indexBuffer.reset();
+		GeometryPool::getInstance().release(geometry);
 	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Material.h"
+#include "GeometryPool.h"
 #include <Math/Geometry.h>
 
 struct Vertex
@@ -18,10 +19,44 @@ struct Vertex
 	glm::vec4 weights = glm::vec4(0);
 };
 
+// Simplified version of a surface, the indices are a range of the LOD indices of the surface.
+// The error is the geometric deviation from the full detail surface in object space.
+struct LodLevel
+{
+	uint32 firstIndex = 0;
+	uint32 indexCount = 0;
+	float error = 0.0f;
+};
+
+// Cluster of consecutive triangles of the full detail indices, with the bounds used to cull it.
+// The cone holds the normals of all triangles, they all face away from a viewer for which
+// dot(center - viewer, coneAxis) >= coneCutoff * length(center - viewer) + radius.
+struct Meshlet
+{
+	uint32 firstIndex = 0;
+	uint32 triangleCount = 0;
+	uint32 vertexCount = 0;
+	glm::vec3 center = glm::vec3(0);
+	float radius = 0.0f;
+	glm::vec3 coneAxis = glm::vec3(0, 0, 1);
+	float coneCutoff = 2.0f; // sine of the cone angle, above 1 if the normals are too far apart
+};
+
+// Part of an index list that is drawn instead of the full index range of a primitive.
+struct DrawRange
+{
+	bool culled = false;
+	uint32 firstIndex = 0;
+	uint32 indexCount = 0;
+};
+
 struct TriangleSurface
 {
 	std::vector<Vertex> vertices;
 	std::vector<uint32> indices;
+	std::vector<uint32> lodIndices; // all LOD levels, they use the same vertices as the full detail indices
+	std::vector<LodLevel> lods; // ordered by increasing error
+	std::vector<Meshlet> meshlets;
 	glm::vec3 minPoint;
 	glm::vec3 maxPoint;
 	bool computeFlatNormals = false;
@@ -135,7 +170,17 @@ struct TriangleSurface
 	{
 		for (int i = 0; i < indices.size(); i += 3)
 			std::swap(indices[i], indices[i + 2]);
+		for (int i = 0; i < lodIndices.size(); i += 3)
+			std::swap(lodIndices[i], lodIndices[i + 2]);
+		for (auto& m : meshlets)
+			m.coneAxis = -m.coneAxis;
 	}
+
+	void buildMeshlets();
+	void calcMeshletBounds();
+
+	static const uint32 maxMeshletVertices = 64;
+	static const uint32 maxMeshletTriangles = 124;
 };
 
 namespace pr
@@ -149,7 +194,11 @@ namespace pr
 		void updateGeometry(TriangleSurface& surface);
 		void preTransform(const glm::mat4& T);
 		void flipWindingOrder();
-		void draw(GPU::CommandBuffer::Ptr cmdBuffer);
+		void draw(GPU::CommandBuffer::Ptr cmdBuffer, float lodError = 0.0f);
+		void drawInstanced(GPU::CommandBuffer::Ptr cmdBuffer, uint32 instanceCount, float lodError = 0.0f);
+		void drawIndices(GPU::CommandBuffer::Ptr cmdBuffer, GPU::Buffer::Ptr indexBuffer, uint32 firstIndex, uint32 indexCount);
+		bool usesFullDetail(float lodError);
+		uint32 getLodLevel(float lodError); // 0 is the full detail
 		void update(GPU::DescriptorPool::Ptr descriptorPool);
 		void setMorphTarget(pr::Texture2DArray::Ptr tex);
 		void bind(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline);
@@ -161,7 +210,26 @@ namespace pr
 		uint32 getIndexCount() {
 			return indexCount;
 		}
+		uint32 getNumLods() {
+			return static_cast<uint32>(surface.lods.size());
+		}
+		const std::vector<uint32>& getIndices()
+		{
+			return surface.indices;
+		}
+		const std::vector<Meshlet>& getMeshlets()
+		{
+			return surface.meshlets;
+		}
 		std::string getName();
+		const GeometryRange& getGeometry()
+		{
+			return geometry;
+		}
+		const VertexLayout& getVertexLayout()
+		{
+			return layout;
+		}
 
 		void createData();
 		void uploadData();
@@ -182,10 +250,11 @@ namespace pr
 	private:
 		Primitive(const Primitive&) = delete;
 		Primitive& operator=(const Primitive&) = delete;
+		void selectLod(float lodError, uint32& firstIndex, uint32& count);
 
 		std::string name;
-		GPU::Buffer::Ptr vertexBuffer;
-		GPU::Buffer::Ptr indexBuffer;
+		GeometryRange geometry;
+		VertexLayout layout;
 		GPU::Topology topology;
 		GPU::DescriptorSet::Ptr descriptorSet;
 		Texture2DArray::Ptr morphTargets;
@@ -1,5 +1,9 @@
 #include "Renderer.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <Graphics/JointPalette.h>
 #include <IO/FileIO.h>
 #include <IO/ImageLoader.h>
 #include <Utils/IBL.h>
@@ -20,6 +24,18 @@ namespace pr
 		initDescriptorLayouts();
 		initPipelines();
 
+		// model data of all renderables is sub-allocated from one uniform buffer
+		modelUniforms = context.createUniformAllocator(sizeof(Renderable::UniformData), maxRenderables);
+		descriptorSetModel = descriptorPool->createDescriptorSet("Model", 1);
+		descriptorSetModel->addDescriptor(modelUniforms->getDescriptor());
+		descriptorSetModel->update();
+
+		if (supportsStorageBuffers())
+		{
+			resizeInstanceBuffer(1024);
+			lightClusters.init(descriptorPool);
+		}
+
 		if (swapchain)
 			postProcessor.init(width, height, descriptorPool, swapchain->getFramebuffer(0));
 		else
@@ -101,13 +117,15 @@ namespace pr
 
 		{ // model descriptor set
 			std::vector<GPU::DescriptorSetLayoutBinding> bindings;
-			bindings.push_back(GPU::DescriptorSetLayoutBinding(0, GPU::DescriptorType::UniformBuffer, 1, GPU::ShaderStage::Vertex | GPU::ShaderStage::Fragment));
+			bindings.push_back(GPU::DescriptorSetLayoutBinding(0, GPU::DescriptorType::UniformBufferDynamic, 1, GPU::ShaderStage::Vertex | GPU::ShaderStage::Fragment));
 			descriptorPool->addDescriptorSetLayout("Model", bindings);
 		}
 
-		{ // animation descriptor set
+		{ // animation descriptor set, the skins either have their joints in the uniform buffer or the offset into the joint palette
 			std::vector<GPU::DescriptorSetLayoutBinding> bindings;
 			bindings.push_back(GPU::DescriptorSetLayoutBinding(0, GPU::DescriptorType::UniformBuffer, 1, GPU::ShaderStage::Vertex));
+			if (JointPalette::isSupported())
+				bindings.push_back(GPU::DescriptorSetLayoutBinding(1, GPU::DescriptorType::StorageBuffer, 1, GPU::ShaderStage::Vertex));
 			descriptorPool->addDescriptorSetLayout("Animation", bindings);
 		}
 
@@ -189,6 +207,20 @@ namespace pr
 			bindings.push_back(GPU::DescriptorSetLayoutBinding(2, GPU::DescriptorType::CombinedImageSampler, 1, GPU::ShaderStage::Fragment));
 			descriptorPool->addDescriptorSetLayout("Scatter", bindings);
 		}
+
+		{ // instance descriptor set
+			std::vector<GPU::DescriptorSetLayoutBinding> bindings;
+			bindings.push_back(GPU::DescriptorSetLayoutBinding(0, GPU::DescriptorType::StorageBuffer, 1, GPU::ShaderStage::Vertex));
+			descriptorPool->addDescriptorSetLayout("Instances", bindings);
+		}
+
+		{ // light cluster descriptor set
+			std::vector<GPU::DescriptorSetLayoutBinding> bindings;
+			bindings.push_back(GPU::DescriptorSetLayoutBinding(0, GPU::DescriptorType::StorageBuffer, 1, GPU::ShaderStage::Fragment));
+			bindings.push_back(GPU::DescriptorSetLayoutBinding(1, GPU::DescriptorType::StorageBuffer, 1, GPU::ShaderStage::Fragment));
+			bindings.push_back(GPU::DescriptorSetLayoutBinding(2, GPU::DescriptorType::StorageBuffer, 1, GPU::ShaderStage::Fragment));
+			descriptorPool->addDescriptorSetLayout("Clusters", bindings);
+		}
 	}
 
 	void Renderer::initDescriptorSets()
@@ -221,6 +253,76 @@ namespace pr
 		morphDescriptorSet->update();
 	}
 
+	GPU::VertexDescription getVertexDescription()
+	{
+		// material shaders read all streams, missing ones are bound to their default value
+		return VertexLayout::all().getVertexDescription();
+	}
+
+	void Renderer::createMaterialPipeline(const std::string& pipelineName, const std::string& shaderPath, const std::string& shaderName, bool transparent)
+	{
+		auto& ctx = GraphicsContext::getInstance();
+
+		std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "Material", "IBL", "Light", "Volume", "Scatter" };
+		if (supportsStorageBuffers())
+		{
+			setLayouts.push_back("Instances");
+			setLayouts.push_back("Clusters");
+		}
+		GPU::GraphicsPipeline::Ptr pipeline;
+		if (transparent)
+		{
+			pipeline = ctx.createGraphicsPipeline(offscreenFramebuffer2, pipelineName, 1);
+			pipeline->setBlending(true);
+		}
+		else
+		{
+			pipeline = ctx.createGraphicsPipeline(offscreenFramebuffer, pipelineName, 3);
+		}
+
+		GraphicsAPI api = ctx.getCurrentAPI();
+		switch (api)
+		{
+			case GraphicsAPI::Null:
+			case GraphicsAPI::OpenGL:
+			{
+				std::string versionStr = "#version 460 core\n";
+				std::string defineStr = "#define USE_OPENGL\n";
+				std::string prefix = versionStr + defineStr;
+				std::cout << "compiling shader " << pipelineName << std::endl;
+				std::string vsCode = loadExpanded(shaderPath + "/" + shaderName + ".vert");
+				if (vsCode.find("InstanceSSBO") != std::string::npos)
+					instancedPipelines.insert(pipelineName);
+				pipeline->addShaderStage(prefix + vsCode, GPU::ShaderStage::Vertex);
+				pipeline->addShaderStage(prefix + loadExpanded(shaderPath + "/" + shaderName + ".frag"), GPU::ShaderStage::Fragment);
+				break;
+			}
+			case GraphicsAPI::Direct3D11:
+			{
+				std::string vsCode, psCode;
+				loadBinary(shaderPath + "/" + shaderName + ".vs.cso", vsCode);
+				loadBinary(shaderPath + "/" + shaderName + ".ps.cso", psCode);
+				pipeline->addShaderStage(vsCode, GPU::ShaderStage::Vertex);
+				pipeline->addShaderStage(psCode, GPU::ShaderStage::Fragment);
+				break;
+			}
+			case GraphicsAPI::Vulkan:
+			{
+				std::cout << "compiling shader " << pipelineName << std::endl;
+				pipeline->addShaderStage(loadTxtFile(shaderPath + "/" + shaderName + ".vert.spv"), GPU::ShaderStage::Vertex);
+				pipeline->addShaderStage(loadTxtFile(shaderPath + "/" + shaderName + ".frag.spv"), GPU::ShaderStage::Fragment);
+				break;
+			}
+		}
+
+		GPU::VertexDescription vertexInputDescription = getVertexDescription();
+		pipeline->setVertexInputDescripton(vertexInputDescription);
+		pipeline->setLayout(descriptorPool, setLayouts);
+		pipeline->createProgram();
+
+		pipelines.insert(std::make_pair(pipelineName, pipeline));
+	}
+
 	void Renderer::initPipelines()
 	{
 		auto& ctx = GraphicsContext::getInstance();
@@ -235,6 +337,7 @@ namespace pr
 				filenames = IO::getAllFileNames(shaderPath, ".cso");
 				break;
 			}
+			case GraphicsAPI::Null:
 			case GraphicsAPI::OpenGL:
 			{
 				shaderPath = "../../../../src/Shaders/GLSL/Generated";
@@ -257,226 +360,19 @@ namespace pr
 			if (shaderName.substr(0, 6).compare("Volume") == 0)
 				continue;
 
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(5, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, tangent)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "NORMAL";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].index = 1;
-			vertexInputDescription.inputAttributes[5].name = "TANGENT";
-			vertexInputDescription.inputAttributes[6].name = "BLENDINDICES";
-			vertexInputDescription.inputAttributes[7].name = "BLENDWEIGHT";
-
-			std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "Material", "IBL", "Light", "Volume", "Scatter" };
-			GPU::GraphicsPipeline::Ptr pipeline;
-
 			// TODO: add alpha blending to opaque pass for now
-			if (shaderName.find("Transmission") != std::string::npos)
-			{
-				pipeline = ctx.createGraphicsPipeline(offscreenFramebuffer2, shaderName, 1);
-				pipeline->setBlending(true);
-			}
-			else
-			{
-				pipeline = ctx.createGraphicsPipeline(offscreenFramebuffer, shaderName, 3);
-			}
-
-			GraphicsAPI api = ctx.getCurrentAPI();
-			switch (api)
-			{
-				case GraphicsAPI::OpenGL:
-				{
-					std::string versionStr = "#version 460 core\n";
-					std::string defineStr = "#define USE_OPENGL\n";
-					std::string prefix = versionStr + defineStr;
-					std::cout << "compiling shader " << shaderName << std::endl;
-					pipeline->addShaderStage(prefix + loadExpanded(shaderPath + "/" + shaderName + ".vert"), GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(prefix + loadExpanded(shaderPath + "/" + shaderName + ".frag"), GPU::ShaderStage::Fragment);
-					break;
-				}
-				case GraphicsAPI::Direct3D11:
-				{
-					std::string vsCode, psCode;
-					loadBinary(shaderPath + "/" + shaderName + ".vs.cso", vsCode);
-					loadBinary(shaderPath + "/" + shaderName + ".ps.cso", psCode);
-					pipeline->addShaderStage(vsCode, GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(psCode, GPU::ShaderStage::Fragment);
-					break;
-				}
-				case GraphicsAPI::Vulkan:
-				{
-					std::cout << "compiling shader " << shaderName << std::endl;
-					pipeline->addShaderStage(loadTxtFile(shaderPath + "/" + shaderName + ".vert.spv"), GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(loadTxtFile(shaderPath + "/" + shaderName + ".frag.spv"), GPU::ShaderStage::Fragment);
-					break;
-				}
-			}
-
-			pipeline->setVertexInputDescripton(vertexInputDescription);
-			pipeline->setLayout(descriptorPool, setLayouts);
-			pipeline->createProgram();
-
-			pipelines.insert(std::make_pair(shaderName, pipeline));
+			bool transparent = shaderName.find("Transmission") != std::string::npos;
+			createMaterialPipeline(shaderName, shaderPath, shaderName, transparent);
 		}
 
-		{
-			std::string shaderName = "UnityDefaultTransparency";
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(5, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, tangent)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "NORMAL";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].index = 1;
-			vertexInputDescription.inputAttributes[5].name = "TANGENT";
-			vertexInputDescription.inputAttributes[6].name = "BLENDINDICES";
-			vertexInputDescription.inputAttributes[7].name = "BLENDWEIGHT";
-
-			std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "Material", "IBL", "Light", "Volume", "Scatter" };
-			GPU::GraphicsPipeline::Ptr pipeline = ctx.createGraphicsPipeline(offscreenFramebuffer2, shaderName, 1);
-			pipeline->setBlending(true);
-
-			GraphicsAPI api = ctx.getCurrentAPI();
-			switch (api)
-			{
-				case GraphicsAPI::OpenGL:
-				{
-					std::string versionStr = "#version 460 core\n";
-					std::string defineStr = "#define USE_OPENGL\n";
-					std::string prefix = versionStr + defineStr;
-					std::cout << "compiling shader " << shaderName << std::endl;
-					pipeline->addShaderStage(prefix + loadExpanded(shaderPath + "/UnityDefault.vert"), GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(prefix + loadExpanded(shaderPath + "/UnityDefault.frag"), GPU::ShaderStage::Fragment);
-					break;
-				}
-				case GraphicsAPI::Direct3D11:
-				{
-					std::string shaderPath = "../../../../cache/shaders/cso";
-					std::string vsCode, psCode;
-					loadBinary(shaderPath + "/UnityDefault.vs.cso", vsCode);
-					loadBinary(shaderPath + "/UnityDefault.ps.cso", psCode);
-					pipeline->addShaderStage(vsCode, GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(psCode, GPU::ShaderStage::Fragment);
-					break;
-				}
-				case GraphicsAPI::Vulkan:
-				{
-					std::cout << "compiling shader " << shaderName << std::endl;
-					pipeline->addShaderStage(loadTxtFile(shaderPath + "/UnityDefault.vert.spv"), GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(loadTxtFile(shaderPath + "/UnityDefault.frag.spv"), GPU::ShaderStage::Fragment);
-					break;
-				}
-			}
-
-			pipeline->setVertexInputDescripton(vertexInputDescription);
-			pipeline->setLayout(descriptorPool, setLayouts);
-			pipeline->createProgram();
-
-			pipelines.insert(std::make_pair(shaderName, pipeline));
-		}
-
-		{
-			std::string shaderName = "UnitySpecGlossTransparency";
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(5, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, tangent)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "COLOR";
-			vertexInputDescription.inputAttributes[2].name = "NORMAL";
-			vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[4].index = 1;
-			vertexInputDescription.inputAttributes[5].name = "TANGENT";
-			vertexInputDescription.inputAttributes[6].name = "BLENDINDICES";
-			vertexInputDescription.inputAttributes[7].name = "BLENDWEIGHT";
-
-			std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "Material", "IBL", "Light", "Volume", "Scatter" };
-			GPU::GraphicsPipeline::Ptr pipeline = ctx.createGraphicsPipeline(offscreenFramebuffer2, shaderName, 1);
-			pipeline->setBlending(true);
-
-			GraphicsAPI api = ctx.getCurrentAPI();
-			switch (api)
-			{
-				case GraphicsAPI::OpenGL:
-				{
-					std::string versionStr = "#version 460 core\n";
-					std::string defineStr = "#define USE_OPENGL\n";
-					std::string prefix = versionStr + defineStr;
-					std::cout << "compiling shader " << shaderName << std::endl;
-					pipeline->addShaderStage(prefix + loadExpanded(shaderPath + "/UnitySpecGloss.vert"), GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(prefix + loadExpanded(shaderPath + "/UnitySpecGloss.frag"), GPU::ShaderStage::Fragment);
-					break;
-				}
-				case GraphicsAPI::Direct3D11:
-				{
-					std::string shaderPath = "../../../../cache/shaders/cso";
-					std::string vsCode, psCode;
-					loadBinary(shaderPath + "/UnitySpecGloss.vs.cso", vsCode);
-					loadBinary(shaderPath + "/UnitySpecGloss.ps.cso", psCode);
-					pipeline->addShaderStage(vsCode, GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(psCode, GPU::ShaderStage::Fragment);
-					break;
-				}
-				case GraphicsAPI::Vulkan:
-				{
-					std::cout << "compiling shader " << shaderName << std::endl;
-					pipeline->addShaderStage(loadTxtFile(shaderPath + "/UnitySpecGloss.vert.spv"), GPU::ShaderStage::Vertex);
-					pipeline->addShaderStage(loadTxtFile(shaderPath + "/UnitySpecGloss.frag.spv"), GPU::ShaderStage::Fragment);
-					break;
-				}
-			}
-
-			pipeline->setVertexInputDescripton(vertexInputDescription);
-			pipeline->setLayout(descriptorPool, setLayouts);
-			pipeline->createProgram();
-
-			pipelines.insert(std::make_pair(shaderName, pipeline));
-		}	
+		createMaterialPipeline("UnityDefaultTransparency", shaderPath, "UnityDefault", true);
+		createMaterialPipeline("UnitySpecGlossTransparency", shaderPath, "UnitySpecGloss", true);
 
 		{
 			std::string shaderName = "Skybox";
 
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
+			VertexLayout vertexLayout = { VertexStream::Position };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<std::string> setLayouts = { "Skybox" };
 			skyboxPipeline = ctx.createGraphicsPipeline(offscreenFramebuffer, "Skybox", 3);
@@ -485,6 +381,7 @@ namespace pr
 			GraphicsAPI api = ctx.getCurrentAPI();
 			switch (api)
 			{
+				case GraphicsAPI::Null:
 				case GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -526,29 +423,21 @@ namespace pr
 
 	void Renderer::initScene(UserCamera& userCamera, Scene::Ptr scene)
 	{
-		std::vector<LightUniformData> lightData;
-		for (auto root : scene->getRootNodes())
-		{
-			for (auto e : root->getChildrenWithComponent<pr::Light>())
-			{
-				auto t = e->getComponent<pr::Transform>();
-				auto l = e->getComponent<pr::Light>();
+		lightData.clear();
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			auto t = e->getComponent<pr::Transform>();
 
-				LightUniformData data;
-				l->writeUniformData(data, t);
-				lightData.push_back(data);
+			LightUniformData data;
+			l->writeUniformData(data, t);
+			lightData.push_back(data);
 
-				l->updateLightViewProjection(userCamera, t);
-			}
-		}
+			l->updateLightViewProjection(userCamera, t);
+		});
 
-		Lights lights;
-		for (int i = 0; i < lightData.size(); i++)
-			lights.lightData[i] = lightData[i];
-		lights.numLights = (int)lightData.size();
-		lightUBO->uploadMapped(&lights);
+		uploadLights();
+		updateClusters();
 
-		scene->initDescriptors(descriptorPool);
+		initDescriptors(scene);
 
 		//shadows.initDescriptorSets(descriptorPool);
 		//shadows.prepare(userCamera, scene);
@@ -566,6 +455,11 @@ namespace pr
 		//}
 	}
 
+	void Renderer::initDescriptors(pr::Scene::Ptr scene)
+	{
+		scene->initDescriptors(descriptorPool, modelUniforms, descriptorSetModel);
+	}
+
 	void Renderer::resize(uint32 width, uint32 height)
 	{
 
@@ -575,28 +469,19 @@ namespace pr
 	{
 		auto& ctx = GraphicsContext::getInstance();
 
-		std::vector<LightUniformData> lightData;
-		for (auto root : scene->getRootNodes())
-		{
-			for (auto e : root->getChildrenWithComponent<pr::Light>())
-			{
-				auto t = e->getComponent<pr::Transform>();
-				auto l = e->getComponent<pr::Light>();
+		lightData.clear();
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			auto t = e->getComponent<pr::Transform>();
 
-				LightUniformData data;
-				l->writeUniformData(data, t);
-				lightData.push_back(data);
+			LightUniformData data;
+			l->writeUniformData(data, t);
+			lightData.push_back(data);
 
-				l->updateLightViewProjection(userCamera, t);
-			}
-		}
+			l->updateLightViewProjection(userCamera, t);
+		});
 
-		Lights lights;
-		for (int i = 0; i < lightData.size(); i++)
-			lights.lightData[i] = lightData[i];
-		lights.numLights = (int)lightData.size();
 		lightUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(Lights), 0);
-		lightUBO->uploadMapped(&lights);
+		uploadLights();
 
 		skyboxUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(Skybox), 0);
 		skyboxData.index = 0;
@@ -625,8 +510,9 @@ namespace pr
 
 		initDescriptorSets();
 		postProcessor.initDescriptorSets(screenTex, brightTex);
-		scene->initDescriptors(descriptorPool);
+		initDescriptors(scene);
 		scene->update(0.0f);
+		modelUniforms->flush();
 		//scene->computeSHLightprobes();
 		scene->computeProbeMapping();
 
@@ -634,10 +520,13 @@ namespace pr
 		shadows.initDescriptorSets(descriptorPool);
 		shadows.initPipelines(descriptorPool);
 		shadows.updateLights(scene);
+		updateShadowIndices(scene);
 		shadows.buildCmdShadowsOMNI(scene);
 		shadows.buildCmdShadowsCSM(scene);
+		shadows.cullCasters(scene);
+		modelUniforms->flush();
 		shadows.updateShadowsCSM(0, scene);
-		shadows.updateShadowsOMNI(scene);
+		shadows.updateShadowsOMNI(scene, userCamera.getViewMatrix(), userCamera.getProjectionMatrix());
 
 		// light set
 		descriptorSetLight = descriptorPool->createDescriptorSet("Light", 1);
@@ -662,8 +551,104 @@ namespace pr
 
 	void Renderer::buildCmdBuffer(pr::Scene::Ptr scene, GPU::Swapchain::Ptr swapchain)
 	{
-		auto opaqueNodes = scene->getOpaqueEntities();
-		auto transparentNodes = scene->getTransparentEntities();
+		collectDraws(scene);
+		recordCmdBuffers(scene, swapchain);
+	}
+
+	void Renderer::updateCmdBuffer(pr::Scene::Ptr scene, GPU::Swapchain::Ptr swapchain)
+	{
+		// culling, LOD selection, meshlet cone culling and the back to front order of blended draws
+		// depend on the view, without any of them only scene changes collect the draws again
+		uint32 sceneVersion = scene->getChangeVersion();
+		bool viewDependent = frustumCulling || lodSelection || cullMeshlets || !scene->getTransparentEntities().empty();
+		for (auto& batch : scene->getOpaqueEntities())
+			viewDependent = viewDependent || batch.priority > 0;
+		bool viewChanged = viewDependent && camera.VP != recordedViewProj;
+		if (scene.get() == recordedScene && swapchain == recordedSwapchain && sceneVersion == recordedSceneVersion && !viewChanged)
+			return;
+
+		collectDraws(scene);
+		recordedSceneVersion = sceneVersion;
+		recordedViewProj = camera.VP;
+		if (scene.get() == recordedScene && swapchain == recordedSwapchain && drawSignature == recordedSignature)
+			return;
+
+		recordCmdBuffers(scene, swapchain);
+	}
+
+	void Renderer::collectDraws(pr::Scene::Ptr scene)
+	{
+		opaqueDraws.clear();
+		transparentDraws.clear();
+		instanceGroups.clear();
+		meshletCulling.clear();
+		bool allowInstancing = instancing && supportsStorageBuffers();
+		addDraws(opaqueDraws, scene->getOpaqueEntities(), allowInstancing);
+		addDraws(transparentDraws, scene->getTransparentEntities(), false);
+		opaqueDraws.sort();
+		transparentDraws.sort();
+		meshletCulling.upload();
+
+		if (!instanceGroups.empty())
+		{
+			uint32 numInstances = 0;
+			for (uint32 i = 0; i < instanceGroups.size(); i++)
+			{
+				auto& group = instanceGroups[i];
+				group.uniformOffset = instanceUniforms[i];
+				group.firstInstance = numInstances;
+				numInstances += static_cast<uint32>(group.renderables.size());
+			}
+
+			if (numInstances > instanceMatrices.size())
+				resizeInstanceBuffer(std::max(numInstances, static_cast<uint32>(instanceMatrices.size()) * 2));
+			updateInstances();
+		}
+
+		// the buffers the draws read from are part of the recording as well
+		drawSignature.clear();
+		drawSignature.push_back(reinterpret_cast<uint64>(instanceBuffer.get()));
+		drawSignature.push_back(reinterpret_cast<uint64>(meshletCulling.getIndexBuffer().get()));
+		addSignature(opaqueDraws);
+		addSignature(transparentDraws);
+	}
+
+	void Renderer::addSignature(DrawList& drawList)
+	{
+		drawSignature.push_back(drawList.size());
+		for (uint32 i = 0; i < drawList.size(); i++)
+		{
+			auto& draw = drawList.getDraw(i);
+			drawSignature.push_back(reinterpret_cast<uint64>(draw.renderable.get()));
+			drawSignature.push_back(reinterpret_cast<uint64>(draw.pipeline.get()));
+			if (draw.instanceGroup >= 0)
+			{
+				auto& group = instanceGroups[draw.instanceGroup];
+				drawSignature.push_back(group.renderables.size());
+				for (auto r : group.renderables)
+					drawSignature.push_back(reinterpret_cast<uint64>(r.get()));
+			}
+
+			auto& subMeshes = draw.renderable->getMesh()->getSubMeshes();
+			for (uint32 s = 0; s < subMeshes.size(); s++)
+			{
+				// submeshes without meshlets use the LOD of the draw in culled draws as well
+				if (draw.meshletDraw >= 0 && meshletCulling.getRanges(draw.meshletDraw)[s].culled)
+				{
+					auto& range = meshletCulling.getRanges(draw.meshletDraw)[s];
+					drawSignature.push_back((static_cast<uint64>(range.firstIndex) << 32) | range.indexCount);
+				}
+				else
+					drawSignature.push_back(subMeshes[s].primitive->getLodLevel(draw.lodError));
+			}
+		}
+	}
+
+	void Renderer::recordCmdBuffers(pr::Scene::Ptr scene, GPU::Swapchain::Ptr swapchain)
+	{
+		recordedSignature = drawSignature;
+		recordedScene = scene.get();
+		recordedSwapchain = swapchain;
 
 		for (int i = 0; i < commandBuffers.size(); i++)
 		{
@@ -676,35 +661,7 @@ namespace pr
 
 			// opaque forward pass
 			cmdBuf->setCullMode(2);
-			for (auto&& [shaderName, renderQueue] : opaqueNodes)
-			{
-				GPU::GraphicsPipeline::Ptr pipeline = nullptr;
-				if (pipelines.find(shaderName) != pipelines.end())
-					pipeline = pipelines[shaderName];
-				else
-				{
-					std::cout << "could not find pipeline with name " << shaderName << std::endl;
-					pipeline = pipelines["Default"];
-				}
-
-				cmdBuf->bindPipeline(pipeline);
-				cmdBuf->bindDescriptorSets(pipeline, descriptorSetCamera, 0);
-				cmdBuf->bindDescriptorSets(pipeline, animDescriptorSet, 2);
-				cmdBuf->bindDescriptorSets(pipeline, morphDescriptorSet, 3);
-				cmdBuf->bindDescriptorSets(pipeline, descriptorSetIBL, 5);
-				cmdBuf->bindDescriptorSets(pipeline, descriptorSetLight, 6);
-				cmdBuf->bindDescriptorSets(pipeline, descriptorSetVolume, 7);
-				cmdBuf->bindDescriptorSets(pipeline, scatter.getDescriptorSet(), 8);
-
-				for (auto e : renderQueue)
-				{
-					if (e->isActive())
-					{
-						auto r = e->getComponent<Renderable>();
-						r->render(cmdBuf, pipeline);
-					}
-				}
-			}
+			recordDraws(cmdBuf, opaqueDraws);
 
 			// skybox
 			cmdBuf->setCullMode(1);
@@ -715,7 +672,7 @@ namespace pr
 			cmdBuf->endRenderPass();
 
 			// transparent forward pass
-			if (!transparentNodes.empty())
+			if (!transparentDraws.empty())
 			{
 				if (GraphicsContext::getInstance().getCurrentAPI() == GraphicsAPI::Direct3D11)
 					grabTex->generateMipmaps();
@@ -726,38 +683,7 @@ namespace pr
 				cmdBuf->setScissor(0, 0, width, height);
 				cmdBuf->beginRenderPass(offscreenFramebuffer2);
 				cmdBuf->setCullMode(2);
-
-				for (auto it = transparentNodes.begin(); it != transparentNodes.end(); ++it)
-				{
-					auto shaderName = it->first;
-					auto renderQueue = it->second;
-					GPU::GraphicsPipeline::Ptr pipeline = nullptr;
-					if (pipelines.find(shaderName) != pipelines.end())
-						pipeline = pipelines[shaderName];
-					else
-					{
-						std::cout << "could not find pipeline with name " << shaderName << std::endl;
-						pipeline = pipelines["Default"];
-					}						
-
-					cmdBuf->bindPipeline(pipeline);
-					cmdBuf->bindDescriptorSets(pipeline, descriptorSetCamera, 0);
-					cmdBuf->bindDescriptorSets(pipeline, animDescriptorSet, 2);
-					cmdBuf->bindDescriptorSets(pipeline, morphDescriptorSet, 3);
-					cmdBuf->bindDescriptorSets(pipeline, descriptorSetIBL, 5);
-					cmdBuf->bindDescriptorSets(pipeline, descriptorSetLight, 6);
-					cmdBuf->bindDescriptorSets(pipeline, descriptorSetVolume, 7);
-					cmdBuf->bindDescriptorSets(pipeline, scatter.getDescriptorSet(), 8);
-
-					for (auto e : renderQueue)
-					{
-						if (e->isActive())
-						{
-							auto r = e->getComponent<Renderable>();
-							r->render(cmdBuf, pipeline);
-						}
-					}
-				}
+				recordDraws(cmdBuf, transparentDraws);
 
 				cmdBuf->endRenderPass();
 			}
@@ -790,6 +716,267 @@ namespace pr
 		}
 	}
 
+	bool Renderer::isVisible(Renderable::Ptr renderable)
+	{
+		if (!frustumCulling || !frustumValid)
+			return true;
+
+		// the bounds of skinned meshes cover all joints, see Skin::getPosedBounds
+		AABB worldBox = renderable->getWorldBoundingBox();
+		return viewFrustum.isInside(worldBox);
+	}
+
+	uint32 getMaterialID(Renderable::Ptr renderable, uint32 pipelineID)
+	{
+		// entities with several materials are keyed by the first one drawn with this pipeline
+		for (auto& s : renderable->getMesh()->getSubMeshes())
+			if (s.material && s.material->getShaderID() == pipelineID)
+				return s.material->getID();
+		return 0;
+	}
+
+	bool Renderer::supportsStorageBuffers()
+	{
+		// instances and light clusters are only read by the GLSL sources that are compiled at runtime
+		GraphicsAPI api = GraphicsContext::getInstance().getCurrentAPI();
+		return api == GraphicsAPI::OpenGL || api == GraphicsAPI::Null;
+	}
+
+	bool Renderer::canInstance(Renderable::Ptr renderable, const std::string& pipelineName)
+	{
+		// shaders without the instance buffer would draw all instances with the first model matrix
+		if (instancedPipelines.find(pipelineName) == instancedPipelines.end())
+			return false;
+
+		// per instance data other than the model matrix is taken from the first instance
+		if (renderable->isSkinnedMesh() || renderable->hasMorphtargets() || renderable->getDiffuseMode() == 2)
+			return false;
+
+		for (auto& s : renderable->getMesh()->getSubMeshes())
+			if (!s.material || s.primitive->getIndexCount() == 0)
+				return false;
+		return true;
+	}
+
+	Renderer::InstanceKey::InstanceKey(Renderable::Ptr renderable) :
+		mesh(renderable->getMesh().get()),
+		diffuseMode(renderable->getDiffuseMode()),
+		reflectionProbe(renderable->getRPIndex()),
+		sh(&renderable->getProbeSH9())
+	{
+
+	}
+
+	bool Renderer::InstanceKey::operator<(const InstanceKey& other) const
+	{
+		if (mesh != other.mesh)
+			return mesh < other.mesh;
+		if (diffuseMode != other.diffuseMode)
+			return diffuseMode < other.diffuseMode;
+		if (reflectionProbe != other.reflectionProbe)
+			return reflectionProbe < other.reflectionProbe;
+		if (diffuseMode != 1) // the SH coefficients are only used for the irradiance in mode 1
+			return false;
+		return std::lexicographical_compare(sh->begin(), sh->end(), other.sh->begin(), other.sh->end(),
+			[](const glm::vec3& a, const glm::vec3& b) {
+				if (a.x != b.x)
+					return a.x < b.x;
+				if (a.y != b.y)
+					return a.y < b.y;
+				return a.z < b.z;
+			});
+	}
+
+	float Renderer::getViewDepth(Renderable::Ptr renderable)
+	{
+		glm::vec3 center = renderable->getWorldBoundingBox().getCenter();
+		return -(viewMatrix * glm::vec4(center, 1.0f)).z / viewFar;
+	}
+
+	float Renderer::getLodError(Renderable::Ptr renderable)
+	{
+		// the bounds of skinned meshes are much larger than the mesh, the scale would be wrong
+		if (!lodSelection || !frustumValid || renderable->isSkinnedMesh())
+			return 0.0f;
+
+		AABB worldBox = renderable->getWorldBoundingBox();
+		AABB localBox = renderable->getBoundingBox();
+		float localRadius = localBox.radius();
+		if (localRadius <= 0.0f)
+			return 0.0f;
+
+		// pixels per world unit at the closest point of the bounds
+		float pixelsPerUnit = 0.5f * height * projMatrix[1][1];
+		if (projMatrix[3][3] == 0.0f) // perspective
+		{
+			glm::vec3 center = glm::vec3(viewMatrix * glm::vec4(worldBox.getCenter(), 1.0f));
+			float distance = glm::length(center) - worldBox.radius();
+			if (distance <= 0.0f)
+				return 0.0f;
+			pixelsPerUnit /= distance;
+		}
+
+		float scale = worldBox.radius() / localRadius;
+		return lodPixelError / (pixelsPerUnit * scale);
+	}
+
+	void Renderer::addDraw(DrawList& drawList, const RenderBatch& batch, Renderable::Ptr renderable, GPU::GraphicsPipeline::Ptr pipeline)
+	{
+		float lodError = getLodError(renderable);
+		int meshletDraw = -1;
+		if (cullMeshlets && frustumValid)
+			meshletDraw = meshletCulling.cull(renderable, viewFrustum, glm::vec3(camera.position), lodError);
+
+		uint32 materialID = getMaterialID(renderable, batch.pipelineID);
+		drawList.add(batch.priority, batch.pipelineID, materialID, getViewDepth(renderable), renderable, pipeline, -1, lodError, meshletDraw);
+	}
+
+	void Renderer::addDraws(DrawList& drawList, const std::vector<RenderBatch>& batches, bool allowInstancing)
+	{
+		for (auto& batch : batches)
+		{
+			GPU::GraphicsPipeline::Ptr pipeline = nullptr;
+			if (pipelines.find(batch.shaderName) != pipelines.end())
+				pipeline = pipelines[batch.shaderName];
+			else
+			{
+				std::cout << "could not find pipeline with name " << batch.shaderName << std::endl;
+				pipeline = pipelines["Default"];
+			}
+
+			std::map<InstanceKey, std::vector<Renderable::Ptr>> meshInstances;
+			for (auto e : batch.entities)
+			{
+				if (!e->isActive())
+					continue;
+
+				auto r = e->getComponent<Renderable>();
+				if (!r->hasModelData() || !isVisible(r))
+					continue;
+
+				// blended layers are drawn back to front per renderable
+				if (allowInstancing && batch.priority == 0 && canInstance(r, batch.shaderName))
+					meshInstances[InstanceKey(r)].push_back(r);
+				else
+					addDraw(drawList, batch, r, pipeline);
+			}
+
+			for (auto& [key, renderables] : meshInstances)
+			{
+				if (renderables.size() < minInstances)
+				{
+					for (auto r : renderables)
+						addDraw(drawList, batch, r, pipeline);
+					continue;
+				}
+
+				// all instances use the LOD of the closest one
+				float depth = 1.0f;
+				float lodError = std::numeric_limits<float>::max();
+				for (auto r : renderables)
+				{
+					depth = std::min(depth, getViewDepth(r));
+					lodError = std::min(lodError, getLodError(r));
+				}
+
+				// the model data of the group needs its own block, the blocks of the groups are kept
+				int groupIndex = static_cast<int>(instanceGroups.size());
+				if (groupIndex >= instanceUniforms.size())
+				{
+					uint32 uniformOffset = 0;
+					if (!modelUniforms->allocate(uniformOffset))
+					{
+						for (auto r : renderables)
+							addDraw(drawList, batch, r, pipeline);
+						continue;
+					}
+					instanceUniforms.push_back(uniformOffset);
+				}
+
+				auto r = renderables[0];
+				InstanceGroup group;
+				group.renderables = renderables;
+				instanceGroups.push_back(group);
+				drawList.add(batch.priority, batch.pipelineID, getMaterialID(r, batch.pipelineID), depth, r, pipeline, groupIndex, lodError);
+			}
+		}
+	}
+
+	void Renderer::recordDraws(GPU::CommandBuffer::Ptr cmdBuf, DrawList& drawList)
+	{
+		// the per pass descriptor sets only have to be bound when the pipeline changes
+		GPU::GraphicsPipeline::Ptr boundPipeline = nullptr;
+		for (uint32 i = 0; i < drawList.size(); i++)
+		{
+			auto& draw = drawList.getDraw(i);
+			if (draw.pipeline != boundPipeline)
+			{
+				auto pipeline = draw.pipeline;
+				cmdBuf->bindPipeline(pipeline);
+				cmdBuf->bindDescriptorSets(pipeline, descriptorSetCamera, 0);
+				cmdBuf->bindDescriptorSets(pipeline, animDescriptorSet, 2);
+				cmdBuf->bindDescriptorSets(pipeline, morphDescriptorSet, 3);
+				cmdBuf->bindDescriptorSets(pipeline, descriptorSetIBL, 5);
+				cmdBuf->bindDescriptorSets(pipeline, descriptorSetLight, 6);
+				cmdBuf->bindDescriptorSets(pipeline, descriptorSetVolume, 7);
+				cmdBuf->bindDescriptorSets(pipeline, scatter.getDescriptorSet(), 8);
+				if (descriptorSetInstances)
+					cmdBuf->bindDescriptorSets(pipeline, descriptorSetInstances, 9);
+				if (lightClusters.getDescriptorSet())
+					cmdBuf->bindDescriptorSets(pipeline, lightClusters.getDescriptorSet(), 10);
+				boundPipeline = pipeline;
+			}
+
+			if (draw.instanceGroup >= 0)
+			{
+				auto& group = instanceGroups[draw.instanceGroup];
+				uint32 instanceCount = static_cast<uint32>(group.renderables.size());
+				cmdBuf->bindDescriptorSets(draw.pipeline, descriptorSetModel, 1, group.uniformOffset);
+				draw.renderable->getMesh()->drawInstanced(cmdBuf, draw.pipeline, instanceCount, draw.lodError);
+			}
+			else if (draw.meshletDraw >= 0)
+			{
+				meshletCulling.draw(cmdBuf, draw.pipeline, draw.renderable, draw.meshletDraw, draw.lodError);
+			}
+			else
+			{
+				draw.renderable->render(cmdBuf, draw.pipeline, draw.lodError);
+			}
+		}
+	}
+
+	void Renderer::resizeInstanceBuffer(uint32 capacity)
+	{
+		auto& ctx = GraphicsContext::getInstance();
+		instanceMatrices.resize(capacity);
+		instanceBuffer = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::StorageBuffer, capacity * sizeof(glm::mat4), 0);
+		descriptorSetInstances = descriptorPool->createDescriptorSet("Instances", 1);
+		descriptorSetInstances->addDescriptor(instanceBuffer->getDescriptor());
+		descriptorSetInstances->update();
+	}
+
+	void Renderer::updateInstances()
+	{
+		if (instanceGroups.empty())
+			return;
+
+		// the renderables have written their current model data already, copy it from there
+		Renderable::UniformData data;
+		for (auto& group : instanceGroups)
+		{
+			for (uint32 i = 0; i < group.renderables.size(); i++)
+			{
+				std::memcpy(&data, modelUniforms->getBlockData(group.renderables[i]->getUniformOffset()), sizeof(data));
+				instanceMatrices[group.firstInstance + i] = data.M;
+			}
+
+			std::memcpy(&data, modelUniforms->getBlockData(group.renderables[0]->getUniformOffset()), sizeof(data));
+			data.instanceOffset = static_cast<int>(group.firstInstance);
+			modelUniforms->write(group.uniformOffset, &data);
+		}
+		instanceBuffer->uploadMapped(instanceMatrices.data());
+	}
+
 	void Renderer::buildScatterCmdBuffer(pr::Scene::Ptr scene)
 	{
 		std::map<uint32, GPU::DescriptorSet::Ptr> descriptorSets;
@@ -798,6 +985,8 @@ namespace pr
 		descriptorSets[3] = morphDescriptorSet;
 		descriptorSets[5] = descriptorSetIBL;
 		descriptorSets[6] = descriptorSetLight;
+		if (lightClusters.getDescriptorSet())
+			descriptorSets[7] = lightClusters.getDescriptorSet();
 		scatter.buildCmdBuffer(scene, descriptorSets);
 	}
 
@@ -810,6 +999,7 @@ namespace pr
 	void Renderer::addLights(pr::Scene::Ptr scene)
 	{
 		shadows.updateLights(scene);
+		updateShadowIndices(scene);
 		descriptorSetLight = descriptorPool->createDescriptorSet("Light", 1);
 		descriptorSetLight->addDescriptor(lightUBO->getDescriptor());
 		shadows.addDesc(descriptorSetLight);
@@ -822,29 +1012,54 @@ namespace pr
 
 	void Renderer::updateLights(UserCamera& userCamera, pr::Scene::Ptr scene)
 	{
-		std::vector<LightUniformData> lightData;
-		for (auto root : scene->getRootNodes())
-		{
-			for (auto e : root->getChildrenWithComponent<pr::Light>())
-			{
-				auto t = e->getComponent<pr::Transform>();
-				auto l = e->getComponent<pr::Light>();
+		lightData.clear();
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			auto t = e->getComponent<pr::Transform>();
 
-				LightUniformData data;
-				l->writeUniformData(data, t);
-				lightData.push_back(data);
+			LightUniformData data;
+			l->writeUniformData(data, t);
+			lightData.push_back(data);
 
-				l->updateLightViewProjection(userCamera, t);
-			}
-		}
+			l->updateLightViewProjection(userCamera, t);
+		});
+
+		uploadLights();
+		updateClusters();
+	}
+
+	void Renderer::updateShadowIndices(pr::Scene::Ptr scene)
+	{
+		// the shadow slots of the point lights are assigned by the shadows, the light order is the same
+		uint32 index = 0;
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			if (index < lightData.size())
+				lightData[index].shadowIndex = l->getShadowIndex();
+			index++;
+		});
+
+		uploadLights();
+		updateClusters();
+	}
+
+	void Renderer::uploadLights()
+	{
+		const int maxLights = sizeof(Lights::lightData) / sizeof(LightUniformData);
+		if ((int)lightData.size() > maxLights && !lightClusters.getDescriptorSet())
+			std::cout << "error: too many lights, max. lights: " << maxLights << std::endl;
 
 		Lights lights;
-		for (int i = 0; i < lightData.size(); i++)
+		lights.numLights = std::min((int)lightData.size(), maxLights);
+		for (int i = 0; i < lights.numLights; i++)
 			lights.lightData[i] = lightData[i];
-		lights.numLights = (int)lightData.size();
 		lightUBO->uploadMapped(&lights);
 	}
 
+	void Renderer::updateClusters()
+	{
+		if (frustumValid)
+			lightClusters.update(lightData, viewMatrix, projMatrix, camera.zNear, camera.zFar, width, height);
+	}
+
 	void Renderer::updateCamera(Scene::Ptr scene, UserCamera& userCamera, float time, int debugChannel)
 	{
 		//userCamera.setAspect((float)width / (float)height);
@@ -862,6 +1077,11 @@ namespace pr
 		camera.zFar = userCamera.getZFar();
 		camera.scale = 1.0f / log2(userCamera.getZFar() / userCamera.getZNear());
 		camera.bias = -(log2(userCamera.getZNear()) * camera.scale);
+		viewFrustum = Math::Frustrum(userCamera.getViewProjectionMatrix());
+		frustumValid = true;
+		viewMatrix = userCamera.getViewMatrix();
+		projMatrix = userCamera.getProjectionMatrix();
+		viewFar = camera.zFar;
 
 		if (GraphicsContext::getInstance().getCurrentAPI() == GraphicsAPI::Direct3D11)
 		{
@@ -873,17 +1093,12 @@ namespace pr
 			camera.V_I = glm::transpose(camera.V_I);
 		}
 
-		for (auto root : scene->getRootNodes())
-		{
-			for (auto e : root->getChildrenWithComponent<pr::Light>())
-			{
-				auto t = e->getComponent<pr::Transform>();
-				auto l = e->getComponent<pr::Light>();
-				l->updateLightViewProjection(userCamera, t);
-			}
-		}		
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			l->updateLightViewProjection(userCamera, e->getComponent<pr::Transform>());
+		});
 
 		cameraUBO->uploadMapped((uint8*)&camera);
+		updateClusters();
 		updated = true;
 	}
 
@@ -903,6 +1118,11 @@ namespace pr
 		camera.zFar = 1000.0f;
 		camera.scale = 1.0f / log2(camera.zFar / camera.zNear);
 		camera.bias = -(log2(camera.zNear) * camera.scale);
+		viewFrustum = Math::Frustrum(P * V);
+		frustumValid = true;
+		viewMatrix = V;
+		projMatrix = P;
+		viewFar = camera.zFar;
 
 		if (GraphicsContext::getInstance().getCurrentAPI() == GraphicsAPI::Direct3D11)
 		{
@@ -915,13 +1135,16 @@ namespace pr
 		}
 
 		cameraUBO->uploadMapped((uint8*)&camera);
+		updateClusters();
 		updated = true;
 	}
 
 	void Renderer::updateShadows(pr::Scene::Ptr scene)
 	{
+		shadows.cullCasters(scene);
+		modelUniforms->flush();
 		shadows.updateShadowsCSM(0, scene);
-		shadows.updateShadowsOMNI(scene);
+		shadows.updateShadowsOMNI(scene, viewMatrix, projMatrix);
 	}
 
 	void Renderer::updatePost(Post& post)
@@ -931,10 +1154,17 @@ namespace pr
 
 	void Renderer::renderToTexture(pr::Scene::Ptr scene)
 	{
+		updateInstances();
+
+		// the cascade masks of the casters are part of the model data, so cull before the flush
+		if (updated)
+			shadows.cullCasters(scene);
+		modelUniforms->flush();
+
 		if (updated)
 		{
 			shadows.updateShadowsCSM(0, scene);
-			shadows.updateShadowsOMNI(scene);
+			shadows.updateShadowsOMNI(scene, viewMatrix, projMatrix);
 			scatter.flush();			
 			volumes.updateVolumes(scene);
 			updated = false;
@@ -11,7 +11,11 @@
 #include <Core/Scene.h>
 
 #include <Graphics/UserCamera.h>
+#include <Graphics/Frustrum.h>
 #include <Graphics/GraphicsContext.h>
+#include <Graphics/DrawList.h>
+#include <Graphics/LightClusters.h>
+#include <Graphics/MeshletCulling.h>
 #include <Graphics/Primitive.h>
 #include <Graphics/GUI.h>
 #include <Graphics/PostProcessor.h>
@@ -20,6 +24,8 @@
 #include <Graphics/Outline.h>
 #include <Graphics/Scatter.h>
 
+#include <set>
+
 namespace pr
 {
 	struct CameraData
@@ -63,9 +69,11 @@ namespace pr
 		void initDescriptorSets();
 		void initPipelines();
 		void initScene(UserCamera& userCamera, Scene::Ptr scene);
+		void initDescriptors(pr::Scene::Ptr scene);
 		void resize(uint32 width, uint32 height);
 		void prepare(UserCamera& userCamera, pr::Scene::Ptr scene);
 		void buildCmdBuffer(pr::Scene::Ptr scene, GPU::Swapchain::Ptr swapchain = nullptr);
+		void updateCmdBuffer(pr::Scene::Ptr scene, GPU::Swapchain::Ptr swapchain = nullptr);
 		void buildScatterCmdBuffer(pr::Scene::Ptr scene);
 		void buildShadowCmdBuffer(pr::Scene::Ptr scene);
 		void addLights(pr::Scene::Ptr scene);
@@ -75,6 +83,14 @@ namespace pr
 		void updateShadows(pr::Scene::Ptr scene);
 		void updatePost(Post& post);
 		void renderToTexture(pr::Scene::Ptr scene);
+		void setFrustumCulling(bool enabled) { frustumCulling = enabled; }
+		bool isFrustumCullingEnabled() { return frustumCulling; }
+		void setInstancing(bool enabled) { instancing = enabled; }
+		bool isInstancingEnabled() { return instancing; }
+		void setLodSelection(bool enabled) { lodSelection = enabled; }
+		bool isLodSelectionEnabled() { return lodSelection; }
+		void setMeshletCulling(bool enabled) { cullMeshlets = enabled; }
+		bool isMeshletCullingEnabled() { return cullMeshlets; }
 
 		GPU::DescriptorPool::Ptr getDescriptorPool() { return descriptorPool; }
 		GPU::CommandBuffer::Ptr getCommandBuffer(int index) {
@@ -91,13 +107,34 @@ namespace pr
 		}
 
 	private:
+		void createMaterialPipeline(const std::string& pipelineName, const std::string& shaderPath, const std::string& shaderName, bool transparent);
+		void collectDraws(pr::Scene::Ptr scene);
+		void recordCmdBuffers(pr::Scene::Ptr scene, GPU::Swapchain::Ptr swapchain);
+		void addSignature(DrawList& drawList);
+		bool isVisible(Renderable::Ptr renderable);
+		bool supportsStorageBuffers();
+		bool canInstance(Renderable::Ptr renderable, const std::string& pipelineName);
+		float getViewDepth(Renderable::Ptr renderable);
+		float getLodError(Renderable::Ptr renderable);
+		void addDraw(DrawList& drawList, const RenderBatch& batch, Renderable::Ptr renderable, GPU::GraphicsPipeline::Ptr pipeline);
+		void addDraws(DrawList& drawList, const std::vector<RenderBatch>& batches, bool allowInstancing);
+		void recordDraws(GPU::CommandBuffer::Ptr cmdBuf, DrawList& drawList);
+		void resizeInstanceBuffer(uint32 capacity);
+		void updateInstances();
+		void updateShadowIndices(pr::Scene::Ptr scene);
+		void uploadLights();
+		void updateClusters();
+
 		PostProcessor postProcessor;
 		Shadows shadows;
 		Volumes volumes;
 		Outline outline;
 		Scatter scatter;
+		LightClusters lightClusters;
+		MeshletCulling meshletCulling;
 
 		std::map<std::string, GPU::GraphicsPipeline::Ptr> pipelines;
+		std::set<std::string> instancedPipelines; // vertex shader reads the model matrices from the instance buffer
 		GPU::GraphicsPipeline::Ptr skyboxPipeline;
 		GPU::Framebuffer::Ptr offscreenFramebuffer;
 		GPU::Framebuffer::Ptr offscreenFramebuffer2;
@@ -107,6 +144,7 @@ namespace pr
 
 		GPU::DescriptorPool::Ptr descriptorPool;
 		GPU::DescriptorSet::Ptr descriptorSetCamera;
+		GPU::DescriptorSet::Ptr descriptorSetModel;
 		GPU::DescriptorSet::Ptr descriptorSetSkybox;
 		GPU::DescriptorSet::Ptr descriptorSetIBL;
 		GPU::DescriptorSet::Ptr descriptorSetLight;
@@ -114,6 +152,7 @@ namespace pr
 		GPU::DescriptorSet::Ptr animDescriptorSet;
 		GPU::DescriptorSet::Ptr morphDescriptorSet;
 
+		GPU::UniformAllocator::Ptr modelUniforms;
 		GPU::Buffer::Ptr cameraUBO;
 		GPU::Buffer::Ptr skyboxUBO;
 		GPU::Buffer::Ptr lightUBO;
@@ -137,6 +176,63 @@ namespace pr
 		std::vector<CameraData> cameras;
 		CameraData camera;
 		Skybox skyboxData;
+		Math::Frustrum viewFrustum;
+		bool frustumValid = false;
+		bool frustumCulling = true;
+
+		// draw lists are sorted while recording, depth is taken from the current view
+		DrawList opaqueDraws{ false };
+		DrawList transparentDraws{ true };
+		glm::mat4 viewMatrix = glm::mat4(1);
+		glm::mat4 projMatrix = glm::mat4(1);
+		float viewFar = 1000.0f;
+
+		// With frustum culling the draws are collected again when the view or the scene changed,
+		// the command buffers are only recorded again if anything they contain is different.
+		std::vector<uint64> drawSignature;
+		std::vector<uint64> recordedSignature;
+		Scene* recordedScene = nullptr;
+		GPU::Swapchain::Ptr recordedSwapchain;
+		uint32 recordedSceneVersion = 0;
+		glm::mat4 recordedViewProj = glm::mat4(0);
+
+		// Each renderable draws the coarsest LOD of its primitives whose error, projected to
+		// the screen, stays below this many pixels.
+		bool lodSelection = true;
+		const float lodPixelError = 1.0f;
+		bool cullMeshlets = true;
+
+		// Opaque renderables that share a mesh are merged into one instanced draw. The group
+		// uses a copy of the model data of its first renderable and reads the model matrices
+		// of all instances from a storage buffer, which is refreshed every frame. Only
+		// renderables with the same lighting data as the first one end up in a group.
+		struct InstanceKey
+		{
+			Mesh* mesh;
+			int diffuseMode;
+			int reflectionProbe;
+			const std::vector<glm::vec3>* sh;
+
+			InstanceKey(Renderable::Ptr renderable);
+			bool operator<(const InstanceKey& other) const;
+		};
+		struct InstanceGroup
+		{
+			std::vector<Renderable::Ptr> renderables;
+			uint32 firstInstance = 0;
+			uint32 uniformOffset = 0;
+		};
+		std::vector<InstanceGroup> instanceGroups;
+		std::vector<uint32> instanceUniforms;
+		std::vector<glm::mat4> instanceMatrices;
+		GPU::Buffer::Ptr instanceBuffer;
+		GPU::DescriptorSet::Ptr descriptorSetInstances;
+		bool instancing = true;
+		const uint32 minInstances = 2;
+
+		// All lights are binned into the clusters, the light UBO only holds the first
+		// lights for the shaders that still loop over all lights (Vulkan, DX11, volumes).
+		std::vector<LightUniformData> lightData;
 
 		// helper meshes
 		pr::Primitive::Ptr unitQuad;
@@ -144,6 +240,7 @@ namespace pr
 
 		uint32 width = 0;
 		uint32 height = 0;
+		const uint32 maxRenderables = 8192;
 
 		bool updated = false;
 		bool offscreen = false;
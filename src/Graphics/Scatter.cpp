@@ -130,35 +130,18 @@ namespace pr
 	{
 		auto& ctx = GraphicsContext::getInstance();
 		std::string shaderName = "DefaultScatter";
-		GPU::VertexDescription vertexInputDescription;
-		vertexInputDescription.binding = 0;
-		vertexInputDescription.stride = sizeof(Vertex);
-		vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(5, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, tangent)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-
-		vertexInputDescription.inputAttributes[0].name = "POSITION";
-		vertexInputDescription.inputAttributes[1].name = "COLOR";
-		vertexInputDescription.inputAttributes[2].name = "NORMAL";
-		vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-		vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-		vertexInputDescription.inputAttributes[4].index = 1;
-		vertexInputDescription.inputAttributes[5].name = "TANGENT";
-		vertexInputDescription.inputAttributes[6].name = "BLENDINDICES";
-		vertexInputDescription.inputAttributes[7].name = "BLENDWEIGHT";
+		VertexLayout vertexLayout = { VertexStream::Position, VertexStream::Normal, VertexStream::Tangent, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Color, VertexStream::Skin };
+		GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 		std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "Material", "IBL", "Light" };
 		scatterPipeline = ctx.createGraphicsPipeline(scatterFramebuffer, shaderName, 1);
 
 		GraphicsAPI api = ctx.getCurrentAPI();
+		if (api == GraphicsAPI::OpenGL || api == GraphicsAPI::Null)
+			setLayouts.push_back("Clusters");
 		switch (api)
 		{
+		case GraphicsAPI::Null:
 		case GraphicsAPI::OpenGL:
 		{
 			std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -198,7 +181,7 @@ namespace pr
 	void Scatter::buildCmdBuffer(pr::Scene::Ptr scene, std::map<uint32, GPU::DescriptorSet::Ptr> descriptorSets)
 	{		
 		// TODO: only get nodes with volume scatter material
-		auto opaqueNodes = scene->getOpaqueEntities();
+		auto& opaqueNodes = scene->getOpaqueEntities();
 
 		scatterCmdBuf->begin();
 		scatterCmdBuf->setViewport(0.0f, 0.0f, (float)width, (float)height);
@@ -207,12 +190,12 @@ namespace pr
 
 		// opaque forward pass
 		scatterCmdBuf->setCullMode(2);
-		for (auto&& [shaderName, renderQueue] : opaqueNodes)
+		for (auto& batch : opaqueNodes)
 		{
 			scatterCmdBuf->bindPipeline(scatterPipeline);
 			for (auto&& [setIndex, descriptorSet] : descriptorSets)
 				scatterCmdBuf->bindDescriptorSets(scatterPipeline, descriptorSet, setIndex);
-			for (auto e : renderQueue)
+			for (auto e : batch.entities)
 			{
 				if (e->isActive())
 				{
@@ -0,0 +1,99 @@
+#include "ShadowAtlas.h"
+#include <algorithm>
+
+namespace pr
+{
+	ShadowAtlas::ShadowAtlas(uint32 size, uint32 minTileSize) :
+		size(size),
+		minTileSize(minTileSize)
+	{
+		reset();
+	}
+
+	ShadowAtlas::~ShadowAtlas()
+	{
+
+	}
+
+	bool ShadowAtlas::allocate(uint32 tileSize, glm::uvec2& offset)
+	{
+		// take the smallest free tile that is large enough
+		int level = static_cast<int>(getLevel(tileSize));
+		int freeLevel = level;
+		while (freeLevel >= 0 && freeTiles[freeLevel].empty())
+			freeLevel--;
+		if (freeLevel < 0)
+			return false;
+
+		glm::uvec2 tile = freeTiles[freeLevel].back();
+		freeTiles[freeLevel].pop_back();
+
+		// split it down to the requested size, the first child is used and the others are free
+		for (int l = freeLevel; l < level; l++)
+		{
+			uint32 half = size >> (l + 1);
+			freeTiles[l + 1].push_back(tile + glm::uvec2(half, 0));
+			freeTiles[l + 1].push_back(tile + glm::uvec2(0, half));
+			freeTiles[l + 1].push_back(tile + glm::uvec2(half, half));
+		}
+
+		offset = tile;
+		return true;
+	}
+
+	void ShadowAtlas::release(uint32 tileSize, glm::uvec2 offset)
+	{
+		uint32 level = getLevel(tileSize);
+		glm::uvec2 tile = offset;
+		while (level > 0)
+		{
+			// merge with the siblings if all three of them are free
+			uint32 parentSize = size >> (level - 1);
+			uint32 half = parentSize / 2;
+			glm::uvec2 parent = (tile / parentSize) * parentSize;
+
+			auto& tiles = freeTiles[level];
+			std::vector<std::vector<glm::uvec2>::iterator> siblings;
+			for (uint32 i = 0; i < 4; i++)
+			{
+				glm::uvec2 sibling = parent + glm::uvec2((i & 1) * half, (i >> 1) * half);
+				if (sibling == tile)
+					continue;
+				auto it = std::find(tiles.begin(), tiles.end(), sibling);
+				if (it == tiles.end())
+					break;
+				siblings.push_back(it);
+			}
+			if (siblings.size() < 3)
+				break;
+
+			// erase from the back so the remaining iterators stay valid
+			std::sort(siblings.begin(), siblings.end());
+			for (auto it = siblings.rbegin(); it != siblings.rend(); ++it)
+				tiles.erase(*it);
+
+			tile = parent;
+			level--;
+		}
+		freeTiles[level].push_back(tile);
+	}
+
+	void ShadowAtlas::reset()
+	{
+		uint32 numLevels = 1;
+		while ((size >> numLevels) >= minTileSize && (size >> numLevels) > 0)
+			numLevels++;
+
+		freeTiles.clear();
+		freeTiles.resize(numLevels);
+		freeTiles[0].push_back(glm::uvec2(0));
+	}
+
+	uint32 ShadowAtlas::getLevel(uint32 tileSize)
+	{
+		uint32 level = 0;
+		while (level + 1 < freeTiles.size() && (size >> (level + 1)) >= tileSize)
+			level++;
+		return level;
+	}
+}
\ No newline at end of file
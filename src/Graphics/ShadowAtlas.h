@@ -0,0 +1,43 @@
+#ifndef INCLUDED_SHADOWATLAS
+#define INCLUDED_SHADOWATLAS
+
+#pragma once
+
+#include <Platform/Types.h>
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace pr
+{
+	// Quadtree allocator for square tiles of a shadow atlas. Tile sizes are powers of two between
+	// minTileSize and the atlas size. Free tiles are kept in one list per size, larger tiles are
+	// split on demand and a released tile is merged with its three siblings when they are free,
+	// so the atlas does not fragment when lights change their resolution.
+	class ShadowAtlas
+	{
+	public:
+		ShadowAtlas(uint32 size, uint32 minTileSize);
+		~ShadowAtlas();
+
+		bool allocate(uint32 tileSize, glm::uvec2& offset);
+		void release(uint32 tileSize, glm::uvec2 offset);
+		void reset();
+		uint32 getSize()
+		{
+			return size;
+		}
+
+	private:
+		uint32 getLevel(uint32 tileSize);
+
+		uint32 size;
+		uint32 minTileSize;
+		std::vector<std::vector<glm::uvec2>> freeTiles; // one list per level, level 0 is the whole atlas
+
+		ShadowAtlas(const ShadowAtlas&) = delete;
+		ShadowAtlas& operator=(const ShadowAtlas&) = delete;
+	};
+}
+
+#endif // INCLUDED_SHADOWATLAS
\ No newline at end of file
@@ -1,8 +1,19 @@
 #include "Shadows.h"
+#include <Graphics/Frustrum.h>
 #include <Utils/IBL.h>
+#include <algorithm>
+#include <set>
 namespace pr
 {
-	Shadows::Shadows()
+	static bool intersectsSphere(const AABB& box, const glm::vec3& center, float radius)
+	{
+		glm::vec3 closest = glm::clamp(center, box.getMinPoint(), box.getMaxPoint());
+		glm::vec3 d = closest - center;
+		return glm::dot(d, d) <= radius * radius;
+	}
+
+	Shadows::Shadows() :
+		omniAtlas(omniAtlasSize, omniMinTileSize)
 	{
 
 	}
@@ -16,37 +27,74 @@ namespace pr
 		auto& ctx = GraphicsContext::getInstance();
 
 		uint32 size = 4096;
-		csmShadowMap = Texture2DArray::create(size, size, 4, GPU::Format::DEPTH32, 1, GPU::ImageUsage::DepthStencilAttachment | GPU::ImageUsage::Sampled);
+		auto usage = GPU::ImageUsage::DepthStencilAttachment | GPU::ImageUsage::Sampled | GPU::ImageUsage::TransferSrc | GPU::ImageUsage::TransferDst;
+		csmShadowMap = Texture2DArray::create(size, size, 4, GPU::Format::DEPTH32, 1, usage);
 		csmShadowMap->setAddressMode(GPU::AddressMode::ClampToBorder);
 		csmShadowMap->setFilter(GPU::Filter::Nearest, GPU::Filter::Nearest);
 		csmShadowMap->setLayout();
 
-		csmFBO = ctx.createFramebuffer(size, size, 4, true, true);
-		csmFBO->addAttachment(csmShadowMap->getImageView());
-		csmFBO->createFramebuffer();
+		// static casters are rendered into a separate map, which is copied into the shadow map
+		// before the dynamic casters are drawn on top, so the dynamic pass must not clear
+		csmStaticMap = Texture2DArray::create(size, size, 4, GPU::Format::DEPTH32, 1, usage);
+		csmStaticMap->setLayout();
+
+		csmStaticFBO = ctx.createFramebuffer(size, size, 4, true, true);
+		csmStaticFBO->addAttachment(csmStaticMap->getImageView());
+		csmStaticFBO->createFramebuffer();
+
+		csmDynamicFBO = ctx.createFramebuffer(size, size, 4, true, false);
+		csmDynamicFBO->addAttachment(csmShadowMap->getImageView());
+		csmDynamicFBO->createFramebuffer();
 
 		csmCmdBuf = ctx.allocateCommandBuffer();
+		csmStaticCmdBuf = ctx.allocateCommandBuffer();
 
 		csmViewsUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(CSMViews), 0);
 		csmDataUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(CSMData), 0);
 
-		size = 4096;
-		omniShadowMap = TextureCubeMapArray::create(size, 1, GPU::Format::DEPTH32, 1, GPU::ImageUsage::DepthStencilAttachment | GPU::ImageUsage::Sampled);
+		for (int i = 0; i < 6; i++)
+			omniViewsUBOs[i] = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(OMNIViews), 0);
+		omniDataUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(OMNIData), 0);
+
+		// all point lights share one atlas, each light gets six tiles for the faces of its cube
+		// and the tiles of the static casters are cleared by copying from an empty tile
+		size = omniAtlasSize;
+		omniShadowMap = Texture2D::create(size, size, GPU::Format::DEPTH32, 1, usage);
 		omniShadowMap->setAddressMode(GPU::AddressMode::ClampToEdge);
 		omniShadowMap->setFilter(GPU::Filter::Linear, GPU::Filter::Linear);
 		omniShadowMap->setCompareMode();
 		omniShadowMap->setLayout();
-		
-		omniViewsUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(OMNIViews), 0);
-		omniDataUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(OMNIData), 0);
 
-		auto image = omniShadowMap->getImage();
-		auto fbo = ctx.createFramebuffer(size, size, 6, true, true);
-		auto view = image->createImageView(GPU::ViewType::ViewCubeMap, GPU::SubResourceRange(0, 0, 1, 6));
-		fbo->addAttachment(view);
-		fbo->createFramebuffer();
-		omniShadowFBOs.push_back(fbo);
-		omniShadowViews.push_back(view);
+		omniStaticMap = Texture2D::create(size, size, GPU::Format::DEPTH32, 1, usage);
+		omniStaticMap->setLayout();
+
+		omniStaticFBO = ctx.createFramebuffer(size, size, 1, true, false);
+		omniStaticFBO->addAttachment(omniStaticMap->getImageView());
+		omniStaticFBO->createFramebuffer();
+
+		omniDynamicFBO = ctx.createFramebuffer(size, size, 1, true, false);
+		omniDynamicFBO->addAttachment(omniShadowMap->getImageView());
+		omniDynamicFBO->createFramebuffer();
+
+		omniClearTile = Texture2D::create(omniMaxTileSize, omniMaxTileSize, GPU::Format::DEPTH32, 1, usage);
+		omniClearTile->setLayout();
+
+		auto clearFBO = ctx.createFramebuffer(omniMaxTileSize, omniMaxTileSize, 1, true, true);
+		clearFBO->addAttachment(omniClearTile->getImageView());
+		clearFBO->createFramebuffer();
+
+		auto cmdBuf = ctx.allocateCommandBuffer();
+		cmdBuf->begin();
+		cmdBuf->beginRenderPass(clearFBO);
+		cmdBuf->endRenderPass();
+		cmdBuf->end();
+		cmdBuf->flush();
+
+		omniCmdBuf = ctx.allocateCommandBuffer();
+		omniStaticCmdBuf = ctx.allocateCommandBuffer();
+
+		for (auto& tile : shadowData.omniTiles)
+			tile = glm::vec4(0.0f);
 
 		unitCube = createCube(glm::vec3(0), 1.0f);
 		unitQuad = createScreenQuad();
@@ -56,29 +104,16 @@ namespace pr
 	{
 		auto& ctx = GraphicsContext::getInstance();
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[2].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[2].index = 1;
-			vertexInputDescription.inputAttributes[3].name = "BLENDINDICES";
-			vertexInputDescription.inputAttributes[4].name = "BLENDWEIGHT";
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Skin };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<std::string> setLayouts = { "Camera", "Model", "Animation", "Morph", "CSM", "MaterialShadow" };
 
-			shadowCSMPipeline = ctx.createGraphicsPipeline(csmFBO, "CSM", 1);
+			shadowCSMPipeline = ctx.createGraphicsPipeline(csmStaticFBO, "CSM", 1);
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -117,30 +152,17 @@ namespace pr
 			shadowCSMPipeline->createProgram();
 		}
 		{
-			GPU::VertexDescription vertexInputDescription;
-			vertexInputDescription.binding = 0;
-			vertexInputDescription.stride = sizeof(Vertex);
-			vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(6, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, joints)));
-			vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(7, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, weights)));
-
-			vertexInputDescription.inputAttributes[0].name = "POSITION";
-			vertexInputDescription.inputAttributes[1].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[2].name = "TEXCOORD";
-			vertexInputDescription.inputAttributes[2].index = 1;
-			vertexInputDescription.inputAttributes[3].name = "BLENDINDICES";
-			vertexInputDescription.inputAttributes[4].name = "BLENDWEIGHT";
+			VertexLayout vertexLayout = { VertexStream::Position, VertexStream::TexCoord0, VertexStream::TexCoord1, VertexStream::Skin };
+			GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 			std::vector<std::string> setLayouts = { "Camera", "Model",  "Animation", "Morph", "OMNIViews", "MaterialShadow", "OMNILight" };
 
-			shadowOMNIPipeline = ctx.createGraphicsPipeline(omniShadowFBOs[0], "OMNI", 1);
+			shadowOMNIPipeline = ctx.createGraphicsPipeline(omniStaticFBO, "OMNI", 1);
 			shadowOMNIPipeline->setWindingOrder(1);
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -210,9 +232,12 @@ namespace pr
 		descriptorSetShadow->addDescriptor(csmViewsUBO->getDescriptor());
 		descriptorSetShadow->update();
 
-		descriptorSetOmniViews = descriptorPool->createDescriptorSet("OMNIViews", 1);
-		descriptorSetOmniViews->addDescriptor(omniViewsUBO->getDescriptor());
-		descriptorSetOmniViews->update();
+		for (int i = 0; i < 6; i++)
+		{
+			descriptorSetsOmniViews[i] = descriptorPool->createDescriptorSet("OMNIViews", 1);
+			descriptorSetsOmniViews[i]->addDescriptor(omniViewsUBOs[i]->getDescriptor());
+			descriptorSetsOmniViews[i]->update();
+		}
 
 		descriptorSetOmniLight = descriptorPool->createDescriptorSet("OMNILight", 1);
 		descriptorSetOmniLight->addDescriptor(omniDataUBO->getDescriptor());
@@ -221,42 +246,27 @@ namespace pr
 
 	void Shadows::updateLights(pr::Scene::Ptr scene)
 	{
-		auto& ctx = GraphicsContext::getInstance();
-		std::vector<pr::Light::Ptr> lights;
-		for (auto entity : scene->getRootNodes())
-		{
-			auto lightsEntity = entity->getChildrenWithComponent<Light>();
-			for (auto lightEntity : lightsEntity)
+		// every shadowed point light gets a slot in the tile table, the tiles are assigned on update
+		omniAtlas.reset();
+		omniLights.clear();
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			if (l->getType() == LightType::POINT && l->getCastShadows() && omniLights.size() < maxShadowLights)
 			{
-				auto t = lightEntity->getComponent<pr::Transform>();
-				auto l = lightEntity->getComponent<pr::Light>();
-				if (l->getType() == LightType::POINT)
-				{
-					lights.push_back(l);
-				}
+				l->setShadowIndex(static_cast<int>(omniLights.size()));
+				OMNILight omniLight;
+				omniLight.light = l;
+				omniLight.transform = e->getComponent<pr::Transform>();
+				omniLights.push_back(omniLight);
 			}
-		}
-
-		uint32 size = 4096;
-		omniShadowMap = TextureCubeMapArray::create(size, (uint32)(lights.size() > 0 ? lights.size() : 1), GPU::Format::DEPTH32, 1, GPU::ImageUsage::DepthStencilAttachment | GPU::ImageUsage::Sampled);
-		omniShadowMap->setAddressMode(GPU::AddressMode::ClampToEdge);
-		omniShadowMap->setFilter(GPU::Filter::Linear, GPU::Filter::Linear);
-		omniShadowMap->setCompareMode();
-		omniShadowMap->setLayout();
-
-		omniShadowFBOs.clear();
-		omniShadowViews.clear();
+			else
+			{
+				l->setShadowIndex(-1);
+			}
+		});
 
-		auto image = omniShadowMap->getImage();
-		for (int i = 0; i < lights.size(); i++)
-		{
-			auto fbo = ctx.createFramebuffer(size, size, 6, true, true);
-			auto view = image->createImageView(GPU::ViewType::ViewCubeMap, GPU::SubResourceRange(0, i * 6, 1, 6));
-			fbo->addAttachment(view);
-			fbo->createFramebuffer();
-			omniShadowFBOs.push_back(fbo);
-			omniShadowViews.push_back(view);
-		}
+		for (auto& tile : shadowData.omniTiles)
+			tile = glm::vec4(0.0f);
+		csmDataUBO->uploadMapped(&shadowData);
 	}
 
 	void Shadows::addDesc(GPU::DescriptorSet::Ptr lightDescSet)
@@ -271,18 +281,13 @@ namespace pr
 		auto& ctx = GraphicsContext::getInstance();
 		std::vector<glm::mat4> lightSpaceMatrices(4);
 		int numDirLights = 0;
-		for (auto root : scene->getRootNodes())
-		{
-			for (auto lightEntity : root->getChildrenWithComponent<pr::Light>())
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			if (l->getType() == LightType::DIRECTIONAL)
 			{
-				auto l = lightEntity->getComponent<pr::Light>();
-				if (l->getType() == LightType::DIRECTIONAL)
-				{
-					lightSpaceMatrices = l->getViewProjections();
-					numDirLights++;
-				}					
+				lightSpaceMatrices = l->getViewProjections();
+				numDirLights++;
 			}
-		}
+		});
 
 		if (numDirLights == 0)
 			return;
@@ -302,132 +307,444 @@ namespace pr
 			0.0
 		};
 
-		CSMData csmData;
 		for (int i = 0; i < 4; i++)
 		{
-			csmData.lightSpaceMatrices[i] = lightSpaceMatrices[i];
-			csmData.cascadePlaneDistance[i] = csmLevels[i];
+			shadowData.lightSpaceMatrices[i] = lightSpaceMatrices[i];
+			shadowData.cascadePlaneDistance[i] = csmLevels[i];
+		}
+		shadowData.cascadeCount = 3;
+		csmDataUBO->uploadMapped(&shadowData);
+
+		// the static casters are only drawn again when they or the cascades changed
+		bool staticChanged = !csmCacheValid;
+		for (int i = 0; i < 4; i++)
+			staticChanged |= (views.VP[i] != csmCachedViews[i]);
+		if (staticChanged)
+		{
+			recordCSM(csmStaticCmdBuf, csmStaticCasters, false);
+			csmStaticCmdBuf->flush();
+			for (int i = 0; i < 4; i++)
+				csmCachedViews[i] = views.VP[i];
+			csmCacheValid = true;
 		}
-		csmData.cascadeCount = 3;
-		csmDataUBO->uploadMapped(&csmData);
 
-		csmCmdBuf->flush();
+		// the dynamic pass also runs once after the last dynamic caster left to remove its shadow
+		bool hasDynamic = !csmDynamicCasters.empty();
+		if (staticChanged || hasDynamic || csmHadDynamic)
+		{
+			recordCSM(csmCmdBuf, csmDynamicCasters, true);
+			csmCmdBuf->flush();
+		}
+		csmHadDynamic = hasDynamic;
 	}
 
-	void Shadows::updateShadowsOMNI(pr::Scene::Ptr scene)
+	void Shadows::updateShadowsOMNI(pr::Scene::Ptr scene, const glm::mat4& V, const glm::mat4& P)
 	{
 		auto& ctx = GraphicsContext::getInstance();
-		uint32 size = 4096;
-		std::vector<glm::vec3> lightPositions;
-		std::vector<pr::Light::Ptr> lights;
-		for (auto entity : scene->getRootNodes())
+		frameCount++;
+
+		// the importance of a light is the fraction of the screen height covered by its range
+		Math::Frustrum viewFrustum(P * V);
+		std::vector<uint32> visibleLights;
+		for (uint32 i = 0; i < omniLights.size(); i++)
 		{
-			auto lightsEntity = entity->getChildrenWithComponent<Light>();
-			for (auto lightEntity : lightsEntity)
+			auto& omniLight = omniLights[i];
+			omniLight.importance = 0.0f;
+
+			// the depth is stored relative to the range, so lights without a range have no shadows
+			float range = omniLight.light->getRange();
+			if (!omniLight.light->getCastShadows() || range <= 0.0f)
+				continue;
+
+			glm::vec3 position = omniLight.transform->getPosition();
+			glm::vec3 minPoint = position - glm::vec3(range);
+			glm::vec3 maxPoint = position + glm::vec3(range);
+			AABB bounds(minPoint, maxPoint);
+			if (!viewFrustum.isInside(bounds))
+				continue;
+
+			float dist = glm::length(glm::vec3(V * glm::vec4(position, 1.0f)));
+			omniLight.importance = dist > range ? glm::min(range * P[1][1] / dist, 1.0f) : 1.0f;
+			omniLight.lastUsed = frameCount;
+			visibleLights.push_back(i);
+		}
+		std::sort(visibleLights.begin(), visibleLights.end(), [&](uint32 a, uint32 b) {
+			return omniLights[a].importance > omniLights[b].importance;
+		});
+
+		// the tiles of a light are kept unless its importance asks for more than twice or less than
+		// half of their resolution, if the atlas is full the least recently used tiles are evicted
+		for (auto i : visibleLights)
+		{
+			auto& omniLight = omniLights[i];
+			uint32 tileSize = omniMaxTileSize;
+			while (tileSize > omniMinTileSize && omniLight.importance * omniMaxTileSize <= tileSize / 2)
+				tileSize /= 2;
+
+			if (omniLight.tileSize > 0 && tileSize <= omniLight.tileSize && tileSize * 2 >= omniLight.tileSize)
+				continue;
+
+			releaseTiles(omniLight);
+			writeTiles(i);
+			while (!allocateTiles(omniLight, tileSize))
 			{
-				auto t = lightEntity->getComponent<pr::Transform>();
-				auto l = lightEntity->getComponent<pr::Light>();
-				if (l->getType() == LightType::POINT)
-				{
-					lights.push_back(l);
-					lightPositions.push_back(t->getPosition());
-				}
+				if (evictTiles(omniLight.importance))
+					continue;
+				if (tileSize == omniMinTileSize)
+					break;
+				tileSize /= 2;
 			}
 		}
 
-		for (int i = 0; i < lights.size(); i++)
+		// the static tiles of at most omniUpdatesPerFrame lights are rendered per update, the most
+		// important lights first, dynamic casters are drawn for every visible light
+		uint32 staticUpdates = 0;
+		for (auto i : visibleLights)
 		{
-			OMNIViews views;
-			auto VPs = lights[i]->getViewProjections();
-			for (int j = 0; j < 6; j++)
+			auto& omniLight = omniLights[i];
+			if (omniLight.tileSize == 0)
+				continue;
+
+			glm::vec3 position = omniLight.transform->getPosition();
+			float range = omniLight.light->getRange();
+			bool staticChanged = !omniLight.valid || omniLight.position != position || omniLight.range != range;
+			if (staticChanged && staticUpdates >= omniUpdatesPerFrame)
+				continue;
+
+			auto VPs = omniLight.light->getViewProjections();
+			for (int f = 0; f < 6; f++)
 			{
+				OMNIViews views;
 				if (ctx.getCurrentAPI() == GraphicsAPI::Direct3D11)
-					views.VP[j] = glm::transpose(VPs[j]);
+					views.VP = glm::transpose(VPs[f]);
 				else
-					views.VP[j] = VPs[j];
+					views.VP = VPs[f];
 				views.lightIndex = i;
+				omniViewsUBOs[f]->uploadMapped(&views);
 			}
-			omniViewsUBO->uploadMapped(&views);
 
 			OMNIData omniData;
-			omniData.position = glm::vec4(lightPositions[i], 0.0f);
-			omniData.range = lights[i]->getRange();
+			omniData.position = glm::vec4(position, 0.0f);
+			omniData.range = range;
 			omniDataUBO->uploadMapped(&omniData);
 
-			omniCmdBufs[i]->flush();
+			if (staticChanged)
+			{
+				recordOMNI(omniStaticCmdBuf, omniLight, false);
+				omniStaticCmdBuf->flush();
+				omniLight.position = position;
+				omniLight.range = range;
+				omniLight.valid = true;
+				staticUpdates++;
+			}
+
+			bool hasDynamic = false;
+			for (int f = 0; f < 6; f++)
+				hasDynamic |= !omniLight.dynamicCasters[f].empty();
+			if (staticChanged || hasDynamic || omniLight.hadDynamic)
+			{
+				recordOMNI(omniCmdBuf, omniLight, true);
+				omniCmdBuf->flush();
+			}
+			omniLight.hadDynamic = hasDynamic;
+
+			if (staticChanged)
+				writeTiles(i);
 		}
+
+		csmDataUBO->uploadMapped(&shadowData);
 	}
 
-	void Shadows::buildCmdShadowsCSM(pr::Scene::Ptr scene)
+	bool Shadows::allocateTiles(OMNILight& light, uint32 tileSize)
 	{
-		uint32 size = 4096;
-		csmCmdBuf->begin();
-		csmCmdBuf->setViewport(0.0f, 0.0f, (float)size, (float)size);
-		csmCmdBuf->setScissor(0, 0, size, size);
-		csmCmdBuf->beginRenderPass(csmFBO);
-		csmCmdBuf->setCullMode(0);
-		csmCmdBuf->bindPipeline(shadowCSMPipeline);
-		csmCmdBuf->bindDescriptorSets(shadowCSMPipeline, camDescriptorSet, 0);
-		csmCmdBuf->bindDescriptorSets(shadowCSMPipeline, animDescriptorSet, 2);
-		csmCmdBuf->bindDescriptorSets(shadowCSMPipeline, morphDescriptorSet, 3);
-		csmCmdBuf->bindDescriptorSets(shadowCSMPipeline, descriptorSetShadow, 4);
-
-		auto opaqueNodes = scene->getOpaqueEntities();
-		for (auto&& [shaderName, renderQueue] : opaqueNodes)
+		for (int f = 0; f < 6; f++)
 		{
-			for (auto e : renderQueue)
+			if (!omniAtlas.allocate(tileSize, light.tiles[f]))
 			{
-				if (e->isActive())
-				{
-					auto r = e->getComponent<Renderable>();
-					r->renderDepth(csmCmdBuf, shadowCSMPipeline);
-				}
+				for (int i = 0; i < f; i++)
+					omniAtlas.release(tileSize, light.tiles[i]);
+				return false;
 			}
 		}
+		light.tileSize = tileSize;
+		light.valid = false;
+		return true;
+	}
+
+	void Shadows::releaseTiles(OMNILight& light)
+	{
+		if (light.tileSize == 0)
+			return;
 
-		csmCmdBuf->endRenderPass();
-		csmCmdBuf->end();
+		for (int f = 0; f < 6; f++)
+			omniAtlas.release(light.tileSize, light.tiles[f]);
+		light.tileSize = 0;
+		light.valid = false;
 	}
 
-	void Shadows::buildCmdShadowsOMNI(pr::Scene::Ptr scene)
+	bool Shadows::evictTiles(float importance)
 	{
-		uint32 size = 4096;
-		omniCmdBufs.clear();
+		// lights that were not visible in this update are evicted first, then the least important ones
+		int victim = -1;
+		for (uint32 i = 0; i < omniLights.size(); i++)
+		{
+			auto& omniLight = omniLights[i];
+			if (omniLight.tileSize == 0)
+				continue;
+			if (omniLight.lastUsed == frameCount && omniLight.importance >= importance)
+				continue;
+
+			if (victim < 0)
+			{
+				victim = i;
+				continue;
+			}
+
+			auto& other = omniLights[victim];
+			if (omniLight.lastUsed < other.lastUsed || (omniLight.lastUsed == other.lastUsed && omniLight.importance < other.importance))
+				victim = i;
+		}
+		if (victim < 0)
+			return false;
+
+		releaseTiles(omniLights[victim]);
+		writeTiles(victim);
+		return true;
+	}
+
+	void Shadows::writeTiles(uint32 slot)
+	{
+		auto& omniLight = omniLights[slot];
+		float scale = 1.0f / static_cast<float>(omniAtlasSize);
+		for (int f = 0; f < 6; f++)
+		{
+			glm::vec4& tile = shadowData.omniTiles[slot * 6 + f];
+			if (omniLight.valid)
+				tile = glm::vec4(glm::vec2(omniLight.tiles[f]) * scale, omniLight.tileSize * scale, 0.0f);
+			else
+				tile = glm::vec4(0.0f);
+		}
+	}
 
+	void Shadows::cullCasters(pr::Scene::Ptr scene)
+	{
 		auto& ctx = GraphicsContext::getInstance();
+		updateCasters(scene);
 
-		for (int i = 0; i < omniShadowFBOs.size(); i++)
+		std::vector<Math::Frustrum> cascades;
+		scene->forEachComponent<pr::Light>([&](pr::Entity* e, pr::Light::Ptr& l) {
+			if (l->getType() == LightType::DIRECTIONAL)
+			{
+				// the light space matrices are transposed for the D3D11 shaders
+				cascades.clear();
+				for (auto VP : l->getViewProjections())
+				{
+					if (ctx.getCurrentAPI() == GraphicsAPI::Direct3D11)
+						VP = glm::transpose(VP);
+					cascades.push_back(Math::Frustrum(VP));
+				}
+			}
+		});
+
+		// the cascade mask is read by the geometry shader, which skips the cascades outside of it
+		csmStaticCasters.clear();
+		csmDynamicCasters.clear();
+		for (auto& caster : casters)
 		{
-			auto cmdBuf = ctx.allocateCommandBuffer();
-			cmdBuf->begin();
-			cmdBuf->setViewport(0.0f, 0.0f, (float)size, (float)size);
-			cmdBuf->setScissor(0, 0, size, size);
-			cmdBuf->beginRenderPass(omniShadowFBOs[i]);
-			cmdBuf->setCullMode(0);
-			cmdBuf->bindPipeline(shadowOMNIPipeline);
-			cmdBuf->bindDescriptorSets(shadowOMNIPipeline, camDescriptorSet, 0);
-			cmdBuf->bindDescriptorSets(shadowOMNIPipeline, animDescriptorSet, 2);
-			cmdBuf->bindDescriptorSets(shadowOMNIPipeline, morphDescriptorSet, 3);
-			cmdBuf->bindDescriptorSets(shadowOMNIPipeline, descriptorSetOmniViews, 4);
-			cmdBuf->bindDescriptorSets(shadowOMNIPipeline, descriptorSetOmniLight, 5);
-
-			auto opaqueNodes = scene->getOpaqueEntities();
-			for (auto&& [shaderName, renderQueue] : opaqueNodes)
+			int mask = 0;
+			for (int c = 0; c < cascades.size(); c++)
+				if (cascades[c].isInside(caster.bounds))
+					mask |= (1 << c);
+			caster.renderable->setShadowCascades(mask);
+
+			if (mask == 0)
+				continue;
+			if (caster.dynamic)
+				csmDynamicCasters.push_back(caster.renderable);
+			else
+				csmStaticCasters.push_back(caster.renderable);
+		}
+
+		// point lights only draw the casters inside their range and the frustum of each face
+		for (auto& omniLight : omniLights)
+		{
+			for (int f = 0; f < 6; f++)
 			{
-				for (auto e : renderQueue)
+				omniLight.staticCasters[f].clear();
+				omniLight.dynamicCasters[f].clear();
+			}
+
+			float range = omniLight.light->getRange();
+			if (range <= 0.0f)
+				continue;
+
+			glm::vec3 position = omniLight.transform->getPosition();
+			auto VPs = omniLight.light->getViewProjections();
+			if (VPs.size() < 6)
+				continue;
+
+			std::vector<Math::Frustrum> faces;
+			for (int f = 0; f < 6; f++)
+				faces.push_back(Math::Frustrum(VPs[f]));
+
+			for (auto& caster : casters)
+			{
+				if (!intersectsSphere(caster.bounds, position, range))
+					continue;
+				for (int f = 0; f < 6; f++)
 				{
-					if (e->isActive())
-					{
-						auto r = e->getComponent<Renderable>();
-						r->renderDepth(cmdBuf, shadowOMNIPipeline);
-					}
+					if (!faces[f].isInside(caster.bounds))
+						continue;
+					if (caster.dynamic)
+						omniLight.dynamicCasters[f].push_back(caster.renderable);
+					else
+						omniLight.staticCasters[f].push_back(caster.renderable);
 				}
 			}
+		}
+	}
+
+	void Shadows::updateCasters(pr::Scene::Ptr scene)
+	{
+		bool queuesChanged = !castersValid ||
+			casterScene != scene.get() ||
+			casterQueueVersion != scene->getQueueVersion();
 
-			cmdBuf->endRenderPass();
-			cmdBuf->end();
+		if (queuesChanged)
+		{
+			// casters that were moved before stay dynamic, so they don't invalidate the cache again
+			std::set<Renderable*> movedCasters;
+			for (auto& caster : casters)
+				if (caster.dynamic)
+					movedCasters.insert(caster.renderable.get());
+
+			casters.clear();
+			auto& opaqueNodes = scene->getOpaqueEntities();
+			for (auto& batch : opaqueNodes)
+			{
+				for (auto e : batch.entities)
+				{
+					if (!e->isActive())
+						continue;
 
-			omniCmdBufs.push_back(cmdBuf);
+					auto r = e->getComponent<Renderable>();
+					if (!r->isEnabled())
+						continue;
+
+					ShadowCaster caster;
+					caster.renderable = r;
+					caster.bounds = r->getWorldBoundingBox();
+					caster.dynamic = r->isSkinnedMesh() || r->hasMorphtargets() || movedCasters.count(r.get()) > 0;
+					casters.push_back(caster);
+				}
+			}
+
+			casterScene = scene.get();
+			casterQueueVersion = scene->getQueueVersion();
+			castersValid = true;
+			invalidateStaticMaps();
+			return;
+		}
+
+		// a static caster that moved becomes dynamic, the static maps have to be drawn without it
+		bool staticChanged = false;
+		for (auto& caster : casters)
+		{
+			AABB bounds = caster.renderable->getWorldBoundingBox();
+			if (!caster.dynamic && (bounds.getMinPoint() != caster.bounds.getMinPoint() || bounds.getMaxPoint() != caster.bounds.getMaxPoint()))
+			{
+				caster.dynamic = true;
+				staticChanged = true;
+			}
+			caster.bounds = bounds;
+		}
+		if (staticChanged)
+			invalidateStaticMaps();
+	}
+
+	void Shadows::invalidateStaticMaps()
+	{
+		csmCacheValid = false;
+		for (auto& omniLight : omniLights)
+			omniLight.valid = false;
+	}
+
+	void Shadows::buildCmdShadowsCSM(pr::Scene::Ptr scene)
+	{
+		// the command buffers are recorded on update with the casters that survived culling
+		castersValid = false;
+		csmCacheValid = false;
+	}
+
+	void Shadows::buildCmdShadowsOMNI(pr::Scene::Ptr scene)
+	{
+		castersValid = false;
+		for (auto& omniLight : omniLights)
+			omniLight.valid = false;
+	}
+
+	void Shadows::recordCSM(GPU::CommandBuffer::Ptr cmdBuf, const std::vector<Renderable::Ptr>& renderables, bool dynamic)
+	{
+		uint32 size = 4096;
+		cmdBuf->begin();
+		if (dynamic)
+			csmStaticMap->getImage()->copyLayers(cmdBuf, csmShadowMap->getImage(), 0, 4);
+		cmdBuf->setViewport(0.0f, 0.0f, (float)size, (float)size);
+		cmdBuf->setScissor(0, 0, size, size);
+		cmdBuf->beginRenderPass(dynamic ? csmDynamicFBO : csmStaticFBO);
+		cmdBuf->setCullMode(0);
+		cmdBuf->bindPipeline(shadowCSMPipeline);
+		cmdBuf->bindDescriptorSets(shadowCSMPipeline, camDescriptorSet, 0);
+		cmdBuf->bindDescriptorSets(shadowCSMPipeline, animDescriptorSet, 2);
+		cmdBuf->bindDescriptorSets(shadowCSMPipeline, morphDescriptorSet, 3);
+		cmdBuf->bindDescriptorSets(shadowCSMPipeline, descriptorSetShadow, 4);
+
+		for (auto r : renderables)
+			r->renderDepth(cmdBuf, shadowCSMPipeline);
+
+		cmdBuf->endRenderPass();
+		cmdBuf->end();
+	}
+
+	void Shadows::recordOMNI(GPU::CommandBuffer::Ptr cmdBuf, OMNILight& light, bool dynamic)
+	{
+		uint32 size = light.tileSize;
+		std::vector<GPU::ImageRegion> regions;
+		for (int f = 0; f < 6; f++)
+		{
+			auto tile = light.tiles[f];
+			if (dynamic)
+				regions.push_back(GPU::ImageRegion(tile.x, tile.y, tile.x, tile.y, size, size));
+			else
+				regions.push_back(GPU::ImageRegion(0, 0, tile.x, tile.y, size, size));
 		}
+
+		cmdBuf->begin();
+		if (dynamic)
+			omniStaticMap->getImage()->copyRegions(cmdBuf, omniShadowMap->getImage(), regions);
+		else
+			omniClearTile->getImage()->copyRegions(cmdBuf, omniStaticMap->getImage(), regions);
+		cmdBuf->beginRenderPass(dynamic ? omniDynamicFBO : omniStaticFBO);
+		cmdBuf->setCullMode(0);
+		cmdBuf->bindPipeline(shadowOMNIPipeline);
+		cmdBuf->bindDescriptorSets(shadowOMNIPipeline, camDescriptorSet, 0);
+		cmdBuf->bindDescriptorSets(shadowOMNIPipeline, animDescriptorSet, 2);
+		cmdBuf->bindDescriptorSets(shadowOMNIPipeline, morphDescriptorSet, 3);
+		cmdBuf->bindDescriptorSets(shadowOMNIPipeline, descriptorSetOmniLight, 5);
+
+		for (int f = 0; f < 6; f++)
+		{
+			auto tile = light.tiles[f];
+			cmdBuf->setViewport((float)tile.x, (float)tile.y, (float)size, (float)size);
+			cmdBuf->setScissor(tile.x, tile.y, size, size);
+			cmdBuf->bindDescriptorSets(shadowOMNIPipeline, descriptorSetsOmniViews[f], 4);
+
+			auto& renderables = dynamic ? light.dynamicCasters[f] : light.staticCasters[f];
+			for (auto r : renderables)
+				r->renderDepth(cmdBuf, shadowOMNIPipeline);
+		}
+
+		cmdBuf->endRenderPass();
+		cmdBuf->end();
 	}
 }
\ No newline at end of file
@@ -7,9 +7,12 @@
 #include <Core/Entity.h>
 #include <Core/Light.h>
 #include <Core/Scene.h>
+#include <Graphics/ShadowAtlas.h>
 
 namespace pr
 {
+	// point lights with a slot in the tile table of the shadow atlas
+	const uint32 maxShadowLights = 64;
 
 	struct CSMViews
 	{
@@ -22,11 +25,12 @@ namespace pr
 		glm::vec4 cascadePlaneDistance;
 		int cascadeCount;
 		int padding[3];
+		glm::vec4 omniTiles[maxShadowLights * 6]; // atlas offset (xy) and size (z) of each cube face, size 0 if not rendered
 	};
 
 	struct OMNIViews
 	{
-		glm::mat4 VP[6];
+		glm::mat4 VP;
 		int lightIndex;
 		int padding[3];
 	};
@@ -38,6 +42,16 @@ namespace pr
 		int padding[3];
 	};
 
+	// A shadow caster with the world bounds it had when the static shadow maps were rendered.
+	// Skinned, morphed and moved casters are dynamic and are drawn every update on top of a
+	// copy of the static maps, all other casters are only drawn when the static maps change.
+	struct ShadowCaster
+	{
+		Renderable::Ptr renderable;
+		AABB bounds;
+		bool dynamic = false;
+	};
+
 	class Shadows
 	{
 	public:
@@ -50,37 +64,91 @@ namespace pr
 		void updateLights(pr::Scene::Ptr);
 		void addDesc(GPU::DescriptorSet::Ptr lightDescSet);
 		void updateShadowsCSM(uint32 frameIndex, pr::Scene::Ptr scene);
-		void updateShadowsOMNI(pr::Scene::Ptr scene);
+		void updateShadowsOMNI(pr::Scene::Ptr scene, const glm::mat4& V, const glm::mat4& P);
+		void cullCasters(pr::Scene::Ptr scene);
 		void buildCmdShadowsCSM(pr::Scene::Ptr scene);
 		void buildCmdShadowsOMNI(pr::Scene::Ptr scene);
 		pr::Texture2DArray::Ptr getShadowMap()
 		{
 			return csmShadowMap;
 		}
+
+		static const uint32 omniAtlasSize = 4096;
+		static const uint32 omniMaxTileSize = 1024;
+		static const uint32 omniMinTileSize = 64;
+		static const uint32 omniUpdatesPerFrame = 4; // lights whose static tiles are rendered per update
+
 	private:
+		struct OMNILight;
+		void updateCasters(pr::Scene::Ptr scene);
+		void invalidateStaticMaps();
+		bool allocateTiles(OMNILight& light, uint32 tileSize);
+		void releaseTiles(OMNILight& light);
+		bool evictTiles(float importance);
+		void writeTiles(uint32 slot);
+		void recordCSM(GPU::CommandBuffer::Ptr cmdBuf, const std::vector<Renderable::Ptr>& renderables, bool dynamic);
+		void recordOMNI(GPU::CommandBuffer::Ptr cmdBuf, OMNILight& light, bool dynamic);
+
 		GPU::DescriptorSet::Ptr descriptorSetShadow;
-		GPU::DescriptorSet::Ptr descriptorSetOmniViews;
+		GPU::DescriptorSet::Ptr descriptorSetsOmniViews[6];
 		GPU::DescriptorSet::Ptr descriptorSetOmniLight;
 		GPU::DescriptorSet::Ptr camDescriptorSet;
 		GPU::DescriptorSet::Ptr animDescriptorSet;
 		GPU::DescriptorSet::Ptr morphDescriptorSet;
 		GPU::Buffer::Ptr csmViewsUBO;
 		GPU::Buffer::Ptr csmDataUBO;
-		GPU::Buffer::Ptr omniViewsUBO;
+		GPU::Buffer::Ptr omniViewsUBOs[6];
 		GPU::Buffer::Ptr omniDataUBO;
 
 		// Shadows CSM
 		pr::Texture2DArray::Ptr csmShadowMap;
-		GPU::Framebuffer::Ptr csmFBO;
 		GPU::CommandBuffer::Ptr csmCmdBuf;
 		GPU::GraphicsPipeline::Ptr shadowCSMPipeline;
+		pr::Texture2DArray::Ptr csmStaticMap;
+		GPU::Framebuffer::Ptr csmStaticFBO;
+		GPU::Framebuffer::Ptr csmDynamicFBO;
+		GPU::CommandBuffer::Ptr csmStaticCmdBuf;
+		std::vector<Renderable::Ptr> csmStaticCasters;
+		std::vector<Renderable::Ptr> csmDynamicCasters;
+		glm::mat4 csmCachedViews[4];
+		bool csmCacheValid = false;
+		bool csmHadDynamic = false;
 
 		// Shadows OMNI
-		pr::TextureCubeMapArray::Ptr omniShadowMap;
-		std::vector<GPU::Framebuffer::Ptr> omniShadowFBOs;
-		std::vector<GPU::ImageView::Ptr> omniShadowViews;
-		std::vector<GPU::CommandBuffer::Ptr> omniCmdBufs;
+		struct OMNILight
+		{
+			pr::Light::Ptr light;
+			pr::Transform::Ptr transform;
+			glm::vec3 position = glm::vec3(0);
+			float range = 0.0f;
+			float importance = 0.0f;	// fraction of the screen height covered by the range, 0 if not visible
+			uint32 lastUsed = 0;
+			uint32 tileSize = 0;		// 0 if the light has no tiles in the atlas
+			glm::uvec2 tiles[6];
+			bool valid = false;			// the static tiles match the position and range
+			bool hadDynamic = false;
+			std::vector<Renderable::Ptr> staticCasters[6];
+			std::vector<Renderable::Ptr> dynamicCasters[6];
+		};
+		std::vector<OMNILight> omniLights; // indexed by the shadow index of the light
+		ShadowAtlas omniAtlas;
+		pr::Texture2D::Ptr omniShadowMap;
+		pr::Texture2D::Ptr omniStaticMap;
+		pr::Texture2D::Ptr omniClearTile;
+		GPU::Framebuffer::Ptr omniStaticFBO;
+		GPU::Framebuffer::Ptr omniDynamicFBO;
+		GPU::CommandBuffer::Ptr omniCmdBuf;
+		GPU::CommandBuffer::Ptr omniStaticCmdBuf;
 		GPU::GraphicsPipeline::Ptr shadowOMNIPipeline;
+		uint32 frameCount = 0;
+
+		CSMData shadowData;
+
+		// shadow casters of the scene, rebuilt when the render queues change
+		std::vector<ShadowCaster> casters;
+		pr::Scene* casterScene = nullptr;
+		uint32 casterQueueVersion = 0;
+		bool castersValid = false;
 
 		// helper meshes
 		pr::Primitive::Ptr unitQuad;
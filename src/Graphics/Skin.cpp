@@ -1,4 +1,7 @@
 #include "Skin.h"
+#include <Graphics/JointPalette.h>
+
+#include <algorithm>
 
 namespace pr
 {
@@ -7,13 +10,26 @@ namespace pr
 		skeleton(0)
 	{
 		auto& ctx = GraphicsContext::getInstance();
-		animUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, sizeof(AnimData), 0);
+		usePalette = JointPalette::isSupported();
+		uint32 size = usePalette ? sizeof(AnimPaletteData) : sizeof(AnimData);
+		animUBO = ctx.createBuffer(GPU::BufferUsage::TransferDst | GPU::BufferUsage::UniformBuffer, size, 0);
+	}
+
+	Skin::~Skin()
+	{
+		if (hasPaletteRange)
+			JointPalette::getInstance().release(paletteOffset, paletteCount);
 	}
 
 	void Skin::setDescriptor(GPU::DescriptorPool::Ptr descriptorPool)
 	{
 		descriptorSet = descriptorPool->createDescriptorSet("Animation", 1);
 		descriptorSet->addDescriptor(animUBO->getDescriptor());
+		if (usePalette)
+		{
+			allocatePaletteRange();
+			descriptorSet->addDescriptor(JointPalette::getInstance().getBuffer()->getDescriptor());
+		}
 		descriptorSet->update();
 	}
 
@@ -26,48 +42,93 @@ namespace pr
 	{
 		joints.push_back(index);
 		inverseBindMatrices.push_back(ibm);
+		bindPositions.push_back(glm::vec3(glm::inverse(ibm)[3]));
 	}
 
 	// computes the current joint transformations
 	void Skin::computeJoints(std::vector<Entity::Ptr>& nodes)
 	{
-		auto& ctx = GraphicsContext::getInstance();
-
-		jointMatrices.clear();
-		normalMatrices.clear();
-
-		auto parentNode = nodes[skeleton];
+		jointRows.resize(joints.size() * 3);
 
+		glm::mat4 parentWorldToLocal = glm::inverse(nodes[skeleton]->getComponent<Transform>()->getTransform());
 		for (uint32 i = 0; i < joints.size(); i++)
 		{
-			uint32 jointIndex = joints[i];
-			auto node = nodes[jointIndex];
-			glm::mat4 jointIBM = inverseBindMatrices[i];
+			auto node = nodes[joints[i]];
 			glm::mat4 nodeLocalToWorld = node->getComponent<Transform>()->getTransform();
-			glm::mat4 parentWorldToLocal = glm::inverse(parentNode->getComponent<Transform>()->getTransform());
-			glm::mat4 jointMatrix = nodeLocalToWorld * jointIBM;
-			jointMatrix = parentWorldToLocal * jointMatrix;
-			glm::mat3 normalMatrix = glm::inverseTranspose(glm::mat3(jointMatrix));
-
-			if (ctx.getCurrentAPI() == GraphicsAPI::Direct3D11)
-			{
-				jointMatrices.push_back(glm::transpose(jointMatrix));
-				normalMatrices.push_back(glm::transpose(normalMatrix));
-			}
-			else
-			{
-				jointMatrices.push_back(jointMatrix);
-				normalMatrices.push_back(normalMatrix);
-			}
+			glm::mat4 jointMatrix = parentWorldToLocal * nodeLocalToWorld * inverseBindMatrices[i];
+
+			// the last row of the affine matrix is always (0, 0, 0, 1) and not stored
+			glm::mat4 rows = glm::transpose(jointMatrix);
+			jointRows[i * 3] = rows[0];
+			jointRows[i * 3 + 1] = rows[1];
+			jointRows[i * 3 + 2] = rows[2];
 		}
 
-		AnimData animData;
-		for (int i = 0; i < jointMatrices.size(); i++)
+		jointsChanged = true;
+	}
+
+	void Skin::uploadJoints()
+	{
+		if (!jointsChanged)
+			return;
+
+		if (usePalette)
 		{
-			animData.joints[i] = jointMatrices[i];
-			animData.normals[i] = normalMatrices[i];
+			if (allocatePaletteRange())
+				JointPalette::getInstance().write(paletteOffset, jointRows);
 		}
-		animUBO->uploadMapped(&animData);
+		else
+		{
+			AnimData animData;
+			uint32 numRows = std::min(static_cast<uint32>(jointRows.size()), maxSkinJoints * 3);
+			std::copy(jointRows.begin(), jointRows.begin() + numRows, animData.jointRows);
+			animUBO->uploadMapped(&animData);
+		}
+		jointsChanged = false;
+	}
+
+	AABB Skin::getPosedBounds(const AABB& meshBox)
+	{
+		if (jointRows.empty())
+			return meshBox;
+
+		// a vertex is never further away from a joint than in the bind pose, times the scale of the
+		// joint. The blended position lies between the joints it is weighted to, so it is inside the
+		// union of the spheres around all joints.
+		glm::vec3 minPoint = meshBox.getMinPoint();
+		glm::vec3 maxPoint = meshBox.getMaxPoint();
+		AABB box;
+		for (uint32 i = 0; i < joints.size(); i++)
+		{
+			glm::vec4 r0 = jointRows[i * 3];
+			glm::vec4 r1 = jointRows[i * 3 + 1];
+			glm::vec4 r2 = jointRows[i * 3 + 2];
+			glm::vec3 position = glm::vec3(r0.w, r1.w, r2.w);
+			float scale = glm::max(glm::length(glm::vec3(r0.x, r1.x, r2.x)), glm::max(glm::length(glm::vec3(r0.y, r1.y, r2.y)), glm::length(glm::vec3(r0.z, r1.z, r2.z))));
+
+			glm::vec3 farthest = glm::max(glm::abs(minPoint - bindPositions[i]), glm::abs(maxPoint - bindPositions[i]));
+			glm::vec3 extent = glm::vec3(glm::length(farthest) * scale);
+			box.expand(position - extent);
+			box.expand(position + extent);
+		}
+		return box;
+	}
+
+	bool Skin::allocatePaletteRange()
+	{
+		if (hasPaletteRange)
+			return true;
+
+		paletteCount = static_cast<uint32>(joints.size());
+		if (paletteCount == 0 || !JointPalette::getInstance().allocate(paletteCount, paletteOffset))
+			return false;
+
+		// the offset doesn't change for the lifetime of the skin
+		AnimPaletteData data;
+		data.jointOffset = static_cast<int>(paletteOffset);
+		animUBO->uploadMapped(&data);
+		hasPaletteRange = true;
+		return true;
 	}
 
 	void Skin::bind(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline)
@@ -5,37 +5,55 @@
 
 #include <Core/Entity.h>
 #include <Graphics/Texture.h>
+#include <Math/Geometry.h>
 #include <Platform/Types.h>
 #include <glm/gtc/matrix_inverse.hpp>
 
 namespace pr
 {
+	// joint indices are stored with 8 bits in the skin vertex stream
+	const uint32 maxSkinJoints = 256;
+
+	// joint matrices of one skin when there is no joint palette, as the three rows of the affine
+	// matrix per joint, the shaders derive the normal matrices from them
 	struct AnimData
 	{
-		glm::mat4 joints[32];
-		glm::mat4 normals[32];
+		glm::vec4 jointRows[maxSkinJoints * 3];
 
 		AnimData()
 		{
-			for (int i = 0; i < 32; i++)
+			for (uint32 i = 0; i < maxSkinJoints; i++)
 			{
-				joints[i] = glm::mat4(1.0f);
-				normals[i] = glm::mat4(1.0f);
+				jointRows[i * 3] = glm::vec4(1, 0, 0, 0);
+				jointRows[i * 3 + 1] = glm::vec4(0, 1, 0, 0);
+				jointRows[i * 3 + 2] = glm::vec4(0, 0, 1, 0);
 			}
 		}
 	};
 
+	// with a joint palette a skin only passes the offset of its joints in the palette
+	struct AnimPaletteData
+	{
+		int jointOffset = 0;
+		int padding[3] = { 0, 0, 0 };
+	};
+
 	class Skin
 	{
 	public:
 		Skin(const std::string& name);
+		~Skin();
 
 		void setDescriptor(GPU::DescriptorPool::Ptr descriptorPool);
 		void setSkeleton(uint32 index);
 		void addJoint(uint32 index, glm::mat4 ibm);
 
-		// computes the current joint transformations
+		// computes the current joint transformations, doesn't touch the GPU so skins can be computed in parallel
 		void computeJoints(std::vector<Entity::Ptr>& nodes);
+		// uploads the joint transformations of the last computeJoints, has to be called on the render thread
+		void uploadJoints();
+		// conservative bounds of the posed mesh in the space of the skeleton, from the last computeJoints
+		AABB getPosedBounds(const AABB& meshBox);
 		void bind(GPU::CommandBuffer::Ptr cmdBuffer, GPU::GraphicsPipeline::Ptr pipeline);
 
 		typedef std::shared_ptr<Skin> Ptr;
@@ -48,9 +66,16 @@ namespace pr
 		std::string name;
 		std::vector<uint32> joints;
 		std::vector<glm::mat4> inverseBindMatrices;
-		std::vector<glm::mat4> jointMatrices;
-		std::vector<glm::mat3> normalMatrices;
+		std::vector<glm::vec3> bindPositions; // joint positions in the bind pose, in the space of the mesh
+		std::vector<glm::vec4> jointRows; // three rows of the affine matrix per joint
 		uint32 skeleton;
+		bool jointsChanged = false;
+
+		bool usePalette = false;
+		bool hasPaletteRange = false;
+		uint32 paletteOffset = 0;
+		uint32 paletteCount = 0;
+		bool allocatePaletteRange();
 
 		GPU::Buffer::Ptr animUBO;
 		GPU::DescriptorSet::Ptr descriptorSet;
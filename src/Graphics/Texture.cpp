@@ -81,6 +81,12 @@ namespace pr
 		sampler->setFilter(minFilter, magFilter);
 	}
 
+	void Texture2D::setCompareMode()
+	{
+		sampler->setCompareMode(true);
+		sampler->setCompareOp(GPU::CompareOp::LessOrEqual);
+	}
+
 	void Texture2D::generateMipmaps()
 	{
 		//genMipmaps = true;
@@ -43,6 +43,7 @@ namespace pr
 		void setAddressMode(GPU::AddressMode modeU, GPU::AddressMode modeV, GPU::AddressMode modeW);
 		void setAddressMode(GPU::AddressMode mode);
 		void setFilter(GPU::Filter minFilter, GPU::Filter magFilter);
+		void setCompareMode();
 		void generateMipmaps();
 		void setLayout();
 		void setLayoutShader(GPU::CommandBuffer::Ptr cmdBuf);
@@ -0,0 +1,228 @@
+#include "VertexLayout.h"
+#include "Primitive.h"
+#include <glm/gtc/packing.hpp>
+#include <cstring>
+#include <iostream>
+
+namespace pr
+{
+	glm::vec2 encodeOctahedral(glm::vec3 v)
+	{
+		// project onto the octahedron and fold the lower hemisphere over the diagonals
+		float l1 = glm::abs(v.x) + glm::abs(v.y) + glm::abs(v.z);
+		if (l1 == 0.0f)
+			return glm::vec2(1.0f, 0.0f);
+
+		glm::vec2 p = glm::vec2(v.x, v.y) / l1;
+		if (v.z < 0.0f)
+		{
+			glm::vec2 s = glm::vec2(p.x >= 0.0f ? 1.0f : -1.0f, p.y >= 0.0f ? 1.0f : -1.0f);
+			p = (1.0f - glm::abs(glm::vec2(p.y, p.x))) * s;
+		}
+		return p;
+	}
+
+	glm::u8vec4 quantizeWeights(glm::vec4 weights)
+	{
+		// round to 8 bit and put the rounding error on the largest weight, so they still sum up to one
+		glm::ivec4 q = glm::ivec4(glm::round(glm::clamp(weights, 0.0f, 1.0f) * 255.0f));
+		int sum = q.x + q.y + q.z + q.w;
+		if (sum > 0)
+		{
+			int largest = 0;
+			for (int i = 1; i < 4; i++)
+				if (q[i] > q[largest])
+					largest = i;
+			q[largest] = glm::clamp(q[largest] + 255 - sum, 0, 255);
+		}
+		return glm::u8vec4(q);
+	}
+
+	VertexLayout::VertexLayout()
+	{
+
+	}
+
+	VertexLayout::VertexLayout(std::initializer_list<VertexStream> streams)
+	{
+		for (auto stream : streams)
+			addStream(stream);
+	}
+
+	void VertexLayout::addStream(VertexStream stream)
+	{
+		streams |= 1 << static_cast<uint32>(stream);
+	}
+
+	bool VertexLayout::hasStream(VertexStream stream) const
+	{
+		return (streams & (1 << static_cast<uint32>(stream))) != 0;
+	}
+
+	uint32 VertexLayout::getVertexSize() const
+	{
+		uint32 size = 0;
+		for (uint32 i = 0; i < static_cast<uint32>(VertexStream::Count); i++)
+			if (hasStream(VertexStream(i)))
+				size += getStride(VertexStream(i));
+		return size;
+	}
+
+	GPU::VertexDescription VertexLayout::getVertexDescription() const
+	{
+		GPU::VertexDescription vertexInputDescription;
+		auto addAttribute = [&vertexInputDescription](VertexStream stream, uint32 location, GPU::VertexAttribFormat format, uint32 offset, std::string name, uint32 index) {
+			GPU::VertexInputAttribute attribute(location, static_cast<uint32>(stream), format, offset);
+			attribute.name = name;
+			attribute.index = index;
+			vertexInputDescription.inputAttributes.push_back(attribute);
+		};
+
+		for (uint32 i = 0; i < static_cast<uint32>(VertexStream::Count); i++)
+		{
+			VertexStream stream = VertexStream(i);
+			if (!hasStream(stream))
+				continue;
+
+			vertexInputDescription.inputBindings.push_back(GPU::VertexInputBinding(i, getStride(stream)));
+			switch (stream)
+			{
+				case VertexStream::Position: addAttribute(stream, 0, GPU::VertexAttribFormat::Vector3F, 0, "POSITION", 0); break;
+				case VertexStream::Normal: addAttribute(stream, 2, GPU::VertexAttribFormat::Vector4SN16, 0, "NORMAL", 0); break;
+				case VertexStream::Tangent: addAttribute(stream, 5, GPU::VertexAttribFormat::Vector2SN16, 0, "TANGENT", 0); break;
+				case VertexStream::TexCoord0: addAttribute(stream, 3, GPU::VertexAttribFormat::Vector2H, 0, "TEXCOORD", 0); break;
+				case VertexStream::TexCoord1: addAttribute(stream, 4, GPU::VertexAttribFormat::Vector2H, 0, "TEXCOORD", 1); break;
+				case VertexStream::Color: addAttribute(stream, 1, GPU::VertexAttribFormat::Vectur4UC, 0, "COLOR", 0); break;
+				case VertexStream::Skin:
+					addAttribute(stream, 6, GPU::VertexAttribFormat::Vector4UB, 0, "BLENDINDICES", 0);
+					addAttribute(stream, 7, GPU::VertexAttribFormat::Vectur4UC, 4, "BLENDWEIGHT", 0);
+					break;
+			}
+		}
+		return vertexInputDescription;
+	}
+
+	VertexLayout VertexLayout::all()
+	{
+		VertexLayout layout;
+		for (uint32 i = 0; i < static_cast<uint32>(VertexStream::Count); i++)
+			layout.addStream(VertexStream(i));
+		return layout;
+	}
+
+	VertexLayout VertexLayout::fromVertices(const std::vector<Vertex>& vertices)
+	{
+		// attributes that keep their default value on every vertex are left out
+		VertexLayout layout = { VertexStream::Position };
+		for (auto& v : vertices)
+		{
+			if (v.normal != glm::vec3(0))
+				layout.addStream(VertexStream::Normal);
+			if (glm::vec3(v.tangent) != glm::vec3(0))
+				layout.addStream(VertexStream::Tangent);
+			if (v.texCoord0 != glm::vec2(0))
+				layout.addStream(VertexStream::TexCoord0);
+			if (v.texCoord1 != glm::vec2(0))
+				layout.addStream(VertexStream::TexCoord1);
+			if (v.color != glm::vec4(1))
+				layout.addStream(VertexStream::Color);
+			if (v.weights != glm::vec4(0))
+				layout.addStream(VertexStream::Skin);
+		}
+
+		// the handedness of the tangent frame is stored with the normal
+		if (layout.hasStream(VertexStream::Tangent))
+			layout.addStream(VertexStream::Normal);
+		return layout;
+	}
+
+	uint32 VertexLayout::getStride(VertexStream stream)
+	{
+		uint32 stride = 0;
+		switch (stream)
+		{
+			case VertexStream::Position: stride = 12; break;
+			case VertexStream::Normal: stride = 8; break;
+			case VertexStream::Tangent: stride = 4; break;
+			case VertexStream::TexCoord0: stride = 4; break;
+			case VertexStream::TexCoord1: stride = 4; break;
+			case VertexStream::Color: stride = 4; break;
+			case VertexStream::Skin: stride = 8; break;
+		}
+		return stride;
+	}
+
+	void VertexLayout::encode(const std::vector<Vertex>& vertices, VertexStream stream, std::vector<uint8>& data)
+	{
+		uint32 stride = getStride(stream);
+		data.resize(vertices.size() * stride);
+
+		bool jointsClamped = false;
+		for (int i = 0; i < vertices.size(); i++)
+		{
+			const Vertex& v = vertices[i];
+			uint8* dst = data.data() + i * stride;
+			switch (stream)
+			{
+				case VertexStream::Position:
+				{
+					std::memcpy(dst, &v.position, stride);
+					break;
+				}
+				case VertexStream::Normal:
+				{
+					float handedness = v.tangent.w < 0.0f ? -1.0f : 1.0f;
+					glm::uint64 packed = glm::packSnorm4x16(glm::vec4(glm::clamp(v.normal, -1.0f, 1.0f), handedness));
+					std::memcpy(dst, &packed, stride);
+					break;
+				}
+				case VertexStream::Tangent:
+				{
+					uint32 packed = glm::packSnorm2x16(encodeOctahedral(glm::vec3(v.tangent)));
+					std::memcpy(dst, &packed, stride);
+					break;
+				}
+				case VertexStream::TexCoord0:
+				{
+					uint32 packed = glm::packHalf2x16(v.texCoord0);
+					std::memcpy(dst, &packed, stride);
+					break;
+				}
+				case VertexStream::TexCoord1:
+				{
+					uint32 packed = glm::packHalf2x16(v.texCoord1);
+					std::memcpy(dst, &packed, stride);
+					break;
+				}
+				case VertexStream::Color:
+				{
+					uint32 packed = glm::packUnorm4x8(glm::clamp(v.color, 0.0f, 1.0f));
+					std::memcpy(dst, &packed, stride);
+					break;
+				}
+				case VertexStream::Skin:
+				{
+					glm::vec4 joints = glm::clamp(v.joints, 0.0f, 255.0f);
+					if (joints != v.joints)
+						jointsClamped = true;
+					glm::u8vec4 indices = glm::u8vec4(joints);
+					glm::u8vec4 weights = quantizeWeights(v.weights);
+					std::memcpy(dst, &indices, 4);
+					std::memcpy(dst + 4, &weights, 4);
+					break;
+				}
+			}
+		}
+
+		if (jointsClamped)
+			std::cout << "error: joint indices above 255 do not fit into the skin stream" << std::endl;
+	}
+
+	void VertexLayout::encodeDefault(VertexStream stream, std::vector<uint8>& data)
+	{
+		Vertex v;
+		v.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+		v.tangent = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+		encode(std::vector<Vertex>(1, v), stream, data);
+	}
+}
\ No newline at end of file
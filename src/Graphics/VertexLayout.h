@@ -0,0 +1,64 @@
+#ifndef INCLUDED_VERTEXLAYOUT
+#define INCLUDED_VERTEXLAYOUT
+
+#pragma once
+
+#include <GPU/Pipeline.h>
+#include <Platform/Types.h>
+
+#include <initializer_list>
+#include <vector>
+
+struct Vertex;
+
+namespace pr
+{
+	// Each vertex attribute is stored in its own stream, which is bound to the vertex binding
+	// with the same index. The streams use compact encodings, they are decoded by the input
+	// assembler except for the tangent, which is unpacked in the vertex shader.
+	enum class VertexStream
+	{
+		Position,	// float3
+		Normal,		// snorm16x4, normal in xyz and the handedness of the tangent frame in w
+		Tangent,	// snorm16x2, octahedral encoded tangent direction
+		TexCoord0,	// half2
+		TexCoord1,	// half2
+		Color,		// unorm8x4
+		Skin,		// uint8x4 joint indices followed by unorm8x4 weights
+		Count
+	};
+
+	// The set of streams a primitive stores. Pipelines use a layout to describe the streams
+	// their shaders read, streams a primitive does not have are bound to a buffer with a
+	// single default value and a stride of zero.
+	class VertexLayout
+	{
+	public:
+		VertexLayout();
+		VertexLayout(std::initializer_list<VertexStream> streams);
+
+		void addStream(VertexStream stream);
+		bool hasStream(VertexStream stream) const;
+		uint32 getStreams() const
+		{
+			return streams;
+		}
+		uint32 getVertexSize() const;
+		GPU::VertexDescription getVertexDescription() const;
+		bool operator==(const VertexLayout& layout) const
+		{
+			return streams == layout.streams;
+		}
+
+		static VertexLayout all();
+		static VertexLayout fromVertices(const std::vector<Vertex>& vertices);
+		static uint32 getStride(VertexStream stream);
+		static void encode(const std::vector<Vertex>& vertices, VertexStream stream, std::vector<uint8>& data);
+		static void encodeDefault(VertexStream stream, std::vector<uint8>& data);
+
+	private:
+		uint32 streams = 0;
+	};
+}
+
+#endif // INCLUDED_VERTEXLAYOUT
\ No newline at end of file
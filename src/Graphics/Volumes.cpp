@@ -168,6 +168,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -202,6 +203,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -237,6 +239,7 @@ namespace pr
 
 			switch (ctx.getCurrentAPI())
 			{
+				case pr::GraphicsAPI::Null:
 				case pr::GraphicsAPI::OpenGL:
 				{
 					std::string shaderPath = "../../../../src/Shaders/GLSL";
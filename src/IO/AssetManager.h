@@ -42,7 +42,7 @@ namespace IO
 		void renameDirectory(FileNode::Ptr node, std::string newName);
 		void loadAssetsFromDisk();
 		void copyAssetsToGPU();
-		void loadAssetsAsync();
+		void loadAssetsAsync(); // imports on a separate thread, the entities can be used once assetsReady() is true
 		void printTree(FileNode::Ptr node);
 		bool assetsReady() { return assetsLoaded; }
 
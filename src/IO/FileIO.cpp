@@ -5,10 +5,111 @@
 #include <iostream>
 #include <sstream>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
 
 namespace IO
 {
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	bool MappedFile::open(const std::string& fileName)
+	{
+		close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			std::cout << "could not open file " << fileName << std::endl;
+			return false;
+		}
+		fileHandle = file;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			std::cout << "could not map empty file " << fileName << std::endl;
+			close();
+			return false;
+		}
+		size = (size_t)fileSize.QuadPart;
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+		{
+			std::cout << "could not create file mapping for " << fileName << " (error: " << GetLastError() << ")" << std::endl;
+			close();
+			return false;
+		}
+		mappingHandle = mapping;
+
+		data = static_cast<const uint8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		fd = ::open(fileName.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			std::cout << "could not open file " << fileName << std::endl;
+			return false;
+		}
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			std::cout << "could not map empty file " << fileName << std::endl;
+			close();
+			return false;
+		}
+		size = (size_t)fileStat.st_size;
+
+		void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (ptr != MAP_FAILED)
+		{
+			madvise(ptr, size, MADV_SEQUENTIAL);
+			data = static_cast<const uint8*>(ptr);
+		}
+#endif
+		if (data == nullptr)
+		{
+			std::cout << "could not map file " << fileName << std::endl;
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+#ifdef _WIN32
+		if (data)
+			UnmapViewOfFile(data);
+		if (mappingHandle)
+			CloseHandle(mappingHandle);
+		if (fileHandle)
+			CloseHandle(fileHandle);
+		mappingHandle = nullptr;
+		fileHandle = nullptr;
+#else
+		if (data)
+			munmap(const_cast<uint8*>(data), size);
+		if (fd >= 0)
+			::close(fd);
+		fd = -1;
+#endif
+		data = nullptr;
+		size = 0;
+	}
+
 	std::vector<std::string> getAllFileNames(const std::string& path, const std::string& extension)
 	{
 		if (!fs::exists(path))
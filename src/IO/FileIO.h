@@ -3,11 +3,46 @@
 
 #pragma once
 
+#include <Platform/Types.h>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace IO
 {
+	// Read-only view of a whole file mapped into the address space
+	// (file mapping on Win32, mmap on POSIX). Pages are loaded on access.
+	class MappedFile
+	{
+	public:
+		MappedFile() {}
+		~MappedFile();
+		bool open(const std::string& fileName);
+		void close();
+		const uint8* getData() { return data; }
+		size_t getSize() { return size; }
+		bool isOpen() { return data != nullptr; }
+
+		typedef std::shared_ptr<MappedFile> Ptr;
+		static Ptr create()
+		{
+			return std::make_shared<MappedFile>();
+		}
+
+	private:
+		const uint8* data = nullptr;
+		size_t size = 0;
+#ifdef _WIN32
+		void* fileHandle = nullptr;
+		void* mappingHandle = nullptr;
+#else
+		int fd = -1;
+#endif
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+	};
+
 	std::vector<std::string> getAllFileNames(const std::string& path, const std::string& extension);
 	void loadBinary(std::string fileName, std::string& buffer);
 	std::string loadTxtFile(const std::string& fileName);
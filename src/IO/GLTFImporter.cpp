@@ -3,10 +3,13 @@
 #include "ImageLoader.h"
 #include <base64/base64.h>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <thread>
 
 #ifdef LIBS_DRACO
 #include <draco/mesh/mesh.h>
@@ -14,6 +17,8 @@
 #endif
 
 #include "TangentSpace.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
 
 namespace fs = std::filesystem;
 
@@ -119,7 +124,7 @@ namespace IO
 		}
 
 
-		unsigned int getUInt32FromBuffer(unsigned char* buf, int index)
+		unsigned int getUInt32FromBuffer(const unsigned char* buf, size_t index)
 		{
 			unsigned int value = 0;
 			int shiftValue = 0;
@@ -156,6 +161,7 @@ namespace IO
 			supportedExtensions.insert("KHR_texture_basisu");
 #endif
 			supportedExtensions.insert("KHR_texture_transform");
+			supportedExtensions.insert("EXT_mesh_gpu_instancing");
 #ifdef IMAGE_WEBP			
 			supportedExtensions.insert("EXT_texture_webp");
 #endif
@@ -191,48 +197,50 @@ namespace IO
 			return true;
 		}
 
-		std::string Importer::loadGLB(const std::string& filename)
+		bool Importer::loadGLB(const std::string& filename, json::Document& document)
 		{
-			std::ifstream file(filename, std::ios::binary | std::ios::ate);
-			int size = file.tellg();
-			file.seekg(0, std::ios::beg);
-			std::vector<unsigned char> buffer(size);
-			file.read((char*)buffer.data(), buffer.size());
+			auto file = MappedFile::create();
+			if (!file->open(filename))
+				return false;
+
+			const uint8* buffer = file->getData();
+			size_t size = file->getSize();
 
 			// header
-			int baseIndex = 0;
-			std::string magic(5, '\0');
-			for (int i = 0; i < 4; i++)
-				magic[i] = buffer[baseIndex + i];
-			unsigned int version = getUInt32FromBuffer(buffer.data(), baseIndex + 4);
-			unsigned int length = getUInt32FromBuffer(buffer.data(), baseIndex + 8);
+			size_t baseIndex = 0;
+			if (size < 20 || std::memcmp(buffer, "glTF", 4) != 0)
+			{
+				std::cout << "error: " << filename << " is not a valid glb file!" << std::endl;
+				return false;
+			}
+			unsigned int version = getUInt32FromBuffer(buffer, baseIndex + 4);
+			unsigned int length = getUInt32FromBuffer(buffer, baseIndex + 8);
 			baseIndex += 12;
 
-			// chunks
-			unsigned int chunkLen = getUInt32FromBuffer(buffer.data(), baseIndex);
-			baseIndex += 4;
-			std::string type(5, '\0');
-			for (int i = 0; i < 4; i++)
-				type[i] = buffer[baseIndex + i];
-			baseIndex += 4;
-			std::string content(buffer.begin() + baseIndex, buffer.begin() + baseIndex + chunkLen);
+			// json chunk, parsed straight from the mapping
+			unsigned int chunkLen = getUInt32FromBuffer(buffer, baseIndex);
+			baseIndex += 8;
+			if (baseIndex + chunkLen > size)
+			{
+				std::cout << "error: json chunk exceeds file size of " << filename << std::endl;
+				return false;
+			}
+			document.Parse((const char*)buffer + baseIndex, chunkLen);
 			baseIndex += chunkLen;
 
-			// TODO: check first if bin chunk exists...
-			chunkLen = getUInt32FromBuffer(buffer.data(), baseIndex);
-			baseIndex += 4;
-			std::string type2(5, '\0');
-			for (int i = 0; i < 4; i++)
-				type2[i] = buffer[baseIndex + i];
-			baseIndex += 4;
-
-			// TODO: add multiple chunks if present
-			std::vector<uint8> binChunk;
-			binChunk.resize(chunkLen);
-			std::copy(buffer.begin() + baseIndex, buffer.begin() + baseIndex + chunkLen, binChunk.begin());
-			buffers.push_back(binChunk);
+			// binary chunk is optional, accessors point directly into the mapping
+			if (baseIndex + 8 <= size)
+			{
+				chunkLen = getUInt32FromBuffer(buffer, baseIndex);
+				baseIndex += 8;
+				if (baseIndex + chunkLen <= size)
+					buffers.push_back(buffer + baseIndex);
+				else
+					std::cout << "error: binary chunk exceeds file size of " << filename << std::endl;
+			}
 
-			return content;
+			mappedFiles.push_back(file);
+			return true;
 		}
 
 		bool Importer::loadJSON(const std::string& filename)
@@ -261,8 +269,8 @@ namespace IO
 			}
 			else if (extension.compare(".glb") == 0)
 			{
-				std::string content = loadGLB(filename);
-				document.Parse(content.c_str());
+				if (!loadGLB(filename, document))
+					return false;
 			}
 
 			if (!checkExtensions(document)) {
@@ -325,22 +333,6 @@ namespace IO
 			return true;
 		}
 
-		std::vector<unsigned char> readBinaryFile(const std::string& filename, unsigned int byteLength)
-		{
-			std::vector<unsigned char> buffer;
-			std::ifstream file(filename, std::ios::binary);
-			if (file.is_open())
-			{
-				buffer.resize(byteLength);
-				file.read((char*)buffer.data(), byteLength);
-			}
-			else
-			{
-				std::cout << "error opening file " << filename << std::endl;
-			}
-			return buffer;
-		}
-
 		pr::Texture2DArray::Ptr Importer::createMorphTexture(std::vector<MorphTarget> morphTargets)
 		{
 			int numTargets = morphTargets.size();
@@ -588,16 +580,14 @@ namespace IO
 			auto draco = primitive.draco.value();
 			uint32 bufferViewIndex = draco.bufferView;
 
-			std::vector<unsigned char> compressedBuffer;
 			BufferView& bv = gltf.bufferViews[bufferViewIndex]; // TODO: get bufferview from $
 
 			int offset = bv.byteOffset;
-			compressedBuffer.resize(bv.byteLength);
-			memcpy(compressedBuffer.data(), &buffers[bv.buffer][offset], bv.byteLength);
+			const uint8* compressedData = &buffers[bv.buffer][offset];
 
 			draco::DecoderBuffer dracoBuffer;
 			draco::Decoder decoder;
-			dracoBuffer.Init((char*)compressedBuffer.data(), compressedBuffer.size());
+			dracoBuffer.Init((const char*)compressedData, bv.byteLength);
 			auto status = decoder.DecodeMeshFromBuffer(&dracoBuffer);
 			auto dracoMesh = std::move(status).value();
 			int numPoints = dracoMesh->num_points();
@@ -878,14 +868,13 @@ namespace IO
 		}
 #endif
 
-		void Importer::loadMeshes(std::string& path)
+		void Importer::loadBuffers(std::string& path)
 		{
 			for (auto& buf : gltf.buffers)
 			{
 				if (buf.uri.has_value())
 				{
 					std::string uri = buf.uri.value();
-					std::vector<uint8> binaryData;
 					if (uri.find(':') != std::string::npos)
 					{
 						int sepIndex = uri.find_last_of(',');
@@ -894,21 +883,40 @@ namespace IO
 						std::string dataURI = uri.substr(0, sepIndex); // TODO: check if media type is correct etc...
 						std::string dataBase64 = uri.substr(dataStart, dataLen);
 						std::string data = base64_decode(dataBase64);
-						binaryData.insert(binaryData.end(), data.begin(), data.end());
+						decodedBuffers.push_back(std::vector<uint8>(data.begin(), data.end()));
+						buffers.push_back(decodedBuffers.back().data());
 					}
 					else
 					{
-						binaryData = readBinaryFile(path + "/" + uri, buf.byteLength);
+						auto file = MappedFile::create();
+						if (file->open(path + "/" + uri) && file->getSize() >= buf.byteLength)
+						{
+							buffers.push_back(file->getData());
+							mappedFiles.push_back(file);
+						}
+						else
+						{
+							std::cout << "error loading buffer " << uri << std::endl;
+							buffers.push_back(nullptr);
+						}
 					}
-					
-					buffers.push_back(binaryData);
 				}
 				else
 				{
-					// nothing todo here since the binary buffer has been loaded from the glb file
+					// nothing todo here since the binary buffer has been mapped from the glb file
 				}
 			}
+		}
 
+		void Importer::releaseBuffers()
+		{
+			buffers.clear();
+			mappedFiles.clear();
+			decodedBuffers.clear();
+		}
+
+		void Importer::loadMeshes(std::string& path)
+		{
 			for (int meshIdx = 0; meshIdx < gltf.meshes.size(); meshIdx++)
 			{
 				auto& gltfMesh = gltf.meshes[meshIdx];
@@ -968,6 +976,39 @@ namespace IO
 					if (gltfPrimitve.material.has_value())
 						mat = materials[gltfPrimitve.material.value()];
 
+					if (lodLevels > 0 && gltfPrimitve.mode == 4 && !surface.indices.empty())
+					{
+						MeshSimplifier simplifier;
+						simplifier.generateLods(surface, lodLevels);
+					}
+
+					if (optimizeVertexCache && gltfPrimitve.mode == 4 && !surface.indices.empty())
+					{
+						MeshOptimizer optimizer;
+						optimizer.optimizeVertexCache(surface, optimizeOverdraw);
+						auto remap = optimizer.optimizeVertexFetch(surface);
+
+						// morph targets are fetched by vertex index
+						auto remapAttribute = [&remap](std::vector<glm::vec3>& data) {
+							if (data.size() != remap.size())
+								return;
+							std::vector<glm::vec3> remapped(data.size());
+							for (uint32 i = 0; i < data.size(); i++)
+								remapped[remap[i]] = data[i];
+							data.swap(remapped);
+						};
+						for (auto& target : morphTargets)
+						{
+							remapAttribute(target.positions);
+							remapAttribute(target.normals);
+							remapAttribute(target.tangents);
+						}
+					}
+
+					// after the reordering, the meshlets are ranges of the final indices
+					if (generateMeshlets && gltfPrimitve.mode == 4 && !surface.indices.empty())
+						surface.buildMeshlets();
+
 					std::stringstream ss;
 					ss << "Primitive_" << std::setfill('0') << std::setw(3) << primIdx;
 					auto primitive = pr::Primitive::create(ss.str(), surface, GPU::Topology(gltfPrimitve.mode));
@@ -1023,24 +1064,19 @@ namespace IO
 			}
 		}
 
-		void Importer::loadTexture(std::string path, int index, bool useSRGB)
+		ImageData::Ptr Importer::decodeImage(std::string path, uint32 index)
 		{
-			//std::string fn = path + "/" + gltfImage.uri;
-			//std::cout << fn << std::endl;
-			if (textures[index])
-				return;
-
-			auto gltfTexture = gltf.textures[index];
-			auto gltfImage = gltf.images[gltfTexture.source.value()];
+			auto& gltfImage = gltf.images[index];
 
 			ImageData::Ptr img;
 			if (gltfImage.bufferView.has_value()) // binary data
 			{
 				uint32 bufferViewIdx = gltfImage.bufferView.value();
 				BufferView& bv = gltf.bufferViews[bufferViewIdx];
-				Buffer& buffer = gltf.buffers[bv.buffer];
-				uint8* dataPtr = (uint8*)&buffers[bv.buffer][bv.byteOffset];
+				if (buffers[bv.buffer] == nullptr)
+					return nullptr;
 
+				uint8* dataPtr = (uint8*)&buffers[bv.buffer][bv.byteOffset];
 				img = IO::ImageLoader::decodeFromMemory(dataPtr, bv.byteLength, gltfImage.mimeType);
 			}
 			else
@@ -1067,6 +1103,138 @@ namespace IO
 					img = IO::ImageLoader::loadFromFile(fn);
 				}
 			}
+			return img;
+		}
+
+		void Importer::startDecoding(std::string& path)
+		{
+			// only decode images that are actually referenced by a texture, in the order
+			// of the textures as loadMaterials mostly requests them in that order as well
+			decodeOrder.clear();
+			imageUses.clear();
+			imageUses.resize(gltf.images.size(), 0);
+			for (auto& tex : gltf.textures)
+			{
+				if (!tex.source.has_value())
+					continue;
+				uint32 source = tex.source.value();
+				if (imageUses[source] == 0)
+					decodeOrder.push_back(source);
+				imageUses[source]++;
+			}
+
+			images.clear();
+			images.resize(gltf.images.size());
+			decodeStates.clear();
+			decodeStates.resize(gltf.images.size(), DecodeState::Queued);
+			nextDecode = 0;
+			numDecoded = 0;
+			stopDecode = false;
+			if (decodeOrder.empty())
+				return;
+
+			// the loading thread decodes images the workers did not get to yet itself,
+			// so it never waits for a free slot
+			uint32 numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+			numThreads = std::min(numThreads, static_cast<uint32>(decodeOrder.size()));
+			maxDecodedImages = std::max(numThreads * 2, 2u);
+			for (uint32 i = 1; i < numThreads; i++)
+				decodeThreads.push_back(std::thread(&Importer::decodeWorker, this, path));
+		}
+
+		void Importer::stopDecoding()
+		{
+			{
+				std::lock_guard<std::mutex> lock(decodeMutex);
+				stopDecode = true;
+			}
+			decodeSignal.notify_all();
+			for (auto& t : decodeThreads)
+				t.join();
+			decodeThreads.clear();
+			images.clear();
+			decodeStates.clear();
+		}
+
+		void Importer::decodeWorker(std::string path)
+		{
+			std::unique_lock<std::mutex> lock(decodeMutex);
+			while (true)
+			{
+				// at most maxDecodedImages images wait for their upload at the same time
+				decodeSignal.wait(lock, [this]() {
+					return stopDecode || nextDecode >= decodeOrder.size() || numDecoded < maxDecodedImages;
+				});
+
+				// skip the images the loading thread already decoded itself
+				while (nextDecode < decodeOrder.size() && decodeStates[decodeOrder[nextDecode]] != DecodeState::Queued)
+					nextDecode++;
+				if (stopDecode || nextDecode >= decodeOrder.size())
+					return;
+
+				uint32 index = decodeOrder[nextDecode++];
+				decodeStates[index] = DecodeState::Decoding;
+				numDecoded++;
+
+				lock.unlock();
+				auto img = decodeImage(path, index);
+				lock.lock();
+
+				images[index] = img;
+				decodeStates[index] = DecodeState::Decoded;
+				if (img == nullptr)
+					numDecoded--;
+				decodeSignal.notify_all();
+			}
+		}
+
+		ImageData::Ptr Importer::acquireImage(std::string& path, uint32 index)
+		{
+			std::unique_lock<std::mutex> lock(decodeMutex);
+			if (decodeStates[index] == DecodeState::Queued)
+			{
+				decodeStates[index] = DecodeState::Decoding;
+				numDecoded++;
+
+				lock.unlock();
+				auto img = decodeImage(path, index);
+				lock.lock();
+
+				images[index] = img;
+				decodeStates[index] = DecodeState::Decoded;
+				if (img == nullptr)
+					numDecoded--;
+			}
+			decodeSignal.wait(lock, [this, index]() { return decodeStates[index] != DecodeState::Decoding; });
+			return images[index];
+		}
+
+		void Importer::releaseImage(uint32 index)
+		{
+			// free the pixel data once the last texture using the image is uploaded
+			{
+				std::lock_guard<std::mutex> lock(decodeMutex);
+				if (imageUses[index] == 0 || --imageUses[index] > 0 || images[index] == nullptr)
+					return;
+				images[index] = nullptr;
+				numDecoded--;
+			}
+			decodeSignal.notify_all();
+		}
+
+		void Importer::loadTexture(std::string path, int index, bool useSRGB)
+		{
+			if (textures[index])
+				return;
+
+			auto gltfTexture = gltf.textures[index];
+			uint32 source = gltfTexture.source.value();
+			auto img = acquireImage(path, source);
+			if (img == nullptr)
+			{
+				std::cout << "error: could not decode image " << gltfTexture.source.value() << std::endl;
+				return;
+			}
 
 			uint32 width = img->getWidth();
 			uint32 height = img->getHeight();
@@ -1137,6 +1305,8 @@ namespace IO
 				textures[index]->setFilter(GPU::Filter::Linear, GPU::Filter::Linear);
 				textures[index]->setAddressMode(GPU::AddressMode::Repeat);
 			}
+
+			releaseImage(source);
 		}
 
 		glm::mat4 getTransform(TextureTransform texTransform)
@@ -1942,6 +2112,49 @@ namespace IO
 			}
 		}
 
+		void Importer::loadInstances(Node& node, pr::Entity::Ptr entity, pr::Mesh::Ptr mesh)
+		{
+			// every instance becomes a child entity that shares the mesh,
+			// the renderer merges them into instanced draws again
+			std::vector<glm::vec3> translations;
+			std::vector<glm::quat> rotations;
+			std::vector<glm::vec3> scales;
+			uint32 count = 0;
+			for (auto& [attribute, accIndex] : node.instanceAttributes)
+			{
+				Accessor& acc = gltf.accessors[accIndex];
+				if (acc.componentType != GL_FLOAT)
+				{
+					std::cout << "error: instance attribute " << attribute << " is not a float accessor, ignoring it" << std::endl;
+					continue;
+				}
+
+				if (attribute.compare("TRANSLATION") == 0)
+					loadData(accIndex, translations);
+				else if (attribute.compare("ROTATION") == 0)
+					loadData(accIndex, rotations);
+				else if (attribute.compare("SCALE") == 0)
+					loadData(accIndex, scales);
+				else
+					continue;
+				count = std::max(count, acc.count);
+			}
+
+			for (uint32 i = 0; i < count; i++)
+			{
+				auto instance = pr::Entity::create(node.name + "_instance_" + std::to_string(i), entity);
+				auto t = instance->getComponent<pr::Transform>();
+				if (i < translations.size())
+					t->setLocalPosition(translations[i]);
+				if (i < rotations.size())
+					t->setLocalRotation(rotations[i]);
+				if (i < scales.size())
+					t->setLocalScale(scales[i]);
+				instance->addComponent(pr::Renderable::create(mesh));
+				entity->addChild(instance);
+			}
+		}
+
 		pr::Entity::Ptr Importer::traverse(uint32 nodeIndex, pr::Entity::Ptr parent)
 		{
 			auto node = gltf.nodes[nodeIndex];
@@ -1956,15 +2169,26 @@ namespace IO
 			if (node.mesh.has_value())
 			{
 				auto mesh = meshes[node.mesh.value()];
-				entity->addComponent(pr::Renderable::create(mesh));
+				if (node.instanceAttributes.empty())
+					entity->addComponent(pr::Renderable::create(mesh));
+				else
+					loadInstances(node, entity, mesh);
 			}			
 
 			if (node.skin.has_value())
 			{
-				auto r = entity->getComponent<pr::Renderable>(); // accourding to GLTF spec a node with a skin MUST have a mesh
+				// accourding to GLTF spec a node with a skin MUST have a mesh, instanced meshes are on the instance children
 				auto skin = skins[node.skin.value()];
 				skin->setSkeleton(nodeIndex);
-				r->setSkin(skin);
+				auto r = entity->getComponent<pr::Renderable>();
+				if (r)
+					r->setSkin(skin);
+				for (int i = 0; i < entity->numChildren(); i++)
+				{
+					auto instance = entity->getChild(i)->getComponent<pr::Renderable>();
+					if (instance)
+						instance->setSkin(skin);
+				}
 			}
 
 			if (node.camera.has_value())
@@ -2043,7 +2267,10 @@ namespace IO
 			textures.resize(gltf.textures.size());
 			entities.resize(gltf.nodes.size());
 
+			loadBuffers(path);
+			startDecoding(path);
 			loadMaterials(path);
+			stopDecoding();
 			loadMeshes(path);
 			loadSkins();
 
@@ -2076,6 +2303,8 @@ namespace IO
 				root->addComponent<pr::Animator>(animator);
 			}
 
+			releaseBuffers();
+
 			return root;
 		}
 
@@ -2093,7 +2322,10 @@ namespace IO
 			textures.resize(gltf.textures.size());
 			entities.resize(gltf.nodes.size());
 
+			loadBuffers(path);
+			startDecoding(path);
 			loadMaterials(path);
+			stopDecoding();
 			loadMeshes(path);
 			loadSkins();
 
@@ -2133,6 +2365,8 @@ namespace IO
 				}
 			}
 
+			releaseBuffers();
+
 			return gltf.defaultScene;
 		}
 	}
@@ -7,13 +7,16 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <iostream>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
-#include <GPU/GL/GLPlatform.h>
+#include <glad/glad.h>
 #include <rapidjson/document.h>
 #include <Core/Renderable.h>
 #include <Core/Camera.h>
@@ -24,6 +27,8 @@
 #include <Graphics/Texture.h>
 #include <Graphics/Skin.h>
 #include <Platform/Types.h>
+#include <IO/FileIO.h>
+#include <IO/Image.h>
 namespace json = rapidjson;
 namespace IO
 {
@@ -84,6 +89,7 @@ namespace IO
 			glm::vec3 scale = glm::vec3(1.0f);
 			std::vector<float> weights;
 			std::vector<uint32> children;
+			std::map<std::string, uint32> instanceAttributes; // EXT_mesh_gpu_instancing
 
 			void parse(const json::Value& value)
 			{
@@ -123,6 +129,13 @@ namespace IO
 						if (extLight.HasMember("light"))
 							light = extLight["light"].GetUint();
 					}
+					if (extNode.HasMember("EXT_mesh_gpu_instancing"))
+					{
+						auto& extInstancing = extNode["EXT_mesh_gpu_instancing"];
+						if (extInstancing.HasMember("attributes"))
+							for (auto& attributeNode : extInstancing["attributes"].GetObj())
+								instanceAttributes.insert(std::make_pair(attributeNode.name.GetString(), attributeNode.value.GetUint()));
+					}
 				}
 			}
 		};
@@ -1301,7 +1314,7 @@ namespace IO
 			};
 
 			bool loadJSON(const std::string& filename);
-			std::string loadGLB(const std::string& filename);
+			bool loadGLB(const std::string& filename, json::Document& document);
 			pr::Entity::Ptr Importer::importModel(const std::string& filepath, uint32 sceneIndex = 0);
 			int importModel(const std::string& filepath, std::vector<pr::Scene::Ptr>& scenes);
 			bool checkExtensions(const json::Document& doc);
@@ -1462,17 +1475,7 @@ namespace IO
 					interp = pr::Interpolation::CUBIC;
 
 				auto channel = pr::Channel<Type>::create(attribute, interp, targetIndex);
-				int numValues = values.size() / times.size();
-				for (int i = 0; i < times.size(); i++)
-				{
-					std::vector<Type> allValues;
-					for (int j = 0; j < numValues; j++)
-					{
-						int index = i * numValues + j;
-						allValues.push_back(values[index]);
-					}
-					channel->addValue(times[i], allValues);
-				}
+				channel->setValues(times, values);
 				return channel;
 			}
 
@@ -1480,10 +1483,18 @@ namespace IO
 #ifdef LIBS_DRACO
 			void loadCompressedSurface(TriangleSurface& surface, Primitive& primitive);
 #endif
+			void loadBuffers(std::string& path);
+			void releaseBuffers();
 			void loadMeshes(std::string& path);
 			void addTexture(std::string name, std::string path, pr::Material::Ptr material, std::optional<TextureInfo> texInfo, bool useSRGB, bool isMainTex = false);
 			void addTexture(std::string name, std::string path, pr::Material::Ptr material, std::optional<NormalTextureInfo> texInfo);
 			void addTexture(std::string name, std::string path, pr::Material::Ptr material, std::optional<OcclusionTextureInfo> texInfo);
+			ImageData::Ptr decodeImage(std::string path, uint32 index);
+			void startDecoding(std::string& path);
+			void stopDecoding();
+			void decodeWorker(std::string path);
+			ImageData::Ptr acquireImage(std::string& path, uint32 index);
+			void releaseImage(uint32 index);
 			void loadTexture(std::string path, int index, bool useSRGB);
 			void loadMaterials(std::string& path);
 			void loadAnimations();
@@ -1491,11 +1502,28 @@ namespace IO
 			pr::IChannel::Ptr loadTexTransform(Animation::Sampler& sampler, pr::AnimAttribute texAttribute, std::string texTransform, int matIndex);
 			pr::IChannel::Ptr loadPointer(Animation::Sampler& sampler, Animation::Channel& channel);
 			pr::Texture2DArray::Ptr createMorphTexture(std::vector<MorphTarget> morphTargets);
+			void loadInstances(Node& node, pr::Entity::Ptr entity, pr::Mesh::Ptr mesh);
 			pr::Entity::Ptr traverse(uint32 nodeIndex, pr::Entity::Ptr parent);
 			std::vector<pr::Material::Ptr> getMaterials()
 			{
 				return materials;
 			}
+			void setLodLevels(uint32 levels)
+			{
+				lodLevels = levels;
+			}
+			void setOptimizeVertexCache(bool enabled)
+			{
+				optimizeVertexCache = enabled;
+			}
+			void setOptimizeOverdraw(bool enabled)
+			{
+				optimizeOverdraw = enabled;
+			}
+			void setGenerateMeshlets(bool enabled)
+			{
+				generateMeshlets = enabled;
+			}
 		private:
 			Importer(const Importer&) = delete;
 			Importer& operator=(const Importer&) = delete;
@@ -1522,8 +1550,28 @@ namespace IO
 				std::vector<Light> lights;
 			} gltf;
 
-			std::vector<std::vector<unsigned char>> buffers;
+			std::vector<const uint8*> buffers; // points into the mapped files or the decoded data URIs
+			std::vector<MappedFile::Ptr> mappedFiles;
+			std::vector<std::vector<uint8>> decodedBuffers;
+			// referenced images are decoded by worker threads ahead of loadTexture, which
+			// uploads them and frees each image once all textures using it are created
+			enum class DecodeState { Queued, Decoding, Decoded };
+			std::vector<ImageData::Ptr> images;
+			std::vector<DecodeState> decodeStates;
+			std::vector<uint32> decodeOrder;
+			std::vector<uint32> imageUses; // textures that still have to upload the image
+			std::vector<std::thread> decodeThreads;
+			std::mutex decodeMutex;
+			std::condition_variable decodeSignal;
+			uint32 nextDecode = 0;
+			uint32 numDecoded = 0; // images in memory that are not uploaded yet
+			uint32 maxDecodedImages = 2;
+			bool stopDecode = false;
 			std::set<std::string> supportedExtensions;
+			uint32 lodLevels = 4; // simplified versions generated for each indexed triangle primitive, 0 disables them
+			bool optimizeVertexCache = true; // reorder triangles and vertices of indexed triangle primitives
+			bool optimizeOverdraw = false; // also sort the triangle clusters to reduce overdraw
+			bool generateMeshlets = true; // clusters of triangles the renderer culls in large primitives
 
 			// photon renderer data
 			std::vector<pr::Entity::Ptr> entities;
@@ -28,7 +28,7 @@ namespace IO
 	{
 		ImageData::Ptr loadPNGFromFile(const std::string& filename)
 		{
-			stbi_set_flip_vertically_on_load(false);
+			stbi_set_flip_vertically_on_load_thread(false);
 
 			int width = 0;
 			int height = 0;
@@ -47,7 +47,7 @@ namespace IO
 
 		ImageData::Ptr loadJPGFromFile(const std::string& filename)
 		{
-			stbi_set_flip_vertically_on_load(false);
+			stbi_set_flip_vertically_on_load_thread(false);
 
 			int width = 0;
 			int height = 0;
@@ -66,7 +66,7 @@ namespace IO
 
 		ImageData::Ptr loadHDRFromFile(const std::string& filename)
 		{
-			stbi_set_flip_vertically_on_load(false);
+			stbi_set_flip_vertically_on_load_thread(false);
 
 			int width = 0;
 			int height = 0;
@@ -309,7 +309,7 @@ namespace IO
 
 		ImageData::Ptr decodePNGFromMemory(uint8* data, uint32 size)
 		{
-			stbi_set_flip_vertically_on_load(false);
+			stbi_set_flip_vertically_on_load_thread(false);
 
 			int width = 0;
 			int height = 0;
@@ -328,7 +328,7 @@ namespace IO
 
 		ImageData::Ptr decodeJPGFromMemory(uint8* data, uint32 size)
 		{
-			stbi_set_flip_vertically_on_load(false);
+			stbi_set_flip_vertically_on_load_thread(false);
 
 			int width = 0;
 			int height = 0;
@@ -0,0 +1,269 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace IO
+{
+	void MeshOptimizer::optimizeVertexCache(TriangleSurface& surface, bool reduceOverdraw)
+	{
+		if (surface.indices.empty())
+			return;
+
+		uint32 vertexCount = static_cast<uint32>(surface.vertices.size());
+		std::vector<uint32> clusters;
+		surface.indices = tipsify(surface.indices.data(), static_cast<uint32>(surface.indices.size()), vertexCount, clusters);
+		if (reduceOverdraw)
+		{
+			splitClusters(surface.indices, vertexCount, clusters);
+			sortClusters(surface.vertices, surface.indices, clusters);
+		}
+
+		// the LOD levels are drawn from a distance, only their cache order matters
+		for (auto& lod : surface.lods)
+		{
+			uint32* indices = surface.lodIndices.data() + lod.firstIndex;
+			std::vector<uint32> optimized = tipsify(indices, lod.indexCount, vertexCount, clusters);
+			std::copy(optimized.begin(), optimized.end(), indices);
+		}
+	}
+
+	std::vector<uint32> MeshOptimizer::optimizeVertexFetch(TriangleSurface& surface)
+	{
+		// new vertex index for every old one, vertices no triangle uses are moved to the end
+		uint32 vertexCount = static_cast<uint32>(surface.vertices.size());
+		const uint32 unused = 0xFFFFFFFF;
+		std::vector<uint32> remap(vertexCount, unused);
+		uint32 next = 0;
+		for (auto i : surface.indices)
+			if (remap[i] == unused)
+				remap[i] = next++;
+		for (auto i : surface.lodIndices)
+			if (remap[i] == unused)
+				remap[i] = next++;
+		for (auto& r : remap)
+			if (r == unused)
+				r = next++;
+
+		std::vector<Vertex> vertices(vertexCount);
+		for (uint32 i = 0; i < vertexCount; i++)
+			vertices[remap[i]] = surface.vertices[i];
+		surface.vertices.swap(vertices);
+
+		for (auto& i : surface.indices)
+			i = remap[i];
+		for (auto& i : surface.lodIndices)
+			i = remap[i];
+		return remap;
+	}
+
+	std::vector<uint32> MeshOptimizer::tipsify(const uint32* indices, uint32 indexCount, uint32 vertexCount, std::vector<uint32>& clusters)
+	{
+		uint32 numTriangles = indexCount / 3;
+
+		// triangles around each vertex
+		std::vector<uint32> offsets(vertexCount + 1, 0);
+		for (uint32 i = 0; i < indexCount; i++)
+			offsets[indices[i] + 1]++;
+		for (uint32 i = 0; i < vertexCount; i++)
+			offsets[i + 1] += offsets[i];
+		std::vector<uint32> adjacency(indexCount);
+		std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+		for (uint32 i = 0; i < indexCount; i++)
+			adjacency[fill[indices[i]]++] = i / 3;
+
+		std::vector<uint32> liveTriangles(vertexCount);
+		for (uint32 i = 0; i < vertexCount; i++)
+			liveTriangles[i] = offsets[i + 1] - offsets[i];
+
+		// a vertex is in the FIFO cache if less than cacheSize vertices were added since its own timestamp
+		std::vector<uint32> cacheTime(vertexCount, 0);
+		uint32 time = cacheSize + 1;
+		std::vector<bool> emitted(numTriangles, false);
+		std::vector<uint32> deadEnd;
+		std::vector<uint32> candidates;
+		uint32 cursor = 0;
+
+		auto skipDeadEnd = [&]() -> int {
+			// recently used vertices first, then the next one in input order
+			while (!deadEnd.empty())
+			{
+				uint32 v = deadEnd.back();
+				deadEnd.pop_back();
+				if (liveTriangles[v] > 0)
+					return static_cast<int>(v);
+			}
+			for (; cursor < vertexCount; cursor++)
+				if (liveTriangles[cursor] > 0)
+					return static_cast<int>(cursor);
+			return -1;
+		};
+
+		std::vector<uint32> result;
+		result.reserve(indexCount);
+		clusters.clear();
+		int fan = skipDeadEnd();
+		while (fan >= 0)
+		{
+			if (clusters.empty() || candidates.empty())
+				clusters.push_back(static_cast<uint32>(result.size() / 3));
+
+			// emit all remaining triangles around the fanning vertex
+			candidates.clear();
+			for (uint32 i = offsets[fan]; i < offsets[fan + 1]; i++)
+			{
+				uint32 t = adjacency[i];
+				if (emitted[t])
+					continue;
+
+				for (uint32 j = 0; j < 3; j++)
+				{
+					uint32 v = indices[t * 3 + j];
+					result.push_back(v);
+					deadEnd.push_back(v);
+					candidates.push_back(v);
+					liveTriangles[v]--;
+					if (time - cacheTime[v] > cacheSize)
+					{
+						cacheTime[v] = time;
+						time++;
+					}
+				}
+				emitted[t] = true;
+			}
+
+			// next fan around the vertex that will still be in the cache after its fan is emitted,
+			// preferring the one that has been in there the longest
+			int next = -1;
+			int bestPriority = -1;
+			for (auto v : candidates)
+			{
+				if (liveTriangles[v] == 0)
+					continue;
+
+				int priority = 0;
+				if (time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize)
+					priority = static_cast<int>(time - cacheTime[v]);
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					next = static_cast<int>(v);
+				}
+			}
+
+			if (next < 0)
+			{
+				next = skipDeadEnd();
+				candidates.clear(); // hard boundary, the next fan starts a new cluster
+			}
+			fan = next;
+		}
+		return result;
+	}
+
+	void MeshOptimizer::splitClusters(const std::vector<uint32>& indices, uint32 vertexCount, std::vector<uint32>& clusters)
+	{
+		// cache misses per triangle of the whole surface
+		std::vector<uint32> cacheTime(vertexCount, 0);
+		uint32 time = cacheSize + 1;
+		uint32 numTriangles = static_cast<uint32>(indices.size() / 3);
+		for (auto v : indices)
+		{
+			if (time - cacheTime[v] > cacheSize)
+			{
+				cacheTime[v] = time;
+				time++;
+			}
+		}
+		float acmr = static_cast<float>(time - cacheSize - 1) / numTriangles;
+
+		// cut the clusters wherever starting with an empty cache doesn't cost much
+		std::vector<uint32> softClusters;
+		clusters.push_back(numTriangles);
+		for (uint32 c = 0; c + 1 < clusters.size(); c++)
+		{
+			uint32 start = clusters[c];
+			uint32 misses = 0;
+			time += cacheSize + 1; // flush the cache
+			softClusters.push_back(start);
+			for (uint32 t = clusters[c]; t < clusters[c + 1]; t++)
+			{
+				for (uint32 j = 0; j < 3; j++)
+				{
+					uint32 v = indices[t * 3 + j];
+					if (time - cacheTime[v] > cacheSize)
+					{
+						cacheTime[v] = time;
+						time++;
+						misses++;
+					}
+				}
+
+				uint32 count = t + 1 - start;
+				if (t + 1 < clusters[c + 1] && static_cast<float>(misses) / count <= acmr * overdrawThreshold)
+				{
+					start = t + 1;
+					misses = 0;
+					time += cacheSize + 1;
+					softClusters.push_back(start);
+				}
+			}
+		}
+		clusters.swap(softClusters);
+	}
+
+	void MeshOptimizer::sortClusters(const std::vector<Vertex>& vertices, std::vector<uint32>& indices, const std::vector<uint32>& clusters)
+	{
+		uint32 numTriangles = static_cast<uint32>(indices.size() / 3);
+		uint32 numClusters = static_cast<uint32>(clusters.size());
+		std::vector<glm::vec3> centroids(numClusters, glm::vec3(0));
+		std::vector<glm::vec3> normals(numClusters, glm::vec3(0));
+		glm::vec3 meshCentroid = glm::vec3(0);
+		float meshArea = 0.0f;
+		for (uint32 c = 0; c < numClusters; c++)
+		{
+			uint32 end = c + 1 < numClusters ? clusters[c + 1] : numTriangles;
+			float clusterArea = 0.0f;
+			for (uint32 t = clusters[c]; t < end; t++)
+			{
+				glm::vec3 p0 = vertices[indices[t * 3]].position;
+				glm::vec3 p1 = vertices[indices[t * 3 + 1]].position;
+				glm::vec3 p2 = vertices[indices[t * 3 + 2]].position;
+				glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+				float area = glm::length(n);
+				centroids[c] += (p0 + p1 + p2) / 3.0f * area;
+				normals[c] += n;
+				clusterArea += area;
+			}
+
+			meshCentroid += centroids[c];
+			meshArea += clusterArea;
+			if (clusterArea > 0.0f)
+				centroids[c] /= clusterArea;
+			float len = glm::length(normals[c]);
+			if (len > 0.0f)
+				normals[c] /= len;
+		}
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
+
+		// clusters facing away from the center are likely to occlude the others, draw them first
+		std::vector<float> sortKeys(numClusters);
+		for (uint32 c = 0; c < numClusters; c++)
+			sortKeys[c] = glm::dot(centroids[c] - meshCentroid, normals[c]);
+		std::vector<uint32> order(numClusters);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32 a, uint32 b) {
+			return sortKeys[a] > sortKeys[b];
+		});
+
+		std::vector<uint32> sorted;
+		sorted.reserve(indices.size());
+		for (auto c : order)
+		{
+			uint32 end = c + 1 < numClusters ? clusters[c + 1] : numTriangles;
+			sorted.insert(sorted.end(), indices.begin() + clusters[c] * 3, indices.begin() + end * 3);
+		}
+		indices.swap(sorted);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef INCLUDED_MESHOPTIMIZER
+#define INCLUDED_MESHOPTIMIZER
+
+#pragma once
+
+#include <Graphics/Primitive.h>
+namespace IO
+{
+	// Import time reordering of triangle surfaces for the post-transform vertex cache (Tipsify,
+	// Sander et al. 2007), overdraw (clusters sorted to draw outward facing parts first) and
+	// vertex fetch (vertices stored in the order they are first used by the indices).
+	class MeshOptimizer
+	{
+	public:
+		void optimizeVertexCache(TriangleSurface& surface, bool reduceOverdraw);
+		std::vector<uint32> optimizeVertexFetch(TriangleSurface& surface);
+
+	private:
+		std::vector<uint32> tipsify(const uint32* indices, uint32 indexCount, uint32 vertexCount, std::vector<uint32>& clusters);
+		void splitClusters(const std::vector<uint32>& indices, uint32 vertexCount, std::vector<uint32>& clusters);
+		void sortClusters(const std::vector<Vertex>& vertices, std::vector<uint32>& indices, const std::vector<uint32>& clusters);
+
+		static const uint32 cacheSize = 16;
+		const float overdrawThreshold = 1.05f; // clusters may have this much worse cache efficiency than the whole surface
+	};
+}
+
+#endif // INCLUDED_MESHOPTIMIZER
\ No newline at end of file
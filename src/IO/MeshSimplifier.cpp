@@ -0,0 +1,299 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace IO
+{
+	void MeshSimplifier::Quadric::addPlane(const glm::vec3& n, float d)
+	{
+		a2 += n.x * n.x; ab += n.x * n.y; ac += n.x * n.z; ad += n.x * d;
+		b2 += n.y * n.y; bc += n.y * n.z; bd += n.y * d;
+		c2 += n.z * n.z; cd += n.z * d;
+		d2 += d * d;
+	}
+
+	void MeshSimplifier::Quadric::add(const Quadric& q)
+	{
+		a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+		b2 += q.b2; bc += q.bc; bd += q.bd;
+		c2 += q.c2; cd += q.cd;
+		d2 += q.d2;
+	}
+
+	float MeshSimplifier::Quadric::evaluate(const glm::vec3& p) const
+	{
+		// sum of the squared distances of p to all planes of the quadric
+		double x = p.x, y = p.y, z = p.z;
+		double e =
+			a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+			b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+			c2 * z * z + 2.0 * cd * z +
+			d2;
+		return static_cast<float>(std::max(e, 0.0));
+	}
+
+	void MeshSimplifier::generateLods(TriangleSurface& surface, uint32 maxLevels)
+	{
+		surface.lods.clear();
+		surface.lodIndices.clear();
+		if (surface.indices.size() < minTriangles * 6)
+			return;
+
+		init(surface);
+
+		// every level halves the triangles of the previous one and starts where it stopped,
+		// so the error of the levels grows with the chain and is measured against the full detail
+		uint32 prevCount = static_cast<uint32>(indices.size());
+		for (uint32 level = 0; level < maxLevels; level++)
+		{
+			uint32 targetCount = prevCount / 6 * 3;
+			if (targetCount < minTriangles * 3)
+				break;
+
+			bool done = collapse(targetCount);
+			uint32 count = static_cast<uint32>(indices.size());
+			if (count > prevCount / 4 * 3) // mostly locked vertices left, not worth another level
+				break;
+
+			LodLevel lod;
+			lod.firstIndex = static_cast<uint32>(surface.lodIndices.size());
+			lod.indexCount = count;
+			lod.error = glm::sqrt(maxError);
+			surface.lods.push_back(lod);
+			surface.lodIndices.insert(surface.lodIndices.end(), indices.begin(), indices.end());
+			prevCount = count;
+
+			if (!done)
+				break;
+		}
+	}
+
+	void MeshSimplifier::init(const TriangleSurface& surface)
+	{
+		uint32 numVertices = static_cast<uint32>(surface.vertices.size());
+		positions.resize(numVertices);
+		for (uint32 i = 0; i < numVertices; i++)
+			positions[i] = surface.vertices[i].position;
+
+		remap.resize(numVertices);
+		std::iota(remap.begin(), remap.end(), 0);
+		indices = surface.indices;
+		maxError = 0.0f;
+
+		// vertices that only differ in their attributes get the same position id
+		std::vector<uint32> order(numVertices);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [this](uint32 a, uint32 b) {
+			const glm::vec3& p = positions[a];
+			const glm::vec3& q = positions[b];
+			if (p.x != q.x) return p.x < q.x;
+			if (p.y != q.y) return p.y < q.y;
+			return p.z < q.z;
+		});
+
+		uint32 numPositions = 0;
+		std::vector<uint32> numWedges;
+		positionIDs.resize(numVertices);
+		for (uint32 i = 0; i < numVertices; i++)
+		{
+			if (i == 0 || positions[order[i]] != positions[order[i - 1]])
+			{
+				numWedges.push_back(0);
+				numPositions++;
+			}
+			positionIDs[order[i]] = numPositions - 1;
+			numWedges[numPositions - 1]++;
+		}
+
+		// edges that don't have exactly two triangles are on a border or non manifold
+		std::unordered_map<glm::uint64, uint32> edges;
+		for (uint32 i = 0; i < indices.size(); i += 3)
+		{
+			for (uint32 e = 0; e < 3; e++)
+			{
+				uint32 a = positionIDs[indices[i + e]];
+				uint32 b = positionIDs[indices[i + (e + 1) % 3]];
+				glm::uint64 key = (static_cast<glm::uint64>(std::min(a, b)) << 32) | std::max(a, b);
+				edges[key]++;
+			}
+		}
+
+		std::vector<bool> lockedPositions(numPositions, false);
+		for (auto& [key, count] : edges)
+		{
+			if (count != 2)
+			{
+				lockedPositions[static_cast<uint32>(key >> 32)] = true;
+				lockedPositions[static_cast<uint32>(key & 0xFFFFFFFF)] = true;
+			}
+		}
+
+		locked.resize(numVertices);
+		for (uint32 i = 0; i < numVertices; i++)
+		{
+			uint32 id = positionIDs[i];
+			locked[i] = lockedPositions[id] || numWedges[id] > 1;
+		}
+
+		quadrics.assign(numVertices, Quadric());
+		for (uint32 i = 0; i < indices.size(); i += 3)
+		{
+			glm::vec3 p0 = positions[indices[i]];
+			glm::vec3 p1 = positions[indices[i + 1]];
+			glm::vec3 p2 = positions[indices[i + 2]];
+			glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+			float len = glm::length(n);
+			if (len == 0.0f)
+				continue;
+
+			n /= len;
+			float d = -glm::dot(n, p0);
+			for (uint32 j = 0; j < 3; j++)
+				quadrics[indices[i + j]].addPlane(n, d);
+		}
+	}
+
+	uint32 MeshSimplifier::findVertex(uint32 v)
+	{
+		uint32 root = v;
+		while (remap[root] != root)
+			root = remap[root];
+
+		while (remap[v] != root)
+		{
+			uint32 next = remap[v];
+			remap[v] = root;
+			v = next;
+		}
+		return root;
+	}
+
+	bool MeshSimplifier::flipsTriangle(uint32 from, uint32 to, const uint32* triangles, uint32 count)
+	{
+		glm::vec3 target = positions[to];
+		for (uint32 i = 0; i < count; i++)
+		{
+			const uint32* tri = &indices[triangles[i] * 3];
+			glm::vec3 p[3];
+			bool collapsed = false;
+			for (uint32 j = 0; j < 3; j++)
+			{
+				p[j] = positions[tri[j]];
+				if (positionIDs[tri[j]] == positionIDs[to])
+					collapsed = true;
+			}
+			if (collapsed) // the triangle on the collapsed edge is removed
+				continue;
+
+			glm::vec3 n0 = glm::cross(p[1] - p[0], p[2] - p[0]);
+			for (uint32 j = 0; j < 3; j++)
+				if (tri[j] == from)
+					p[j] = target;
+			glm::vec3 n1 = glm::cross(p[1] - p[0], p[2] - p[0]);
+			if (glm::dot(n0, n1) <= 0.0f)
+				return true;
+		}
+		return false;
+	}
+
+	bool MeshSimplifier::collapse(uint32 targetIndexCount)
+	{
+		uint32 numVertices = static_cast<uint32>(positions.size());
+		while (indices.size() > targetIndexCount)
+		{
+			uint32 numTriangles = static_cast<uint32>(indices.size() / 3);
+
+			// triangles around each vertex
+			std::vector<uint32> offsets(numVertices + 1, 0);
+			for (auto i : indices)
+				offsets[i + 1]++;
+			for (uint32 i = 0; i < numVertices; i++)
+				offsets[i + 1] += offsets[i];
+			std::vector<uint32> adjacency(indices.size());
+			std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+			for (uint32 i = 0; i < indices.size(); i++)
+				adjacency[fill[indices[i]]++] = i / 3;
+
+			std::vector<Collapse> collapses;
+			collapses.reserve(indices.size() * 2);
+			for (uint32 i = 0; i < indices.size(); i += 3)
+			{
+				for (uint32 e = 0; e < 3; e++)
+				{
+					uint32 a = indices[i + e];
+					uint32 b = indices[i + (e + 1) % 3];
+					if (!locked[a])
+						collapses.push_back({ a, b, quadrics[a].evaluate(positions[b]) });
+					if (!locked[b])
+						collapses.push_back({ b, a, quadrics[b].evaluate(positions[a]) });
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& c0, const Collapse& c1) {
+				return c0.cost < c1.cost;
+			});
+
+			// cheapest collapses first, the neighbourhood of a collapsed vertex is not touched
+			// again in the same pass so the flip test always sees the current triangles
+			uint32 trianglesToRemove = numTriangles - targetIndexCount / 3;
+			uint32 removed = 0;
+			uint32 numCollapses = 0;
+			std::vector<bool> touched(numVertices, false);
+			for (auto& c : collapses)
+			{
+				if (removed >= trianglesToRemove)
+					break;
+				if (touched[c.from] || touched[c.to])
+					continue;
+
+				const uint32* triangles = &adjacency[offsets[c.from]];
+				uint32 count = offsets[c.from + 1] - offsets[c.from];
+				if (flipsTriangle(c.from, c.to, triangles, count))
+					continue;
+
+				for (uint32 i = 0; i < count; i++)
+				{
+					bool collapsed = false;
+					for (uint32 j = 0; j < 3; j++)
+					{
+						uint32 v = indices[triangles[i] * 3 + j];
+						touched[v] = true;
+						if (positionIDs[v] == positionIDs[c.to])
+							collapsed = true;
+					}
+					if (collapsed)
+						removed++;
+				}
+
+				remap[c.from] = c.to;
+				quadrics[c.to].add(quadrics[c.from]);
+				maxError = std::max(maxError, c.cost);
+				numCollapses++;
+			}
+
+			if (numCollapses == 0)
+				return false;
+
+			std::vector<uint32> newIndices;
+			newIndices.reserve(indices.size());
+			for (uint32 i = 0; i < indices.size(); i += 3)
+			{
+				uint32 a = findVertex(indices[i]);
+				uint32 b = findVertex(indices[i + 1]);
+				uint32 c = findVertex(indices[i + 2]);
+				uint32 pa = positionIDs[a];
+				uint32 pb = positionIDs[b];
+				uint32 pc = positionIDs[c];
+				if (pa == pb || pb == pc || pa == pc)
+					continue;
+
+				newIndices.push_back(a);
+				newIndices.push_back(b);
+				newIndices.push_back(c);
+			}
+			indices.swap(newIndices);
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef INCLUDED_MESHSIMPLIFIER
+#define INCLUDED_MESHSIMPLIFIER
+
+#pragma once
+
+#include <Graphics/Primitive.h>
+namespace IO
+{
+	// Quadric error metric simplification (Garland & Heckbert). Vertices are only collapsed onto
+	// one of their neighbours, so every level is a new index list for the vertices of the surface.
+	// Vertices on borders and attribute seams (several vertices at the same position) are locked.
+	class MeshSimplifier
+	{
+	public:
+		MeshSimplifier() {}
+		void generateLods(TriangleSurface& surface, uint32 maxLevels);
+
+	private:
+		struct Quadric
+		{
+			double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+			double b2 = 0.0, bc = 0.0, bd = 0.0;
+			double c2 = 0.0, cd = 0.0;
+			double d2 = 0.0;
+
+			void addPlane(const glm::vec3& n, float d);
+			void add(const Quadric& q);
+			float evaluate(const glm::vec3& p) const;
+		};
+
+		struct Collapse
+		{
+			uint32 from;
+			uint32 to;
+			float cost;
+		};
+
+		void init(const TriangleSurface& surface);
+		uint32 findVertex(uint32 v);
+		bool flipsTriangle(uint32 from, uint32 to, const uint32* triangles, uint32 count);
+		bool collapse(uint32 targetIndexCount);
+
+		std::vector<glm::vec3> positions;
+		std::vector<uint32> positionIDs; // vertices at the same position share the id
+		std::vector<uint32> remap; // vertex a collapsed vertex was moved to
+		std::vector<Quadric> quadrics;
+		std::vector<bool> locked;
+		std::vector<uint32> indices; // current level
+		float maxError = 0.0f;
+
+		static const uint32 minTriangles = 64;
+
+		MeshSimplifier(const MeshSimplifier&) = delete;
+		MeshSimplifier& operator=(const MeshSimplifier&) = delete;
+	};
+}
+
+#endif // INCLUDED_MESHSIMPLIFIER
\ No newline at end of file
@@ -1,251 +1,302 @@
 #include "AABBTree.h"
 
 #include <algorithm>
+#include <limits>
 
-AABBNode::AABBNode(AABBNode* parent) :
-	parent(parent)
+AABBTree::AABBTree()
 {
-	leftChild = nullptr;
-	rightChild = nullptr;
-	tri = nullptr;
-}
 
-AABBNode::~AABBNode()
-{
-	delete leftChild;
-	delete rightChild;
-	delete tri;
 }
 
-bool AABBNode::compareX(Triangle a, Triangle b)
+AABBTree::~AABBTree()
 {
-	return a.plane.x < b.plane.x;
-}
 
-bool AABBNode::compareY(Triangle a, Triangle b)
-{
-	return a.plane.y < b.plane.y;
 }
 
-bool AABBNode::compareZ(Triangle a, Triangle b)
+void AABBTree::build(const TriList& triangles)
 {
-	return a.plane.z < b.plane.z;
-}
+	nodes.clear();
+	triIndices.clear();
+	vertices.clear();
+	triIDs.clear();
 
-void AABBNode::addTriangles(TriList& triangles)
-{
 	if (triangles.empty())
 		return;
 
-	if (triangles.size() == 1)
+	unsigned int numTris = (unsigned int)triangles.size();
+	vertices.reserve(numTris * 3);
+	centroids.reserve(numTris);
+	triIDs.reserve(numTris);
+	triIndices.resize(numTris);
+	for (unsigned int i = 0; i < numTris; i++)
 	{
-		boundingBox.expand(triangles[0].v0);
-		boundingBox.expand(triangles[0].v1);
-		boundingBox.expand(triangles[0].v2);
-		tri = new Triangle(triangles[0]);
-
-		return;
+		const Triangle& tri = triangles[i];
+		vertices.push_back(tri.v0);
+		vertices.push_back(tri.v1);
+		vertices.push_back(tri.v2);
+		centroids.push_back((tri.v0 + tri.v1 + tri.v2) / 3.0f);
+		triIDs.push_back(tri.triID);
+		triIndices[i] = i;
 	}
 
-	std::vector<Triangle> splits[6];
-
-	float boundX = splitEntries(compareX, triangles, splits[0], splits[1]);
-	float boundY = splitEntries(compareY, triangles, splits[2], splits[3]);
-	float boundZ = splitEntries(compareZ, triangles, splits[4], splits[5]);
-
-	leftChild = new AABBNode(this);
-	rightChild = new AABBNode(this);
-
-	if (boundX <= boundY && boundX <= boundZ)
+	nodes.reserve(2 * numTris - 1);
+	BVHNode root;
+	root.leftFirst = 0;
+	root.count = numTris;
+	nodes.push_back(root);
+	updateNodeBounds(0);
+
+	// subdivide iteratively, the depth limit keeps the traversal stack in raycast bounded
+	std::vector<std::pair<unsigned int, unsigned int>> stack;
+	stack.push_back(std::make_pair(0, 0));
+	while (!stack.empty())
 	{
-		leftChild->addTriangles(splits[0]);
-		rightChild->addTriangles(splits[1]);
+		auto [nodeIndex, depth] = stack.back();
+		stack.pop_back();
+		if (depth >= maxDepth)
+			continue;
+
+		int axis = -1;
+		float splitPos = 0.0f;
+		float splitCost = findBestSplit(nodes[nodeIndex], axis, splitPos);
+		if (axis < 0)
+			continue; // all centroids in the same spot, nothing to split
+		if (splitCost >= nodeCost(nodes[nodeIndex]) && nodes[nodeIndex].count <= maxLeafSize)
+			continue;
+
+		BVHNode& node = nodes[nodeIndex];
+		auto first = triIndices.begin() + node.leftFirst;
+		auto last = first + node.count;
+		auto middle = std::partition(first, last, [&](unsigned int t) { return centroids[t][axis] < splitPos; });
+		unsigned int leftCount = (unsigned int)(middle - first);
+		if (leftCount == 0 || leftCount == node.count)
+			continue;
+
+		BVHNode left;
+		left.leftFirst = node.leftFirst;
+		left.count = leftCount;
+		BVHNode right;
+		right.leftFirst = node.leftFirst + leftCount;
+		right.count = node.count - leftCount;
+
+		unsigned int leftIndex = (unsigned int)nodes.size();
+		node.leftFirst = leftIndex;
+		node.count = 0;
+		nodes.push_back(left); // no reallocation, capacity is 2n-1
+		nodes.push_back(right);
+		updateNodeBounds(leftIndex);
+		updateNodeBounds(leftIndex + 1);
+
+		stack.push_back(std::make_pair(leftIndex, depth + 1));
+		stack.push_back(std::make_pair(leftIndex + 1, depth + 1));
 	}
-	else if (boundY <= boundX && boundY <= boundZ)
-	{
-		leftChild->addTriangles(splits[2]);
-		rightChild->addTriangles(splits[3]);
-	}
-	else //(if (boundZ <= boundX && boundZ <= boundY)
+
+	centroids.clear();
+	centroids.shrink_to_fit();
+}
+
+void AABBTree::updateNodeBounds(unsigned int nodeIndex)
+{
+	BVHNode& node = nodes[nodeIndex];
+	AABB bounds;
+	for (unsigned int i = 0; i < node.count; i++)
 	{
-		assert(boundZ <= boundX && boundZ <= boundY);
-		leftChild->addTriangles(splits[4]);
-		rightChild->addTriangles(splits[5]);
+		unsigned int t = triIndices[node.leftFirst + i];
+		bounds.expand(vertices[t * 3 + 0]);
+		bounds.expand(vertices[t * 3 + 1]);
+		bounds.expand(vertices[t * 3 + 2]);
 	}
+	node.minPoint = bounds.getMinPoint();
+	node.maxPoint = bounds.getMaxPoint();
+}
 
-	boundingBox.expand(leftChild->getBoundingBox());
-	boundingBox.expand(rightChild->getBoundingBox());
+static float surfaceArea(const AABB& box)
+{
+	glm::vec3 e = box.getMaxPoint() - box.getMinPoint();
+	return e.x * e.y + e.y * e.z + e.z * e.x;
 }
 
-float AABBNode::splitEntries(bool(*compare)(Triangle, Triangle), TriList& entries, TriList& splitA, TriList& splitB)
+float AABBTree::nodeCost(const BVHNode& node)
 {
-	size_t numEntries = entries.size();
-	splitA.reserve(numEntries / 2);
-	splitB.reserve(numEntries / 2);
+	glm::vec3 e = node.maxPoint - node.minPoint;
+	return (e.x * e.y + e.y * e.z + e.z * e.x) * node.count;
+}
 
-	std::sort(entries.begin(), entries.end(), compare);
+float AABBTree::findBestSplit(BVHNode& node, int& axis, float& splitPos)
+{
+	AABB centroidBounds;
+	for (unsigned int i = 0; i < node.count; i++)
+		centroidBounds.expand(centroids[triIndices[node.leftFirst + i]]);
 
-	AABB boundA;
-	AABB boundB;
+	glm::vec3 cMin = centroidBounds.getMinPoint();
+	glm::vec3 cMax = centroidBounds.getMaxPoint();
 
-	for (size_t i = 0; i < numEntries / 2; i++)
+	float bestCost = std::numeric_limits<float>::max();
+	for (int a = 0; a < 3; a++)
 	{
-		Triangle& tri = entries[i];
-		boundA.expand(tri.v0);
-		boundA.expand(tri.v1);
-		boundA.expand(tri.v2);
-		splitA.push_back(tri);
-	}
+		float extent = cMax[a] - cMin[a];
+		if (extent <= 0.0f)
+			continue;
 
-	for (size_t i = numEntries / 2; i < numEntries; i++)
-	{
-		Triangle& tri = entries[i];
-		boundB.expand(tri.v0);
-		boundB.expand(tri.v1);
-		boundB.expand(tri.v2);
-		splitB.push_back(tri);
+		Bin bins[numBins];
+		float scale = numBins / extent;
+		for (unsigned int i = 0; i < node.count; i++)
+		{
+			unsigned int t = triIndices[node.leftFirst + i];
+			int binIndex = std::min(numBins - 1, (int)((centroids[t][a] - cMin[a]) * scale));
+			bins[binIndex].count++;
+			bins[binIndex].bounds.expand(vertices[t * 3 + 0]);
+			bins[binIndex].bounds.expand(vertices[t * 3 + 1]);
+			bins[binIndex].bounds.expand(vertices[t * 3 + 2]);
+		}
+
+		// sweep from both sides to get area and count for every split plane
+		float leftArea[numBins - 1], rightArea[numBins - 1];
+		unsigned int leftCount[numBins - 1], rightCount[numBins - 1];
+		AABB leftBox, rightBox;
+		unsigned int leftSum = 0, rightSum = 0;
+		for (int i = 0; i < numBins - 1; i++)
+		{
+			leftSum += bins[i].count;
+			leftCount[i] = leftSum;
+			if (bins[i].count > 0)
+				leftBox.expand(bins[i].bounds);
+			leftArea[i] = leftSum > 0 ? surfaceArea(leftBox) : 0.0f;
+
+			rightSum += bins[numBins - 1 - i].count;
+			rightCount[numBins - 2 - i] = rightSum;
+			if (bins[numBins - 1 - i].count > 0)
+				rightBox.expand(bins[numBins - 1 - i].bounds);
+			rightArea[numBins - 2 - i] = rightSum > 0 ? surfaceArea(rightBox) : 0.0f;
+		}
+
+		float binWidth = extent / numBins;
+		for (int i = 0; i < numBins - 1; i++)
+		{
+			float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				axis = a;
+				splitPos = cMin[a] + binWidth * (i + 1);
+			}
+		}
 	}
 
-	return boundA.radius() + boundB.radius();
+	return bestCost;
 }
 
-glm::vec3 getInterpNormal(Triangle* tri, glm::vec2& uv)
+static bool intersectBox(const BVHNode& node, const glm::vec3& origin, const glm::vec3& invDir, float tMax, float& tNear)
 {
-	glm::vec3& n0 = tri->n0;
-	glm::vec3& n1 = tri->n1;
-	glm::vec3& n2 = tri->n2;
-	return n0 + (n1 - n0) * uv.x + (n2 - n0) * uv.y;
+	glm::vec3 t0 = (node.minPoint - origin) * invDir;
+	glm::vec3 t1 = (node.maxPoint - origin) * invDir;
+	glm::vec3 tSmall = glm::min(t0, t1);
+	glm::vec3 tBig = glm::max(t0, t1);
+	float tmin = glm::max(glm::max(tSmall.x, tSmall.y), tSmall.z);
+	float tmax = glm::min(glm::min(tBig.x, tBig.y), tBig.z);
+	tNear = tmin;
+	return tmax >= glm::max(tmin, 0.0f) && tmin < tMax;
 }
 
-bool AABBNode::raycast(Ray& ray, glm::vec3& hitPoint, glm::vec2& uv, unsigned int& triID)
+static bool intersectTri(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& t, glm::vec2& uv)
 {
-	if (tri)
-	{
-		if (Intersections::rayTriIntersection(ray, *tri, hitPoint, uv))
-		{
-			triID = tri->triID;
-			return true;
-		}
+	// same test as Intersections::rayTriIntersection but returns the ray parameter
+	glm::vec3 e1 = v1 - v0;
+	glm::vec3 e2 = v2 - v0;
+	glm::vec3 p = glm::cross(ray.direction, e2);
+	float eps = 0.0000001f;
+	float det = glm::dot(e1, p);
+	if (det > -eps && det < eps)
 		return false;
-	}
 
-	if (!leftChild || !rightChild)
+	float detInv = 1.0f / det;
+	glm::vec3 diff = ray.origin - v0;
+	float u = glm::dot(diff, p) * detInv;
+	if (u < 0.0f || u > 1.0f)
 		return false;
 
-	const AABB& boundA = leftChild->getBoundingBox();
-	const AABB& boundB = rightChild->getBoundingBox();
+	glm::vec3 q = glm::cross(diff, e1);
+	float v = glm::dot(ray.direction, q) * detInv;
+	if (v < 0.0f || u + v > 1.0f)
+		return false;
 
-	glm::vec3 closestA;
-	glm::vec3 closestB;
+	t = glm::dot(e2, q) * detInv;
+	if (t <= eps)
+		return false;
 
-	if (!Intersections::rayBoxIntersection(ray, boundA, closestA))
-	{
-		return rightChild->raycast(ray, hitPoint, uv, triID);
-	}
-	if (!Intersections::rayBoxIntersection(ray, boundB, closestB))
-	{
-		return leftChild->raycast(ray, hitPoint, uv, triID);
-	}
+	uv = glm::vec2(u, v);
+	return true;
+}
+
+bool AABBTree::raycast(Ray& ray, glm::vec3& hitPoint, glm::vec2& uv, unsigned int& triID)
+{
+	if (nodes.empty())
+		return false;
 
-	glm::vec3 diffA = closestA - ray.origin;
-	glm::vec3 diffB = closestB - ray.origin;
-	float distA = glm::dot(diffA, diffA);
-	float distB = glm::dot(diffB, diffB);
+	glm::vec3 invDir = 1.0f / ray.direction;
+	float closestT = std::numeric_limits<float>::max();
+	bool hit = false;
 
-	glm::vec3 hitPointA;
-	glm::vec3 hitPointB;
-	glm::vec2 uvA;
-	glm::vec2 uvB;
-	unsigned int idA = 0;
-	unsigned int idB = 0;
+	float tNear;
+	if (!intersectBox(nodes[0], ray.origin, invDir, closestT, tNear))
+		return false;
 
-	if (distA < distB)
+	unsigned int stack[maxDepth + 1];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
 	{
-		if (leftChild->raycast(ray, hitPointA, uvA, idA))
+		const BVHNode& node = nodes[stack[--stackSize]];
+		if (node.isLeaf())
 		{
-			glm::vec3 diffHitA = hitPointA - ray.origin;
-			float distHitA = glm::dot(diffHitA, diffHitA);
-			if (distHitA < distB)
-			{
-				hitPoint = hitPointA;
-				uv = uvA;
-				triID = idA;
-				return true;
-			}
-
-			if (!rightChild->raycast(ray, hitPointB, uvB, idB))
-			{
-				hitPoint = hitPointA;
-				uv = uvA;
-				triID = idA;
-				return true;
-			}
-
-			glm::vec3 diffHitB = hitPointB - ray.origin;
-			float distHitB = glm::dot(diffHitB, diffHitB);
-			if (distHitA < distHitB)
+			for (unsigned int i = 0; i < node.count; i++)
 			{
-				hitPoint = hitPointA;
-				uv = uvA;
-				triID = idA;
-				return true;
+				unsigned int t = triIndices[node.leftFirst + i];
+				float tHit;
+				glm::vec2 uvHit;
+				if (intersectTri(ray, vertices[t * 3 + 0], vertices[t * 3 + 1], vertices[t * 3 + 2], tHit, uvHit) && tHit < closestT)
+				{
+					closestT = tHit;
+					uv = uvHit;
+					triID = triIDs[t];
+					hit = true;
+				}
 			}
-
-			hitPoint = hitPointB;
-			uv = uvB;
-			triID = idB;
-			return true;
+			continue;
 		}
-		else
+
+		// visit the closer child first, the far one is skipped if a closer hit was found in the meantime
+		unsigned int childA = node.leftFirst;
+		unsigned int childB = node.leftFirst + 1;
+		float tA, tB;
+		bool hitA = intersectBox(nodes[childA], ray.origin, invDir, closestT, tA);
+		bool hitB = intersectBox(nodes[childB], ray.origin, invDir, closestT, tB);
+		if (hitA && hitB)
 		{
-			return rightChild->raycast(ray, hitPoint, uv, triID);
+			if (tB < tA)
+				std::swap(childA, childB);
+			stack[stackSize++] = childB;
+			stack[stackSize++] = childA;
 		}
+		else if (hitA)
+			stack[stackSize++] = childA;
+		else if (hitB)
+			stack[stackSize++] = childB;
 	}
-	else
-	{
-		if (rightChild->raycast(ray, hitPointB, uvB, idB))
-		{
-			glm::vec3 diffHitB = hitPointB - ray.origin;
-			float distHitB = glm::dot(diffHitB, diffHitB);
-			if (distHitB < distA)
-			{
-				hitPoint = hitPointB;
-				uv = uvB;
-				triID = idB;
-				return true;
-			}
-
-			if (!leftChild->raycast(ray, hitPointA, uvA, idA))
-			{
-				hitPoint = hitPointB;
-				uv = uvB;
-				triID = idB;
-				return true;
-			}
 
-			glm::vec3 diffHitA = hitPointA - ray.origin;
-			float distHitA = glm::dot(diffHitA, diffHitA);
-			if (distHitB < distHitA)
-			{
-				hitPoint = hitPointB;
-				uv = uvB;
-				triID = idB;
-				return true;
-			}
+	if (hit)
+		hitPoint = ray.origin + closestT * ray.direction;
+	return hit;
+}
 
-			hitPoint = hitPointA;
-			uv = uvA;
-			triID = idA;
-			return true;
-		}
-		else
-		{
-			return leftChild->raycast(ray, hitPoint, uv, triID);
-		}
-	}
+AABB AABBTree::getBoundingBox()
+{
+	if (nodes.empty())
+		return AABB();
+	return AABB(nodes[0].minPoint, nodes[0].maxPoint);
 }
 
-const AABB& AABBNode::getBoundingBox()
+unsigned int AABBTree::getNumNodes()
 {
-	return boundingBox;
+	return (unsigned int)nodes.size();
 }
\ No newline at end of file
@@ -9,27 +9,51 @@
 
 typedef std::vector<Triangle> TriList;
 
-class AABBNode
+// 32 byte node, children of inner nodes are stored next to each other
+struct BVHNode
 {
-private:
-	AABBNode* parent;
-	AABBNode* leftChild;
-	AABBNode* rightChild;
-	AABB boundingBox;
-	Triangle* tri;
+	glm::vec3 minPoint;
+	unsigned int leftFirst; // index of left child (inner node) or first triangle index (leaf)
+	glm::vec3 maxPoint;
+	unsigned int count; // number of triangles, 0 for inner nodes
 
+	bool isLeaf() const { return count > 0; }
+};
 
+class AABBTree
+{
 public:
-	AABBNode(AABBNode* parent);
-	~AABBNode();
-	static bool compareX(Triangle a, Triangle b);
-	static bool compareY(Triangle a, Triangle b);
-	static bool compareZ(Triangle a, Triangle b);
-	
-	void addTriangles(TriList& triangles);
-	float splitEntries(bool(*compare)(Triangle, Triangle), TriList& entries, TriList& splitA, TriList& splitB);
+	AABBTree();
+	~AABBTree();
+
+	void build(const TriList& triangles);
 	bool raycast(Ray& ray, glm::vec3& hitPoint, glm::vec2& uv, unsigned int& triID);
-	const AABB& getBoundingBox();
+	AABB getBoundingBox();
+	unsigned int getNumNodes();
+
+private:
+	struct Bin
+	{
+		AABB bounds;
+		unsigned int count = 0;
+	};
+
+	void updateNodeBounds(unsigned int nodeIndex);
+	float findBestSplit(BVHNode& node, int& axis, float& splitPos);
+	float nodeCost(const BVHNode& node);
+
+	static constexpr int numBins = 16;
+	static constexpr unsigned int maxLeafSize = 8;
+	static constexpr unsigned int maxDepth = 63;
+
+	std::vector<BVHNode> nodes;
+	std::vector<unsigned int> triIndices;
+	std::vector<glm::vec3> vertices; // 3 positions per triangle
+	std::vector<glm::vec3> centroids;
+	std::vector<unsigned int> triIDs;
+
+	AABBTree(const AABBTree&) = delete;
+	AABBTree& operator=(const AABBTree&) = delete;
 };
 
 #endif // INCLUDED_AABBTREE
\ No newline at end of file
@@ -88,6 +88,21 @@ glm::vec3 AABB::getSize()
 	return maxPoint - minPoint;
 }
 
+AABB AABB::transform(const glm::mat4& M) const
+{
+	// Arvo: project the extents onto the world axes instead of transforming all 8 corners
+	glm::vec3 center = (maxPoint + minPoint) * 0.5f;
+	glm::vec3 extents = (maxPoint - minPoint) * 0.5f;
+	glm::vec3 worldCenter = glm::vec3(M * glm::vec4(center, 1.0f));
+	glm::mat3 A = glm::mat3(M);
+	glm::vec3 worldExtents;
+	for (int i = 0; i < 3; i++)
+		worldExtents[i] = std::abs(A[0][i]) * extents.x + std::abs(A[1][i]) * extents.y + std::abs(A[2][i]) * extents.z;
+	glm::vec3 minP = worldCenter - worldExtents;
+	glm::vec3 maxP = worldCenter + worldExtents;
+	return AABB(minP, maxP);
+}
+
 //Sphere::Sphere() :
 //	position(0),
 //	radius(1)
@@ -56,6 +56,7 @@ public:
 	bool isInside(const glm::vec3& point);
 	glm::vec3 getCenter();
 	glm::vec3 getSize();
+	AABB transform(const glm::mat4& M) const;
 	std::vector<glm::vec3> getPoints();	
 };
 
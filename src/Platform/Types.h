@@ -3,6 +3,7 @@
 
 #pragma once
 
+typedef unsigned long long uint64;
 typedef unsigned int uint32;
 typedef unsigned short uint16;
 typedef unsigned char uint8;
@@ -1,13 +1,44 @@
 
 #ifdef USE_OPENGL
 layout(std140, binding = 2) uniform AnimUBO
+{
+	int jointOffset;
+} animation;
+
+// joints of all skins, three rows of the affine matrix per joint
+layout(std430, binding = 0) readonly buffer JointSSBO
+{
+	vec4 jointRows[];
+} palette;
 #else
 layout(std140, set = 2, binding = 0) uniform AnimUBO
-#endif
 {
-	mat4 joints[32];
-	mat4 normals[32];
+	vec4 jointRows[MAX_JOINTS * 3];
 } animation;
+#endif
+
+// the rows of the joint matrix are the columns, so v * M transforms the row vector v
+mat3x4 getJointMatrix(uint index)
+{
+#ifdef USE_OPENGL
+	int row = (animation.jointOffset + int(index)) * 3;
+	return mat3x4(palette.jointRows[row], palette.jointRows[row + 1], palette.jointRows[row + 2]);
+#else
+	int row = int(index) * 3;
+	return mat3x4(animation.jointRows[row], animation.jointRows[row + 1], animation.jointRows[row + 2]);
+#endif
+}
+
+// the cofactor matrix only differs from the inverse transpose by the determinant,
+// its scale is removed when the transformed vectors are normalized
+mat3 getSkinNormalMatrix(mat3x4 B)
+{
+	vec3 r0 = B[0].xyz;
+	vec3 r1 = B[1].xyz;
+	vec3 r2 = B[2].xyz;
+	vec3 c0 = cross(r1, r2);
+	return transpose(mat3(c0, cross(r2, r0), cross(r0, r1))) * sign(dot(r0, c0));
+}
 
 #ifdef USE_OPENGL
 layout(binding = 0) uniform sampler2DArray morphTargets;
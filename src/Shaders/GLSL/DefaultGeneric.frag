@@ -297,9 +297,17 @@ float diffuseTransmissionThickness = 1.0;
 
 	// compute direct light contribution
 	vec3 directColor = vec3(0);
+#ifdef USE_OPENGL
+	float viewDepth = -(camera.view * vec4(wPosition, 1.0)).z;
+	uvec2 lightCluster = getLightCluster(gl_FragCoord.xy, viewDepth);
+	for(uint c = 0; c < lightCluster.y; c++)
+	{
+		int i = int(lightIndices[lightCluster.x + c]);
+#else
 	for(int i = 0; i < numLights; i++)
 	{
-		Light light = lights[i];
+#endif
+		Light light = getLight(i);
 		
 		vec3 lightDir = vec3(0,0,-1);
 		if (light.type == 0)
@@ -5,14 +5,15 @@
 #endif
 
 #define MAX_MORPH_TARGETS 8
+#define MAX_JOINTS 256
 
 layout(location = 0) in vec3 vPosition;
 layout(location = 1) in vec4 vColor;
-layout(location = 2) in vec3 vNormal;
+layout(location = 2) in vec4 vNormal;
 layout(location = 3) in vec2 vTexCoord0;
 layout(location = 4) in vec2 vTexCoord1;
-layout(location = 5) in vec4 vTangent;
-layout(location = 6) in vec4 vJointIndices;
+layout(location = 5) in vec2 vTangent;
+layout(location = 6) in uvec4 vJointIndices;
 layout(location = 7) in vec4 vJointWeights;
 
 layout(location = 0) out vec3 wPosition;
@@ -26,6 +27,30 @@ layout(location = 5) out mat3 wTBN;
 #include "Model.glsl"
 #include "Animation.glsl"
 
+#ifdef USE_OPENGL
+layout(std430, binding = 1) readonly buffer InstanceSSBO
+{
+	mat4 matrices[];
+} instances;
+#endif
+
+mat4 getLocalToWorld()
+{
+#ifdef USE_OPENGL
+	if (model.instanceOffset >= 0) // instanced draw, model data is shared by all instances
+		return instances.matrices[model.instanceOffset + gl_InstanceID];
+#endif
+	return model.localToWorld;
+}
+
+vec3 decodeOctahedral(vec2 e)
+{
+	vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	if (v.z < 0.0)
+		v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+	return normalize(v);
+}
+
 out gl_PerVertex
 {
 	vec4 gl_Position;
@@ -34,42 +59,39 @@ out gl_PerVertex
 void main()
 {
 	vec3 mPosition = vPosition;
-	vec3 mNormal = vNormal;
-	vec3 mTangent = vTangent.xyz;
-	vec3 mBitangent = cross(mNormal, mTangent) * sign(vTangent.w);
+	vec3 mNormal = vNormal.xyz;
+	vec3 mTangent = decodeOctahedral(vTangent);
+	vec3 mBitangent = cross(mNormal, mTangent) * sign(vNormal.w); // handedness is stored with the normal
 
 	if (model.animMode == 1) // vertex skinning
 	{
-		mat4 B = mat4(0.0);
-		mat3 C = mat3(0.0);
+		mat3x4 B = mat3x4(0.0);
 		for(int i = 0; i < 4; i++)
-		{
-			int idx = int(vJointIndices[i]);
-			B += animation.joints[idx] * vJointWeights[i];
-			C += mat3(animation.normals[idx]) * vJointWeights[i];
-		}
+			B += getJointMatrix(vJointIndices[i]) * vJointWeights[i];
 
-		mPosition = vec3(B * vec4(mPosition, 1.0));
+		mat3 C = getSkinNormalMatrix(B);
+		mPosition = vec4(mPosition, 1.0) * B;
 		mNormal = normalize(C * mNormal);
 		mTangent = normalize(C * mTangent);
 		mBitangent = normalize(C * mBitangent);
 	}
 	if (model.animMode == 2) // morph targets
 	{
+		// the vertex index includes the base vertex of the primitive in the geometry pool
 #ifdef USE_OPENGL
-		mPosition += getTargetAttribute(gl_VertexID, 0);
-		mNormal += getTargetAttribute(gl_VertexID, 1);
-		mTangent += getTargetAttribute(gl_VertexID, 2);
+		int vertexID = gl_VertexID - gl_BaseVertex;
 #else
-		mPosition += getTargetAttribute(gl_VertexIndex, 0);
-		mNormal += getTargetAttribute(gl_VertexIndex, 1);
-		mTangent += getTargetAttribute(gl_VertexIndex, 2);
+		int vertexID = gl_VertexIndex - gl_BaseVertex;
 #endif
+		mPosition += getTargetAttribute(vertexID, 0);
+		mNormal += getTargetAttribute(vertexID, 1);
+		mTangent += getTargetAttribute(vertexID, 2);
 	}
 
-	wPosition = vec3(model.localToWorld * vec4(mPosition, 1.0));
+	mat4 M = getLocalToWorld();
+	wPosition = vec3(M * vec4(mPosition, 1.0));
 	
-	mat3 N = inverse(transpose(mat3(model.localToWorld)));
+	mat3 N = inverse(transpose(mat3(M)));
 	wNormal = normalize(N * mNormal);
 	vec3 wTangent = normalize(N * mTangent);
 	vec3 wBitangent = normalize(N * mBitangent);
@@ -5,14 +5,15 @@
 #endif
 
 #define MAX_MORPH_TARGETS 8
+#define MAX_JOINTS 256
 
 layout(location = 0) in vec3 vPosition;
 layout(location = 1) in vec4 vColor;
-layout(location = 2) in vec3 vNormal;
+layout(location = 2) in vec4 vNormal;
 layout(location = 3) in vec2 vTexCoord0;
 layout(location = 4) in vec2 vTexCoord1;
-layout(location = 5) in vec4 vTangent;
-layout(location = 6) in vec4 vJointIndices;
+layout(location = 5) in vec2 vTangent;
+layout(location = 6) in uvec4 vJointIndices;
 layout(location = 7) in vec4 vJointWeights;
 
 layout(location = 0) out vec3 wPosition;
@@ -83,13 +84,44 @@ vec3 computeRadianceSHPrescaled(vec3 dir)
 }
 #ifdef USE_OPENGL
 layout(std140, binding = 2) uniform AnimUBO
+{
+	int jointOffset;
+} animation;
+
+// joints of all skins, three rows of the affine matrix per joint
+layout(std430, binding = 0) readonly buffer JointSSBO
+{
+	vec4 jointRows[];
+} palette;
 #else
 layout(std140, set = 2, binding = 0) uniform AnimUBO
-#endif
 {
-	mat4 joints[32];
-	mat4 normals[32];
+	vec4 jointRows[MAX_JOINTS * 3];
 } animation;
+#endif
+
+// the rows of the joint matrix are the columns, so v * M transforms the row vector v
+mat3x4 getJointMatrix(uint index)
+{
+#ifdef USE_OPENGL
+	int row = (animation.jointOffset + int(index)) * 3;
+	return mat3x4(palette.jointRows[row], palette.jointRows[row + 1], palette.jointRows[row + 2]);
+#else
+	int row = int(index) * 3;
+	return mat3x4(animation.jointRows[row], animation.jointRows[row + 1], animation.jointRows[row + 2]);
+#endif
+}
+
+// the cofactor matrix only differs from the inverse transpose by the determinant,
+// its scale is removed when the transformed vectors are normalized
+mat3 getSkinNormalMatrix(mat3x4 B)
+{
+	vec3 r0 = B[0].xyz;
+	vec3 r1 = B[1].xyz;
+	vec3 r2 = B[2].xyz;
+	vec3 c0 = cross(r1, r2);
+	return transpose(mat3(c0, cross(r2, r0), cross(r0, r1))) * sign(dot(r0, c0));
+}
 
 #ifdef USE_OPENGL
 layout(binding = 0) uniform sampler2DArray morphTargets;
@@ -113,6 +145,14 @@ vec3 getTargetAttribute(int vertexID, int attrOffset)
 	return offset;
 }
 
+vec3 decodeOctahedral(vec2 e)
+{
+	vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	if (v.z < 0.0)
+		v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+	return normalize(v);
+}
+
 out gl_PerVertex
 {
 	vec4 gl_Position;
@@ -121,37 +161,33 @@ out gl_PerVertex
 void main()
 {
 	vec3 mPosition = vPosition;
-	vec3 mNormal = vNormal;
-	vec3 mTangent = vTangent.xyz;
-	vec3 mBitangent = cross(mNormal, mTangent) * sign(vTangent.w);
+	vec3 mNormal = vNormal.xyz;
+	vec3 mTangent = decodeOctahedral(vTangent);
+	vec3 mBitangent = cross(mNormal, mTangent) * sign(vNormal.w); // handedness is stored with the normal
 
 	if (model.animMode == 1) // vertex skinning
 	{
-		mat4 B = mat4(0.0);
-		mat3 C = mat3(0.0);
+		mat3x4 B = mat3x4(0.0);
 		for(int i = 0; i < 4; i++)
-		{
-			int idx = int(vJointIndices[i]);
-			B += animation.joints[idx] * vJointWeights[i];
-			C += mat3(animation.normals[idx]) * vJointWeights[i];
-		}
+			B += getJointMatrix(vJointIndices[i]) * vJointWeights[i];
 
-		mPosition = vec3(B * vec4(mPosition, 1.0));
+		mat3 C = getSkinNormalMatrix(B);
+		mPosition = vec4(mPosition, 1.0) * B;
 		mNormal = normalize(C * mNormal);
 		mTangent = normalize(C * mTangent);
 		mBitangent = normalize(C * mBitangent);
 	}
 	if (model.animMode == 2) // morph targets
 	{
+		// the vertex index includes the base vertex of the primitive in the geometry pool
 #ifdef USE_OPENGL
-		mPosition += getTargetAttribute(gl_VertexID, 0);
-		mNormal += getTargetAttribute(gl_VertexID, 1);
-		mTangent += getTargetAttribute(gl_VertexID, 2);
+		int vertexID = gl_VertexID - gl_BaseVertex;
 #else
-		mPosition += getTargetAttribute(gl_VertexIndex, 0);
-		mNormal += getTargetAttribute(gl_VertexIndex, 1);
-		mTangent += getTargetAttribute(gl_VertexIndex, 2);
+		int vertexID = gl_VertexIndex - gl_BaseVertex;
 #endif
+		mPosition += getTargetAttribute(vertexID, 0);
+		mNormal += getTargetAttribute(vertexID, 1);
+		mTangent += getTargetAttribute(vertexID, 2);
 	}
 
 	wPosition = vec3(model.localToWorld * vec4(mPosition, 1.0));
@@ -11,6 +11,7 @@ struct Light
 	int type;
 	bool on;
 	bool castShadows;
+	int shadowIndex;
 };
 
 #ifdef USE_OPENGL
@@ -23,7 +24,46 @@ layout(std140, set = 6, binding = 0) uniform LightUBO
 	int numLights;
 };
 
+#ifdef USE_OPENGL
+// clustered lights, the grid holds the offset and count of each cluster in the index list
+layout(std430, binding = 2) readonly buffer LightSSBO
+{
+	Light clusterLights[];
+};
+
+layout(std430, binding = 3) readonly buffer ClusterSSBO
+{
+	uvec4 clusterSize;
+	vec4 clusterScale;
+	uvec2 clusters[];
+};
+
+layout(std430, binding = 4) readonly buffer LightIndexSSBO
+{
+	uint lightIndices[];
+};
+
+uvec2 getLightCluster(vec2 fragCoord, float viewDepth)
+{
+	uvec2 tile = min(uvec2(fragCoord * clusterScale.xy), clusterSize.xy - 1);
+	float slice = log2(max(viewDepth, 0.0001)) * clusterScale.z + clusterScale.w;
+	uint z = uint(clamp(slice, 0.0, float(clusterSize.z - 1)));
+	return clusters[(z * clusterSize.y + tile.y) * clusterSize.x + tile.x];
+}
+
+Light getLight(int index)
+{
+	return clusterLights[index];
+}
+#else
+Light getLight(int index)
+{
+	return lights[index];
+}
+#endif
+
 #define MAX_CASCADES 4
+#define MAX_SHADOW_LIGHTS 64
 #ifdef USE_OPENGL
 layout(std140, binding = 6) uniform ShadowUBO
 #else
@@ -33,15 +73,16 @@ layout(std140, set = 6, binding = 1) uniform ShadowUBO
 	mat4 lightSpaceMatrices[MAX_CASCADES];
 	vec4 cascadePlaneDistance;
 	int cascadeCount;
+	vec4 omniTiles[MAX_SHADOW_LIGHTS * 6]; // atlas offset (xy) and size (z) of each cube face
 };
 
 #ifdef USE_OPENGL
-layout(binding = 18) uniform samplerCubeArrayShadow shadowMaps;
+layout(binding = 18) uniform sampler2DShadow shadowAtlas;
 layout(binding = 19) uniform sampler2DArray shadowCascades;
 layout(binding = 20) uniform sampler2DArray lightMaps;
 layout(binding = 21) uniform sampler2DArray directionMaps;
 #else
-layout(set = 6, binding = 2) uniform samplerCubeArrayShadow shadowMaps;
+layout(set = 6, binding = 2) uniform sampler2DShadow shadowAtlas;
 layout(set = 6, binding = 3) uniform sampler2DArray shadowCascades;
 layout(set = 6, binding = 4) uniform sampler2DArray lightMaps;
 layout(set = 6, binding = 5) uniform sampler2DArray directionMaps;
@@ -66,30 +107,61 @@ vec3 getLightmapRadiance(int index, vec2 uv, vec4 st)
 	return irradiance * lightIntensity * NoL;
 }
 
+// the faces of the cube are tiles in the shadow atlas, selected with the same table as the light views
 float getPointShadow(vec3 fragPos, int index)
 {
-	Light light = lights[index];
+	Light light = getLight(index);
+	if (light.shadowIndex < 0)
+		return 1.0;
+
 	vec3 f = fragPos - light.position.xyz;
-	float len = length(f);
-	float shadow = 0.0;
-	float radius = 0.002;
-	float depth = (len / light.range) - 0.0001; // TODO: add to light properties
+	vec3 a = abs(f);
+	int face;
+	vec3 fwd;
+	vec3 up;
+	if (a.x >= a.y && a.x >= a.z)
+	{
+		face = f.x > 0.0 ? 0 : 1;
+		fwd = vec3(f.x > 0.0 ? 1.0 : -1.0, 0.0, 0.0);
+		up = vec3(0.0, -1.0, 0.0);
+	}
+	else if (a.y >= a.z)
+	{
+		face = f.y > 0.0 ? 2 : 3;
+		fwd = vec3(0.0, f.y > 0.0 ? 1.0 : -1.0, 0.0);
+		up = vec3(0.0, 0.0, fwd.y);
+	}
+	else
+	{
+		face = f.z > 0.0 ? 4 : 5;
+		fwd = vec3(0.0, 0.0, f.z > 0.0 ? 1.0 : -1.0);
+		up = vec3(0.0, -1.0, 0.0);
+	}
+
+	vec4 tile = omniTiles[light.shadowIndex * 6 + face];
+	if (tile.z == 0.0)
+		return 1.0;
 
+	// project like the 90 degree view of the face and map to the tile
+	vec3 s = normalize(cross(fwd, up));
+	vec3 u = cross(s, fwd);
+	vec2 uv = vec2(dot(f, s), dot(f, u)) / dot(f, fwd) * 0.5 + 0.5;
+	float depth = (length(f) / light.range) - 0.0001; // TODO: add to light properties
+
+	// the samples are clamped to the tile, so the filter never reads a neighbouring light
+	vec2 texelSize = 1.0 / vec2(textureSize(shadowAtlas, 0));
+	vec2 minUV = tile.xy + texelSize * 0.5;
+	vec2 maxUV = tile.xy + tile.zz - texelSize * 0.5;
+	float shadow = 0.0;
 	for (int x = -1; x <= 1; x++)
 	{
 		for (int y = -1; y <= 1; y++)
 		{
-			for (int z = -1; z <= 1; z++)
-			{
-				vec3 offset = vec3(x, y, z);
-				vec3 uvw = f + offset * radius;
-//				uvw.y = -uvw.y;
-				//shadow += texture(shadowMaps, vec4(uvw, depth));
-				shadow += texture(shadowMaps, vec4(uvw, index), depth);
-			}
+			vec2 coords = clamp(tile.xy + uv * tile.z + vec2(x, y) * texelSize, minUV, maxUV);
+			shadow += texture(shadowAtlas, vec3(coords, depth));
 		}
 	}
-	return shadow / 27.0;
+	return shadow / 9.0;
 }
 
 float getDirectionalShadowCSM(mat4 V, vec3 wPosition, float NoL, float zFar)
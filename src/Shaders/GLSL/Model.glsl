@@ -15,6 +15,8 @@ layout(std140, set = 1, binding = 0) uniform ModelUBO
 	vec4 lightMapST;
 	vec4 sh[9];
 	int reflectionProbeIndex;
+	int instanceOffset;
+	int shadowCascades;
 } model;
 
 vec3 computeRadianceSHPrescaled(vec3 dir)
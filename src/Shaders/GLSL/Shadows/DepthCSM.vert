@@ -1,6 +1,6 @@
 #version 460 core
 
-#define MAX_JOINTS 160
+#define MAX_JOINTS 256
 #define MAX_MORPH_TARGETS 8
 #define MORPH_TARGET_POSITION_OFFSET 0
 #define MORPH_TARGET_NORMAL_OFFSET 1
@@ -9,11 +9,12 @@
 layout(location = 0) in vec3 vPosition;
 layout(location = 3) in vec2 vTexCoord0;
 layout(location = 4) in vec2 vTexCoord1;
-layout(location = 6) in vec4 vJointIndices;
+layout(location = 6) in uvec4 vJointIndices;
 layout(location = 7) in vec4 vJointWeights;
 
 layout(location = 0) out vec2 texCoord0;
 layout(location = 1) out vec2 texCoord1;
+layout(location = 2) flat out int cascades;
 
 #ifdef USE_OPENGL
 layout(std140, binding = 0) uniform CameraUBO
@@ -53,17 +54,39 @@ layout(std140, set = 1, binding = 0) uniform ModelUBO
 	vec4 lightMapST;
 	vec4 sh[9];
 	int reflectionProbeIndex;
+	int instanceOffset;
+	int shadowCascades;
 } model;
 
 #ifdef USE_OPENGL
 layout(std140, binding = 2) uniform AnimUBO
+{
+	int jointOffset;
+} animation;
+
+// joints of all skins, three rows of the affine matrix per joint
+layout(std430, binding = 0) readonly buffer JointSSBO
+{
+	vec4 jointRows[];
+} palette;
 #else
 layout(std140, set = 2, binding = 0) uniform AnimUBO
-#endif
 {
-	mat4 joints[32];
-	mat4 normals[32];
+	vec4 jointRows[MAX_JOINTS * 3];
 } animation;
+#endif
+
+// the rows of the joint matrix are the columns, so v * M transforms the row vector v
+mat3x4 getJointMatrix(uint index)
+{
+#ifdef USE_OPENGL
+	int row = (animation.jointOffset + int(index)) * 3;
+	return mat3x4(palette.jointRows[row], palette.jointRows[row + 1], palette.jointRows[row + 2]);
+#else
+	int row = int(index) * 3;
+	return mat3x4(animation.jointRows[row], animation.jointRows[row + 1], animation.jointRows[row + 2]);
+#endif
+}
 
 #ifdef USE_OPENGL
 layout(binding = 0) uniform sampler2DArray morphTargets;
@@ -92,24 +115,24 @@ void main()
 	vec3 mPosition = vPosition;
 	if (model.animMode == 1)
 	{
-		mat4 B = mat4(0.0);
+		mat3x4 B = mat3x4(0.0);
 		for(int i = 0; i < 4; i++)
-		{
-			int index = int(vJointIndices[i]);
-			B += animation.joints[index] * vJointWeights[i];
-		}
-		mPosition = vec3(B * vec4(mPosition, 1.0));
+			B += getJointMatrix(vJointIndices[i]) * vJointWeights[i];
+		mPosition = vec4(mPosition, 1.0) * B;
 	}
 	else if(model.animMode == 2)
 	{
+		// the vertex index includes the base vertex of the primitive in the geometry pool
 #ifdef USE_OPENGL
-		mPosition += getTargetAttribute(gl_VertexID, 0);
+		int vertexID = gl_VertexID - gl_BaseVertex;
 #else
-		mPosition += getTargetAttribute(gl_VertexIndex, 0);
+		int vertexID = gl_VertexIndex - gl_BaseVertex;
 #endif
+		mPosition += getTargetAttribute(vertexID, 0);
 	}
 
 	texCoord0 = vTexCoord0;
 	texCoord1 = vTexCoord1;
+	cascades = model.shadowCascades;
 	gl_Position = model.localToWorld * vec4(mPosition, 1.0);
 }
\ No newline at end of file
@@ -1,12 +1,13 @@
 #version 460 core
 
 #define MAX_MORPH_TARGETS 8
+#define MAX_JOINTS 256
 
 layout(location = 0) in vec3 vPosition;
 layout(location = 1) in vec4 vColor;
 layout(location = 3) in vec2 vTexCoord0;
 layout(location = 4) in vec2 vTexCoord1;
-layout(location = 6) in vec4 vJointIndices;
+layout(location = 6) in uvec4 vJointIndices;
 layout(location = 7) in vec4 vJointWeights;
 
 layout(location = 0) out vec3 wPosition;
@@ -55,13 +56,33 @@ layout(std140, set = 1, binding = 0) uniform ModelUBO
 
 #ifdef USE_OPENGL
 layout(std140, binding = 2) uniform AnimUBO
+{
+	int jointOffset;
+} animation;
+
+// joints of all skins, three rows of the affine matrix per joint
+layout(std430, binding = 0) readonly buffer JointSSBO
+{
+	vec4 jointRows[];
+} palette;
 #else
 layout(std140, set = 2, binding = 0) uniform AnimUBO
-#endif
 {
-	mat4 joints[32];
-	mat4 normals[32];
+	vec4 jointRows[MAX_JOINTS * 3];
 } animation;
+#endif
+
+// the rows of the joint matrix are the columns, so v * M transforms the row vector v
+mat3x4 getJointMatrix(uint index)
+{
+#ifdef USE_OPENGL
+	int row = (animation.jointOffset + int(index)) * 3;
+	return mat3x4(palette.jointRows[row], palette.jointRows[row + 1], palette.jointRows[row + 2]);
+#else
+	int row = int(index) * 3;
+	return mat3x4(animation.jointRows[row], animation.jointRows[row + 1], animation.jointRows[row + 2]);
+#endif
+}
 
 #ifdef USE_OPENGL
 layout(binding = 0) uniform sampler2DArray morphTargets;
@@ -96,24 +117,21 @@ void main()
 
 	if (model.animMode == 1) // vertex skinning
 	{
-		mat4 B = mat4(0.0);
-		mat3 C = mat3(0.0);
+		mat3x4 B = mat3x4(0.0);
 		for(int i = 0; i < 4; i++)
-		{
-			int idx = int(vJointIndices[i]);
-			B += animation.joints[idx] * vJointWeights[i];
-			C += mat3(animation.normals[idx]) * vJointWeights[i];
-		}
+			B += getJointMatrix(vJointIndices[i]) * vJointWeights[i];
 
-		mPosition = vec3(B * vec4(mPosition, 1.0));
+		mPosition = vec4(mPosition, 1.0) * B;
 	}
 	if (model.animMode == 2) // morph targets
 	{
+		// the vertex index includes the base vertex of the primitive in the geometry pool
 #ifdef USE_OPENGL
-		mPosition += getTargetAttribute(gl_VertexID, 0);
+		int vertexID = gl_VertexID - gl_BaseVertex;
 #else
-		mPosition += getTargetAttribute(gl_VertexIndex, 0);
+		int vertexID = gl_VertexIndex - gl_BaseVertex;
 #endif
+		mPosition += getTargetAttribute(vertexID, 0);
 	}
 
 	wPosition = vec3(model.localToWorld * vec4(mPosition, 1.0));
@@ -81,7 +81,7 @@ struct Light
     int type;
     int on;
     int castShadows;
-    int padding;
+    int shadowIndex;
 };
 
 cbuffer LightUBO : register(b5)
@@ -90,14 +90,17 @@ cbuffer LightUBO : register(b5)
     int numLights;
 };
 
+#define MAX_SHADOW_LIGHTS 64
+
 cbuffer ShadowUBO : register(b6)
 {
     float4x4 lightSpaceMatrices[4];
     float4 cascadePlaneDistance;
     int cascadeCount;
+    float4 omniTiles[MAX_SHADOW_LIGHTS * 6]; // atlas offset (xy) and size (z) of each cube face
 };
 
-TextureCubeArray shadowMaps : register(t18);
+Texture2D shadowAtlas : register(t18);
 Texture2DArray shadowCascades : register(t19);
 Texture2DArray lightMaps : register(t20);
 Texture2DArray directionMaps : register(t21);
@@ -125,33 +128,66 @@ float3 getLightmapRadiance(int index, float2 uv, float4 st, float3 normal)
     return irradiance * lightIntensity * NoL;
 }
 
+// the faces of the cube are tiles in the shadow atlas, selected with the same table as the light views
 float getPointShadow(float3 fragPos, int index)
 {
-    //fragPos.x += 1.0;
     Light light = lights[index];
+    if (light.shadowIndex < 0)
+        return 1.0;
+
     float3 f = fragPos - light.position.xyz;
-    float len = length(f);
-    float shadow = 0.0;
-    float radius = 0.02;
-    float depth = (len / light.range) - 0.001; // TODO: add to light properties
+    float3 a = abs(f);
+    int face;
+    float3 fwd;
+    float3 up;
+    if (a.x >= a.y && a.x >= a.z)
+    {
+        face = f.x > 0.0 ? 0 : 1;
+        fwd = float3(f.x > 0.0 ? 1.0 : -1.0, 0.0, 0.0);
+        up = float3(0.0, -1.0, 0.0);
+    }
+    else if (a.y >= a.z)
+    {
+        face = f.y > 0.0 ? 2 : 3;
+        fwd = float3(0.0, f.y > 0.0 ? 1.0 : -1.0, 0.0);
+        up = float3(0.0, 0.0, fwd.y);
+    }
+    else
+    {
+        face = f.z > 0.0 ? 4 : 5;
+        fwd = float3(0.0, 0.0, f.z > 0.0 ? 1.0 : -1.0);
+        up = float3(0.0, -1.0, 0.0);
+    }
 
+    float4 tile = omniTiles[light.shadowIndex * 6 + face];
+    if (tile.z == 0.0)
+        return 1.0;
+
+    // project like the 90 degree view of the face and map to the tile, the viewport of D3D is flipped in y
+    float3 s = normalize(cross(fwd, up));
+    float3 u = cross(s, fwd);
+    float2 ndc = float2(dot(f, s), dot(f, u)) / dot(f, fwd);
+    float2 uv = float2(ndc.x, -ndc.y) * 0.5 + 0.5;
+    float depth = (length(f) / light.range) - 0.001; // TODO: add to light properties
+
+    // the samples are clamped to the tile, so the filter never reads a neighbouring light
+    float width, height;
+    shadowAtlas.GetDimensions(width, height);
+    float2 texelSize = 1.0 / float2(width, height);
+    float2 minUV = tile.xy + texelSize * 0.5;
+    float2 maxUV = tile.xy + tile.zz - texelSize * 0.5;
+    float shadow = 0.0;
     [unroll]
     for (int x = -1; x <= 1; x++)
     {
         [unroll]
         for (int y = -1; y <= 1; y++)
         {
-            [unroll]
-            for (int z = -1; z <= 1; z++)
-            {
-                float3 offset = float3(x, y, z);
-                float3 uvw = f + offset * radius;
-                uvw.x = -uvw.x;
-                shadow += shadowMaps.SampleCmp(shadowMapSampler, float4(uvw, index), depth).r;
-            }
+            float2 coords = clamp(tile.xy + uv * tile.z + float2(x, y) * texelSize, minUV, maxUV);
+            shadow += shadowAtlas.SampleCmpLevelZero(shadowMapSampler, coords, depth).r;
         }
     }
-    return shadow / 27.0;
+    return shadow / 9.0;
 }
 
 float getDirectionalShadowCSM(float4x4 V, float3 wPosition, float NoL, float zFar)
@@ -1,14 +1,15 @@
 #define MAX_MORPH_TARGETS 8
+#define MAX_JOINTS 256
 
 struct VSInput
 {
     float3 vPosition : POSITION;
     float4 vColor : COLOR;
-    float3 vNormal : NORMAL;
+    float4 vNormal : NORMAL;
     float2 vTexCoord0 : TEXCOORD0;
     float2 vTexCoord1 : TEXCOORD1;
-    float4 vTangent : TANGENT;
-    float4 vJointIndices : BLENDINDICES;
+    float2 vTangent : TANGENT;
+    uint4 vJointIndices : BLENDINDICES;
     float4 vJointWeights : BLENDWEIGHT;
     uint vertexID : SV_VertexID;
 };
@@ -57,10 +58,26 @@ cbuffer ModelUBO : register(b1)
 
 cbuffer AnimUBO : register(b2)
 {
-    float4x4 joints[32];
-    float4x4 normals[32];
+    float4 jointRows[MAX_JOINTS * 3]; // three rows of the affine matrix per joint
 };
 
+float3x4 getJointMatrix(uint index)
+{
+    uint row = index * 3;
+    return float3x4(jointRows[row], jointRows[row + 1], jointRows[row + 2]);
+}
+
+// the cofactor matrix only differs from the inverse transpose by the determinant,
+// its scale is removed when the transformed vectors are normalized
+float3x3 getSkinNormalMatrix(float3x4 B)
+{
+    float3 r0 = B[0].xyz;
+    float3 r1 = B[1].xyz;
+    float3 r2 = B[2].xyz;
+    float3 c0 = cross(r1, r2);
+    return float3x3(c0, cross(r2, r0), cross(r0, r1)) * sign(dot(r0, c0));
+}
+
 Texture2DArray morphTargets : register(t0);
 SamplerState morphSampler : register(s0);
 
@@ -82,29 +99,32 @@ float3 getTargetAttribute(uint vertexID, uint attrOffset)
     return offset;
 }
 
+float3 decodeOctahedral(float2 e)
+{
+    float3 v = float3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0)
+        v.xy = (1.0 - abs(v.yx)) * float2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(v);
+}
+
 VSOutput main(VSInput input)
 {
     float3 mPosition = input.vPosition;
-    float3 mNormal = input.vNormal;
-    float3 mTangent = input.vTangent.xyz;
-    float3 mBitangent = cross(mNormal, mTangent) * sign(input.vTangent.w);
+    float3 mNormal = input.vNormal.xyz;
+    float3 mTangent = decodeOctahedral(input.vTangent);
+    float3 mBitangent = cross(mNormal, mTangent) * sign(input.vNormal.w); // handedness is stored with the normal
     
     if (animMode == 1) // vertex skinning
     {
-        float4x4 B = float4x4(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-        float3x3 C = float3x3(0, 0, 0, 0, 0, 0, 0, 0, 0);
+        float3x4 B = (float3x4)0;
         for (int i = 0; i < 4; i++)
-        {
-            int idx = int(input.vJointIndices[i]);
-            float3x3 N = float3x3(normals[idx][0].xyz, normals[idx][1].xyz, normals[idx][2].xyz);
-            B += joints[idx] * input.vJointWeights[i];
-            C += N * input.vJointWeights[i];
-        }
+            B += getJointMatrix(input.vJointIndices[i]) * input.vJointWeights[i];
 
-        mPosition = mul(float4(mPosition, 1.0), B).xyz;
-        mNormal = normalize(mul(mNormal, C));
-        mTangent = normalize(mul(mTangent, C));
-        mBitangent = normalize(mul(mBitangent, C));
+        float3x3 C = getSkinNormalMatrix(B);
+        mPosition = mul(B, float4(mPosition, 1.0));
+        mNormal = normalize(mul(C, mNormal));
+        mTangent = normalize(mul(C, mTangent));
+        mBitangent = normalize(mul(C, mBitangent));
     }
     if (animMode == 2) // morph targets
     {
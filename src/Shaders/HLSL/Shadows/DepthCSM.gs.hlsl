@@ -3,6 +3,7 @@ struct GSInput
     float4 position : SV_Position;
     float2 texCoord0 : TEXCOORD0;
     float2 texCoord1 : TEXCOORD1;
+    nointerpolation int cascades : CASCADES;
 };
 
 struct GSOutput
@@ -24,6 +25,10 @@ cbuffer ViewsUBO : register(b3)
 [instance(4)]
 void main(triangle GSInput input[3], inout TriangleStream<GSOutput> triStream, uint instanceID : SV_GSInstanceID)
 {
+	// skip cascades the renderable was culled from
+	if ((input[0].cascades & (1 << instanceID)) == 0)
+		return;
+
 	for(int i = 0; i < 3; i++)
 	{
         GSOutput output;
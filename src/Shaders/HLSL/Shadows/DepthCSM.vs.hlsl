@@ -1,11 +1,12 @@
 #define MAX_MORPH_TARGETS 8
+#define MAX_JOINTS 256
 
 struct VSInput
 {
     float3 vPosition : POSITION;
     float2 vTexCoord0 : TEXCOORD0;
     float2 vTexCoord1 : TEXCOORD1;
-    float4 vJointIndices : BLENDINDICES;
+    uint4 vJointIndices : BLENDINDICES;
     float4 vJoinWeights : BLENDWEIGHT;
 };
 
@@ -14,6 +15,7 @@ struct VSOutput
     float4 position : SV_Position;
     float2 texCoord0 : TEXCOORD0;
     float2 texCoord1 : TEXCOORD1;
+    nointerpolation int cascades : CASCADES;
 };
 
 cbuffer CameraUBO : register(b0)
@@ -37,7 +39,7 @@ cbuffer ModelUBO : register(b1)
 {
     float4x4 localToWorld;
     float4x4 localToWorldNormal;
-    float4x4 weights[MAX_MORPH_TARGETS / 4];
+    float4 weights[MAX_MORPH_TARGETS / 4];
     int animMode;
     int numMorphTargets;
     int irradianceMode;
@@ -45,14 +47,21 @@ cbuffer ModelUBO : register(b1)
     float4 lightMapST;
     float4 sh[9];
     int reflectionProbeIndex;
+    int instanceOffset;
+    int shadowCascades;
 };
 
 cbuffer AnimUBO : register(b2)
 {
-    float4x4 joints[32];
-    float4x4 normals[32];
+    float4 jointRows[MAX_JOINTS * 3]; // three rows of the affine matrix per joint
 };
 
+float3x4 getJointMatrix(uint index)
+{
+    uint row = index * 3;
+    return float3x4(jointRows[row], jointRows[row + 1], jointRows[row + 2]);
+}
+
 Texture2D morphTargets : register(t0);
 SamplerState morphSamplers : register(s0);
 
@@ -62,6 +71,7 @@ VSOutput main(VSInput input)
     VSOutput output;
     output.texCoord0 = input.vTexCoord0;
     output.texCoord1 = input.vTexCoord1;
+    output.cascades = shadowCascades;
     output.position = mul(float4(input.vPosition, 1.0), localToWorld);
     //output.position.x *= -1.0;
     return output;
@@ -11,34 +11,26 @@ struct GSOutput
 	float3 wPosition : POSITION;
     float2 texCoord0 : TEXCOORD0;
     float2 texCoord1 : TEXCOORD1;
-    uint rtIndex : SV_RenderTargetArrayIndex;
 };
 
-#define NUM_FACES 6
-
 cbuffer ViewsUBO : register(b3)
 {
-	float4x4 VP[NUM_FACES];
+	float4x4 VP; // one face of the cube, rendered into its tile of the shadow atlas
 	int lightIndex;
 };
 
-[maxvertexcount(18)]
+[maxvertexcount(3)]
 void main(triangle GSInput input[3], inout TriangleStream<GSOutput> triStream)
 {
-	for(int face = 0; face < NUM_FACES; face++)
-	{
-        GSOutput output;
-        output.rtIndex = face;
-
-		for(int i = 0; i < 3; i++)
-		{
-			float4 pos = input[i].position;
-            output.position = mul(pos, VP[face]);
-            output.wPosition = pos.xyz;
-            output.texCoord0 = input[i].texCoord0;
-            output.texCoord1 = input[i].texCoord1;
-            triStream.Append(output);
-        }
-        triStream.RestartStrip();
+    GSOutput output;
+    for(int i = 0; i < 3; i++)
+    {
+        float4 pos = input[i].position;
+        output.position = mul(pos, VP);
+        output.wPosition = pos.xyz;
+        output.texCoord0 = input[i].texCoord0;
+        output.texCoord1 = input[i].texCoord1;
+        triStream.Append(output);
     }
-}
+    triStream.RestartStrip();
+}
\ No newline at end of file
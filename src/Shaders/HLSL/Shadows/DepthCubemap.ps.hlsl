@@ -4,7 +4,6 @@ struct PSInput
     float3 wPosition : POSITION;
     float2 texCoord0 : TEXCOORD0;
     float2 texCoord1 : TEXCOORD1;
-    uint rtIndex : SV_RenderTargetArrayIndex;
 };
 
 cbuffer LightUBO : register(b4)
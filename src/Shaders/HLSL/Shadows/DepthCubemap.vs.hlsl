@@ -1,11 +1,12 @@
 #define MAX_MORPH_TARGETS 8
+#define MAX_JOINTS 256
 
 struct VSInput
 {
     float3 vPosition : POSITION;
     float2 vTexCoord0 : TEXCOORD0;
     float2 vTexCoord1 : TEXCOORD1;
-    float4 vJointIndices : BLENDINDICES;
+    uint4 vJointIndices : BLENDINDICES;
     float4 vJoinWeights : BLENDWEIGHT;
 };
 
@@ -49,10 +50,15 @@ cbuffer ModelUBO : register(b1)
 
 cbuffer AnimUBO : register(b2)
 {
-    float4x4 joints[32];
-    float4x4 normals[32];
+    float4 jointRows[MAX_JOINTS * 3]; // three rows of the affine matrix per joint
 };
 
+float3x4 getJointMatrix(uint index)
+{
+    uint row = index * 3;
+    return float3x4(jointRows[row], jointRows[row + 1], jointRows[row + 2]);
+}
+
 Texture2D morphTargets : register(t0);
 SamplerState morphSamplers : register(s0);
 
@@ -1,4 +1,5 @@
 #define MAX_MORPH_TARGETS 8
+#define MAX_JOINTS 256
 
 struct VSInput
 {
@@ -6,7 +7,7 @@ struct VSInput
     float4 vColor : COLOR;
     float2 vTexCoord0 : TEXCOORD0;
     float2 vTexCoord1 : TEXCOORD1;
-    float4 vJointIndices : BLENDINDICES;
+    uint4 vJointIndices : BLENDINDICES;
     float4 vJointWeights : BLENDWEIGHT;
     uint vertexID : SV_VertexID;
 };
@@ -53,10 +54,15 @@ cbuffer ModelUBO : register(b1)
 
 cbuffer AnimUBO : register(b2)
 {
-    float4x4 joints[32];
-    float4x4 normals[32];
+    float4 jointRows[MAX_JOINTS * 3]; // three rows of the affine matrix per joint
 };
 
+float3x4 getJointMatrix(uint index)
+{
+    uint row = index * 3;
+    return float3x4(jointRows[row], jointRows[row + 1], jointRows[row + 2]);
+}
+
 Texture2DArray morphTargets : register(t0);
 SamplerState morphSampler : register(s0);
 
@@ -84,15 +90,11 @@ VSOutput main(VSInput input)
     
     if (animMode == 1) // vertex skinning
     {
-        float4x4 B = float4x4(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-        float3x3 C = float3x3(0, 0, 0, 0, 0, 0, 0, 0, 0);
+        float3x4 B = (float3x4)0;
         for (int i = 0; i < 4; i++)
-        {
-            int idx = int(input.vJointIndices[i]);
-            B += joints[idx] * input.vJointWeights[i];
-        }
+            B += getJointMatrix(input.vJointIndices[i]) * input.vJointWeights[i];
 
-        mPosition = mul(float4(mPosition, 1.0), B).xyz;
+        mPosition = mul(B, float4(mPosition, 1.0));
     }
     if (animMode == 2) // morph targets
     {
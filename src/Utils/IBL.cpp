@@ -126,22 +126,8 @@ namespace IBL
 		fbo->addAttachment(brdfLUT->getImageView());
 		fbo->createFramebuffer();
 
-		GPU::VertexDescription vertexInputDescription;
-		vertexInputDescription.binding = 0;
-		vertexInputDescription.stride = sizeof(Vertex);
-		vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(1, 0, GPU::VertexAttribFormat::Vector4F, offsetof(Vertex, color)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(2, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, normal)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(3, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord0)));
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(4, 0, GPU::VertexAttribFormat::Vector2F, offsetof(Vertex, texCoord1)));
-
-		vertexInputDescription.inputAttributes[0].name = "POSITION";
-		vertexInputDescription.inputAttributes[1].name = "COLOR";
-		vertexInputDescription.inputAttributes[2].name = "NORMAL";
-		vertexInputDescription.inputAttributes[3].name = "TEXCOORD";
-		vertexInputDescription.inputAttributes[4].name = "TEXCOORD";
-		vertexInputDescription.inputAttributes[4].index = 1;
+		pr::VertexLayout vertexLayout = { pr::VertexStream::Position, pr::VertexStream::Normal, pr::VertexStream::TexCoord0, pr::VertexStream::TexCoord1, pr::VertexStream::Color };
+		GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 		auto descriptorPool = ctx.createDescriptorPool();
 		auto pipeline = ctx.createGraphicsPipeline(fbo, "BRDFLUT", 1);
@@ -151,6 +137,7 @@ namespace IBL
 
 		switch (ctx.getCurrentAPI())
 		{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -252,12 +239,8 @@ namespace IBL
 		descriptorSet->addDescriptor(pano->getDescriptor());
 		descriptorSet->update();
 
-		GPU::VertexDescription vertexInputDescription;
-		vertexInputDescription.binding = 0;
-		vertexInputDescription.stride = sizeof(Vertex);
-		vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-		vertexInputDescription.inputAttributes[0].name = "POSITION";
+		pr::VertexLayout vertexLayout = { pr::VertexStream::Position };
+		GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 		std::vector<std::string> setLayouts = { "Pano2CM" };
 
@@ -268,6 +251,7 @@ namespace IBL
 
 		switch (ctx.getCurrentAPI())
 		{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -379,12 +363,8 @@ namespace IBL
 		descriptorSet->addDescriptor(lightProbe->getDescriptor());
 		descriptorSet->update();
 
-		GPU::VertexDescription vertexInputDescription;
-		vertexInputDescription.binding = 0;
-		vertexInputDescription.stride = sizeof(Vertex);
-		vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-		vertexInputDescription.inputAttributes[0].name = "POSITION";
+		pr::VertexLayout vertexLayout = { pr::VertexStream::Position };
+		GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 		std::vector<std::string> setLayouts = { "IBLFilter" };
 
@@ -395,6 +375,7 @@ namespace IBL
 
 		switch (ctx.getCurrentAPI())
 		{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -517,12 +498,8 @@ namespace IBL
 		descriptorSet->addDescriptor(lightProbe->getDescriptor());
 		descriptorSet->update();
 
-		GPU::VertexDescription vertexInputDescription;
-		vertexInputDescription.binding = 0;
-		vertexInputDescription.stride = sizeof(Vertex);
-		vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-		vertexInputDescription.inputAttributes[0].name = "POSITION";
+		pr::VertexLayout vertexLayout = { pr::VertexStream::Position };
+		GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 		std::vector<std::string> setLayouts = { "IBLFilter" };
 		auto pipeline = ctx.createGraphicsPipeline(framebuffers[0], "IBLFilter", 1);
@@ -532,6 +509,7 @@ namespace IBL
 
 		switch (ctx.getCurrentAPI())
 		{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -675,12 +653,8 @@ namespace IBL
 			descriptorSets.push_back(descriptorSet);
 		}
 
-		GPU::VertexDescription vertexInputDescription;
-		vertexInputDescription.binding = 0;
-		vertexInputDescription.stride = sizeof(Vertex);
-		vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-		vertexInputDescription.inputAttributes[0].name = "POSITION";
+		pr::VertexLayout vertexLayout = { pr::VertexStream::Position };
+		GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 		std::vector<std::string> setLayouts = { "IBLFilter" };
 		auto pipeline = ctx.createGraphicsPipeline(framebuffers[0][0], "IBLFilter", 1);
@@ -690,6 +664,7 @@ namespace IBL
 
 		switch (ctx.getCurrentAPI())
 		{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -829,12 +804,8 @@ namespace IBL
 		descriptorSet->addDescriptor(lightProbe->getDescriptor());
 		descriptorSet->update();
 
-		GPU::VertexDescription vertexInputDescription;
-		vertexInputDescription.binding = 0;
-		vertexInputDescription.stride = sizeof(Vertex);
-		vertexInputDescription.inputRate = GPU::VertexInputeRate::Vertex;
-		vertexInputDescription.inputAttributes.push_back(GPU::VertexInputAttribute(0, 0, GPU::VertexAttribFormat::Vector3F, offsetof(Vertex, position)));
-		vertexInputDescription.inputAttributes[0].name = "POSITION";
+		pr::VertexLayout vertexLayout = { pr::VertexStream::Position };
+		GPU::VertexDescription vertexInputDescription = vertexLayout.getVertexDescription();
 
 		std::vector<std::string> setLayouts = { "IBLFilter" };
 		auto pipeline = ctx.createGraphicsPipeline(framebuffers[0], "IBLFilter", 1);
@@ -844,6 +815,7 @@ namespace IBL
 
 		switch (ctx.getCurrentAPI())
 		{
+			case pr::GraphicsAPI::Null:
 			case pr::GraphicsAPI::OpenGL:
 			{
 				std::string shaderPath = "../../../../src/Shaders/GLSL";
@@ -0,0 +1,67 @@
+#include "Profiler.h"
+
+#include <algorithm>
+
+namespace pr
+{
+	void Profiler::addSample(const std::string& phase, double ms)
+	{
+		auto it = samples.find(phase);
+		if (it == samples.end())
+		{
+			phases.push_back(phase);
+			it = samples.insert(std::make_pair(phase, std::vector<double>())).first;
+		}
+		it->second.push_back(ms);
+	}
+
+	Profiler::Stats Profiler::getStats(const std::string& phase)
+	{
+		Stats stats;
+		auto it = samples.find(phase);
+		if (it == samples.end() || it->second.empty())
+			return stats;
+
+		std::vector<double> sorted = it->second;
+		std::sort(sorted.begin(), sorted.end());
+
+		double sum = 0.0;
+		for (auto s : sorted)
+			sum += s;
+
+		auto percentile = [&sorted](double p) {
+			size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+			return sorted[index];
+		};
+
+		stats.count = static_cast<uint32>(sorted.size());
+		stats.avg = sum / sorted.size();
+		stats.min = sorted.front();
+		stats.max = sorted.back();
+		stats.p50 = percentile(0.50);
+		stats.p95 = percentile(0.95);
+		stats.p99 = percentile(0.99);
+		return stats;
+	}
+
+	void Profiler::clear()
+	{
+		phases.clear();
+		samples.clear();
+	}
+
+	ScopedTimer::ScopedTimer(Profiler& profiler, const std::string& phase) :
+		profiler(profiler),
+		phase(phase),
+		startTime(std::chrono::high_resolution_clock::now())
+	{
+
+	}
+
+	ScopedTimer::~ScopedTimer()
+	{
+		auto endTime = std::chrono::high_resolution_clock::now();
+		double ms = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		profiler.addSample(phase, ms);
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef INCLUDED_PROFILER
+#define INCLUDED_PROFILER
+
+#pragma once
+
+#include <Platform/Types.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace pr
+{
+	// collects CPU timings (in milliseconds) of named phases, usually one sample per frame
+	class Profiler
+	{
+	public:
+		struct Stats
+		{
+			uint32 count = 0;
+			double avg = 0.0;
+			double min = 0.0;
+			double max = 0.0;
+			double p50 = 0.0;
+			double p95 = 0.0;
+			double p99 = 0.0;
+		};
+
+		void addSample(const std::string& phase, double ms);
+		Stats getStats(const std::string& phase);
+		const std::vector<std::string>& getPhases() { return phases; }
+		void clear();
+
+	private:
+		std::vector<std::string> phases; // in order of the first sample
+		std::map<std::string, std::vector<double>> samples;
+	};
+
+	class ScopedTimer
+	{
+	public:
+		ScopedTimer(Profiler& profiler, const std::string& phase);
+		~ScopedTimer();
+
+	private:
+		Profiler& profiler;
+		std::string phase;
+		std::chrono::high_resolution_clock::time_point startTime;
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+	};
+}
+
+#endif // INCLUDED_PROFILER
\ No newline at end of file